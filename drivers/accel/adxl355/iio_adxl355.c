@@ -222,6 +222,7 @@ static struct iio_channel adxl355_channels[] = {
 static struct iio_device adxl355_iio_dev = {
 	.num_ch = NO_OS_ARRAY_SIZE(adxl355_channels),
 	.channels = adxl355_channels,
+	.timestamp = true,
 	.pre_enable = (int32_t (*)())adxl355_iio_update_channels,
 	.trigger_handler = (int32_t (*)())adxl355_trigger_handler,
 	.read_dev = (int32_t (*)())adxl355_iio_read_samples,
@@ -87,13 +87,15 @@ static struct iio_attribute channel_attributes[] = {
 		.name = "filter_low_pass_3db_frequency",
 		.priv = 0,
 		.show = ad7124_iio_read_filter_3db,
-		.store = ad7124_iio_write_filter_3db
+		.store = ad7124_iio_write_filter_3db,
+		.cache_ms = IIO_ATTR_CONST
 	},
 	{
 		.name = "offset",
 		.priv = 0,
 		.show = ad7124_iio_read_offset_chan,
-		.store = ad7124_iio_change_offset_chan
+		.store = ad7124_iio_change_offset_chan,
+		.cache_ms = IIO_ATTR_CONST
 	},
 	{
 		.name = "raw",
@@ -105,13 +107,15 @@ static struct iio_attribute channel_attributes[] = {
 		.name = "sampling_frequency",
 		.priv = 0,
 		.show = ad7124_iio_read_odr_chan,
-		.store = ad7124_iio_change_odr_chan
+		.store = ad7124_iio_change_odr_chan,
+		.cache_ms = IIO_ATTR_CONST
 	},
 	{
 		.name = "scale",
 		.priv = 0,
 		.show = ad7124_iio_read_scale_chan,
-		.store = ad7124_iio_change_scale_chan
+		.store = ad7124_iio_change_scale_chan,
+		.cache_ms = IIO_ATTR_CONST
 	},
 	END_ATTRIBUTES_ARRAY
 };
@@ -153,6 +153,24 @@ int32_t close_adc_channels(void* dev)
 	return 0;
 }
 
+/**
+ * @brief Set the number of scans the emulated FIFO holds when it fires the
+ * trigger
+ * @param dev - physical instance of an adc device
+ * @param watermark - number of scans
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adc_demo_set_watermark(void *dev, uint32_t watermark)
+{
+	if(!dev)
+		return -ENODEV;
+
+	if (watermark > ADC_DEMO_FIFO_DEPTH)
+		return -EINVAL;
+
+	return 0;
+}
+
 /**
  * @brief read function for the adc demo driver
  * @param desc - descriptor for the adc
@@ -57,6 +57,8 @@
 #ifndef TOTAL_ADC_CHANNELS
 #define TOTAL_ADC_CHANNELS 2
 #endif
+/* Scans held by the emulated FIFO, drained at once on each trigger */
+#define ADC_DEMO_FIFO_DEPTH	32
 
 /**
  * @struct iio_demo_adc_desc
@@ -112,6 +114,8 @@ int32_t update_adc_channels(void *dev, uint32_t mask);
 
 int32_t close_adc_channels(void* dev);
 
+int32_t adc_demo_set_watermark(void *dev, uint32_t watermark);
+
 int32_t adc_submit_samples(struct iio_device_data *dev_data);
 
 int32_t adc_demo_reg_read(struct adc_demo_desc *desc, uint8_t reg_index,
@@ -178,7 +178,8 @@ int32_t adc_submit_samples(struct iio_device_data *dev_data)
 
 
 /**
- * @brief Handles trigger: reads one data-set and writes it to the buffer.
+ * @brief Handles trigger: reads the watermark number of data-sets held by the
+ * emulated FIFO and writes them to the buffer.
  *
  * @param dev_data  - The iio device data structure.
  *
@@ -189,8 +190,9 @@ int32_t adc_demo_trigger_handler(struct iio_device_data *dev_data)
 {
 	struct adc_demo_desc *desc;
 	uint32_t k = 0;
-	uint32_t ch = -1;
-	uint16_t buff[TOTAL_ADC_CHANNELS];
+	uint32_t ch;
+	uint32_t n;
+	uint16_t buff[ADC_DEMO_FIFO_DEPTH * TOTAL_ADC_CHANNELS];
 	static uint32_t i = 0;
 	uint16_t *ch_buf_ptr;
 
@@ -199,28 +201,32 @@ int32_t adc_demo_trigger_handler(struct iio_device_data *dev_data)
 
 	desc = (struct adc_demo_desc *)dev_data->dev;
 
-	if(desc->ext_buff == NULL) {
-		int offset_per_ch = NO_OS_ARRAY_SIZE(sine_lut) / TOTAL_ADC_CHANNELS;
-		while(get_next_ch_idx(desc->active_ch, ch, &ch))
-			buff[k++] = sine_lut[(i + ch * offset_per_ch ) % NO_OS_ARRAY_SIZE(sine_lut)];
-		if (i == NO_OS_ARRAY_SIZE(sine_lut))
+	/* Drain the scans gathered in the FIFO since the last trigger */
+	for (n = 0; n < dev_data->buffer->watermark; n++) {
+		ch = -1;
+		if(desc->ext_buff == NULL) {
+			int offset_per_ch = NO_OS_ARRAY_SIZE(sine_lut) / TOTAL_ADC_CHANNELS;
+			while(get_next_ch_idx(desc->active_ch, ch, &ch))
+				buff[k++] = sine_lut[(i + ch * offset_per_ch ) % NO_OS_ARRAY_SIZE(sine_lut)];
+			if (i == NO_OS_ARRAY_SIZE(sine_lut))
+				i = 0;
+			else
+				i++;
+			continue;
+		}
+
+		while(get_next_ch_idx(desc->active_ch, ch, &ch)) {
+			ch_buf_ptr = (uint16_t*)desc->ext_buff + (ch * desc->ext_buff_len);
+			buff[k++] = ch_buf_ptr[i];
+		}
+		if (i == (desc->ext_buff_len - 1))
 			i = 0;
 		else
 			i++;
-
-		return iio_buffer_push_scan(dev_data->buffer, buff);
-	}
-
-	while(get_next_ch_idx(desc->active_ch, ch, &ch)) {
-		ch_buf_ptr = (uint16_t*)desc->ext_buff + (ch * desc->ext_buff_len);
-		buff[k++] = ch_buf_ptr[i];
 	}
-	if (i == (desc->ext_buff_len - 1))
-		i = 0;
-	else
-		i++;
 
-	return iio_buffer_push_scan(dev_data->buffer, buff);
+	return iio_buffer_push_scans(dev_data->buffer, buff,
+				     dev_data->buffer->watermark);
 }
 
 #define ADC_DEMO_ATTR(_name, _priv) {\
@@ -281,12 +287,14 @@ static struct iio_channel iio_adc_channels[] = {
 struct iio_device adc_demo_iio_descriptor = {
 	.num_ch = TOTAL_ADC_CHANNELS,
 	.channels = iio_adc_channels,
+	.timestamp = true,
 	.attributes = iio_adc_global_attributes,
 	.debug_attributes = NULL,
 	.buffer_attributes = NULL,
 	.pre_enable = update_adc_channels,
 	.post_disable = close_adc_channels,
 	.trigger_handler = (int32_t (*)())adc_demo_trigger_handler,
+	.set_watermark = adc_demo_set_watermark,
 	.submit = (int32_t (*)())adc_submit_samples,
 	.debug_reg_read = (int32_t (*)()) adc_demo_reg_read,
 	.debug_reg_write = (int32_t (*)()) adc_demo_reg_write
@@ -43,6 +43,7 @@
 #include "no_os_error.h"
 #include "no_os_mutex.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
 
 /**
  * @brief i2c_table contains the pointers towards the i2c buses
@@ -213,3 +214,86 @@ int32_t no_os_i2c_read(struct no_os_i2c_desc *desc,
 
 	return ret;
 }
+
+/**
+ * @brief Execute several messages as one combined I2C transaction.
+ * Messages are separated by repeated starts and a stop condition is generated
+ * after the last one. Platforms without a native transfer implementation get
+ * the messages issued one by one, with the stop bit set only on the last one.
+ * @param desc - The I2C descriptor.
+ * @param msgs - Array of messages.
+ * @param len - Number of messages.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_i2c_transfer(struct no_os_i2c_desc *desc,
+			   struct no_os_i2c_msg *msgs,
+			   uint32_t len)
+{
+	uint32_t i;
+	int32_t ret;
+
+	if (!desc || !desc->platform_ops || !msgs)
+		return -EINVAL;
+
+	if (desc->platform_ops->i2c_ops_transfer) {
+		no_os_mutex_lock(desc->bus->mutex);
+		ret = desc->platform_ops->i2c_ops_transfer(desc, msgs, len);
+		no_os_mutex_unlock(desc->bus->mutex);
+
+		return ret;
+	}
+
+	if (!desc->platform_ops->i2c_ops_write ||
+	    !desc->platform_ops->i2c_ops_read)
+		return -ENOSYS;
+
+	for (i = 0; i < len; i++)
+		if (msgs[i].len > UINT8_MAX)
+			return -EINVAL;
+
+	no_os_mutex_lock(desc->bus->mutex);
+	for (i = 0, ret = 0; i < len && !ret; i++) {
+		if (msgs[i].flags & NO_OS_I2C_M_RD)
+			ret = desc->platform_ops->i2c_ops_read(desc, msgs[i].buf,
+							       msgs[i].len,
+							       i == len - 1);
+		else
+			ret = desc->platform_ops->i2c_ops_write(desc, msgs[i].buf,
+								msgs[i].len,
+								i == len - 1);
+	}
+	no_os_mutex_unlock(desc->bus->mutex);
+
+	return ret;
+}
+
+/**
+ * @brief Write data (usually a register address) and read back data from the
+ * slave device in a single transaction, with a repeated start in between.
+ * @param desc - The I2C descriptor.
+ * @param tx_data - Data to be written.
+ * @param tx_len - Number of bytes to write.
+ * @param rx_data - Buffer where the read data is stored.
+ * @param rx_len - Number of bytes to read.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_i2c_write_read(struct no_os_i2c_desc *desc,
+			     uint8_t *tx_data,
+			     uint16_t tx_len,
+			     uint8_t *rx_data,
+			     uint16_t rx_len)
+{
+	struct no_os_i2c_msg msgs[2] = {
+		{
+			.buf = tx_data,
+			.len = tx_len,
+		},
+		{
+			.buf = rx_data,
+			.len = rx_len,
+			.flags = NO_OS_I2C_M_RD,
+		},
+	};
+
+	return no_os_i2c_transfer(desc, msgs, NO_OS_ARRAY_SIZE(msgs));
+}
@@ -42,6 +42,8 @@
 /******************************************************************************/
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
 #include <inttypes.h>
 #include "no_os_error.h"
 #include "no_os_delay.h"
@@ -751,74 +753,136 @@ int32_t axi_dac_dds_get_calib_phase(struct axi_dac *dac,
 	return axi_dac_dds_get_calib_phase_scale(dac, 1, chan, val, val2);
 }
 
+/**
+ * @brief Get direct access to DAC buffer memory. If the platform can't map
+ * the range, a staging buffer is returned instead and written out word by
+ * word by axi_dac_mem_put().
+ * @param address - Buffer base address.
+ * @param size - Size in bytes.
+ * @param mem - Address through which the buffer is written.
+ * @param mapped - Whether mem is mapped or a staging buffer.
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+static int32_t axi_dac_mem_get(uint32_t address, uint32_t size,
+			       uint32_t **mem, bool *mapped)
+{
+	*mapped = !no_os_axi_io_map(address, size, (void **)mem);
+	if (*mapped)
+		return 0;
+
+	*mem = no_os_malloc(size);
+	if (!*mem)
+		return -ENOMEM;
+
+	return 0;
+}
+
+/**
+ * @brief Release access to DAC buffer memory obtained with axi_dac_mem_get().
+ * Flushes mapped memory once for the whole range.
+ * @param address - Buffer base address.
+ * @param mem - Address returned by axi_dac_mem_get().
+ * @param size - Size in bytes.
+ * @param mapped - Whether mem is mapped or a staging buffer.
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+static int32_t axi_dac_mem_put(uint32_t address, uint32_t *mem, uint32_t size,
+			       bool mapped)
+{
+	uint32_t index;
+
+	if (mapped)
+		return no_os_axi_io_unmap(address, mem, size);
+
+	for (index = 0; index < size / sizeof(uint32_t); index++)
+		no_os_axi_io_write(address, index * sizeof(uint32_t), mem[index]);
+	no_os_free(mem);
+
+	return 0;
+}
+
+/**
+ * @brief AXI DAC Load I/Q samples into the DAC buffer memory. The memory is
+ * written in one pass and flushed once.
+ * @param dac - The device structure.
+ * @param address - The address where the data is loaded.
+ * @param iq - Samples in DMA format (I in the low, Q in the high 16 bits).
+ * @param count - Number of samples.
+ * @param copies - Number of consecutive copies of each sample (e.g. one per
+ *		   TX channel).
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+int32_t axi_dac_load_iq(struct axi_dac *dac,
+			uint32_t address,
+			const uint32_t *iq,
+			uint32_t count,
+			uint32_t copies)
+{
+	uint32_t index, chan, size;
+	uint32_t *mem;
+	bool mapped;
+	int32_t ret;
+
+	if (!iq || !copies)
+		return -EINVAL;
+
+	size = count * copies * sizeof(uint32_t);
+	ret = axi_dac_mem_get(address, size, &mem, &mapped);
+	if (ret)
+		return ret;
+
+	if (copies == 1) {
+		memcpy(mem, iq, size);
+	} else {
+		for (index = 0; index < count; index++)
+			for (chan = 0; chan < copies; chan++)
+				mem[index * copies + chan] = iq[index];
+	}
+
+	return axi_dac_mem_put(address, mem, size, mapped);
+}
+
 /**
  * @brief AXI DAC Set data based on a Sine Lookup Table
  * @param dac - The device structure.
  * @param address - Address of the sine lut.
- * @return Returns 0 in case of success or negative error code otherwise.
+ * @return Returns the length of the data in bytes, 0 in case of failure.
  */
 uint32_t axi_dac_set_sine_lut(struct axi_dac *dac,
 			      uint32_t address)
 {
-	uint32_t length;
-	uint32_t tx_count;
-	uint32_t index_mem;
-	uint32_t index;
-	uint32_t index_i1;
-	uint32_t index_q1;
-	uint32_t index_i2;
-	uint32_t index_q2;
-	uint32_t data_i1;
-	uint32_t data_q1;
-	uint32_t data_i2;
-	uint32_t data_q2;
-	tx_count = sizeof(sine_lut) / sizeof(uint16_t);
-	if(dac->num_channels == 4) {
-		for(index = 0, index_mem = 0; index < (tx_count * 2);
-		    index += 2, index_mem += 2) {
-			index_i1 = index;
-			index_q1 = index + (tx_count / 2);
-			if(index_q1 >= (tx_count * 2))
-				index_q1 -= (tx_count * 2);
-			data_i1 = (sine_lut[index_i1 / 2] << 20);
-			data_q1 = (sine_lut[index_q1 / 2] << 4);
-
-			no_os_axi_io_write(address, index_mem * 4, data_i1 | data_q1);
-
-			index_i2 = index_i1;
-			index_q2 = index_q1;
-			if(index_i2 >= (tx_count * 2))
-				index_i2 -= (tx_count * 2);
-			if(index_q2 >= (tx_count * 2))
-				index_q2 -= (tx_count * 2);
-			data_i2 = (sine_lut[index_i2 / 2] << 20);
-			data_q2 = (sine_lut[index_q2 / 2] << 4);
-
-			no_os_axi_io_write(address, (index_mem + 1) * 4, data_i2 | data_q2);
-
-		}
-	} else {
-		for(index = 0; index < tx_count; index += 1) {
-			index_i1 = index;
-			index_q1 = index + (tx_count / 4);
-			if(index_q1 >= tx_count)
-				index_q1 -= tx_count;
-			data_i1 = (sine_lut[index_i1] << 20);
-			data_q1 = (sine_lut[index_q1] << 4);
-
-			no_os_axi_io_write(address, index * 4, data_i1 | data_q1);
-		}
+	uint32_t tx_count = NO_OS_ARRAY_SIZE(sine_lut);
+	uint32_t copies = (dac->num_channels == 4) ? 2 : 1;
+	uint32_t index, index_q, size;
+	uint32_t *mem;
+	bool mapped;
+
+	size = tx_count * copies * sizeof(uint32_t);
+	if (axi_dac_mem_get(address, size, &mem, &mapped))
+		return 0;
+
+	/* Q leads I by a quarter period */
+	for (index = 0; index < tx_count; index++) {
+		index_q = index + tx_count / 4;
+		if (index_q >= tx_count)
+			index_q -= tx_count;
+		mem[index * copies] = (sine_lut[index] << 20) |
+				      (sine_lut[index_q] << 4);
+		if (copies == 2)
+			mem[index * copies + 1] = mem[index * copies];
 	}
 
-	length = tx_count * dac->num_channels * 2;
-	return length;
+	if (axi_dac_mem_put(address, mem, size, mapped))
+		return 0;
+
+	return tx_count * dac->num_channels * 2;
 }
 
 /**
  * @brief AXI DAC Set data buffer.
  * @param dac - The device structure.
  * @param address - Base Address.
- * @param buff - The buffer to be set.
+ * @param buff - The buffer to be set, interleaved I/Q samples.
  * @param buff_size - The buffer size.
  * @return Returns 0 in case of success or negative error code otherwise.
  */
@@ -827,18 +891,20 @@ int32_t axi_dac_set_buff(struct axi_dac *dac,
 			 uint16_t *buff,
 			 uint32_t buff_size)
 {
-	uint32_t index;
-	uint32_t data_i;
-	uint32_t data_q;
+	uint32_t index, size;
+	uint32_t *mem;
+	bool mapped;
+	int32_t ret;
 
-	for(index = 0; index < buff_size; index += 2) {
-		data_i = (buff[index]);
-		data_q = (buff[index + 1] << 16);
+	size = buff_size / 2 * sizeof(uint32_t);
+	ret = axi_dac_mem_get(address, size, &mem, &mapped);
+	if (ret)
+		return ret;
 
-		no_os_axi_io_write(address, index * 2, data_i | data_q);
-	}
+	for (index = 0; index < buff_size / 2; index++)
+		mem[index] = buff[2 * index] | ((uint32_t)buff[2 * index + 1] << 16);
 
-	return 0;
+	return axi_dac_mem_put(address, mem, size, mapped);
 }
 
 /**
@@ -854,20 +920,14 @@ int32_t axi_dac_load_custom_data(struct axi_dac *dac,
 				 uint32_t custom_tx_count,
 				 uint32_t address)
 {
-	uint32_t index, index_mem = 0;
 	uint8_t chan;
-	uint8_t num_tx_channels = dac->num_channels / 2;
-
-	for(index = 0; index < custom_tx_count; index++) {
-		/* Send the same data on all the channels */
-		for (chan = 0; chan < num_tx_channels; chan++) {
-
-			no_os_axi_io_write(address, index_mem * sizeof(uint32_t),
-					   custom_data_iq[index]);
+	int32_t ret;
 
-			index_mem++;
-		}
-	}
+	/* Send the same data on all the channels */
+	ret = axi_dac_load_iq(dac, address, custom_data_iq, custom_tx_count,
+			      dac->num_channels / 2);
+	if (ret)
+		return ret;
 
 	for (chan = 0; chan < dac->num_channels; chan++) {
 		axi_dac_write(dac, AXI_DAC_REG_DATA_SELECT((chan*2)+0), 0x2);
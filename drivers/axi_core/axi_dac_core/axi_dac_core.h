@@ -176,6 +176,12 @@ int32_t axi_dac_load_custom_data(struct axi_dac *dac,
 				 const uint32_t *custom_data_iq,
 				 uint32_t custom_tx_count,
 				 uint32_t address);
+/** AXI DAC Load I/Q samples into DAC buffer memory */
+int32_t axi_dac_load_iq(struct axi_dac *dac,
+			uint32_t address,
+			const uint32_t *iq,
+			uint32_t count,
+			uint32_t copies);
 /** Setup the AXI DAC Data */
 int32_t axi_dac_data_setup(struct axi_dac *dac);
 
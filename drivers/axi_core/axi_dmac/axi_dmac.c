@@ -50,6 +50,8 @@
 #include "no_os_alloc.h"
 #include "axi_dmac.h"
 
+static void axi_dmac_stream_isr(struct axi_dmac *dmac);
+
 /*******************************************************************************
  * @brief ISR for dev to mem DMA transfer. It computes the next transfer params,
  *			if any, and sets the transfer structure fields accordingly.
@@ -119,6 +121,11 @@ void axi_dmac_mem_to_dev_isr(void *instance)
 	axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
 	axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_PENDING, reg_val);
 
+	if (dmac->stream) {
+		axi_dmac_stream_isr(dmac);
+		return;
+	}
+
 	if (reg_val & AXI_DMAC_IRQ_SOT) {
 		if ((dmac->transfer.cyclic == CYCLIC) &&
 		    (dmac->next_src_addr >= (dmac->init_addr + dmac->transfer.size - 1))) {
@@ -546,3 +553,167 @@ void axi_dmac_transfer_stop(struct axi_dmac *dmac)
 {
 	axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, AXI_DMAC_CTRL_DISABLE);
 }
+
+/*******************************************************************************
+ * @brief Queue stream bursts in the DMAC until its transfer queue is full or
+ *			no more blocks are available.
+ *
+ * @param dmac - DMAC istance.
+ *
+ * @return None
+*******************************************************************************/
+static void axi_dmac_stream_fill(struct axi_dmac *dmac)
+{
+	struct axi_dmac_stream *stream = dmac->stream;
+	uint32_t reg_val, burst_size;
+	uint8_t slot;
+
+	while (stream->count < AXI_DMAC_TRANSFER_IDS) {
+		if (!stream->remaining &&
+		    stream->get_block(stream->ctx, &stream->addr, &stream->remaining))
+			break;
+
+		axi_dmac_read(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, &reg_val);
+		if (reg_val & AXI_DMAC_QUEUE_FULL)
+			break;
+
+		if (stream->remaining > dmac->max_length)
+			burst_size = dmac->max_length;
+		else
+			burst_size = stream->remaining - 1;
+
+		slot = (stream->head + stream->count) % AXI_DMAC_TRANSFER_IDS;
+		axi_dmac_read(dmac, AXI_DMAC_REG_TRANSFER_ID, &reg_val);
+		stream->id[slot] = reg_val & (AXI_DMAC_TRANSFER_IDS - 1);
+		stream->last[slot] = stream->remaining == burst_size + 1;
+
+		axi_dmac_write(dmac, AXI_DMAC_REG_SRC_ADDRESS, stream->addr);
+		axi_dmac_write(dmac, AXI_DMAC_REG_SRC_STRIDE, 0x0);
+		axi_dmac_write(dmac, AXI_DMAC_REG_X_LENGTH, burst_size);
+		axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH, 0x0);
+		axi_dmac_write(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT,
+			       AXI_DMAC_TRANSFER_SUBMIT);
+
+		stream->addr += burst_size + 1;
+		stream->remaining -= burst_size + 1;
+		stream->count++;
+	}
+}
+
+/*******************************************************************************
+ * @brief Stream ISR: retire the completed bursts, release the fully transferred
+ *			blocks and chain the next ones.
+ *
+ * @param dmac - DMAC istance.
+ *
+ * @return None
+*******************************************************************************/
+static void axi_dmac_stream_isr(struct axi_dmac *dmac)
+{
+	struct axi_dmac_stream *stream = dmac->stream;
+	uint32_t done;
+
+	axi_dmac_read(dmac, AXI_DMAC_REG_TRANSFER_DONE, &done);
+	while (stream->count && (done & NO_OS_BIT(stream->id[stream->head]))) {
+		if (stream->last[stream->head])
+			stream->put_block(stream->ctx);
+		stream->head = (stream->head + 1) % AXI_DMAC_TRANSFER_IDS;
+		stream->count--;
+	}
+
+	axi_dmac_stream_fill(dmac);
+	if (!stream->count)
+		stream->idle = true;
+}
+
+/*******************************************************************************
+ * @brief Start a streaming memory to device transfer: blocks provided by the
+ *			stream callbacks are transferred back to back, without
+ *			gaps as long as new blocks are queued in time. Requires the
+ *			DMAC interrupt to be routed to axi_dmac_mem_to_dev_isr().
+ *
+ * @param dmac - DMAC istance.
+ * @param stream - Stream callbacks and state.
+ *
+ * @return 0 for success, negative error code otherwise.
+*******************************************************************************/
+int32_t axi_dmac_stream_start(struct axi_dmac *dmac,
+			      struct axi_dmac_stream *stream)
+{
+	uint32_t reg_val;
+
+	if (!dmac || !stream || !stream->get_block || !stream->put_block)
+		return -EINVAL;
+
+	if (dmac->direction != DMA_MEM_TO_DEV || dmac->irq_option != IRQ_ENABLED)
+		return -ENOTSUP;
+
+	stream->underflows = 0;
+	stream->remaining = 0;
+	stream->head = 0;
+	stream->count = 0;
+	stream->idle = true;
+
+	axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, AXI_DMAC_CTRL_DISABLE);
+	axi_dmac_read(dmac, AXI_DMAC_REG_FLAGS, &reg_val);
+	axi_dmac_write(dmac, AXI_DMAC_REG_FLAGS, reg_val & ~DMA_CYCLIC);
+	axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, AXI_DMAC_CTRL_ENABLE);
+
+	dmac->stream = stream;
+	dmac->transfer.transfer_done = false;
+
+	/* The first submit raises SOT, keep the ISR out until the fill is done */
+	axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_MASK,
+		       AXI_DMAC_IRQ_SOT | AXI_DMAC_IRQ_EOT);
+	axi_dmac_stream_fill(dmac);
+	if (stream->count)
+		stream->idle = false;
+	axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_MASK, 0x0);
+
+	return 0;
+}
+
+/*******************************************************************************
+ * @brief Notify the stream that new blocks were queued. Restarts the transfer
+ *			if it ran dry (counted as an underflow); otherwise the
+ *			ISR picks the blocks up.
+ *
+ * @param dmac - DMAC istance.
+ *
+ * @return 0 for success, negative error code otherwise.
+*******************************************************************************/
+int32_t axi_dmac_stream_kick(struct axi_dmac *dmac)
+{
+	struct axi_dmac_stream *stream;
+
+	if (!dmac || !dmac->stream)
+		return -EINVAL;
+
+	stream = dmac->stream;
+	/* The ISR also refills the stream, keep it out while the queue is used */
+	axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_MASK,
+		       AXI_DMAC_IRQ_SOT | AXI_DMAC_IRQ_EOT);
+	if (stream->idle) {
+		axi_dmac_stream_fill(dmac);
+		if (stream->count) {
+			stream->idle = false;
+			stream->underflows++;
+		}
+	}
+	axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_MASK, 0x0);
+
+	return 0;
+}
+
+/*******************************************************************************
+ * @brief Stop a streaming transfer. Blocks still queued are not transferred.
+ *
+ * @param dmac - DMAC istance.
+ *
+ * @return None
+*******************************************************************************/
+void axi_dmac_stream_stop(struct axi_dmac *dmac)
+{
+	axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, AXI_DMAC_CTRL_DISABLE);
+	dmac->stream = NULL;
+}
@@ -76,6 +76,9 @@
 #define AXI_DMAC_REG_SRC_STRIDE			0x424
 #define AXI_DMAC_REG_TRANSFER_DONE		0x428
 
+/* Number of transfer IDs tracked by the core */
+#define AXI_DMAC_TRANSFER_IDS			4
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -111,6 +114,30 @@ struct axi_dma_transfer {
 	uint32_t dest_addr;
 };
 
+/**
+ * @struct axi_dmac_stream
+ * @brief Chain of non-cyclic memory to device transfers, fed block by block
+ * from axi_dmac_mem_to_dev_isr().
+ */
+struct axi_dmac_stream {
+	/** Get the next block to transfer, negative if none is queued */
+	int32_t (*get_block)(void *ctx, uint32_t *addr, uint32_t *size);
+	/** The oldest block handed out by get_block() has been transferred */
+	void (*put_block)(void *ctx);
+	/** Context passed to the callbacks */
+	void *ctx;
+	/** Number of times the transfer ran dry and had to be restarted */
+	volatile uint32_t underflows;
+	/* Internal state */
+	volatile bool idle;
+	uint32_t addr;
+	uint32_t remaining;
+	uint8_t id[AXI_DMAC_TRANSFER_IDS];
+	bool last[AXI_DMAC_TRANSFER_IDS];
+	uint8_t head;
+	volatile uint8_t count;
+};
+
 struct axi_dmac {
 	const char *name;
 	uint32_t base;
@@ -124,6 +151,8 @@ struct axi_dmac {
 	uint32_t remaining_size;
 	uint32_t next_src_addr;
 	uint32_t next_dest_addr;
+	/* Streaming (chained) transfer, if any */
+	struct axi_dmac_stream *stream;
 };
 
 struct axi_dmac_init {
@@ -152,5 +181,9 @@ int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
 int32_t axi_dmac_transfer_wait_completion(struct axi_dmac *dmac,
 		uint32_t timeout_ms);
 void axi_dmac_transfer_stop(struct axi_dmac *dmac);
+int32_t axi_dmac_stream_start(struct axi_dmac *dmac,
+			      struct axi_dmac_stream *stream);
+int32_t axi_dmac_stream_kick(struct axi_dmac *dmac);
+void axi_dmac_stream_stop(struct axi_dmac *dmac);
 
 #endif
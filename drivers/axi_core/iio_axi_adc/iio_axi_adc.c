@@ -321,6 +321,8 @@ static struct iio_attribute iio_voltage_attributes[] = {
 		.name = "sampling_frequency",
 		.show = get_sampling_frequency,
 		.store = set_sampling_frequency,
+		/* The clock may also be changed by the converter driver */
+		.cache_ms = 1000,
 	},
 	END_ATTRIBUTES_ARRAY
 };
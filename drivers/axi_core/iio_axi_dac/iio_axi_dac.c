@@ -48,6 +48,7 @@
 #include <stdlib.h>
 #include "no_os_error.h"
 #include "no_os_alloc.h"
+#include "no_os_waveform.h"
 #include "iio.h"
 #include "iio_axi_dac.h"
 
@@ -56,6 +57,12 @@
 /******************************************************************************/
 
 #define STORAGE_BITS 16
+/* Length of the waveforms generated on target, replayed cyclically */
+#define WAVE_SAMPLES 4096
+
+int32_t iio_axi_dac_prepare_transfer(void *dev, uint32_t mask);
+static int32_t iio_axi_dac_cyclic_start(struct iio_axi_dac_desc *iio_dac,
+					void *buff, uint32_t bytes);
 
 /**
  * @brief get_dds_calibscale().
@@ -461,6 +468,167 @@ static struct iio_attribute iio_altvoltage_attributes[] = {
 	END_ATTRIBUTES_ARRAY,
 };
 
+/**
+ * @brief Get the streaming queue depth.
+ * @param device - Physical instance of a iio_axi_dac_desc device.
+ * @param buf - Where value is stored.
+ * @param len - Maximum length of value to be stored in buf.
+ * @param channel - Channel properties.
+ * @return Number of bytes written in buf, or negative value on failure.
+ */
+static int get_stream_depth(void *device, char *buf, uint32_t len,
+			    const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct iio_axi_dac_desc *iio_dac = (struct iio_axi_dac_desc *)device;
+
+	return snprintf(buf, len, "%"PRIu32"", iio_dac->stream_depth);
+}
+
+/**
+ * @brief Set the streaming queue depth, 0 for cyclic mode. Only possible while
+ * the buffer is not streaming.
+ * @param device - Physical instance of a iio_axi_dac_desc device.
+ * @param buf - Value to be written to attribute.
+ * @param len - Length of the data in "buf".
+ * @param channel - Channel properties.
+ * @return Number of bytes written to device, or negative value on failure.
+ */
+static int set_stream_depth(void *device, char *buf, uint32_t len,
+			    const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct iio_axi_dac_desc *iio_dac = (struct iio_axi_dac_desc *)device;
+	uint32_t depth = no_os_str_to_uint32(buf);
+
+	if (iio_dac->streaming)
+		return -EBUSY;
+
+	if (depth != iio_dac->stream_depth) {
+		no_os_free(iio_dac->stream_buf);
+		iio_dac->stream_buf = NULL;
+		iio_dac->block_size = 0;
+		iio_dac->stream_depth = depth;
+	}
+
+	return len;
+}
+
+/**
+ * @brief Get the number of streaming underflows.
+ * @param device - Physical instance of a iio_axi_dac_desc device.
+ * @param buf - Where value is stored.
+ * @param len - Maximum length of value to be stored in buf.
+ * @param channel - Channel properties.
+ * @return Number of bytes written in buf, or negative value on failure.
+ */
+static int get_stream_underflows(void *device, char *buf, uint32_t len,
+				 const struct iio_ch_info *channel,
+				 intptr_t priv)
+{
+	struct iio_axi_dac_desc *iio_dac = (struct iio_axi_dac_desc *)device;
+
+	return snprintf(buf, len, "%"PRIu32"", iio_dac->stream.underflows);
+}
+
+/**
+ * @brief Get the description of the generated waveform.
+ * @param device - Physical instance of a iio_axi_dac_desc device.
+ * @param buf - Where value is stored.
+ * @param len - Maximum length of value to be stored in buf.
+ * @param channel - Channel properties.
+ * @return Number of bytes written in buf, or negative value on failure.
+ */
+static int get_waveform(void *device, char *buf, uint32_t len,
+			const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct iio_axi_dac_desc *iio_dac = (struct iio_axi_dac_desc *)device;
+
+	return snprintf(buf, len, "%s", iio_dac->waveform);
+}
+
+/**
+ * @brief Generate a waveform on all channels and replay it cyclically. Channel
+ * pairs get the I and Q components. See no_os_wave_parse() for the format,
+ * e.g. "tone 10000000,-3000000 0.7" or "chirp 1000000 20000000 0 log".
+ * @param device - Physical instance of a iio_axi_dac_desc device.
+ * @param buf - Waveform description.
+ * @param len - Length of the data in "buf".
+ * @param channel - Channel properties.
+ * @return Number of bytes written to device, or negative value on failure.
+ */
+static int set_waveform(void *device, char *buf, uint32_t len,
+			const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct iio_axi_dac_desc *iio_dac = (struct iio_axi_dac_desc *)device;
+	uint32_t nb_ch = iio_dac->dac->num_channels;
+	struct no_os_wave w = {
+		.fmt = {
+			.sign = 's',
+			.realbits = STORAGE_BITS,
+			.storagebits = STORAGE_BITS,
+		},
+	};
+	int16_t *samples;
+	uint32_t ch;
+	int ret;
+
+	if (iio_dac->streaming)
+		return -EBUSY;
+
+	ret = no_os_wave_parse(&w, buf, iio_dac->dac->clock_hz, WAVE_SAMPLES);
+	if (ret)
+		return ret;
+
+	samples = no_os_malloc(WAVE_SAMPLES * nb_ch * sizeof(*samples));
+	if (!samples)
+		return -ENOMEM;
+
+	for (ch = 0; ch < nb_ch; ch += 2) {
+		w.iq = ch + 1 < nb_ch;
+		no_os_wave_init(&w);
+		no_os_wave_fill(&w, samples + ch, samples + ch + 1, WAVE_SAMPLES,
+				nb_ch);
+	}
+
+	ret = iio_axi_dac_prepare_transfer(iio_dac, NO_OS_GENMASK(nb_ch - 1, 0));
+	if (ret)
+		goto error;
+
+	axi_dmac_transfer_stop(iio_dac->dmac);
+	no_os_free(iio_dac->wave_buf);
+	iio_dac->wave_buf = samples;
+
+	ret = iio_axi_dac_cyclic_start(iio_dac, samples,
+				       WAVE_SAMPLES * nb_ch * sizeof(*samples));
+	if (ret)
+		return ret;
+
+	snprintf(iio_dac->waveform, sizeof(iio_dac->waveform), "%s", buf);
+
+	return len;
+error:
+	no_os_free(samples);
+
+	return ret;
+}
+
+static struct iio_attribute iio_axi_dac_attributes[] = {
+	{
+		.name = "stream_depth",
+		.show = get_stream_depth,
+		.store = set_stream_depth,
+	},
+	{
+		.name = "stream_underflows",
+		.show = get_stream_underflows,
+	},
+	{
+		.name = "waveform",
+		.show = get_waveform,
+		.store = set_waveform,
+	},
+	END_ATTRIBUTES_ARRAY,
+};
+
 /**
  * @brief Update active channels
  * @param dev - Instance of the iio_axi_dac
@@ -489,6 +657,115 @@ int32_t iio_axi_dac_prepare_transfer(void *dev, uint32_t mask)
 	return 0;
 }
 
+/**
+ * @brief Hand the oldest queued block to the DMA. Called from the DMA ISR.
+ * @param ctx - Instance of the iio_axi_dac
+ * @param addr - Block address
+ * @param size - Block size in bytes
+ * @return 0 in case of success, -EAGAIN if no block is queued.
+ */
+static int32_t iio_axi_dac_stream_get_block(void *ctx, uint32_t *addr,
+		uint32_t *size)
+{
+	struct iio_axi_dac_desc *iio_dac = ctx;
+	uint32_t slot;
+
+	if (iio_dac->stream_sub == iio_dac->stream_wr)
+		return -EAGAIN;
+
+	slot = iio_dac->stream_sub % iio_dac->stream_depth;
+	*addr = (uintptr_t)(iio_dac->stream_buf + slot * iio_dac->block_size);
+	*size = iio_dac->block_size;
+	iio_dac->stream_sub++;
+
+	return 0;
+}
+
+/**
+ * @brief Release the oldest block handed to the DMA. Called from the DMA ISR.
+ * @param ctx - Instance of the iio_axi_dac
+ * @return None.
+ */
+static void iio_axi_dac_stream_put_block(void *ctx)
+{
+	struct iio_axi_dac_desc *iio_dac = ctx;
+
+	iio_dac->stream_rd++;
+}
+
+/**
+ * @brief Queue a buffer block for streaming, starting the stream on the first
+ * block.
+ * @param iio_dac - Instance of the iio_axi_dac
+ * @param buff - Block data
+ * @param bytes - Block size in bytes
+ * @return 0 in case of success, -EAGAIN if the queue is full or negative value
+ * otherwise.
+ */
+static int32_t iio_axi_dac_stream_data(struct iio_axi_dac_desc *iio_dac,
+				       void *buff, uint32_t bytes)
+{
+	uint8_t *block;
+	int32_t ret;
+
+	if (bytes != iio_dac->block_size) {
+		if (iio_dac->streaming)
+			return -EINVAL;
+
+		no_os_free(iio_dac->stream_buf);
+		iio_dac->block_size = 0;
+		iio_dac->stream_buf = no_os_malloc(iio_dac->stream_depth * bytes);
+		if (!iio_dac->stream_buf)
+			return -ENOMEM;
+		iio_dac->block_size = bytes;
+	}
+
+	/* The caller retries once the DMA released a block */
+	if (iio_dac->stream_wr - iio_dac->stream_rd == iio_dac->stream_depth)
+		return -EAGAIN;
+
+	block = iio_dac->stream_buf +
+		(iio_dac->stream_wr % iio_dac->stream_depth) * bytes;
+	memcpy(block, buff, bytes);
+	if (iio_dac->dcache_flush_range)
+		iio_dac->dcache_flush_range((uintptr_t)block, bytes);
+	iio_dac->stream_wr++;
+
+	if (iio_dac->streaming)
+		return axi_dmac_stream_kick(iio_dac->dmac);
+
+	iio_dac->stream.get_block = iio_axi_dac_stream_get_block;
+	iio_dac->stream.put_block = iio_axi_dac_stream_put_block;
+	iio_dac->stream.ctx = iio_dac;
+	ret = axi_dmac_stream_start(iio_dac->dmac, &iio_dac->stream);
+	if (ret)
+		return ret;
+	iio_dac->streaming = true;
+
+	return 0;
+}
+
+/**
+ * @brief Stop streaming, if active. Queued blocks are dropped.
+ * @param dev - Instance of the iio_axi_dac
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int32_t iio_axi_dac_end_transfer(void *dev)
+{
+	struct iio_axi_dac_desc *iio_dac = dev;
+
+	if (!iio_dac->streaming)
+		return 0;
+
+	axi_dmac_stream_stop(iio_dac->dmac);
+	iio_dac->streaming = false;
+	iio_dac->stream_wr = 0;
+	iio_dac->stream_sub = 0;
+	iio_dac->stream_rd = 0;
+
+	return 0;
+}
+
 /**
  * @brief Update active channels
  * @param dev - Instance of the iio_axi_dac
@@ -507,6 +784,22 @@ int32_t iio_axi_dac_write_data(void *dev, void *buff, uint32_t nb_samples)
 	iio_dac = (struct iio_axi_dac_desc *)dev;
 	bytes = nb_samples * no_os_hweight32(iio_dac->mask) * (STORAGE_BITS / 8);
 
+	if (iio_dac->stream_depth)
+		return iio_axi_dac_stream_data(iio_dac, buff, bytes);
+
+	return iio_axi_dac_cyclic_start(iio_dac, buff, bytes);
+}
+
+/**
+ * @brief Replay a buffer cyclically.
+ * @param iio_dac - Instance of the iio_axi_dac
+ * @param buff - Samples
+ * @param bytes - Size of the buffer in bytes
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int32_t iio_axi_dac_cyclic_start(struct iio_axi_dac_desc *iio_dac,
+					void *buff, uint32_t bytes)
+{
 	if(iio_dac->dcache_flush_range)
 		iio_dac->dcache_flush_range((uintptr_t)buff, bytes);
 
@@ -595,7 +888,8 @@ static int32_t iio_axi_dac_create_device_descriptor(
 	voltage_ch_no = desc->dac->num_channels;
 	altvoltage_ch_no = desc->dac->num_channels * 2;
 	iio_device->num_ch = voltage_ch_no + altvoltage_ch_no;
-	iio_device->attributes = NULL; /* no device attribute */
+	/* Streaming needs a DMA */
+	iio_device->attributes = desc->dmac ? iio_axi_dac_attributes : NULL;
 	iio_device->channels = no_os_calloc(iio_device->num_ch,
 					    sizeof(struct iio_channel));
 	if (!iio_device->channels)
@@ -633,6 +927,7 @@ static int32_t iio_axi_dac_create_device_descriptor(
 	}
 	iio_device->pre_enable = iio_axi_dac_prepare_transfer;
 	iio_device->write_dev = iio_axi_dac_write_data;
+	iio_device->post_disable = iio_axi_dac_end_transfer;
 
 	return 0;
 
@@ -683,6 +978,7 @@ int32_t iio_axi_dac_init(struct iio_axi_dac_desc **desc,
 	if (init->tx_dmac) {
 		iio_axi_dac_inst->dmac = init->tx_dmac;
 		iio_axi_dac_inst->dcache_flush_range = init->dcache_flush_range;
+		iio_axi_dac_inst->stream_depth = init->stream_depth;
 	}
 
 	status = iio_axi_dac_create_device_descriptor(iio_axi_dac_inst,
@@ -713,6 +1009,9 @@ int32_t iio_axi_dac_remove(struct iio_axi_dac_desc *desc)
 	if (status < 0)
 		return status;
 
+	iio_axi_dac_end_transfer(desc);
+	no_os_free(desc->stream_buf);
+	no_os_free(desc->wave_buf);
 	no_os_free(desc);
 
 	return 0;
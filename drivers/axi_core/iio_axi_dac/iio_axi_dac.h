@@ -68,6 +68,22 @@ struct iio_axi_dac_desc {
 	struct iio_device dev_descriptor;
 	/** Channel names */
 	char (*ch_names)[20];
+	/** Streaming queue depth in blocks, 0 for cyclic (replay) mode */
+	uint32_t stream_depth;
+	/** Streaming transfer */
+	struct axi_dmac_stream stream;
+	/** Streaming queue: stream_depth blocks of block_size bytes */
+	uint8_t *stream_buf;
+	uint32_t block_size;
+	/** Blocks written, handed to the DMA and released, free running */
+	volatile uint32_t stream_wr;
+	volatile uint32_t stream_sub;
+	volatile uint32_t stream_rd;
+	bool streaming;
+	/** Buffer of the waveform generated on target */
+	void *wave_buf;
+	/** Description of the generated waveform */
+	char waveform[64];
 };
 
 /**
@@ -81,6 +97,12 @@ struct iio_axi_dac_init_param {
 	struct axi_dmac *tx_dmac;
 	/** Function pointer to flush the data cache for the given address range */
 	void (*dcache_flush_range)(uint32_t address, uint32_t bytes_count);
+	/**
+	 * Number of buffer blocks queued in streaming mode. 0 keeps the
+	 * default mode, where each pushed buffer is replayed cyclically.
+	 * Streaming requires tx_dmac to run with IRQ_ENABLED.
+	 */
+	uint32_t stream_depth;
 };
 
 /******************************************************************************/
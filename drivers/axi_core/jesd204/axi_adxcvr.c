@@ -271,6 +271,42 @@ static unsigned long adxcvr_clk_recalc_rate(struct adxcvr *xcvr,
 	}
 }
 
+/**
+ * @brief Compute the PLL configuration for a lane rate, or reuse the last one
+ *        if the rates did not change.
+ * @param xcvr - The device structure.
+ * @param rate - The lane rate (kHz).
+ * @param parent_rate - The reference rate (kHz).
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+static int adxcvr_calc_pll_config(struct adxcvr *xcvr, unsigned long rate,
+				  unsigned long parent_rate)
+{
+	struct adxcvr_pll_cache *cache = &xcvr->pll_cache;
+	int ret;
+
+	if (cache->valid && cache->rate == rate &&
+	    cache->parent_rate == parent_rate)
+		return 0;
+
+	cache->valid = false;
+	if (xcvr->cpll_enable)
+		ret = xilinx_xcvr_calc_cpll_config(&xcvr->xlx_xcvr, parent_rate, rate,
+						   &cache->cpll_conf, &cache->out_div);
+	else
+		ret = xilinx_xcvr_calc_qpll_config(&xcvr->xlx_xcvr, xcvr->sys_clk_sel,
+						   parent_rate, rate, &cache->qpll_conf,
+						   &cache->out_div);
+	if (ret < 0)
+		return ret;
+
+	cache->rate = rate;
+	cache->parent_rate = parent_rate;
+	cache->valid = true;
+
+	return 0;
+}
+
 static long adxcvr_clk_round_rate(struct adxcvr *xcvr,
 				  unsigned long rate,
 				  unsigned long parent_rate)
@@ -283,13 +319,8 @@ static long adxcvr_clk_round_rate(struct adxcvr *xcvr,
 	pr_debug("%s: Rate %lu kHz Parent Rate %lu Hz",
 		 __func__, rate, *prate);
 
-	/* Just check if we can support the requested rate */
-	if (xcvr->cpll_enable)
-		ret = xilinx_xcvr_calc_cpll_config(&xcvr->xlx_xcvr, parent_rate, rate,
-						   NULL, NULL);
-	else
-		ret = xilinx_xcvr_calc_qpll_config(&xcvr->xlx_xcvr,
-						   xcvr->sys_clk_sel, parent_rate, rate,	NULL, NULL);
+	/* Check if we can support the requested rate, keep the result for set_rate */
+	ret = adxcvr_calc_pll_config(xcvr, rate, parent_rate);
 
 	return ret < 0 ? ret : rate;
 }
@@ -313,8 +344,8 @@ int adxcvr_clk_set_rate(struct adxcvr *xcvr,
 			unsigned long rate,
 			unsigned long parent_rate)
 {
-	struct xilinx_xcvr_cpll_config cpll_conf;
-	struct xilinx_xcvr_qpll_config qpll_conf;
+	struct xilinx_xcvr_cpll_config *cpll_conf = &xcvr->pll_cache.cpll_conf;
+	struct xilinx_xcvr_qpll_config *qpll_conf = &xcvr->pll_cache.qpll_conf;
 	uint32_t out_div, clk25_div, prog_div;
 	uint32_t i;
 	int ret;
@@ -324,24 +355,20 @@ int adxcvr_clk_set_rate(struct adxcvr *xcvr,
 
 	clk25_div = NO_OS_DIV_ROUND_CLOSEST(parent_rate, 25000);
 
-	if (xcvr->cpll_enable)
-		ret = xilinx_xcvr_calc_cpll_config(&xcvr->xlx_xcvr, parent_rate, rate,
-						   &cpll_conf, &out_div);
-	else
-		ret = xilinx_xcvr_calc_qpll_config(&xcvr->xlx_xcvr, xcvr->sys_clk_sel,
-						   parent_rate, rate, &qpll_conf, &out_div);
+	ret = adxcvr_calc_pll_config(xcvr, rate, parent_rate);
 	if (ret < 0)
 		return ret;
+	out_div = xcvr->pll_cache.out_div;
 
 	for (i = 0; i < xcvr->num_lanes; i++) {
 
 		if (xcvr->cpll_enable)
 			ret = xilinx_xcvr_cpll_write_config(&xcvr->xlx_xcvr,
-							    ADXCVR_DRP_PORT_CHANNEL(i), &cpll_conf);
+							    ADXCVR_DRP_PORT_CHANNEL(i), cpll_conf);
 		else if ((i % 4 == 0) && xcvr->qpll_enable)
 			ret = xilinx_xcvr_qpll_write_config(&xcvr->xlx_xcvr,
 							    xcvr->sys_clk_sel,
-							    ADXCVR_DRP_PORT_COMMON(i), &qpll_conf);
+							    ADXCVR_DRP_PORT_COMMON(i), qpll_conf);
 		if (ret < 0)
 			return ret;
 
@@ -62,6 +62,25 @@
 #define ADXCVR_REFCLK_DIV2	4
 #define ADXCVR_PROGDIV_CLK	5 /* GTHE3, GTHE4, GTYE4 only */
 
+/**
+ * @struct adxcvr_pll_cache
+ * @brief Last computed PLL configuration, reused while the rates are unchanged.
+ */
+struct adxcvr_pll_cache {
+	/** The cached configuration is valid */
+	bool valid;
+	/** Lane rate (kHz) the configuration was computed for */
+	uint32_t rate;
+	/** Reference rate (kHz) the configuration was computed for */
+	uint32_t parent_rate;
+	/** Output divider */
+	uint32_t out_div;
+	/** CPLL configuration */
+	struct xilinx_xcvr_cpll_config cpll_conf;
+	/** QPLL configuration */
+	struct xilinx_xcvr_qpll_config qpll_conf;
+};
+
 /**
  * @struct adxcvr
  * @brief ADI JESD204B/C AXI_ADXCVR Highspeed Transceiver Device structure.
@@ -97,6 +116,8 @@ struct adxcvr {
 	struct xilinx_xcvr xlx_xcvr;
 	/** Exported no-OS output clock */
 	struct no_os_clk_desc *clk_out;
+	/** Last computed PLL configuration */
+	struct adxcvr_pll_cache pll_cache;
 };
 
 /**
@@ -129,6 +129,43 @@ int32_t close_dac_channels(void* dev)
 	return 0;
 }
 
+/***************************************************************************//**
+ * @brief fill the loopback buffers with a generated waveform, channel pairs
+ * (0, 1), (2, 3)... get the I and Q components
+ * @param desc - descriptor for the dac
+ * @param w - waveform, set up with no_os_wave_init() or no_os_wave_parse()
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int32_t dac_demo_load_wave(struct dac_demo_desc *desc, struct no_os_wave *w)
+{
+	uint16_t *buf;
+	bool iq;
+	int32_t ret = 0;
+	int ch;
+
+	if (!desc || !w || !desc->loopback_buffers)
+		return -EINVAL;
+
+	buf = (uint16_t *)desc->loopback_buffers;
+	iq = w->iq;
+	for (ch = 0; ch < TOTAL_DAC_CHANNELS; ch += 2) {
+		/* Same start phase on every pair */
+		w->iq = iq && ch + 1 < TOTAL_DAC_CHANNELS;
+		ret = no_os_wave_init(w);
+		if (ret)
+			break;
+
+		ret = no_os_wave_fill(w, buf + ch * desc->loopback_buffer_len,
+				      buf + (ch + 1) * desc->loopback_buffer_len,
+				      desc->loopback_buffer_len, 1);
+		if (ret)
+			break;
+	}
+	w->iq = iq;
+
+	return ret;
+}
+
 /**********************************************************************//**
  * @brief read function for the dac demo driver
  * @param desc - descriptor for the dac
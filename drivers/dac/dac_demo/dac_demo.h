@@ -46,6 +46,7 @@
 
 #include <stdint.h>
 #include "iio_types.h"
+#include "no_os_waveform.h"
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -74,6 +75,8 @@ struct dac_demo_desc {
 	uint32_t loopback_buffer_len;
 	/** Array of buffers for each channel*/
 	uint16_t **loopback_buffers;
+	/** Description of the last generated waveform */
+	char waveform[64];
 };
 
 /**
@@ -94,6 +97,7 @@ struct dac_demo_init_param {
 enum iio_dac_demo_attributes {
 	DAC_CHANNEL_ATTR,
 	DAC_GLOBAL_ATTR,
+	DAC_WAVEFORM_ATTR,
 };
 
 /******************************************************************************/
@@ -109,6 +113,8 @@ int32_t update_dac_channels(void *dev, int32_t mask);
 
 int32_t close_dac_channels(void* dev);
 
+int32_t dac_demo_load_wave(struct dac_demo_desc *desc, struct no_os_wave *w);
+
 int32_t dac_submit_samples(struct iio_device_data *dev_data);
 
 int get_dac_demo_attr(void *device, char *buf, uint32_t len,
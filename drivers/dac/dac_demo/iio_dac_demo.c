@@ -92,6 +92,8 @@ int get_dac_demo_attr(void *device, char *buf, uint32_t len,
 	switch(attr_id) {
 	case DAC_GLOBAL_ATTR:
 		return snprintf(buf,len,"%"PRIu32"",desc->dac_global_attr);
+	case DAC_WAVEFORM_ATTR:
+		return snprintf(buf, len, "%s", desc->waveform);
 	case DAC_CHANNEL_ATTR:
 		return snprintf(buf,len,"%"PRIu32"",desc->dac_ch_attr[channel->ch_num]);
 	default:
@@ -187,6 +189,44 @@ int32_t dac_demo_trigger_handler(struct iio_device_data *dev_data)
 	return 0;
 }
 
+/**
+ * @brief generate a waveform in the loopback buffers, see no_os_wave_parse()
+ * for the description format. Frequencies are in cycles per buffer, so that
+ * the buffer loops seamlessly (e.g. "tone 4,9 0.8").
+ * @param desc - Physical instance of a iio_demo_device.
+ * @param buf - Waveform description.
+ * @param len -	Length of the data in "buf".
+ * @return: Number of bytes written to device, or negative value on failure.
+ */
+static int set_dac_demo_waveform(struct dac_demo_desc *desc, char *buf,
+				 uint32_t len)
+{
+	struct no_os_wave w = {
+		.fmt = {
+			.sign = dac_scan_type.sign,
+			.realbits = dac_scan_type.realbits,
+			.storagebits = dac_scan_type.storagebits,
+			.shift = dac_scan_type.shift,
+			.is_big_endian = dac_scan_type.is_big_endian,
+		},
+		.iq = true,
+	};
+	int ret;
+
+	ret = no_os_wave_parse(&w, buf, desc->loopback_buffer_len,
+			       desc->loopback_buffer_len);
+	if (ret)
+		return ret;
+
+	ret = dac_demo_load_wave(desc, &w);
+	if (ret)
+		return ret;
+
+	snprintf(desc->waveform, sizeof(desc->waveform), "%s", buf);
+
+	return len;
+}
+
 /**
  * @brief set attributes for dac.
  * @param device - Physical instance of a iio_demo_device.
@@ -211,6 +251,8 @@ int set_dac_demo_attr(void *device, char *buf, uint32_t len,
 	case DAC_GLOBAL_ATTR:
 		desc->dac_global_attr = value;
 		return len;
+	case DAC_WAVEFORM_ATTR:
+		return set_dac_demo_waveform(desc, buf, len);
 	case DAC_CHANNEL_ATTR:
 		desc->dac_ch_attr[channel->ch_num] = value;
 		return len;
@@ -254,6 +296,7 @@ struct iio_attribute dac_channel_attributes[] = {
 
 struct iio_attribute dac_global_attributes[] = {
 	DAC_DEMO_ATTR("dac_global_attr", DAC_GLOBAL_ATTR),
+	DAC_DEMO_ATTR("waveform", DAC_WAVEFORM_ATTR),
 	END_ATTRIBUTES_ARRAY,
 };
 
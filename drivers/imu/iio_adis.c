@@ -1093,15 +1093,40 @@ int adis_iio_post_disable(void* dev, uint32_t mask)
 	return 0;
 }
 
+/**
+ * @brief Set the number of samples in FIFO which fires the watermark interrupt.
+ * @param dev       - The iio device structure.
+ * @param watermark - The FIFO watermark threshold level.
+ * @return 0 in case of success, error code otherwise.
+ */
+int adis_iio_set_watermark(void* dev, uint32_t watermark)
+{
+	struct adis_iio_dev *iio_adis;
+
+	if (!dev)
+		return -EINVAL;
+
+	iio_adis = (struct adis_iio_dev *)dev;
+
+	if (!iio_adis->adis_dev || !iio_adis->has_fifo)
+		return -EINVAL;
+
+	return adis_write_fifo_wm_lvl(iio_adis->adis_dev, watermark);
+}
+
 /**
  * @brief API to be called to get one single sample-set based on the given mask.
  * @param iio_adis - The iio adis structure.
  * @param mask     - The active channels mask.
  * @param buffer   - IIO buffer to push the sample set to.
+ * @param pop      - True to pop the sample set from the FIFO.
+ * @param burst_request - True if this read only requests the burst data.
+ * @param timestamp - Time of the sample set, in ns.
  * @return 0 in case of success, error code otherwise.
  */
 static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
-		uint32_t mask, struct iio_buffer *buffer, bool pop, bool burst_request)
+		uint32_t mask, struct iio_buffer *buffer, bool pop, bool burst_request,
+		int64_t timestamp)
 {
 	struct adis_dev *adis;
 	int ret;
@@ -1218,7 +1243,7 @@ static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
 		}
 	}
 
-	return iio_buffer_push_scan(buffer, &iio_adis->data[0]);
+	return iio_buffer_push_scan_ts(buffer, &iio_adis->data[0], timestamp);
 }
 
 /**
@@ -1239,7 +1264,8 @@ int adis_iio_trigger_handler(struct iio_device_data *dev_data)
 		return -EINVAL;
 
 	return adis_iio_trigger_push_single_sample(iio_adis,
-			dev_data->buffer->active_mask, dev_data->buffer, false, false);
+			dev_data->buffer->active_mask, dev_data->buffer, false, false,
+			dev_data->buffer->timestamp);
 }
 
 /**
@@ -1251,9 +1277,11 @@ int adis_iio_trigger_handler(struct iio_device_data *dev_data)
 int adis_iio_trigger_handler_with_fifo(struct iio_device_data *dev_data)
 {
 	struct adis_iio_dev *iio_adis;
+	struct iio_buffer *buffer;
 	struct adis_dev *adis;
 	int ret;
 	uint32_t fifo_cnt;
+	int64_t period;
 	uint16_t j;
 
 	if (!dev_data)
@@ -1267,6 +1295,7 @@ int adis_iio_trigger_handler_with_fifo(struct iio_device_data *dev_data)
 	iio_trig_disable(iio_adis->hw_trig_desc);
 
 	adis = iio_adis->adis_dev;
+	buffer = dev_data->buffer;
 
 	ret = adis_read_fifo_cnt(adis, &fifo_cnt);
 	if (ret)
@@ -1274,13 +1303,22 @@ int adis_iio_trigger_handler_with_fifo(struct iio_device_data *dev_data)
 
 	/* From data-sheet, minimum time between reads */
 	no_os_udelay(10);
-	if (fifo_cnt > dev_data->buffer->samples)
-		fifo_cnt = dev_data->buffer->samples;
+	if (fifo_cnt > buffer->samples)
+		fifo_cnt = buffer->samples;
+
+	/* Leave the samples in FIFO until the watermark level is reached */
+	if (fifo_cnt > 2 && fifo_cnt >= buffer->watermark) {
+		/*
+		 * The samples were taken evenly since the last pushed one, the
+		 * newest at the time of the trigger.
+		 */
+		period = (buffer->timestamp - buffer->last_timestamp) / fifo_cnt;
+		if (period < 0)
+			period = 0;
 
-	if (fifo_cnt > 2) {
 		/* Burst request */
 		ret = adis_iio_trigger_push_single_sample(iio_adis,
-				dev_data->buffer->active_mask, dev_data->buffer, true, true);
+				buffer->active_mask, buffer, true, true, 0);
 		if (ret)
 			goto trig_enable;
 
@@ -1289,7 +1327,8 @@ int adis_iio_trigger_handler_with_fifo(struct iio_device_data *dev_data)
 
 		for (j = 0; j < fifo_cnt - 1; j++) {
 			ret = adis_iio_trigger_push_single_sample(iio_adis,
-					dev_data->buffer->active_mask, dev_data->buffer, true, false);
+					buffer->active_mask, buffer, true, false,
+					buffer->timestamp - (fifo_cnt - 1 - j) * period);
 			if (ret)
 				goto trig_enable;
 
@@ -1297,7 +1336,8 @@ int adis_iio_trigger_handler_with_fifo(struct iio_device_data *dev_data)
 			no_os_udelay(10);
 		}
 		ret = adis_iio_trigger_push_single_sample(iio_adis,
-				dev_data->buffer->active_mask, dev_data->buffer, false, false);
+				buffer->active_mask, buffer, false, false,
+				buffer->timestamp);
 		/* From data-sheet, minimum time between reads */
 		no_os_udelay(10);
 	}
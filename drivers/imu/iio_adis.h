@@ -283,6 +283,8 @@ extern struct iio_trigger adis_iio_trig_desc;
 int adis_iio_pre_enable(void* dev, uint32_t mask);
 /*! API to be called before trigger is disabled. */
 int adis_iio_post_disable(void* dev, uint32_t mask);
+/*! API to be called when the FIFO watermark buffer attribute is written. */
+int adis_iio_set_watermark(void* dev, uint32_t watermark);
 /*! Read adis iio samples for the active channels. */
 int adis_iio_read_samples(void* dev, int* buff, uint32_t samples);
 /*! Callback for adis iio data ready trigger. */
@@ -353,6 +353,7 @@ static struct iio_attribute adis1650x_debug_attrs[] = {
 static struct iio_device adis1650x_iio_dev = {
 	.num_ch 		= NO_OS_ARRAY_SIZE(adis1650x_channels),
 	.channels 		= adis1650x_channels,
+	.timestamp		= true,
 	.debug_attributes 	= adis1650x_debug_attrs,
 	.attributes		= adis_dev_attrs,
 	.pre_enable 		= (int32_t (*)())adis_iio_pre_enable,
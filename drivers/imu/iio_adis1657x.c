@@ -479,11 +479,13 @@ struct iio_attribute adis1657x_debug_attrs[] = {
 static struct iio_device adis1657x_iio_dev = {
 	.num_ch 		= NO_OS_ARRAY_SIZE(adis1657x_channels),
 	.channels 		= adis1657x_channels,
+	.timestamp		= true,
 	.debug_attributes 	= adis1657x_debug_attrs,
 	.attributes		= adis_dev_attrs,
 	.pre_enable 		= (int32_t (*)())adis_iio_pre_enable,
 	.post_disable 		= (int32_t (*)())adis_iio_post_disable,
 	.trigger_handler 	= (int32_t (*)())adis_iio_trigger_handler_with_fifo,
+	.set_watermark 		= (int32_t (*)())adis_iio_set_watermark,
 	.debug_reg_read 	= (int32_t (*)())adis_iio_read_reg,
 	.debug_reg_write 	= (int32_t (*)())adis_iio_write_reg,
 };
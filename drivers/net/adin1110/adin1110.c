@@ -68,6 +68,117 @@ static struct _adin1110_priv driver_data[2] = {
 	},
 };
 
+/**
+ * @brief Drop the cached FIFO state (TX space and next RX frame sizes).
+ * @param desc - the device descriptor
+ */
+static void adin1110_fifo_cache_clear(struct adin1110_desc *desc)
+{
+	desc->tx_space = 0;
+	memset(desc->rx_fsize, 0, sizeof(desc->rx_fsize));
+}
+
+/**
+ * @brief Format the SPI header of a register or FIFO access.
+ * @param desc - the device descriptor
+ * @param addr - register's address
+ * @param write - true for a write access, false for a read access.
+ * @param buff - buffer in which the header is placed.
+ * @return the header length (including the CRC and turnaround bytes)
+ */
+static uint32_t adin1110_format_hdr(struct adin1110_desc *desc, uint16_t addr,
+				    bool write, uint8_t *buff)
+{
+	uint32_t len = ADIN1110_WR_HEADER_LEN;
+
+	addr &= ADIN1110_ADDR_MASK;
+	addr |= ADIN1110_CD_MASK;
+	if (write)
+		addr |= ADIN1110_RW_MASK;
+
+	no_os_put_unaligned_be16(addr, buff);
+
+	if (desc->append_crc)
+		buff[len++] = no_os_crc8(_crc_table, buff, ADIN1110_WR_HEADER_LEN, 0);
+
+	/* Turnaround byte */
+	if (!write)
+		buff[len++] = 0x0;
+
+	return len;
+}
+
+/**
+ * @brief Format a complete register write frame.
+ * @param desc - the device descriptor
+ * @param addr - register's address
+ * @param data - register's value
+ * @param buff - buffer in which the frame is placed.
+ * @return the frame length
+ */
+static uint32_t adin1110_format_reg_write(struct adin1110_desc *desc,
+		uint16_t addr, uint32_t data,
+		uint8_t *buff)
+{
+	uint32_t len;
+
+	len = adin1110_format_hdr(desc, addr, true, buff);
+	no_os_put_unaligned_be32(data, &buff[len]);
+	if (desc->append_crc) {
+		buff[len + ADIN1110_REG_LEN] = no_os_crc8(_crc_table, &buff[len],
+						ADIN1110_REG_LEN, 0);
+		len += ADIN1110_CRC_LEN;
+	}
+
+	return len + ADIN1110_REG_LEN;
+}
+
+/**
+ * @brief Format a complete register read frame.
+ * @param desc - the device descriptor
+ * @param addr - register's address
+ * @param buff - buffer in which the frame is placed.
+ * @param data_off - offset of the register value in the frame.
+ * @return the frame length
+ */
+static uint32_t adin1110_format_reg_read(struct adin1110_desc *desc,
+		uint16_t addr, uint8_t *buff,
+		uint32_t *data_off)
+{
+	uint32_t len;
+
+	len = adin1110_format_hdr(desc, addr, false, buff);
+	*data_off = len;
+	len += ADIN1110_REG_LEN;
+	if (desc->append_crc)
+		len += ADIN1110_CRC_LEN;
+
+	return len;
+}
+
+/**
+ * @brief Extract a register's value from a received read frame.
+ * @param desc - the device descriptor
+ * @param buff - the register value, followed by its CRC (if enabled).
+ * @param data - register's value
+ * @return 0 in case of success, negative error code otherwise
+ */
+static int adin1110_parse_reg_read(struct adin1110_desc *desc, uint8_t *buff,
+				   uint32_t *data)
+{
+	uint8_t crc;
+
+	if (desc->append_crc) {
+		crc = no_os_crc8(_crc_table, buff, ADIN1110_REG_LEN, 0);
+		if (crc != buff[ADIN1110_REG_LEN])
+			return -EINVAL;
+	}
+
+	*data = no_os_get_unaligned_be32(buff);
+
+	return 0;
+}
+
 /**
  * @brief Write a register's value
  * @param desc - the device descriptor
@@ -77,29 +188,19 @@ static struct _adin1110_priv driver_data[2] = {
  */
 int adin1110_reg_write(struct adin1110_desc *desc, uint16_t addr, uint32_t data)
 {
-	uint32_t header_len = ADIN1110_WR_HDR_SIZE;
 	struct no_os_spi_msg xfer = {
 		.tx_buff = desc->data,
-		.bytes_number = ADIN1110_WR_FRAME_SIZE,
+		.rx_buff = desc->data,
 		.cs_change = 1,
 	};
 
-	addr &= ADIN1110_ADDR_MASK;
-	addr |= ADIN1110_CD_MASK | ADIN1110_RW_MASK;
-	no_os_put_unaligned_be16(addr, desc->data);
-
-	if (desc->append_crc) {
-		desc->data[2] = no_os_crc8(_crc_table, desc->data, 2, 0);
-		header_len++;
-		xfer.bytes_number++;
-	}
+	/* A FIFO clear or a reset makes the cached FIFO state stale */
+	if (addr == ADIN1110_FIFO_CLR_REG || addr == ADIN1110_RESET_REG ||
+	    addr == ADIN1110_SOFT_RST_REG)
+		adin1110_fifo_cache_clear(desc);
 
-	no_os_put_unaligned_be32(data, &desc->data[header_len]);
-	if (desc->append_crc) {
-		desc->data[header_len + ADIN1110_REG_LEN] =
-			no_os_crc8(_crc_table, &desc->data[header_len], ADIN1110_REG_LEN, 0);
-		xfer.bytes_number++;
-	}
+	xfer.bytes_number = adin1110_format_reg_write(desc, addr, data,
+			    desc->data);
 
 	return no_os_spi_transfer(desc->comm_desc, &xfer, 1);
 }
@@ -113,44 +214,21 @@ int adin1110_reg_write(struct adin1110_desc *desc, uint16_t addr, uint32_t data)
  */
 int adin1110_reg_read(struct adin1110_desc *desc, uint16_t addr, uint32_t *data)
 {
-	uint8_t crc;
-	uint8_t recv_crc;
-	uint32_t header_len = ADIN1110_RD_HEADER_LEN;
+	uint32_t data_off;
 	struct no_os_spi_msg xfer = {
 		.tx_buff = desc->data,
 		.rx_buff = desc->data,
-		.bytes_number = ADIN1110_REG_LEN,
 		.cs_change = 1,
 	};
 	int ret;
 
-	no_os_put_unaligned_be16(addr, &desc->data[0]);
-	desc->data[0] |= ADIN1110_SPI_CD;
-	desc->data[2] = 0x0;
-
-	if (desc->append_crc) {
-		xfer.bytes_number += ADIN1110_CRC_LEN;
-		desc->data[2] = no_os_crc8(_crc_table, desc->data, 2, 0);
-		desc->data[3] = 0x0;
-		header_len++;
-	}
-
-	xfer.bytes_number += header_len;
+	xfer.bytes_number = adin1110_format_reg_read(desc, addr, desc->data,
+			    &data_off);
 	ret = no_os_spi_transfer(desc->comm_desc, &xfer, 1);
 	if (ret)
 		return ret;
 
-	if (desc->append_crc) {
-		crc = no_os_crc8(_crc_table, &desc->data[header_len], 4, 0);
-		recv_crc = desc->data[header_len + ADIN1110_REG_LEN];
-
-		if (crc != recv_crc)
-			return -EINVAL;
-	}
-
-	*data = no_os_get_unaligned_be32(&desc->data[header_len]);
-
-	return 0;
+	return adin1110_parse_reg_read(desc, &desc->data[data_off], data);
 }
 
 /**
@@ -486,103 +564,309 @@ int adin1110_broadcast_filter(struct adin1110_desc *desc, bool enabled)
 }
 
 /**
- * @brief Write a frame to the TX FIFO.
+ * @brief Run a chain of SPI messages. Buffers are passed straight to the
+ * platform driver if it supports message transfers, otherwise each chip
+ * select frame is gathered into the descriptor's buffer, transferred in place
+ * and scattered back.
+ * @param desc - the device descriptor
+ * @param msgs - the SPI messages.
+ * @param nb_msgs - the number of messages.
+ * @return 0 in case of success, negative error code otherwise
+ */
+static int adin1110_sg_transfer(struct adin1110_desc *desc,
+				struct no_os_spi_msg *msgs, uint32_t nb_msgs)
+{
+	struct no_os_spi_msg xfer = {
+		.tx_buff = desc->data,
+		.rx_buff = desc->data,
+		.cs_change = 1,
+	};
+	uint32_t first;
+	uint32_t len;
+	uint32_t i;
+	int ret;
+
+	if (desc->comm_desc->platform_ops->transfer)
+		return no_os_spi_transfer(desc->comm_desc, msgs, nb_msgs);
+
+	for (first = 0; first < nb_msgs; first = i) {
+		len = 0;
+		for (i = first; i < nb_msgs; i++) {
+			if (len + msgs[i].bytes_number > ADIN1110_BUFF_LEN)
+				return -EMSGSIZE;
+
+			if (msgs[i].tx_buff)
+				memcpy(&desc->data[len], msgs[i].tx_buff,
+				       msgs[i].bytes_number);
+			else
+				memset(&desc->data[len], 0, msgs[i].bytes_number);
+
+			len += msgs[i].bytes_number;
+			if (msgs[i].cs_change) {
+				i++;
+				break;
+			}
+		}
+
+		xfer.bytes_number = len;
+		ret = no_os_spi_transfer(desc->comm_desc, &xfer, 1);
+		if (ret)
+			return ret;
+
+		len = 0;
+		for (; first < i; first++) {
+			if (msgs[first].rx_buff)
+				memcpy(msgs[first].rx_buff, &desc->data[len],
+				       msgs[first].bytes_number);
+			len += msgs[first].bytes_number;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Write a frame, given as a list of spans, to the TX FIFO. The spans
+ * are clocked out directly, together with the TX_FSIZE write, in a single
+ * chained transfer. TX_SPACE is only read back once the cached value is
+ * no longer enough for the frame.
  * @param desc - the device descriptor
  * @param port - the port for the frame to be transmitted on.
- * @param eth_buff - the frame to be transmitted.
+ * @param spans - the frame (starting with the destination MAC address),
+ * without the FCS.
+ * @param nb_spans - the number of spans (at most ADIN1110_SG_MAX_SPANS).
  * @return 0 in case of success, negative error code otherwise
  */
-int adin1110_write_fifo(struct adin1110_desc *desc, uint32_t port,
-			struct adin1110_eth_buff *eth_buff)
+int adin1110_write_fifo_sg(struct adin1110_desc *desc, uint32_t port,
+			   struct adin1110_frame_span *spans, uint32_t nb_spans)
 {
-	uint32_t header_len = ADIN1110_WR_HEADER_LEN;
-	uint32_t frame_offset;
+	static uint8_t zero_pad[64];
+	struct no_os_spi_msg xfer[ADIN1110_SG_MAX_SPANS + 3] = {0};
+	uint32_t frame_len = 0;
 	uint32_t padding = 0;
 	uint32_t padded_len;
 	uint32_t round_len;
 	uint32_t tx_space;
+	uint32_t hdr_len;
+	uint32_t nb_msgs;
+	uint32_t i;
 	int ret;
 
-	struct no_os_spi_msg xfer = {
-		.tx_buff = desc->data,
-		.cs_change = 1,
-	};
-
 	if (port >= driver_data[desc->chip_type].num_ports)
 		return -EINVAL;
 
+	if (nb_spans > ADIN1110_SG_MAX_SPANS || (nb_spans && !spans))
+		return -EINVAL;
+
+	for (i = 0; i < nb_spans; i++)
+		frame_len += spans[i].len;
+
 	/* The minimum frame length is 64 bytes */
-	if (eth_buff->len + ADIN1110_FCS_LEN < 64)
-		padding = 64 - (eth_buff->len + ADIN1110_FCS_LEN);
+	if (frame_len + ADIN1110_FCS_LEN < 64)
+		padding = 64 - (frame_len + ADIN1110_FCS_LEN);
 
-	padded_len = eth_buff->len + padding + ADIN1110_FRAME_HEADER_LEN;
+	padded_len = frame_len + padding + ADIN1110_FRAME_HEADER_LEN;
 
 	/** Align the frame length to 4 bytes */
 	round_len = no_os_align(padded_len, 4);
-
-	ret = adin1110_reg_read(desc, ADIN1110_TX_SPACE_REG, &tx_space);
-	if (ret)
-		return ret;
+	if (round_len + ADIN1110_WR_HEADER_LEN + ADIN1110_CRC_LEN >
+	    ADIN1110_BUFF_LEN)
+		return -EMSGSIZE;
 
 	/*
 	 * Check if there is enough space for the frame in the TX FIFO.
 	 * The tx_space value is expressed in 16 bit words.
 	 */
-	if (padded_len > 2 * (tx_space - ADIN1110_FRAME_HEADER_LEN))
-		return -EAGAIN;
+	tx_space = no_os_max(desc->tx_space, ADIN1110_FRAME_HEADER_LEN);
+	if (padded_len > 2 * (tx_space - ADIN1110_FRAME_HEADER_LEN)) {
+		ret = adin1110_reg_read(desc, ADIN1110_TX_SPACE_REG,
+					&desc->tx_space);
+		if (ret)
+			return ret;
 
-	ret = adin1110_reg_write(desc, ADIN1110_TX_FSIZE_REG, padded_len);
-	if (ret)
-		return ret;
+		tx_space = no_os_max(desc->tx_space, ADIN1110_FRAME_HEADER_LEN);
+		if (padded_len > 2 * (tx_space - ADIN1110_FRAME_HEADER_LEN))
+			return -EAGAIN;
+	}
 
-	no_os_put_unaligned_be16(ADIN1110_TX_REG, &desc->data[0]);
-	desc->data[0] |= ADIN1110_SPI_CD | ADIN1110_SPI_RW;
+	/* TX_FSIZE write, in its own chip select frame */
+	xfer[0].tx_buff = desc->hdr;
+	xfer[0].bytes_number = adin1110_format_reg_write(desc,
+			       ADIN1110_TX_FSIZE_REG,
+			       padded_len, desc->hdr);
+	xfer[0].cs_change = 1;
+
+	/* TX FIFO header, followed by the port on which to send the frame */
+	xfer[1].tx_buff = &desc->hdr[xfer[0].bytes_number];
+	hdr_len = adin1110_format_hdr(desc, ADIN1110_TX_REG, true,
+				      xfer[1].tx_buff);
+	no_os_put_unaligned_be16(port, &xfer[1].tx_buff[hdr_len]);
+	xfer[1].bytes_number = hdr_len + ADIN1110_FRAME_HEADER_LEN;
+	nb_msgs = 2;
+
+	for (i = 0; i < nb_spans; i++) {
+		if (!spans[i].len)
+			continue;
 
-	if (desc->append_crc) {
-		desc->data[2] = no_os_crc8(_crc_table, desc->data, 2, 0);
-		header_len++;
+		xfer[nb_msgs].tx_buff = spans[i].buff;
+		xfer[nb_msgs].bytes_number = spans[i].len;
+		nb_msgs++;
 	}
 
-	/* Set the port on which to send the frame */
-	no_os_put_unaligned_be16(port, &desc->data[header_len]);
-	xfer.bytes_number = round_len + header_len;
-	frame_offset = header_len + ADIN1110_FRAME_HEADER_LEN;
+	if (round_len > frame_len + ADIN1110_FRAME_HEADER_LEN) {
+		xfer[nb_msgs].tx_buff = zero_pad;
+		xfer[nb_msgs].bytes_number = round_len - frame_len -
+					     ADIN1110_FRAME_HEADER_LEN;
+		nb_msgs++;
+	}
+	xfer[nb_msgs - 1].cs_change = 1;
 
-	memcpy(&desc->data[frame_offset], (void *)&eth_buff->mac_dest[0],
-	       ADIN1110_ETH_HDR_LEN);
-	frame_offset += ADIN1110_ETH_HDR_LEN;
-	memcpy(&desc->data[frame_offset], eth_buff->payload,
-	       eth_buff->len - ADIN1110_ETH_HDR_LEN);
+	ret = adin1110_sg_transfer(desc, xfer, nb_msgs);
+	if (ret) {
+		desc->tx_space = 0;
+		return ret;
+	}
 
-	return no_os_spi_transfer(desc->comm_desc, &xfer, 1);
+	desc->tx_space = tx_space - no_os_min(tx_space,
+					      round_len / 2 +
+					      ADIN1110_FRAME_HEADER_LEN);
+
+	return 0;
 }
 
 /**
- * @brief Read a frame from the RX FIFO.
+ * @brief Write a frame to the TX FIFO.
+ * @param desc - the device descriptor
+ * @param port - the port for the frame to be transmitted on.
+ * @param eth_buff - the frame to be transmitted.
+ * @return 0 in case of success, negative error code otherwise
+ */
+int adin1110_write_fifo(struct adin1110_desc *desc, uint32_t port,
+			struct adin1110_eth_buff *eth_buff)
+{
+	struct adin1110_frame_span spans[2] = {
+		{
+			.buff = &eth_buff->mac_dest[0],
+			.len = ADIN1110_ETH_HDR_LEN,
+		},
+		{
+			.buff = eth_buff->payload,
+			.len = eth_buff->len - ADIN1110_ETH_HDR_LEN,
+		},
+	};
+
+	return adin1110_write_fifo_sg(desc, port, spans, NO_OS_ARRAY_SIZE(spans));
+}
+
+/**
+ * @brief Read and discard a frame from the RX FIFO, in chunks of at most
+ * ADIN1110_BUFF_LEN bytes sent under the same chip select.
+ * @param desc - the device descriptor
+ * @param hdr_len - the length of the RX FIFO header, already in desc->hdr.
+ * @param len - the number of bytes to be read after the header.
+ * @return 0 in case of success, negative error code otherwise
+ */
+static int adin1110_drain_frame(struct adin1110_desc *desc, uint32_t hdr_len,
+				uint32_t len)
+{
+	struct no_os_spi_msg xfer[ADIN1110_SG_MAX_SPANS + 3] = {0};
+	uint32_t nb_msgs = 0;
+	uint32_t chunk;
+
+	memcpy(desc->data, desc->hdr, hdr_len);
+	len += hdr_len;
+	while (len) {
+		if (nb_msgs == NO_OS_ARRAY_SIZE(xfer))
+			return -EMSGSIZE;
+
+		chunk = no_os_min(len, ADIN1110_BUFF_LEN);
+		xfer[nb_msgs].tx_buff = desc->data;
+		xfer[nb_msgs].rx_buff = desc->data;
+		xfer[nb_msgs].bytes_number = chunk;
+		len -= chunk;
+		nb_msgs++;
+	}
+	xfer[nb_msgs - 1].cs_change = 1;
+
+	return no_os_spi_transfer(desc->comm_desc, xfer, nb_msgs);
+}
+
+/**
+ * @brief Get the length of the next frame in the RX FIFO, as returned by
+ * adin1110_read_fifo_sg(). The size is kept for the read of the frame, so it
+ * isn't read twice from the device.
  * @param desc - the device descriptor
  * @param port - the port from which the frame shall be received.
- * @param eth_buff - the frame to be received.
+ * @param len - the frame length, 0 if no frame is available.
  * @return 0 in case of success, negative error code otherwise
  */
-int adin1110_read_fifo(struct adin1110_desc *desc, uint32_t port,
-		       struct adin1110_eth_buff *eth_buff)
+int adin1110_rx_frame_len(struct adin1110_desc *desc, uint32_t port,
+			  uint32_t *len)
 {
-	uint32_t field_offset = ADIN1110_RD_HEADER_LEN;
-	uint32_t payload_length;
+	uint32_t frame_size;
+	int ret;
+
+	if (port >= driver_data[desc->chip_type].num_ports || !len)
+		return -EINVAL;
+
+	*len = 0;
+	frame_size = desc->rx_fsize[port];
+	if (!frame_size) {
+		ret = adin1110_reg_read(desc, port ? ADIN2111_RX_P2_FSIZE_REG :
+					ADIN1110_RX_FSIZE_REG, &frame_size);
+		if (ret)
+			return ret;
+	}
+
+	if (frame_size < ADIN1110_FRAME_HEADER_LEN + ADIN1110_FEC_LEN) {
+		desc->rx_fsize[port] = 0;
+		return 0;
+	}
+
+	desc->rx_fsize[port] = frame_size;
+	*len = frame_size - ADIN1110_FRAME_HEADER_LEN;
+
+	return 0;
+}
+
+/**
+ * @brief Read a frame from the RX FIFO directly into a list of spans. The
+ * RX_FSIZE of the following frame is read in the same chained transfer, so
+ * back to back frames don't need a separate size read.
+ * @param desc - the device descriptor
+ * @param port - the port from which the frame shall be received.
+ * @param spans - the buffers, filled in order with the frame (starting with
+ * the destination MAC address).
+ * @param nb_spans - the number of spans (at most ADIN1110_SG_MAX_SPANS).
+ * @param len - the frame length, 0 if no frame was available.
+ * @return 0 in case of success, -EMSGSIZE if the frame didn't fit in the spans
+ * (the frame is dropped), negative error code otherwise
+ */
+int adin1110_read_fifo_sg(struct adin1110_desc *desc, uint32_t port,
+			  struct adin1110_frame_span *spans, uint32_t nb_spans,
+			  uint32_t *len)
+{
+	struct no_os_spi_msg xfer[ADIN1110_SG_MAX_SPANS + 3] = {0};
 	uint32_t fifo_fsize_reg;
 	uint32_t rounded_len;
 	uint32_t frame_size;
+	uint32_t frame_len;
+	uint32_t remaining;
+	uint32_t data_off;
+	uint32_t capacity = 0;
 	uint32_t fifo_reg;
-	struct no_os_spi_msg xfer = {
-		.tx_buff = desc->data,
-		.rx_buff = desc->data,
-		.cs_change = 1,
-	};
+	uint32_t hdr_len;
+	uint32_t nb_msgs;
+	uint32_t chunk;
+	uint32_t i;
 	int ret;
 
 	if (port >= driver_data[desc->chip_type].num_ports)
 		return -EINVAL;
 
+	if (nb_spans > ADIN1110_SG_MAX_SPANS || (nb_spans && !spans) || !len)
+		return -EINVAL;
+
 	if (!port) {
 		fifo_reg = ADIN1110_RX_REG;
 		fifo_fsize_reg = ADIN1110_RX_FSIZE_REG;
@@ -591,47 +875,114 @@ int adin1110_read_fifo(struct adin1110_desc *desc, uint32_t port,
 		fifo_fsize_reg = ADIN2111_RX_P2_FSIZE_REG;
 	}
 
-	ret = adin1110_reg_read(desc, fifo_fsize_reg, &frame_size);
-	if (ret)
+	*len = 0;
+	ret = adin1110_rx_frame_len(desc, port, &frame_len);
+	if (ret || !frame_len)
 		return ret;
 
-	if (frame_size < ADIN1110_FRAME_HEADER_LEN + ADIN1110_FEC_LEN)
-		return 0;
+	desc->rx_fsize[port] = 0;
+	frame_size = frame_len + ADIN1110_FRAME_HEADER_LEN;
+
+	/* Can only read multiples of 4 bytes (the last bytes might be 0) */
+	rounded_len = no_os_align(frame_size, 4);
 
-	memset(desc->data, 0, ADIN1110_BUFF_LEN);
-	no_os_put_unaligned_be16(fifo_reg, &desc->data[0]);
-	desc->data[0] |= ADIN1110_SPI_CD;
-	desc->data[2] = 0x0;
+	for (i = 0; i < nb_spans; i++)
+		capacity += spans[i].len;
 
-	if (desc->append_crc) {
-		desc->data[2] = no_os_crc8(_crc_table, desc->data, 2, 0);
-		desc->data[3] = 0x0;
-		field_offset++;
+	/* RX FIFO header, followed by the port from which to receive the frame */
+	hdr_len = adin1110_format_hdr(desc, fifo_reg, false, desc->hdr);
+	no_os_put_unaligned_be16(port, &desc->hdr[hdr_len]);
+	hdr_len += ADIN1110_FRAME_HEADER_LEN;
+
+	if (capacity < frame_len || rounded_len + ADIN1110_RD_HEADER_LEN +
+	    ADIN1110_CRC_LEN > ADIN1110_BUFF_LEN) {
+		/* Drain the frame so that the FIFO doesn't stall on it */
+		ret = adin1110_drain_frame(desc, hdr_len,
+					   rounded_len - ADIN1110_FRAME_HEADER_LEN);
+		if (ret)
+			return ret;
+
+		return -EMSGSIZE;
 	}
 
-	/* Set the port from which to receive the frame */
-	no_os_put_unaligned_be16(port, &desc->data[field_offset]);
-	rounded_len = no_os_align(frame_size, 4);
+	xfer[0].tx_buff = desc->hdr;
+	xfer[0].rx_buff = desc->hdr;
+	xfer[0].bytes_number = hdr_len;
+	nb_msgs = 1;
 
-	/* Can only read multiples of 4 bytes (the last bytes might be 0) */
-	xfer.bytes_number = rounded_len + field_offset;
-	field_offset += ADIN1110_FRAME_HEADER_LEN;
+	/* Burst read the frame straight into the spans */
+	remaining = frame_len;
+	for (i = 0; i < nb_spans && remaining; i++) {
+		chunk = no_os_min(spans[i].len, remaining);
+		if (!chunk)
+			continue;
 
-	/** Burst read the whole frame */
-	ret = no_os_spi_transfer(desc->comm_desc, &xfer, 1);
+		xfer[nb_msgs].tx_buff = spans[i].buff;
+		xfer[nb_msgs].rx_buff = spans[i].buff;
+		xfer[nb_msgs].bytes_number = chunk;
+		remaining -= chunk;
+		nb_msgs++;
+	}
+
+	if (rounded_len > frame_size) {
+		xfer[nb_msgs].tx_buff = &desc->hdr[hdr_len];
+		xfer[nb_msgs].rx_buff = &desc->hdr[hdr_len];
+		xfer[nb_msgs].bytes_number = rounded_len - frame_size;
+		nb_msgs++;
+		hdr_len += rounded_len - frame_size;
+	}
+	xfer[nb_msgs - 1].cs_change = 1;
+
+	/* RX_FSIZE of the next frame, in its own chip select frame */
+	xfer[nb_msgs].tx_buff = &desc->hdr[hdr_len];
+	xfer[nb_msgs].rx_buff = &desc->hdr[hdr_len];
+	xfer[nb_msgs].bytes_number = adin1110_format_reg_read(desc,
+				     fifo_fsize_reg,
+				     &desc->hdr[hdr_len],
+				     &data_off);
+	xfer[nb_msgs].cs_change = 1;
+	nb_msgs++;
+
+	ret = adin1110_sg_transfer(desc, xfer, nb_msgs);
 	if (ret)
 		return ret;
 
-	payload_length = frame_size - ADIN1110_FRAME_HEADER_LEN - ADIN1110_ETH_HDR_LEN;
-	memcpy((void *)&eth_buff->mac_dest[0], &desc->data[field_offset],
-	       ADIN1110_ETH_HDR_LEN);
-	field_offset += ADIN1110_ETH_HDR_LEN;
-	memcpy(eth_buff->payload, &desc->data[field_offset], payload_length);
-	eth_buff->len = frame_size - ADIN1110_FRAME_HEADER_LEN;
+	/* On a CRC error, the next call reads the size again */
+	ret = adin1110_parse_reg_read(desc, &desc->hdr[hdr_len + data_off],
+				      &frame_size);
+	if (!ret)
+		desc->rx_fsize[port] = frame_size;
+
+	*len = frame_len;
 
 	return 0;
 }
 
+/**
+ * @brief Read a frame from the RX FIFO.
+ * @param desc - the device descriptor
+ * @param port - the port from which the frame shall be received.
+ * @param eth_buff - the frame to be received.
+ * @return 0 in case of success, negative error code otherwise
+ */
+int adin1110_read_fifo(struct adin1110_desc *desc, uint32_t port,
+		       struct adin1110_eth_buff *eth_buff)
+{
+	struct adin1110_frame_span spans[2] = {
+		{
+			.buff = &eth_buff->mac_dest[0],
+			.len = ADIN1110_ETH_HDR_LEN,
+		},
+		{
+			.buff = eth_buff->payload,
+			.len = ADIN1110_BUFF_LEN,
+		},
+	};
+
+	return adin1110_read_fifo_sg(desc, port, spans, NO_OS_ARRAY_SIZE(spans),
+				     &eth_buff->len);
+}
+
 /**
  * @brief Reset the MAC device.
  * @param desc - the device descriptor
@@ -67,6 +67,9 @@
 #define ADIN1110_PORTS				1
 #define ADIN2111_PORTS				2
 
+#define ADIN1110_SG_MAX_SPANS			8
+#define ADIN1110_SG_HDR_LEN			20
+
 #define ADIN1110_CD_MASK			NO_OS_BIT(15)
 #define ADIN1110_RW_MASK			NO_OS_BIT(13)
 
@@ -209,6 +212,12 @@ struct adin1110_desc {
 	uint8_t data[ADIN1110_BUFF_LEN];
 	struct no_os_gpio_desc *reset_gpio;
 	bool append_crc;
+	/* Scratch for the register/FIFO headers of a chained FIFO transfer */
+	uint8_t hdr[ADIN1110_SG_HDR_LEN];
+	/* Last known TX FIFO space (16 bit words), decremented on each write */
+	uint32_t tx_space;
+	/* Size of the next RX frame, fetched along with the previous one */
+	uint32_t rx_fsize[ADIN2111_PORTS];
 };
 
 /**
@@ -233,6 +242,14 @@ struct adin1110_eth_buff {
 	uint8_t *payload;
 };
 
+/**
+ * @brief Contiguous piece of a frame, used by the scatter-gather FIFO API.
+ */
+struct adin1110_frame_span {
+	uint8_t *buff;
+	uint32_t len;
+};
+
 /* Reset both the MAC and PHY. */
 int adin1110_sw_reset(struct adin1110_desc *);
 
@@ -253,6 +270,17 @@ int adin1110_write_fifo(struct adin1110_desc *, uint32_t,
 int adin1110_read_fifo(struct adin1110_desc *, uint32_t,
 		       struct adin1110_eth_buff *);
 
+/* Write a frame, given as a list of spans, to the TX FIFO */
+int adin1110_write_fifo_sg(struct adin1110_desc *, uint32_t,
+			   struct adin1110_frame_span *, uint32_t);
+
+/* Get the length of the next frame in the RX FIFO */
+int adin1110_rx_frame_len(struct adin1110_desc *, uint32_t, uint32_t *);
+
+/* Read a frame from the RX FIFO directly into a list of spans */
+int adin1110_read_fifo_sg(struct adin1110_desc *, uint32_t,
+			  struct adin1110_frame_span *, uint32_t, uint32_t *);
+
 /* Write a PHY register using clause 22 */
 int adin1110_mdio_write(struct adin1110_desc *, uint32_t, uint32_t, uint16_t);
 
@@ -136,3 +136,15 @@ void no_os_mdelay(uint32_t msecs)
 			return ;
 	start_and_wait(ms_timer, msecs);
 }
+
+/**
+ * @brief Get current time. The delay timers are restarted on every delay, so
+ * there is no free running time source: zero is returned.
+ * @return Current time structure (seconds, microseconds), always zero.
+ */
+struct no_os_time no_os_get_time(void)
+{
+	struct no_os_time t = {0, 0};
+
+	return t;
+}
@@ -42,6 +42,7 @@
 /******************************************************************************/
 
 #include <io.h>
+#include <sys/alt_cache.h>
 #include "no_os_error.h"
 #include "no_os_axi_io.h"
 
@@ -77,3 +78,32 @@ int32_t no_os_axi_io_write(uint32_t base, uint32_t offset, uint32_t data)
 	return 0;
 }
 
+
+/**
+ * @brief AXI IO Altera specific map function.
+ * @param base - Base address
+ * @param size - Size of the range
+ * @param addr - Address through which the range can be accessed
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_axi_io_map(uint32_t base, uint32_t size, void **addr)
+{
+	*addr = (void *)(uintptr_t)base;
+
+	return 0;
+}
+
+/**
+ * @brief AXI IO Altera specific unmap function. Flushes the range from the
+ * data cache.
+ * @param base - Base address
+ * @param addr - Address returned by no_os_axi_io_map()
+ * @param size - Size of the range
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_axi_io_unmap(uint32_t base, void *addr, uint32_t size)
+{
+	alt_dcache_flush(addr, size);
+
+	return 0;
+}
@@ -80,3 +80,35 @@ int32_t no_os_axi_io_write(uint32_t base, uint32_t offset, uint32_t data)
 
 	return 0;
 }
+
+/**
+ * @brief AXI IO generic map function.
+ * @param base - Base address
+ * @param size - Size of the range
+ * @param addr - Address through which the range can be accessed
+ * @return -ENOSYS, direct access is not available.
+ */
+int32_t no_os_axi_io_map(uint32_t base, uint32_t size, void **addr)
+{
+	NO_OS_UNUSED_PARAM(base);
+	NO_OS_UNUSED_PARAM(size);
+	NO_OS_UNUSED_PARAM(addr);
+
+	return -ENOSYS;
+}
+
+/**
+ * @brief AXI IO generic unmap function.
+ * @param base - Base address
+ * @param addr - Address returned by no_os_axi_io_map()
+ * @param size - Size of the range
+ * @return -ENOSYS, direct access is not available.
+ */
+int32_t no_os_axi_io_unmap(uint32_t base, void *addr, uint32_t size)
+{
+	NO_OS_UNUSED_PARAM(base);
+	NO_OS_UNUSED_PARAM(addr);
+	NO_OS_UNUSED_PARAM(size);
+
+	return -ENOSYS;
+}
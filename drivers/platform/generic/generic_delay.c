@@ -67,3 +67,14 @@ void no_os_mdelay(uint32_t msecs)
 {
 	NO_OS_UNUSED_PARAM(msecs);
 }
+
+/**
+ * @brief Get current time.
+ * @return Current time structure from system start (seconds, microseconds).
+ */
+struct no_os_time no_os_get_time(void)
+{
+	struct no_os_time t = {0, 0};
+
+	return t;
+}
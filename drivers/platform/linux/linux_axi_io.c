@@ -190,3 +190,52 @@ int32_t no_os_axi_io_write(uint32_t base, uint32_t offset, uint32_t data)
 	return uio_read_write(base, offset, NULL, &data);
 #endif
 }
+
+/**
+ * @brief AXI IO Linux specific map function: maps the UIO memory once, so a
+ * whole range can be accessed without an open()/mmap() cycle per word.
+ * @param base - UIO index (/dev/uioX).
+ * @param size - Size of the range.
+ * @param addr - Address through which the range can be accessed.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_axi_io_map(uint32_t base, uint32_t size, void **addr)
+{
+#ifdef DEVMEM
+	return -ENOSYS;
+#else
+	char buf[32];
+	int uio_fd;
+	void *uio_addr;
+
+	sprintf(buf, "/dev/uio%"PRIu32"", base);
+
+	uio_fd = open(buf, O_RDWR);
+	if (uio_fd < 0)
+		return -ENODEV;
+
+	uio_addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, uio_fd, 0);
+	close(uio_fd);
+	if (uio_addr == MAP_FAILED)
+		return -ENOMEM;
+
+	*addr = uio_addr;
+
+	return 0;
+#endif
+}
+
+/**
+ * @brief AXI IO Linux specific unmap function.
+ * @param base - UIO index (/dev/uioX).
+ * @param addr - Address returned by no_os_axi_io_map().
+ * @param size - Size of the range.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_axi_io_unmap(uint32_t base, void *addr, uint32_t size)
+{
+	if (munmap(addr, size) < 0)
+		return -EFAULT;
+
+	return 0;
+}
@@ -39,9 +39,92 @@
 #ifndef LINUX_GPIO_H_
 #define LINUX_GPIO_H_
 
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include "no_os_gpio.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/** Maximum number of lines in one character device line request */
+#define LINUX_GPIO_BULK_MAX_LINES	64
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
 /**
- * @brief Linux specific GPIO platform ops structure
+ * @struct linux_gpio_bulk_init_param
+ * @brief Parameters for requesting a group of lines of the same GPIO chip.
+ */
+struct linux_gpio_bulk_init_param {
+	/** GPIO chip index (/dev/gpiochip<chip>) */
+	uint32_t chip;
+	/** Line offsets, bit i of the bulk values maps to lines[i] */
+	const uint32_t *lines;
+	/** Number of lines, at most LINUX_GPIO_BULK_MAX_LINES */
+	uint32_t nb_lines;
+	/** NO_OS_GPIO_OUT or NO_OS_GPIO_IN */
+	uint8_t direction;
+	/** Initial output values, used only for outputs */
+	uint64_t values;
+	/** Pull up/down resistor configuration, used only for inputs */
+	enum no_os_gpio_pull_up pull;
+};
+
+/**
+ * @struct linux_gpio_bulk_desc
+ * @brief Group of lines of the same GPIO chip accessed with a single ioctl.
+ */
+struct linux_gpio_bulk_desc {
+	/** Line request file descriptor */
+	int line_fd;
+	/** Number of requested lines */
+	uint32_t nb_lines;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Request a set of lines from a GPIO chip. */
+int linux_gpio_cdev_request(uint32_t chip, const uint32_t *offsets,
+			    uint32_t nb_lines, uint64_t flags, uint64_t values,
+			    int *line_fd);
+
+/* Reconfigure all the lines of an existing line request. */
+int linux_gpio_cdev_set_config(int line_fd, uint32_t nb_lines,
+			       uint64_t flags, uint64_t values);
+
+/* Request several lines of a GPIO chip as a single group. */
+int linux_gpio_bulk_get(struct linux_gpio_bulk_desc **desc,
+			const struct linux_gpio_bulk_init_param *param);
+
+/* Set the values of several lines with a single ioctl. */
+int linux_gpio_bulk_set_values(struct linux_gpio_bulk_desc *desc,
+			       uint64_t mask, uint64_t values);
+
+/* Read the values of several lines with a single ioctl. */
+int linux_gpio_bulk_get_values(struct linux_gpio_bulk_desc *desc,
+			       uint64_t mask, uint64_t *values);
+
+/* Free the resources allocated by linux_gpio_bulk_get(). */
+int linux_gpio_bulk_remove(struct linux_gpio_bulk_desc *desc);
+
+/**
+ * @brief Linux specific GPIO platform ops structure (sysfs interface)
  */
 extern const struct no_os_gpio_platform_ops linux_gpio_ops;
 
+/**
+ * @brief Linux specific GPIO platform ops structure (character device).
+ * The port field of the init param selects /dev/gpiochip<port> and the
+ * number field is the line offset within that chip.
+ */
+extern const struct no_os_gpio_platform_ops linux_gpio_cdev_ops;
+
 #endif // LINUX_GPIO_H_
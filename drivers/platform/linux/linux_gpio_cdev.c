@@ -0,0 +1,533 @@
+/***************************************************************************//**
+ *   @file   linux/linux_gpio_cdev.c
+ *   @brief  Implementation of the Linux GPIO character device (v2 uAPI) driver.
+********************************************************************************
+ * Copyright 2023(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include "no_os_error.h"
+#include "no_os_gpio.h"
+#include "no_os_alloc.h"
+#include "linux_gpio.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define LINUX_GPIO_CDEV_CONSUMER	"no-OS"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct linux_gpio_cdev_desc
+ * @brief Linux platform specific GPIO character device descriptor
+ */
+struct linux_gpio_cdev_desc {
+	/** Line request file descriptor */
+	int line_fd;
+	/** Bias flags derived from the pull configuration */
+	uint64_t bias;
+	/** Cached line direction */
+	uint8_t direction;
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Convert the no-OS pull configuration to GPIO v2 bias flags.
+ * @param pull - Pull up/down configuration.
+ * @return The corresponding GPIO_V2_LINE_FLAG_BIAS_* flags.
+ */
+static uint64_t linux_gpio_cdev_bias(enum no_os_gpio_pull_up pull)
+{
+	switch (pull) {
+	case NO_OS_PULL_UP:
+	case NO_OS_PULL_UP_WEAK:
+		return GPIO_V2_LINE_FLAG_BIAS_PULL_UP;
+	case NO_OS_PULL_DOWN:
+	case NO_OS_PULL_DOWN_WEAK:
+		return GPIO_V2_LINE_FLAG_BIAS_PULL_DOWN;
+	default:
+		return 0;
+	}
+}
+
+/**
+ * @brief Request a set of lines from a GPIO chip.
+ * @param chip - GPIO chip index (/dev/gpiochip<chip>).
+ * @param offsets - Line offsets within the chip.
+ * @param nb_lines - Number of lines, at most LINUX_GPIO_BULK_MAX_LINES.
+ * @param flags - GPIO_V2_LINE_FLAG_* flags applied to all the lines.
+ * @param values - Initial output values, bit i for offsets[i]. Only used
+ *                 when flags contain GPIO_V2_LINE_FLAG_OUTPUT.
+ * @param line_fd - The resulting line request file descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_gpio_cdev_request(uint32_t chip, const uint32_t *offsets,
+			    uint32_t nb_lines, uint64_t flags, uint64_t values,
+			    int *line_fd)
+{
+	struct gpio_v2_line_request req;
+	char path[32];
+	int chip_fd;
+	int ret;
+
+	if (!offsets || !line_fd || !nb_lines ||
+	    nb_lines > LINUX_GPIO_BULK_MAX_LINES)
+		return -EINVAL;
+
+	sprintf(path, "/dev/gpiochip%u", chip);
+	chip_fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (chip_fd < 0) {
+		printf("%s: Can't open %s\n\r", __func__, path);
+		return -errno;
+	}
+
+	memset(&req, 0, sizeof(req));
+	memcpy(req.offsets, offsets, nb_lines * sizeof(*offsets));
+	strncpy(req.consumer, LINUX_GPIO_CDEV_CONSUMER,
+		sizeof(req.consumer) - 1);
+	req.num_lines = nb_lines;
+	req.config.flags = flags;
+	if (flags & GPIO_V2_LINE_FLAG_OUTPUT) {
+		req.config.num_attrs = 1;
+		req.config.attrs[0].attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+		req.config.attrs[0].attr.values = values;
+		req.config.attrs[0].mask = (nb_lines == 64) ? ~0ULL :
+					   ((1ULL << nb_lines) - 1);
+	}
+
+	ret = ioctl(chip_fd, GPIO_V2_GET_LINE_IOCTL, &req);
+	if (ret < 0) {
+		ret = -errno;
+		printf("%s: Can't request lines from %s\n\r", __func__, path);
+		close(chip_fd);
+		return ret;
+	}
+
+	close(chip_fd);
+	*line_fd = req.fd;
+
+	return 0;
+}
+
+/**
+ * @brief Reconfigure all the lines of an existing line request.
+ * @param line_fd - Line request file descriptor.
+ * @param nb_lines - Number of lines in the request.
+ * @param flags - New GPIO_V2_LINE_FLAG_* flags.
+ * @param values - Output values, used only for output lines.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_gpio_cdev_set_config(int line_fd, uint32_t nb_lines,
+			       uint64_t flags, uint64_t values)
+{
+	struct gpio_v2_line_config cfg;
+
+	memset(&cfg, 0, sizeof(cfg));
+	cfg.flags = flags;
+	if (flags & GPIO_V2_LINE_FLAG_OUTPUT) {
+		cfg.num_attrs = 1;
+		cfg.attrs[0].attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+		cfg.attrs[0].attr.values = values;
+		cfg.attrs[0].mask = (nb_lines == 64) ? ~0ULL :
+				    ((1ULL << nb_lines) - 1);
+	}
+
+	if (ioctl(line_fd, GPIO_V2_LINE_SET_CONFIG_IOCTL, &cfg) < 0)
+		return -errno;
+
+	return 0;
+}
+
+/**
+ * @brief Obtain the GPIO decriptor.
+ * @param desc - The GPIO descriptor.
+ * @param param - GPIO initialization parameters. The port selects the GPIO
+ *                chip (/dev/gpiochip<port>) and the number is the line offset.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_cdev_get(struct no_os_gpio_desc **desc,
+				   const struct no_os_gpio_init_param *param)
+{
+	struct linux_gpio_cdev_desc *linux_desc;
+	struct no_os_gpio_desc *descriptor;
+	uint32_t offset;
+	int ret;
+
+	if (!desc || !param || param->number < 0)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	linux_desc = no_os_calloc(1, sizeof(*linux_desc));
+	if (!linux_desc) {
+		ret = -ENOMEM;
+		goto free_desc;
+	}
+
+	descriptor->extra = linux_desc;
+	descriptor->port = param->port;
+	descriptor->number = param->number;
+	descriptor->pull = param->pull;
+
+	linux_desc->bias = linux_gpio_cdev_bias(param->pull);
+	linux_desc->direction = NO_OS_GPIO_IN;
+
+	/* Lines start as inputs, the same as a freshly exported sysfs GPIO. */
+	offset = param->number;
+	ret = linux_gpio_cdev_request(param->port, &offset, 1,
+				      GPIO_V2_LINE_FLAG_INPUT | linux_desc->bias,
+				      0, &linux_desc->line_fd);
+	if (ret)
+		goto free_linux_desc;
+
+	*desc = descriptor;
+
+	return 0;
+
+free_linux_desc:
+	no_os_free(linux_desc);
+free_desc:
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Get the value of an optional GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param param - GPIO Initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_cdev_get_optional(struct no_os_gpio_desc **desc,
+		const struct no_os_gpio_init_param *param)
+{
+	if (!param) {
+		*desc = NULL;
+		return 0;
+	}
+
+	return linux_gpio_cdev_get(desc, param);
+}
+
+/**
+ * @brief Free the resources allocated by no_os_gpio_get().
+ * @param desc - The GPIO descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_cdev_remove(struct no_os_gpio_desc *desc)
+{
+	struct linux_gpio_cdev_desc *linux_desc;
+
+	if (!desc)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+
+	close(linux_desc->line_fd);
+	no_os_free(linux_desc);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Set the value of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param value - The value.
+ *                Example: NO_OS_GPIO_HIGH
+ *                         NO_OS_GPIO_LOW
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_cdev_set_value(struct no_os_gpio_desc *desc,
+		uint8_t value)
+{
+	struct linux_gpio_cdev_desc *linux_desc;
+	struct gpio_v2_line_values vals;
+	int32_t ret;
+
+	linux_desc = desc->extra;
+
+	if (value == NO_OS_GPIO_HIGH_Z) {
+		ret = linux_gpio_cdev_set_config(linux_desc->line_fd, 1,
+						 GPIO_V2_LINE_FLAG_INPUT |
+						 linux_desc->bias, 0);
+		if (ret)
+			return ret;
+
+		linux_desc->direction = NO_OS_GPIO_IN;
+
+		return 0;
+	}
+
+	vals.mask = 1;
+	vals.bits = value ? 1 : 0;
+	if (ioctl(linux_desc->line_fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &vals) < 0)
+		return -errno;
+
+	return 0;
+}
+
+/**
+ * @brief Get the value of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param value - The value.
+ *                Example: NO_OS_GPIO_HIGH
+ *                         NO_OS_GPIO_LOW
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_cdev_get_value(struct no_os_gpio_desc *desc,
+		uint8_t *value)
+{
+	struct linux_gpio_cdev_desc *linux_desc;
+	struct gpio_v2_line_values vals;
+
+	linux_desc = desc->extra;
+
+	vals.mask = 1;
+	vals.bits = 0;
+	if (ioctl(linux_desc->line_fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &vals) < 0)
+		return -errno;
+
+	*value = (vals.bits & 1) ? NO_OS_GPIO_HIGH : NO_OS_GPIO_LOW;
+
+	return 0;
+}
+
+/**
+ * @brief Enable the input direction of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_cdev_direction_input(struct no_os_gpio_desc *desc)
+{
+	struct linux_gpio_cdev_desc *linux_desc;
+	int ret;
+
+	linux_desc = desc->extra;
+
+	ret = linux_gpio_cdev_set_config(linux_desc->line_fd, 1,
+					 GPIO_V2_LINE_FLAG_INPUT |
+					 linux_desc->bias, 0);
+	if (ret)
+		return ret;
+
+	linux_desc->direction = NO_OS_GPIO_IN;
+
+	return 0;
+}
+
+/**
+ * @brief Enable the output direction of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param value - The value.
+ *                Example: NO_OS_GPIO_HIGH
+ *                         NO_OS_GPIO_LOW
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_cdev_direction_output(struct no_os_gpio_desc *desc,
+		uint8_t value)
+{
+	struct linux_gpio_cdev_desc *linux_desc;
+	int ret;
+
+	linux_desc = desc->extra;
+
+	/* Direction and level are applied atomically, avoiding glitches. */
+	ret = linux_gpio_cdev_set_config(linux_desc->line_fd, 1,
+					 GPIO_V2_LINE_FLAG_OUTPUT,
+					 value ? 1 : 0);
+	if (ret)
+		return ret;
+
+	linux_desc->direction = NO_OS_GPIO_OUT;
+
+	return 0;
+}
+
+/**
+ * @brief Get the direction of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param direction - The direction.
+ *                    Example: NO_OS_GPIO_OUT
+ *                             NO_OS_GPIO_IN
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_cdev_get_direction(struct no_os_gpio_desc *desc,
+		uint8_t *direction)
+{
+	struct linux_gpio_cdev_desc *linux_desc;
+
+	linux_desc = desc->extra;
+
+	*direction = linux_desc->direction;
+
+	return 0;
+}
+
+/**
+ * @brief Request several lines of a GPIO chip as a single group.
+ * @param desc - The bulk GPIO descriptor.
+ * @param param - Bulk GPIO initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_gpio_bulk_get(struct linux_gpio_bulk_desc **desc,
+			const struct linux_gpio_bulk_init_param *param)
+{
+	struct linux_gpio_bulk_desc *descriptor;
+	uint64_t flags;
+	int ret;
+
+	if (!desc || !param)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	if (param->direction == NO_OS_GPIO_OUT)
+		flags = GPIO_V2_LINE_FLAG_OUTPUT;
+	else
+		flags = GPIO_V2_LINE_FLAG_INPUT | linux_gpio_cdev_bias(param->pull);
+
+	ret = linux_gpio_cdev_request(param->chip, param->lines,
+				      param->nb_lines, flags, param->values,
+				      &descriptor->line_fd);
+	if (ret) {
+		no_os_free(descriptor);
+		return ret;
+	}
+
+	descriptor->nb_lines = param->nb_lines;
+	*desc = descriptor;
+
+	return 0;
+}
+
+/**
+ * @brief Set the values of several lines with a single ioctl.
+ * @param desc - The bulk GPIO descriptor.
+ * @param mask - Lines to be updated, bit i selects param->lines[i].
+ * @param values - New line values, bit i for param->lines[i].
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_gpio_bulk_set_values(struct linux_gpio_bulk_desc *desc,
+			       uint64_t mask, uint64_t values)
+{
+	struct gpio_v2_line_values vals;
+
+	if (!desc)
+		return -EINVAL;
+
+	vals.mask = mask;
+	vals.bits = values;
+	if (ioctl(desc->line_fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &vals) < 0)
+		return -errno;
+
+	return 0;
+}
+
+/**
+ * @brief Read the values of several lines with a single ioctl.
+ * @param desc - The bulk GPIO descriptor.
+ * @param mask - Lines to be read, bit i selects param->lines[i].
+ * @param values - Read line values, bit i for param->lines[i].
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_gpio_bulk_get_values(struct linux_gpio_bulk_desc *desc,
+			       uint64_t mask, uint64_t *values)
+{
+	struct gpio_v2_line_values vals;
+
+	if (!desc || !values)
+		return -EINVAL;
+
+	vals.mask = mask;
+	vals.bits = 0;
+	if (ioctl(desc->line_fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &vals) < 0)
+		return -errno;
+
+	*values = vals.bits & mask;
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by linux_gpio_bulk_get().
+ * @param desc - The bulk GPIO descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_gpio_bulk_remove(struct linux_gpio_bulk_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	close(desc->line_fd);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Linux platform specific GPIO character device platform ops structure
+ */
+const struct no_os_gpio_platform_ops linux_gpio_cdev_ops = {
+	.gpio_ops_get = &linux_gpio_cdev_get,
+	.gpio_ops_get_optional = &linux_gpio_cdev_get_optional,
+	.gpio_ops_remove = &linux_gpio_cdev_remove,
+	.gpio_ops_direction_input = &linux_gpio_cdev_direction_input,
+	.gpio_ops_direction_output = &linux_gpio_cdev_direction_output,
+	.gpio_ops_get_direction = &linux_gpio_cdev_get_direction,
+	.gpio_ops_set_value = &linux_gpio_cdev_set_value,
+	.gpio_ops_get_value = &linux_gpio_cdev_get_value,
+};
@@ -0,0 +1,780 @@
+/***************************************************************************//**
+ *   @file   linux/linux_gpio_irq.c
+ *   @brief  Linux GPIO interrupt controller based on the GPIO character device.
+********************************************************************************
+ * Copyright 2023(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+
+#include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "no_os_irq.h"
+#include "linux_gpio.h"
+#include "linux_gpio_irq.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/** Number of kernel line events fetched with one read() */
+#define LINUX_GPIO_IRQ_EVENT_BURST	16
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct linux_gpio_irq_line
+ * @brief State of a line used as interrupt source
+ */
+struct linux_gpio_irq_line {
+	/** Line offset within the GPIO chip */
+	uint32_t irq_id;
+	/** Line request file descriptor */
+	int fd;
+	/** Configured trigger condition */
+	enum no_os_irq_trig_level trig;
+	/** Events are delivered only when the line is enabled */
+	bool enabled;
+	/** Level triggered line has to be checked without waiting for an edge */
+	bool pending;
+	/** User callback */
+	void (*callback)(void *ctx);
+	/** User callback context */
+	void *ctx;
+	/** CLOCK_MONOTONIC timestamp of the last delivered event */
+	uint64_t timestamp_ns;
+};
+
+/**
+ * @struct linux_gpio_irq_desc
+ * @brief Linux platform specific GPIO interrupt controller descriptor
+ */
+struct linux_gpio_irq_desc {
+	/** Poll thread delivering the events */
+	pthread_t thread;
+	/** Protects the lines table, recursive so callbacks may use the API */
+	pthread_mutex_t lock;
+	/** Used to wake up the poll thread when the line set changes */
+	int event_fd;
+	/** Cleared to stop the poll thread */
+	bool running;
+	/** Global interrupt enable */
+	bool global_enabled;
+	/** Registered lines */
+	struct linux_gpio_irq_line *lines[LINUX_GPIO_IRQ_MAX_LINES];
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Convert a trigger condition to GPIO v2 edge detection flags.
+ * Level triggers are detected on their activating edge and then re-checked
+ * by reading the line value after each callback.
+ * @param trig - Trigger condition.
+ * @return The GPIO_V2_LINE_FLAG_EDGE_* flags.
+ */
+static uint64_t linux_gpio_irq_edge_flags(enum no_os_irq_trig_level trig)
+{
+	switch (trig) {
+	case NO_OS_IRQ_LEVEL_LOW:
+	case NO_OS_IRQ_EDGE_FALLING:
+		return GPIO_V2_LINE_FLAG_EDGE_FALLING;
+	case NO_OS_IRQ_LEVEL_HIGH:
+	case NO_OS_IRQ_EDGE_RISING:
+		return GPIO_V2_LINE_FLAG_EDGE_RISING;
+	default:
+		return GPIO_V2_LINE_FLAG_EDGE_RISING |
+		       GPIO_V2_LINE_FLAG_EDGE_FALLING;
+	}
+}
+
+/**
+ * @brief Find a registered line.
+ * @param desc - Linux GPIO interrupt controller descriptor.
+ * @param irq_id - Line offset.
+ * @return Index in the lines table, negative error code if not found.
+ */
+static int linux_gpio_irq_find(struct linux_gpio_irq_desc *desc,
+			       uint32_t irq_id)
+{
+	int i;
+
+	for (i = 0; i < LINUX_GPIO_IRQ_MAX_LINES; i++)
+		if (desc->lines[i] && desc->lines[i]->irq_id == irq_id)
+			return i;
+
+	return -ENODEV;
+}
+
+/**
+ * @brief Wake up the poll thread so it rebuilds its file descriptor set.
+ * @param desc - Linux GPIO interrupt controller descriptor.
+ */
+static void linux_gpio_irq_kick(struct linux_gpio_irq_desc *desc)
+{
+	uint64_t one = 1;
+
+	if (write(desc->event_fd, &one, sizeof(one)) < 0)
+		printf("%s: Can't wake up the poll thread\n\r", __func__);
+}
+
+/**
+ * @brief Discard the events queued by the kernel for a line.
+ * @param line - Line state.
+ */
+static void linux_gpio_irq_drain(struct linux_gpio_irq_line *line)
+{
+	struct gpio_v2_line_event events[LINUX_GPIO_IRQ_EVENT_BURST];
+
+	while (read(line->fd, events, sizeof(events)) > 0)
+		;
+}
+
+/**
+ * @brief Check whether a line is level triggered.
+ * @param line - Line state.
+ * @return true if the line is level triggered.
+ */
+static bool linux_gpio_irq_is_level(struct linux_gpio_irq_line *line)
+{
+	return line->trig == NO_OS_IRQ_LEVEL_HIGH ||
+	       line->trig == NO_OS_IRQ_LEVEL_LOW;
+}
+
+/**
+ * @brief Check whether a level triggered line is at its active level.
+ * @param line - Line state.
+ * @return true if the line is level triggered and active.
+ */
+static bool linux_gpio_irq_level_active(struct linux_gpio_irq_line *line)
+{
+	struct gpio_v2_line_values vals = {.mask = 1};
+
+	if (!linux_gpio_irq_is_level(line))
+		return false;
+
+	if (ioctl(line->fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &vals) < 0)
+		return false;
+
+	return (line->trig == NO_OS_IRQ_LEVEL_HIGH) == !!(vals.bits & 1);
+}
+
+/**
+ * @brief Deliver the events of one line. Called with the lock held.
+ * A level triggered line is delivered at most once per wakeup. While it stays
+ * active, the poll thread is woken up again, so the lock is released between
+ * two deliveries and the line can be disabled from another thread.
+ * A callback may unregister its own line, so the line is looked up again
+ * after each callback before being touched.
+ * @param desc - Linux GPIO interrupt controller descriptor.
+ * @param idx - Index of the line in the lines table.
+ * @return true if the line is still registered, false otherwise.
+ */
+static bool linux_gpio_irq_handle(struct linux_gpio_irq_desc *desc, int idx)
+{
+	struct gpio_v2_line_event events[LINUX_GPIO_IRQ_EVENT_BURST];
+	struct linux_gpio_irq_line *line = desc->lines[idx];
+	bool level = linux_gpio_irq_is_level(line);
+	struct timespec now;
+	bool edge = false;
+	ssize_t len;
+	size_t i;
+
+	while (1) {
+		len = read(line->fd, events, sizeof(events));
+		if (len < (ssize_t)sizeof(events[0]))
+			break;
+
+		for (i = 0; i < len / sizeof(events[0]); i++) {
+			if (!line->enabled || !desc->global_enabled)
+				return true;
+
+			line->timestamp_ns = events[i].timestamp_ns;
+			edge = true;
+			/* Level lines are delivered below, from the line value */
+			if (level || !line->callback)
+				continue;
+
+			line->callback(line->ctx);
+			if (desc->lines[idx] != line)
+				return false;
+		}
+	}
+
+	line->pending = false;
+	if (!line->enabled || !desc->global_enabled || !line->callback ||
+	    !linux_gpio_irq_level_active(line))
+		return true;
+
+	if (!edge) {
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		line->timestamp_ns = now.tv_sec * 1000000000ULL + now.tv_nsec;
+	}
+	line->callback(line->ctx);
+	if (desc->lines[idx] != line)
+		return false;
+
+	if (line->enabled && linux_gpio_irq_level_active(line)) {
+		line->pending = true;
+		linux_gpio_irq_kick(desc);
+	}
+
+	return true;
+}
+
+/**
+ * @brief Poll thread waiting for line events and calling the callbacks.
+ * @param arg - Linux GPIO interrupt controller descriptor.
+ * @return NULL
+ */
+static void *linux_gpio_irq_thread(void *arg)
+{
+	struct linux_gpio_irq_desc *desc = arg;
+	struct pollfd pfds[LINUX_GPIO_IRQ_MAX_LINES + 1];
+	int idx[LINUX_GPIO_IRQ_MAX_LINES + 1];
+	struct linux_gpio_irq_line *line;
+	uint64_t cnt;
+	int nfds;
+	int ret;
+	int i;
+
+	pfds[0].fd = desc->event_fd;
+	pfds[0].events = POLLIN;
+
+	while (1) {
+		pthread_mutex_lock(&desc->lock);
+		if (!desc->running) {
+			pthread_mutex_unlock(&desc->lock);
+			break;
+		}
+
+		nfds = 1;
+		for (i = 0; i < LINUX_GPIO_IRQ_MAX_LINES; i++) {
+			line = desc->lines[i];
+			if (!line || line->fd < 0 || !line->enabled)
+				continue;
+
+			if (line->pending && desc->global_enabled &&
+			    !linux_gpio_irq_handle(desc, i))
+				continue;
+
+			pfds[nfds].fd = line->fd;
+			pfds[nfds].events = POLLIN;
+			idx[nfds++] = i;
+		}
+		if (!desc->global_enabled)
+			nfds = 1;
+		pthread_mutex_unlock(&desc->lock);
+
+		ret = poll(pfds, nfds, -1);
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+
+		if (pfds[0].revents & POLLIN) {
+			if (read(desc->event_fd, &cnt, sizeof(cnt)) < 0)
+				continue;
+		}
+
+		pthread_mutex_lock(&desc->lock);
+		for (i = 1; i < nfds; i++) {
+			if (!(pfds[i].revents & POLLIN))
+				continue;
+
+			/* The line may have been unregistered meanwhile. */
+			line = desc->lines[idx[i]];
+			if (!line || line->fd != pfds[i].fd)
+				continue;
+
+			linux_gpio_irq_handle(desc, idx[i]);
+		}
+		pthread_mutex_unlock(&desc->lock);
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Initialize the GPIO interrupt controller
+ * @param desc - Pointer where the configured instance is stored
+ * @param param - Configuration information for the instance
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
+					const struct no_os_irq_init_param *param)
+{
+	struct no_os_irq_ctrl_desc *descriptor;
+	struct linux_gpio_irq_desc *linux_desc;
+	pthread_mutexattr_t attr;
+	int ret;
+
+	if (!desc || !param)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	linux_desc = no_os_calloc(1, sizeof(*linux_desc));
+	if (!linux_desc) {
+		ret = -ENOMEM;
+		goto free_desc;
+	}
+
+	descriptor->irq_ctrl_id = param->irq_ctrl_id;
+	descriptor->extra = linux_desc;
+
+	linux_desc->event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (linux_desc->event_fd < 0) {
+		ret = -errno;
+		goto free_linux_desc;
+	}
+
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&linux_desc->lock, &attr);
+	pthread_mutexattr_destroy(&attr);
+
+	linux_desc->running = true;
+	linux_desc->global_enabled = true;
+
+	ret = -pthread_create(&linux_desc->thread, NULL, linux_gpio_irq_thread,
+			      linux_desc);
+	if (ret)
+		goto free_mutex;
+
+	*desc = descriptor;
+
+	return 0;
+
+free_mutex:
+	pthread_mutex_destroy(&linux_desc->lock);
+	close(linux_desc->event_fd);
+free_linux_desc:
+	no_os_free(linux_desc);
+free_desc:
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Free the resources allocated by no_os_irq_ctrl_init()
+ * @param desc - Interrupt GPIO controller descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_irq_ctrl_remove(struct no_os_irq_ctrl_desc *desc)
+{
+	struct linux_gpio_irq_desc *linux_desc;
+	int i;
+
+	if (!desc)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+
+	pthread_mutex_lock(&linux_desc->lock);
+	linux_desc->running = false;
+	linux_gpio_irq_kick(linux_desc);
+	pthread_mutex_unlock(&linux_desc->lock);
+	pthread_join(linux_desc->thread, NULL);
+
+	for (i = 0; i < LINUX_GPIO_IRQ_MAX_LINES; i++) {
+		if (!linux_desc->lines[i])
+			continue;
+
+		if (linux_desc->lines[i]->fd >= 0)
+			close(linux_desc->lines[i]->fd);
+		no_os_free(linux_desc->lines[i]);
+	}
+
+	pthread_mutex_destroy(&linux_desc->lock);
+	close(linux_desc->event_fd);
+	no_os_free(linux_desc);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Register a callback function to be triggered when an
+ * interrupt occurs. The line is requested from the GPIO chip as an input with
+ * edge detection enabled.
+ * @param desc - The GPIO IRQ controller descriptor.
+ * @param irq_id - The line offset.
+ * @param callback_desc - Descriptor of the callback.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_irq_register_callback(struct no_os_irq_ctrl_desc
+		*desc, uint32_t irq_id,
+		struct no_os_callback_desc *callback_desc)
+{
+	struct linux_gpio_irq_desc *linux_desc;
+	struct linux_gpio_irq_line *line;
+	int ret = 0;
+	int i;
+
+	if (!desc || !callback_desc)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+
+	pthread_mutex_lock(&linux_desc->lock);
+
+	i = linux_gpio_irq_find(linux_desc, irq_id);
+	if (i >= 0) {
+		line = linux_desc->lines[i];
+		line->callback = callback_desc->callback;
+		line->ctx = callback_desc->ctx;
+		goto unlock;
+	}
+
+	for (i = 0; i < LINUX_GPIO_IRQ_MAX_LINES; i++)
+		if (!linux_desc->lines[i])
+			break;
+	if (i == LINUX_GPIO_IRQ_MAX_LINES) {
+		ret = -ENOMEM;
+		goto unlock;
+	}
+
+	line = no_os_calloc(1, sizeof(*line));
+	if (!line) {
+		ret = -ENOMEM;
+		goto unlock;
+	}
+
+	line->irq_id = irq_id;
+	line->trig = NO_OS_IRQ_EDGE_RISING;
+	line->callback = callback_desc->callback;
+	line->ctx = callback_desc->ctx;
+
+	ret = linux_gpio_cdev_request(desc->irq_ctrl_id, &irq_id, 1,
+				      GPIO_V2_LINE_FLAG_INPUT |
+				      linux_gpio_irq_edge_flags(line->trig),
+				      0, &line->fd);
+	if (ret) {
+		no_os_free(line);
+		goto unlock;
+	}
+
+	fcntl(line->fd, F_SETFL, fcntl(line->fd, F_GETFL) | O_NONBLOCK);
+	linux_desc->lines[i] = line;
+
+unlock:
+	pthread_mutex_unlock(&linux_desc->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Unregister a callback function and release the line.
+ * @param desc - GPIO interrupt controller descriptor.
+ * @param irq_id - The line offset.
+ * @param callback_desc - Callback descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_irq_unregister_callback(struct no_os_irq_ctrl_desc
+		*desc, uint32_t irq_id,
+		struct no_os_callback_desc *callback_desc)
+{
+	struct linux_gpio_irq_desc *linux_desc;
+	int i;
+
+	if (!desc)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+
+	pthread_mutex_lock(&linux_desc->lock);
+
+	i = linux_gpio_irq_find(linux_desc, irq_id);
+	if (i < 0) {
+		pthread_mutex_unlock(&linux_desc->lock);
+		return i;
+	}
+
+	close(linux_desc->lines[i]->fd);
+	no_os_free(linux_desc->lines[i]);
+	linux_desc->lines[i] = NULL;
+	linux_gpio_irq_kick(linux_desc);
+
+	pthread_mutex_unlock(&linux_desc->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Set the trigger condition.
+ * @param desc - The GPIO irq descriptor.
+ * @param irq_id - The line offset.
+ * @param trig - The trigger condition.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_irq_trigger_level_set(struct no_os_irq_ctrl_desc
+		*desc, uint32_t irq_id,
+		enum no_os_irq_trig_level trig)
+{
+	struct linux_gpio_irq_desc *linux_desc;
+	struct linux_gpio_irq_line *line;
+	int ret;
+	int i;
+
+	if (!desc || trig > NO_OS_IRQ_EDGE_BOTH)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+
+	pthread_mutex_lock(&linux_desc->lock);
+
+	i = linux_gpio_irq_find(linux_desc, irq_id);
+	if (i < 0) {
+		ret = i;
+		goto unlock;
+	}
+
+	line = linux_desc->lines[i];
+	ret = linux_gpio_cdev_set_config(line->fd, 1, GPIO_V2_LINE_FLAG_INPUT |
+					 linux_gpio_irq_edge_flags(trig), 0);
+	if (ret)
+		goto unlock;
+
+	line->trig = trig;
+	line->pending = line->enabled;
+	linux_gpio_irq_kick(linux_desc);
+
+unlock:
+	pthread_mutex_unlock(&linux_desc->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Enable or disable the event delivery for a line.
+ * @param desc - The GPIO irq descriptor.
+ * @param irq_id - The line offset.
+ * @param enable - New state.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int linux_gpio_irq_set_enable(struct no_os_irq_ctrl_desc *desc,
+				     uint32_t irq_id, bool enable)
+{
+	struct linux_gpio_irq_desc *linux_desc;
+	struct linux_gpio_irq_line *line;
+	int i;
+
+	if (!desc)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+
+	pthread_mutex_lock(&linux_desc->lock);
+
+	i = linux_gpio_irq_find(linux_desc, irq_id);
+	if (i < 0) {
+		pthread_mutex_unlock(&linux_desc->lock);
+		return i;
+	}
+
+	line = linux_desc->lines[i];
+	if (enable && !line->enabled) {
+		/* Edges seen while disabled are not delivered. */
+		linux_gpio_irq_drain(line);
+		line->pending = true;
+	}
+	line->enabled = enable;
+	linux_gpio_irq_kick(linux_desc);
+
+	pthread_mutex_unlock(&linux_desc->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Enable a specific interrupt
+ * @param desc - the GPIO irq descriptor.
+ * @param irq_id - The line offset.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_irq_enable(struct no_os_irq_ctrl_desc *desc,
+				     uint32_t irq_id)
+{
+	return linux_gpio_irq_set_enable(desc, irq_id, true);
+}
+
+/**
+ * @brief Disable a specific interrupt
+ * @param desc - the GPIO irq descriptor.
+ * @param irq_id - The line offset.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_irq_disable(struct no_os_irq_ctrl_desc *desc,
+				      uint32_t irq_id)
+{
+	return linux_gpio_irq_set_enable(desc, irq_id, false);
+}
+
+/**
+ * @brief Enable or disable the delivery of all the events.
+ * @param desc - GPIO interrupt controller descriptor.
+ * @param enable - New state.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int linux_gpio_irq_set_global(struct no_os_irq_ctrl_desc *desc,
+				     bool enable)
+{
+	struct linux_gpio_irq_desc *linux_desc;
+
+	if (!desc)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+
+	pthread_mutex_lock(&linux_desc->lock);
+	linux_desc->global_enabled = enable;
+	linux_gpio_irq_kick(linux_desc);
+	pthread_mutex_unlock(&linux_desc->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Enable all interrupts
+ * @param desc - GPIO interrupt controller descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_irq_global_enable(struct no_os_irq_ctrl_desc *desc)
+{
+	return linux_gpio_irq_set_global(desc, true);
+}
+
+/**
+ * @brief Disable all interrupts
+ * @param desc - GPIO interrupt controller descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_irq_global_disable(struct no_os_irq_ctrl_desc *desc)
+{
+	return linux_gpio_irq_set_global(desc, false);
+}
+
+/**
+ * @brief Set the real-time priority of the poll thread.
+ * @param desc - GPIO interrupt controller descriptor.
+ * @param irq_id - Unused, the priority is common to all the lines.
+ * @param priority_level - SCHED_FIFO priority, 0 selects SCHED_OTHER.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_irq_set_priority(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		uint32_t priority_level)
+{
+	struct linux_gpio_irq_desc *linux_desc;
+	struct sched_param sp = {.sched_priority = priority_level};
+
+	if (!desc)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+
+	return -pthread_setschedparam(linux_desc->thread,
+				      priority_level ? SCHED_FIFO : SCHED_OTHER,
+				      &sp);
+}
+
+/**
+ * @brief Get the timestamp of the last event delivered for a line.
+ * Meant to be called from the callback to get the time of the edge that
+ * caused it, as measured by the kernel.
+ * @param desc - GPIO interrupt controller descriptor.
+ * @param irq_id - The line offset.
+ * @param timestamp_ns - CLOCK_MONOTONIC timestamp in nanoseconds.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_gpio_irq_get_timestamp(struct no_os_irq_ctrl_desc *desc,
+				 uint32_t irq_id, uint64_t *timestamp_ns)
+{
+	struct linux_gpio_irq_desc *linux_desc;
+	int i;
+
+	if (!desc || !timestamp_ns)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+
+	pthread_mutex_lock(&linux_desc->lock);
+	i = linux_gpio_irq_find(linux_desc, irq_id);
+	if (i >= 0)
+		*timestamp_ns = linux_desc->lines[i]->timestamp_ns;
+	pthread_mutex_unlock(&linux_desc->lock);
+
+	return i < 0 ? i : 0;
+}
+
+/**
+ * @brief Linux specific GPIO IRQ platform ops structure
+ */
+const struct no_os_irq_platform_ops linux_gpio_irq_ops = {
+	.init = &linux_gpio_irq_ctrl_init,
+	.register_callback = &linux_gpio_irq_register_callback,
+	.unregister_callback = &linux_gpio_irq_unregister_callback,
+	.enable = &linux_gpio_irq_enable,
+	.disable = &linux_gpio_irq_disable,
+	.trigger_level_set = &linux_gpio_irq_trigger_level_set,
+	.global_enable = &linux_gpio_irq_global_enable,
+	.global_disable = &linux_gpio_irq_global_disable,
+	.set_priority = &linux_gpio_irq_set_priority,
+	.remove = &linux_gpio_irq_ctrl_remove
+};
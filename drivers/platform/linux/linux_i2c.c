@@ -46,13 +46,23 @@
 #include "no_os_alloc.h"
 #include "linux_i2c.h"
 
+#include <errno.h>
 #include <fcntl.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
+#include <linux/i2c.h>
 #include <linux/i2c-dev.h>
 
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/** Transfers up to this many messages don't allocate memory */
+#define LINUX_I2C_STACK_MSGS	8
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -64,12 +74,72 @@
 struct linux_i2c_desc {
 	/** /dev/i2c-"device_id" file descriptor */
 	int fd;
+	/** Adapter supports plain I2C messages (I2C_RDWR) */
+	bool rdwr;
+	/** Slave address last selected with I2C_SLAVE, -1 if none */
+	int slave_address;
 };
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
 
+/**
+ * @brief Select the slave address for read()/write(), only if it changed.
+ * @param desc - The I2C descriptor.
+ * @return 0 in case of success, -1 otherwise.
+ */
+static int32_t linux_i2c_select(struct no_os_i2c_desc *desc)
+{
+	struct linux_i2c_desc *linux_desc = desc->extra;
+	int32_t ret;
+
+	if (linux_desc->slave_address == desc->slave_address)
+		return 0;
+
+	ret = ioctl(linux_desc->fd, I2C_SLAVE, desc->slave_address);
+	if (ret < 0) {
+		printf("%s: Can't select device\n\r", __func__);
+		linux_desc->slave_address = -1;
+		return -1;
+	}
+
+	linux_desc->slave_address = desc->slave_address;
+
+	return 0;
+}
+
+/**
+ * @brief Issue a combined transaction with the I2C_RDWR ioctl. Transfers
+ * longer than I2C_RDWR_IOCTL_MAX_MSGS are split, with a stop condition
+ * between the chunks.
+ * @param desc - The I2C descriptor.
+ * @param msgs - Kernel I2C messages.
+ * @param len - Number of messages.
+ * @return 0 in case of success, -1 otherwise.
+ */
+static int32_t linux_i2c_rdwr(struct no_os_i2c_desc *desc,
+			      struct i2c_msg *msgs, uint32_t len)
+{
+	struct linux_i2c_desc *linux_desc = desc->extra;
+	struct i2c_rdwr_ioctl_data data;
+	uint32_t n;
+
+	while (len) {
+		n = len > I2C_RDWR_IOCTL_MAX_MSGS ? I2C_RDWR_IOCTL_MAX_MSGS : len;
+		data.msgs = msgs;
+		data.nmsgs = n;
+		if (ioctl(linux_desc->fd, I2C_RDWR, &data) < 0) {
+			printf("%s: Transfer failed\n\r", __func__);
+			return -1;
+		}
+		msgs += n;
+		len -= n;
+	}
+
+	return 0;
+}
+
 /**
  * @brief Initialize the I2C communication peripheral.
  * @param desc - The I2C descriptor.
@@ -82,13 +152,14 @@ int32_t linux_i2c_init(struct no_os_i2c_desc **desc,
 	struct linux_i2c_init_param *linux_init;
 	struct linux_i2c_desc *linux_desc;
 	struct no_os_i2c_desc *descriptor;
+	unsigned long funcs;
 	char path[64];
 
 	descriptor = no_os_malloc(sizeof(*descriptor));
 	if (!descriptor)
 		return -1;
 
-	linux_desc = (struct linux_i2c_desc*) no_os_malloc(sizeof(
+	linux_desc = (struct linux_i2c_desc*) no_os_calloc(1, sizeof(
 				struct linux_i2c_desc));
 	if (!linux_desc)
 		goto free_desc;
@@ -104,6 +175,10 @@ int32_t linux_i2c_init(struct no_os_i2c_desc **desc,
 		goto free;
 	}
 
+	if (!ioctl(linux_desc->fd, I2C_FUNCS, &funcs))
+		linux_desc->rdwr = !!(funcs & I2C_FUNC_I2C);
+	linux_desc->slave_address = -1;
+
 	descriptor->slave_address = param->slave_address;
 
 	*desc = descriptor;
@@ -144,6 +219,8 @@ int32_t linux_i2c_remove(struct no_os_i2c_desc *desc)
 
 /**
  * @brief Write data to a slave device.
+ * The kernel ends every transfer with a stop condition, use
+ * no_os_i2c_transfer() for a write followed by a repeated start.
  * @param desc - The I2C descriptor.
  * @param data - Buffer that stores the transmission data.
  * @param bytes_number - Number of bytes to write.
@@ -158,27 +235,31 @@ int32_t linux_i2c_write(struct no_os_i2c_desc *desc,
 			uint8_t stop_bit)
 {
 	struct linux_i2c_desc *linux_desc;
+	struct i2c_msg msg;
 	int32_t ret;
 
 	linux_desc = desc->extra;
 
-	ret = ioctl(linux_desc->fd, I2C_SLAVE, desc->slave_address);
-	if (ret < 0) {
-		printf("%s: Can't select device\n\r", __func__);
-		return -1;
-	}
+	if (!linux_desc->rdwr) {
+		ret = linux_i2c_select(desc);
+		if (ret)
+			return ret;
 
-	ret = write(linux_desc->fd, data, bytes_number);
-	if (ret < 0) {
-		printf("%s: Can't write to file\n\r", __func__);
-		return -1;
-	}
+		ret = write(linux_desc->fd, data, bytes_number);
+		if (ret < 0) {
+			printf("%s: Can't write to file\n\r", __func__);
+			return -1;
+		}
 
-	if (stop_bit) {
-		// Unused variable - fix compiler warning
+		return 0;
 	}
 
-	return 0;
+	msg.addr = desc->slave_address;
+	msg.flags = 0;
+	msg.len = bytes_number;
+	msg.buf = data;
+
+	return linux_i2c_rdwr(desc, &msg, 1);
 }
 
 /**
@@ -197,29 +278,112 @@ int32_t linux_i2c_read(struct no_os_i2c_desc *desc,
 		       uint8_t stop_bit)
 {
 	struct linux_i2c_desc *linux_desc;
+	struct i2c_msg msg;
 	int32_t ret;
 
 	linux_desc = desc->extra;
 
-	ret = ioctl(linux_desc->fd, I2C_SLAVE, desc->slave_address);
-	if (ret < 0) {
-		printf("%s: Can't select device\n\r", __func__);
-		return -1;
-	}
+	if (!linux_desc->rdwr) {
+		ret = linux_i2c_select(desc);
+		if (ret)
+			return ret;
 
-	ret = read(linux_desc->fd, data, bytes_number);
-	if (ret < 0) {
-		printf("%s: Can't read from file\n\r", __func__);
-		return -1;
+		ret = read(linux_desc->fd, data, bytes_number);
+		if (ret < 0) {
+			printf("%s: Can't read from file\n\r", __func__);
+			return -1;
+		}
+
+		return 0;
 	}
 
-	if (stop_bit) {
-		// Unused variable - fix compiler warning
+	msg.addr = desc->slave_address;
+	msg.flags = I2C_M_RD;
+	msg.len = bytes_number;
+	msg.buf = data;
+
+	return linux_i2c_rdwr(desc, &msg, 1);
+}
+
+/**
+ * @brief Execute the messages one by one with read()/write(), for adapters
+ * without I2C_RDWR support. Each message ends with a stop condition.
+ * @param desc - The I2C descriptor.
+ * @param msgs - Array of messages.
+ * @param len - Number of messages.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_i2c_transfer_split(struct no_os_i2c_desc *desc,
+					struct no_os_i2c_msg *msgs,
+					uint32_t len)
+{
+	struct linux_i2c_desc *linux_desc = desc->extra;
+	ssize_t ret;
+	uint32_t i;
+
+	if (linux_i2c_select(desc))
+		return -EIO;
+
+	for (i = 0; i < len; i++) {
+		if (msgs[i].flags & NO_OS_I2C_M_RD)
+			ret = read(linux_desc->fd, msgs[i].buf, msgs[i].len);
+		else
+			ret = write(linux_desc->fd, msgs[i].buf, msgs[i].len);
+		if (ret != msgs[i].len) {
+			printf("%s: Transfer failed\n\r", __func__);
+			return -EIO;
+		}
 	}
 
 	return 0;
 }
 
+/**
+ * @brief Execute several messages as one combined transaction, with a
+ * single I2C_RDWR ioctl. If the adapter only supports SMBus, the messages
+ * are sent one by one instead, without repeated starts.
+ * @param desc - The I2C descriptor.
+ * @param msgs - Array of messages.
+ * @param len - Number of messages.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_i2c_transfer(struct no_os_i2c_desc *desc,
+			   struct no_os_i2c_msg *msgs,
+			   uint32_t len)
+{
+	struct i2c_msg stack_msgs[LINUX_I2C_STACK_MSGS];
+	struct linux_i2c_desc *linux_desc;
+	struct i2c_msg *kmsgs;
+	uint32_t i;
+	int32_t ret;
+
+	linux_desc = desc->extra;
+
+	if (!linux_desc->rdwr)
+		return linux_i2c_transfer_split(desc, msgs, len);
+
+	if (len <= LINUX_I2C_STACK_MSGS) {
+		kmsgs = stack_msgs;
+	} else {
+		kmsgs = no_os_calloc(len, sizeof(*kmsgs));
+		if (!kmsgs)
+			return -ENOMEM;
+	}
+
+	for (i = 0; i < len; i++) {
+		kmsgs[i].addr = desc->slave_address;
+		kmsgs[i].flags = (msgs[i].flags & NO_OS_I2C_M_RD) ? I2C_M_RD : 0;
+		kmsgs[i].len = msgs[i].len;
+		kmsgs[i].buf = msgs[i].buf;
+	}
+
+	ret = linux_i2c_rdwr(desc, kmsgs, len);
+	if (kmsgs != stack_msgs)
+		no_os_free(kmsgs);
+
+	return ret ? -EIO : 0;
+}
+
 /**
  * @brief Linux platform specific I2C platform ops structure
  */
@@ -227,5 +391,6 @@ const struct no_os_i2c_platform_ops linux_i2c_ops = {
 	.i2c_ops_init = &linux_i2c_init,
 	.i2c_ops_write = &linux_i2c_write,
 	.i2c_ops_read = &linux_i2c_read,
-	.i2c_ops_remove = &linux_i2c_remove
+	.i2c_ops_remove = &linux_i2c_remove,
+	.i2c_ops_transfer = &linux_i2c_transfer
 };
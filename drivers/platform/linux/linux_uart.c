@@ -42,19 +42,75 @@
 /******************************************************************************/
 #include "no_os_error.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
 #include "linux_uart.h"
 
+#include <errno.h>
 #include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <termios.h>
 #include <unistd.h>
+#include <sys/eventfd.h>
 #include <sys/ioctl.h>
 
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define LINUX_UART_DEFAULT_RX_SIZE	65536
+#define LINUX_UART_DEFAULT_TX_SIZE	16384
+/* Time allowed on remove to send the queued data, on top of its line time */
+#define LINUX_UART_REMOVE_MARGIN_MS	1000
+
+/*
+ * Kernel termios2 layout, used to set baud rates without a Bxxx constant.
+ * It can't be taken from <asm/termbits.h>, which clashes with <termios.h>.
+ */
+#if defined(__x86_64__) || defined(__i386__) || defined(__arm__) || \
+	defined(__aarch64__) || defined(__riscv)
+#define LINUX_UART_TERMIOS2
+#define LINUX_UART_BOTHER		0010000
+#define LINUX_UART_CBAUD		0010017
+#define LINUX_UART_KERNEL_NCCS		19
+
+struct linux_uart_termios2 {
+	tcflag_t c_iflag;
+	tcflag_t c_oflag;
+	tcflag_t c_cflag;
+	tcflag_t c_lflag;
+	cc_t c_line;
+	cc_t c_cc[LINUX_UART_KERNEL_NCCS];
+	speed_t c_ispeed;
+	speed_t c_ospeed;
+};
+
+#define LINUX_UART_TCGETS2	_IOR('T', 0x2A, struct linux_uart_termios2)
+#define LINUX_UART_TCSETS2	_IOW('T', 0x2B, struct linux_uart_termios2)
+#endif
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
 
+/**
+ * @struct linux_uart_ring
+ * @brief Byte ring shared between the I/O thread and the API calls
+ */
+struct linux_uart_ring {
+	/** Storage */
+	uint8_t *buf;
+	/** Size of the storage in bytes */
+	uint32_t size;
+	/** Read index */
+	uint32_t head;
+	/** Number of bytes stored */
+	uint32_t used;
+};
+
 /**
  * @struct linux_uart_desc
  * @brief Linux platform specific UART descriptor
@@ -64,12 +120,281 @@ struct linux_uart_desc {
 	int fd;
 	/** structure containing the terminal flags/settings */
 	struct termios *terminal;
+	/** Used to wake up the I/O thread */
+	int event_fd;
+	/** I/O thread moving data between the rings and the device */
+	pthread_t thread;
+	/** Protects the rings */
+	pthread_mutex_t lock;
+	/** Signaled when data is added to the RX ring */
+	pthread_cond_t rx_cond;
+	/** Signaled when data is removed from the TX ring */
+	pthread_cond_t tx_cond;
+	/** Received data not yet read by the application */
+	struct linux_uart_ring rx;
+	/** Data written by the application not yet sent */
+	struct linux_uart_ring tx;
+	/** Blocking read returns the available data instead of waiting */
+	bool asynchronous_rx;
+	/** Cleared to stop the I/O thread */
+	bool running;
+	/** Number of times the RX ring filled up */
+	uint32_t rx_overruns;
+	/** Negative error code once the device failed (e.g. was unplugged) */
+	int error;
 };
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
 
+/**
+ * @brief Copy data into a ring.
+ * @param ring - The ring.
+ * @param data - Data to be copied.
+ * @param len - Maximum number of bytes to copy.
+ * @return Number of bytes copied.
+ */
+static uint32_t linux_uart_ring_put(struct linux_uart_ring *ring,
+				    const uint8_t *data, uint32_t len)
+{
+	uint32_t tail;
+	uint32_t n;
+
+	len = no_os_min(len, ring->size - ring->used);
+	tail = (ring->head + ring->used) % ring->size;
+	n = no_os_min(len, ring->size - tail);
+	memcpy(ring->buf + tail, data, n);
+	memcpy(ring->buf, data + n, len - n);
+	ring->used += len;
+
+	return len;
+}
+
+/**
+ * @brief Copy data out of a ring.
+ * @param ring - The ring.
+ * @param data - Destination buffer.
+ * @param len - Maximum number of bytes to copy.
+ * @return Number of bytes copied.
+ */
+static uint32_t linux_uart_ring_get(struct linux_uart_ring *ring,
+				    uint8_t *data, uint32_t len)
+{
+	uint32_t n;
+
+	len = no_os_min(len, ring->used);
+	n = no_os_min(len, ring->size - ring->head);
+	memcpy(data, ring->buf + ring->head, n);
+	memcpy(data + n, ring->buf, len - n);
+	ring->head = (ring->head + len) % ring->size;
+	ring->used -= len;
+
+	return len;
+}
+
+/**
+ * @brief Wake up the I/O thread.
+ * @param linux_desc - Linux UART descriptor.
+ */
+static void linux_uart_kick(struct linux_uart_desc *linux_desc)
+{
+	uint64_t one = 1;
+
+	if (write(linux_desc->event_fd, &one, sizeof(one)) < 0)
+		printf("%s: Can't wake up the I/O thread\n\r", __func__);
+}
+
+/**
+ * @brief Mark the device as failed and wake up the waiting readers and
+ * writers. The data not yet sent is dropped. Called with the lock held.
+ * @param linux_desc - Linux UART descriptor.
+ * @param error - Negative error code.
+ */
+static void linux_uart_fail(struct linux_uart_desc *linux_desc, int error)
+{
+	if (linux_desc->error)
+		return;
+
+	printf("%s: Device failed (%d)\n\r", __func__, error);
+	linux_desc->error = error;
+	linux_desc->tx.used = 0;
+	pthread_cond_broadcast(&linux_desc->rx_cond);
+	pthread_cond_broadcast(&linux_desc->tx_cond);
+}
+
+/**
+ * @brief Move received data into the RX ring, reading directly into its
+ * free space. Called with the lock held.
+ * @param linux_desc - Linux UART descriptor.
+ */
+static void linux_uart_fill_rx(struct linux_uart_desc *linux_desc)
+{
+	struct linux_uart_ring *ring = &linux_desc->rx;
+	uint32_t tail;
+	uint32_t n;
+	ssize_t ret;
+
+	while (ring->used < ring->size) {
+		tail = (ring->head + ring->used) % ring->size;
+		n = no_os_min(ring->size - ring->used, ring->size - tail);
+		ret = read(linux_desc->fd, ring->buf + tail, n);
+		if (ret < 0 && errno != EAGAIN && errno != EINTR)
+			linux_uart_fail(linux_desc, -errno);
+		if (ret <= 0)
+			return;
+
+		ring->used += ret;
+		pthread_cond_broadcast(&linux_desc->rx_cond);
+		if ((uint32_t)ret < n)
+			return;
+	}
+
+	linux_desc->rx_overruns++;
+}
+
+/**
+ * @brief Send data from the TX ring, writing directly from its storage.
+ * Called with the lock held.
+ * @param linux_desc - Linux UART descriptor.
+ */
+static void linux_uart_drain_tx(struct linux_uart_desc *linux_desc)
+{
+	struct linux_uart_ring *ring = &linux_desc->tx;
+	uint32_t n;
+	ssize_t ret;
+
+	while (ring->used) {
+		n = no_os_min(ring->used, ring->size - ring->head);
+		ret = write(linux_desc->fd, ring->buf + ring->head, n);
+		if (ret < 0 && errno != EAGAIN && errno != EINTR)
+			linux_uart_fail(linux_desc, -errno);
+		if (ret <= 0)
+			return;
+
+		ring->head = (ring->head + ret) % ring->size;
+		ring->used -= ret;
+		pthread_cond_broadcast(&linux_desc->tx_cond);
+	}
+}
+
+/**
+ * @brief I/O thread, moves data between the device and the rings.
+ * Once the device failed, it is no longer polled and the thread only waits
+ * to be stopped.
+ * @param arg - Linux UART descriptor.
+ * @return NULL
+ */
+static void *linux_uart_thread(void *arg)
+{
+	struct linux_uart_desc *linux_desc = arg;
+	struct pollfd pfds[2];
+	uint64_t cnt;
+
+	pfds[0].fd = linux_desc->event_fd;
+	pfds[0].events = POLLIN;
+	pfds[1].fd = linux_desc->fd;
+
+	while (1) {
+		pthread_mutex_lock(&linux_desc->lock);
+		if (!linux_desc->running) {
+			pthread_mutex_unlock(&linux_desc->lock);
+			break;
+		}
+		pfds[1].fd = linux_desc->error ? -1 : linux_desc->fd;
+		pfds[1].events = 0;
+		if (linux_desc->rx.used < linux_desc->rx.size)
+			pfds[1].events |= POLLIN;
+		if (linux_desc->tx.used)
+			pfds[1].events |= POLLOUT;
+		pthread_mutex_unlock(&linux_desc->lock);
+
+		if (poll(pfds, 2, -1) < 0) {
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+
+		if (pfds[0].revents & POLLIN) {
+			if (read(linux_desc->event_fd, &cnt, sizeof(cnt)) < 0)
+				continue;
+		}
+
+		pthread_mutex_lock(&linux_desc->lock);
+		if (pfds[1].revents & POLLIN)
+			linux_uart_fill_rx(linux_desc);
+		if (pfds[1].revents & POLLOUT)
+			linux_uart_drain_tx(linux_desc);
+		if (pfds[1].revents & (POLLHUP | POLLERR | POLLNVAL))
+			linux_uart_fail(linux_desc, -EIO);
+		pthread_mutex_unlock(&linux_desc->lock);
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Get the termios speed constant of a baud rate.
+ * @param baud_rate - The baud rate.
+ * @param speed - The Bxxx constant.
+ * @return 0 in case of success, -EINVAL if there is no constant for the rate.
+ */
+static int linux_uart_speed(uint32_t baud_rate, speed_t *speed)
+{
+	static const struct {
+		uint32_t rate;
+		speed_t speed;
+	} speeds[] = {
+		{50, B50}, {75, B75}, {110, B110}, {134, B134}, {150, B150},
+		{200, B200}, {300, B300}, {600, B600}, {1200, B1200},
+		{1800, B1800}, {2400, B2400}, {4800, B4800}, {9600, B9600},
+		{19200, B19200}, {38400, B38400}, {57600, B57600},
+		{115200, B115200}, {230400, B230400}, {460800, B460800},
+		{500000, B500000}, {576000, B576000}, {921600, B921600},
+		{1000000, B1000000}, {1152000, B1152000}, {1500000, B1500000},
+		{2000000, B2000000}, {2500000, B2500000}, {3000000, B3000000},
+		{3500000, B3500000}, {4000000, B4000000},
+	};
+	uint32_t i;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(speeds); i++) {
+		if (speeds[i].rate == baud_rate) {
+			*speed = speeds[i].speed;
+			return 0;
+		}
+	}
+
+	return -EINVAL;
+}
+
+/**
+ * @brief Set a baud rate that has no Bxxx constant, using termios2.
+ * @param fd - Serial device file descriptor.
+ * @param baud_rate - The baud rate.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int linux_uart_set_custom_speed(int fd, uint32_t baud_rate)
+{
+#ifdef LINUX_UART_TERMIOS2
+	struct linux_uart_termios2 tio;
+
+	if (ioctl(fd, LINUX_UART_TCGETS2, &tio) < 0)
+		return -errno;
+
+	tio.c_cflag &= ~LINUX_UART_CBAUD;
+	tio.c_cflag |= LINUX_UART_BOTHER;
+	tio.c_ispeed = baud_rate;
+	tio.c_ospeed = baud_rate;
+
+	if (ioctl(fd, LINUX_UART_TCSETS2, &tio) < 0)
+		return -errno;
+
+	return 0;
+#else
+	return -EINVAL;
+#endif
+}
+
 /**
  * @brief Initialize the UART communication peripheral.
  * @param desc - The UART descriptor.
@@ -82,15 +407,17 @@ static int32_t linux_uart_init(struct no_os_uart_desc **desc,
 	struct linux_uart_init_param *linux_init;
 	struct linux_uart_desc *linux_desc;
 	struct no_os_uart_desc *descriptor;
+	pthread_condattr_t cond_attr;
+	bool custom_speed = false;
 	speed_t speed;
 	char path[64];
 	int ret;
 
-	descriptor = no_os_malloc(sizeof(*descriptor));
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
 	if (!descriptor)
 		return -ENOMEM;
 
-	linux_desc = (struct linux_uart_desc*) no_os_malloc(sizeof(
+	linux_desc = (struct linux_uart_desc*) no_os_calloc(1, sizeof(
 				struct linux_uart_desc));
 	if (!linux_desc) {
 		ret = -ENOMEM;
@@ -104,74 +431,52 @@ static int32_t linux_uart_init(struct no_os_uart_desc **desc,
 	}
 
 	descriptor->extra = linux_desc;
+	descriptor->device_id = param->device_id;
+	descriptor->baud_rate = param->baud_rate;
 	linux_init = param->extra;
 
+	linux_desc->rx.size = linux_init->rx_buffer_size ?
+			      linux_init->rx_buffer_size :
+			      LINUX_UART_DEFAULT_RX_SIZE;
+	linux_desc->tx.size = linux_init->tx_buffer_size ?
+			      linux_init->tx_buffer_size :
+			      LINUX_UART_DEFAULT_TX_SIZE;
+	linux_desc->asynchronous_rx = param->asynchronous_rx;
+
+	linux_desc->rx.buf = no_os_malloc(linux_desc->rx.size);
+	if (!linux_desc->rx.buf) {
+		ret = -ENOMEM;
+		goto free_terminal;
+	}
+
+	linux_desc->tx.buf = no_os_malloc(linux_desc->tx.size);
+	if (!linux_desc->tx.buf) {
+		ret = -ENOMEM;
+		goto free_rx;
+	}
+
 	ret = snprintf(path, sizeof(path), "/dev/%s", linux_init->device_id);
 	if (ret < 0 || ret >= (int)sizeof(path)) {
 		ret = -ENOMEM;
-		goto free_linux_desc;
+		goto free_tx;
 	}
 
 	linux_desc->fd = open(path, O_RDWR | O_NOCTTY | O_NONBLOCK);
 	if (linux_desc->fd < 0) {
 		printf("%s: Can't open %s\n\r", __func__, path);
 		ret = -ENOENT;
-		goto free_terminal;
+		goto free_tx;
 	}
 
 	tcgetattr(linux_desc->fd, linux_desc->terminal);
 
 	cfmakeraw(linux_desc->terminal);
 
-	switch(param->baud_rate) {
-	case 50:
-		speed = B50;
-		break;
-	case 75:
-		speed = B75;
-		break;
-	case 110:
-		speed = B110;
-		break;
-	case 134:
-		speed = B134;
-		break;
-	case 150:
-		speed = B150;
-		break;
-	case 200:
-		speed = B200;
-		break;
-	case 300:
-		speed = B300;
-		break;
-	case 600:
-		speed = B600;
-		break;
-	case 1200:
-		speed = B1200;
-		break;
-	case 1800:
-		speed = B1800;
-		break;
-	case 2400:
-		speed = B2400;
-		break;
-	case 4800:
-		speed = B4800;
-		break;
-	case 9600:
-		speed = B9600;
-		break;
-	case 19200:
-		speed = B19200;
-		break;
-	case 38400:
+	ret = linux_uart_speed(param->baud_rate, &speed);
+	if (ret) {
+		/* Set a placeholder now, the exact rate is applied below. */
 		speed = B38400;
-		break;
-	default:
-		ret = -EINVAL;
-		goto free;
+		custom_speed = true;
 	}
 	cfsetispeed(linux_desc->terminal, speed);
 	cfsetospeed(linux_desc->terminal, speed);
@@ -220,14 +525,49 @@ static int32_t linux_uart_init(struct no_os_uart_desc **desc,
 
 	tcsetattr(linux_desc->fd, TCSANOW, linux_desc->terminal);
 
+	if (custom_speed) {
+		ret = linux_uart_set_custom_speed(linux_desc->fd,
+						  param->baud_rate);
+		if (ret)
+			goto free;
+	}
+
 	tcflush(linux_desc->fd, TCIOFLUSH);
 
+	linux_desc->event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (linux_desc->event_fd < 0) {
+		ret = -errno;
+		goto free;
+	}
+
+	pthread_mutex_init(&linux_desc->lock, NULL);
+	pthread_cond_init(&linux_desc->rx_cond, NULL);
+	pthread_condattr_init(&cond_attr);
+	pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+	pthread_cond_init(&linux_desc->tx_cond, &cond_attr);
+	pthread_condattr_destroy(&cond_attr);
+	linux_desc->running = true;
+
+	ret = -pthread_create(&linux_desc->thread, NULL, linux_uart_thread,
+			      linux_desc);
+	if (ret)
+		goto free_sync;
+
 	*desc = descriptor;
 
 	return 0;
 
+free_sync:
+	pthread_cond_destroy(&linux_desc->tx_cond);
+	pthread_cond_destroy(&linux_desc->rx_cond);
+	pthread_mutex_destroy(&linux_desc->lock);
+	close(linux_desc->event_fd);
 free:
 	close(linux_desc->fd);
+free_tx:
+	no_os_free(linux_desc->tx.buf);
+free_rx:
+	no_os_free(linux_desc->rx.buf);
 free_terminal:
 	no_os_free(linux_desc->terminal);
 free_linux_desc:
@@ -240,20 +580,56 @@ free_desc:
 
 /**
  * @brief Free the resources allocated by linux_uart_init().
+ * Data still queued for transmission is sent before closing the device. It
+ * is dropped if the device failed or can't send it in its line time plus
+ * LINUX_UART_REMOVE_MARGIN_MS.
  * @param desc - The UART descriptor.
  * @return 0 in case of success, -1 otherwise.
  */
 static int32_t linux_uart_remove(struct no_os_uart_desc *desc)
 {
 	struct linux_uart_desc *linux_desc;
+	struct timespec deadline;
+	uint64_t ms;
+	bool drained;
 	int32_t ret;
 
 	linux_desc = desc->extra;
 
+	pthread_mutex_lock(&linux_desc->lock);
+	/* 10 bits per byte on the line */
+	ms = (uint64_t)linux_desc->tx.used * 10000 /
+	     no_os_max(desc->baud_rate, 1U) + LINUX_UART_REMOVE_MARGIN_MS;
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+	deadline.tv_nsec += ms % 1000 * 1000000;
+	deadline.tv_sec += ms / 1000 + deadline.tv_nsec / 1000000000;
+	deadline.tv_nsec %= 1000000000;
+	while (linux_desc->tx.used)
+		if (pthread_cond_timedwait(&linux_desc->tx_cond, &linux_desc->lock,
+					   &deadline) == ETIMEDOUT)
+			break;
+	drained = !linux_desc->tx.used && !linux_desc->error;
+	linux_desc->running = false;
+	linux_uart_kick(linux_desc);
+	pthread_mutex_unlock(&linux_desc->lock);
+	pthread_join(linux_desc->thread, NULL);
+
+	if (drained)
+		tcdrain(linux_desc->fd);
+	else
+		tcflush(linux_desc->fd, TCOFLUSH);
+
 	ret = close(linux_desc->fd);
 	if (ret < 0)
 		printf("%s: Can't close device\n\r", __func__);
 
+	pthread_cond_destroy(&linux_desc->tx_cond);
+	pthread_cond_destroy(&linux_desc->rx_cond);
+	pthread_mutex_destroy(&linux_desc->lock);
+	close(linux_desc->event_fd);
+	no_os_free(linux_desc->tx.buf);
+	no_os_free(linux_desc->rx.buf);
+	no_os_free(linux_desc->terminal);
 	no_os_free(desc->extra);
 	no_os_free(desc);
 
@@ -261,11 +637,12 @@ static int32_t linux_uart_remove(struct no_os_uart_desc *desc)
 };
 
 /**
- * @brief Write data to UART device.
+ * @brief Write data to UART device. The data is queued in the TX ring,
+ * waiting only while the ring is full.
  * @param desc - Instance of UART.
  * @param data - Pointer to buffer containing data.
- * @param bytes_number - Number of bytes to read.
- * @return 0 in case of success, -1 otherwise.
+ * @param bytes_number - Number of bytes to write.
+ * @return Number of bytes written, negative error code if the device failed.
  */
 static int32_t linux_uart_write(struct no_os_uart_desc *desc,
 				const uint8_t *data,
@@ -273,44 +650,154 @@ static int32_t linux_uart_write(struct no_os_uart_desc *desc,
 {
 	struct linux_uart_desc *linux_desc;
 	uint32_t count = 0;
-	int32_t ret;
 
 	linux_desc = desc->extra;
 
+	pthread_mutex_lock(&linux_desc->lock);
 	while (count < bytes_number) {
-		ret = write(linux_desc->fd, data, bytes_number);
-		if (ret > 0)
-			count += ret;
+		while (linux_desc->tx.used == linux_desc->tx.size &&
+		       !linux_desc->error)
+			pthread_cond_wait(&linux_desc->tx_cond, &linux_desc->lock);
+		if (linux_desc->error) {
+			pthread_mutex_unlock(&linux_desc->lock);
+			return linux_desc->error;
+		}
+
+		count += linux_uart_ring_put(&linux_desc->tx, data + count,
+					     bytes_number - count);
+		linux_uart_kick(linux_desc);
 	}
+	pthread_mutex_unlock(&linux_desc->lock);
 
-	return 0;
+	return bytes_number;
 };
 
 /**
  * @brief Read data from UART device.
+ * If the UART was initialized with asynchronous_rx, the data already received
+ * is returned without waiting, otherwise the call waits for all the bytes.
  * @param desc - Instance of UART.
  * @param data - Pointer to buffer containing data.
  * @param bytes_number - Number of bytes to read.
- * @return 0 in case of success, -1 otherwise.
+ * @return Number of bytes read, -EAGAIN if asynchronous_rx is set and no data
+ * is available, negative error code if the device failed and no received data
+ * is left.
  */
 static int32_t linux_uart_read(struct no_os_uart_desc *desc, uint8_t *data,
 			       uint32_t bytes_number)
 {
 	struct linux_uart_desc *linux_desc;
+	bool was_full;
 	uint32_t count = 0;
-	int ret;
 
 	linux_desc = desc->extra;
 
+	pthread_mutex_lock(&linux_desc->lock);
 	while (count < bytes_number) {
-		ret = read(linux_desc->fd, &data[count], bytes_number - count);
-		if (ret > 0)
-			count += ret;
+		if (!linux_desc->rx.used) {
+			if (linux_desc->asynchronous_rx || linux_desc->error)
+				break;
+			pthread_cond_wait(&linux_desc->rx_cond, &linux_desc->lock);
+			continue;
+		}
+
+		was_full = linux_desc->rx.used == linux_desc->rx.size;
+		count += linux_uart_ring_get(&linux_desc->rx, data + count,
+					     bytes_number - count);
+		if (was_full)
+			linux_uart_kick(linux_desc);
 	}
+	pthread_mutex_unlock(&linux_desc->lock);
 
-	return 0;
+	if (count || !bytes_number)
+		return count;
+
+	return linux_desc->error ? linux_desc->error : -EAGAIN;
 };
 
+/**
+ * @brief Read the data already received, without waiting.
+ * @param desc - Instance of UART.
+ * @param data - Pointer to buffer containing data.
+ * @param bytes_number - Maximum number of bytes to read.
+ * @return Number of bytes read, 0 if no data is available, negative error
+ * code if the device failed and no received data is left.
+ */
+static int32_t linux_uart_read_nonblocking(struct no_os_uart_desc *desc,
+		uint8_t *data,
+		uint32_t bytes_number)
+{
+	struct linux_uart_desc *linux_desc;
+	uint32_t count;
+	bool was_full;
+
+	linux_desc = desc->extra;
+
+	pthread_mutex_lock(&linux_desc->lock);
+	was_full = linux_desc->rx.used == linux_desc->rx.size;
+	count = linux_uart_ring_get(&linux_desc->rx, data, bytes_number);
+	if (was_full && count)
+		linux_uart_kick(linux_desc);
+	pthread_mutex_unlock(&linux_desc->lock);
+
+	if (!count && bytes_number && linux_desc->error)
+		return linux_desc->error;
+
+	return count;
+};
+
+/**
+ * @brief Queue data for transmission, without waiting.
+ * @param desc - Instance of UART.
+ * @param data - Pointer to buffer containing data.
+ * @param bytes_number - Number of bytes to write.
+ * @return Number of bytes queued, less than bytes_number if the TX ring is
+ * full, negative error code if the device failed.
+ */
+static int32_t linux_uart_write_nonblocking(struct no_os_uart_desc *desc,
+		const uint8_t *data,
+		uint32_t bytes_number)
+{
+	struct linux_uart_desc *linux_desc;
+	uint32_t count;
+
+	linux_desc = desc->extra;
+
+	pthread_mutex_lock(&linux_desc->lock);
+	if (linux_desc->error) {
+		pthread_mutex_unlock(&linux_desc->lock);
+		return linux_desc->error;
+	}
+	count = linux_uart_ring_put(&linux_desc->tx, data, bytes_number);
+	if (count)
+		linux_uart_kick(linux_desc);
+	pthread_mutex_unlock(&linux_desc->lock);
+
+	return count;
+};
+
+/**
+ * @brief Get the number of RX overruns, i.e. times the RX ring filled up and
+ * reception was paused until the application read data. Reading clears the
+ * counter.
+ * @param desc - Instance of UART.
+ * @return Number of overruns.
+ */
+static uint32_t linux_uart_get_errors(struct no_os_uart_desc *desc)
+{
+	struct linux_uart_desc *linux_desc;
+	uint32_t errors;
+
+	linux_desc = desc->extra;
+
+	pthread_mutex_lock(&linux_desc->lock);
+	errors = linux_desc->rx_overruns;
+	linux_desc->rx_overruns = 0;
+	pthread_mutex_unlock(&linux_desc->lock);
+
+	return errors;
+}
+
 /**
  * @brief Linux platform specific UART platform ops structure
  */
@@ -318,5 +805,8 @@ const struct no_os_uart_platform_ops linux_uart_ops = {
 	.init = &linux_uart_init,
 	.read = &linux_uart_read,
 	.write = &linux_uart_write,
-	.remove = &linux_uart_remove
+	.read_nonblocking = &linux_uart_read_nonblocking,
+	.write_nonblocking = &linux_uart_write_nonblocking,
+	.remove = &linux_uart_remove,
+	.get_errors = &linux_uart_get_errors
 };
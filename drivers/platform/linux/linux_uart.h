@@ -49,6 +49,10 @@
 struct linux_uart_init_param {
 	/** UART device ID (/dev/"device_id") */
 	const char *device_id;
+	/** Size of the RX ring in bytes, 0 selects the default (64 KiB) */
+	uint32_t rx_buffer_size;
+	/** Size of the TX ring in bytes, 0 selects the default (16 KiB) */
+	uint32_t tx_buffer_size;
 };
 
 /**
@@ -77,6 +77,21 @@ void no_os_mdelay(uint32_t msecs)
 		thread_sleep_for(msecs);
 }
 
+/**
+ * @brief Get current time.
+ * @return Current time structure from system start (seconds, microseconds).
+ */
+struct no_os_time no_os_get_time(void)
+{
+	us_timestamp_t us = ticker_read_us(get_us_ticker_data());
+	struct no_os_time t;
+
+	t.s = us / 1000000;
+	t.us = us % 1000000;
+
+	return t;
+}
+
 #ifdef __cplusplus  // Closing extern c
 }
 #endif //  _cplusplus
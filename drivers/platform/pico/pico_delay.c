@@ -67,3 +67,18 @@ void no_os_mdelay(uint32_t msecs)
 {
 	sleep_ms(msecs);
 }
+
+/**
+ * @brief Get current time.
+ * @return Current time structure from system start (seconds, microseconds).
+ */
+struct no_os_time no_os_get_time(void)
+{
+	uint64_t us = time_us_64();
+	struct no_os_time t;
+
+	t.s = us / 1000000;
+	t.us = us % 1000000;
+
+	return t;
+}
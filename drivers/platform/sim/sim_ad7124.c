@@ -0,0 +1,281 @@
+/***************************************************************************//**
+ *   @file   sim/sim_ad7124.c
+ *   @brief  Register-level model of the AD7124-4/AD7124-8.
+********************************************************************************
+ * Copyright 2023(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <string.h>
+#include "sim_models.h"
+#include "ad7124.h"
+#include "no_os_alloc.h"
+#include "no_os_crc8.h"
+#include "no_os_error.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define SIM_AD7124_NB_REGS	(AD7124_GAIN7_REG + 1)
+#define SIM_AD7124_NB_CH	16
+#define SIM_AD7124_MCLK_CNT_REG	0x08
+/* The serial interface resets after 64 consecutive ones on DIN */
+#define SIM_AD7124_RESET_BYTES	8
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct sim_ad7124
+ * @brief AD7124 model state.
+ */
+struct sim_ad7124 {
+	struct sim_ad7124_param param;
+	uint32_t regs[SIM_AD7124_NB_REGS];
+	/** Consecutive 0xFF bytes seen on DIN */
+	uint32_t ones;
+	/** Channel converted last */
+	uint32_t channel;
+	/** Free running counter for the default ramp */
+	uint32_t ramp;
+};
+
+/******************************************************************************/
+/************************ Variable Declarations *******************************/
+/******************************************************************************/
+
+NO_OS_DECLARE_CRC8_TABLE(sim_ad7124_crc);
+
+/** Register sizes in bytes */
+static const uint8_t sim_ad7124_size[SIM_AD7124_NB_REGS] = {
+	1, 2, 3, 3, 2, 1, 3, 3, 1,
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+	2, 2, 2, 2, 2, 2, 2, 2,
+	3, 3, 3, 3, 3, 3, 3, 3,
+	3, 3, 3, 3, 3, 3, 3, 3,
+	3, 3, 3, 3, 3, 3, 3, 3,
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Bring the register file to its power-on state.
+ * @param st - Model state.
+ */
+static void sim_ad7124_reset(struct sim_ad7124 *st)
+{
+	uint32_t i;
+
+	memset(st->regs, 0, sizeof(st->regs));
+	st->regs[AD7124_STATUS_REG] = AD7124_STATUS_REG_POR_FLAG;
+	st->regs[AD7124_ID_REG] = st->param.id;
+	st->regs[AD7124_ERREN_REG] = 0x000040;
+	for (i = 0; i < SIM_AD7124_NB_CH; i++)
+		st->regs[AD7124_CH0_MAP_REG + i] = 0x0001;
+	st->regs[AD7124_CH0_MAP_REG] |= AD7124_CH_MAP_REG_CH_ENABLE;
+	for (i = 0; i < 8; i++) {
+		st->regs[AD7124_CFG0_REG + i] = 0x0860;
+		st->regs[AD7124_FILT0_REG + i] = 0x060180;
+		st->regs[AD7124_OFFS0_REG + i] = 0x800000;
+		st->regs[AD7124_GAIN0_REG + i] = 0x500000;
+	}
+	st->channel = 0;
+}
+
+/**
+ * @brief Produce the next conversion, cycling through the enabled channels.
+ * @param st - Model state.
+ * @return The 24-bit conversion result.
+ */
+static uint32_t sim_ad7124_convert(struct sim_ad7124 *st)
+{
+	uint32_t ch = st->channel;
+	uint32_t i;
+
+	for (i = 1; i <= SIM_AD7124_NB_CH; i++) {
+		ch = (st->channel + i) % SIM_AD7124_NB_CH;
+		if (st->regs[AD7124_CH0_MAP_REG + ch] & AD7124_CH_MAP_REG_CH_ENABLE)
+			break;
+	}
+	st->channel = ch;
+
+	st->regs[AD7124_STATUS_REG] &= ~AD7124_STATUS_REG_CH_ACTIVE(0xF);
+	st->regs[AD7124_STATUS_REG] |= AD7124_STATUS_REG_CH_ACTIVE(ch);
+
+	if (st->param.sample)
+		return st->param.sample(st->param.ctx, ch) & 0xFFFFFF;
+
+	return (0x800000 + (ch << 16) + (st->ramp++ & 0xFFFF)) & 0xFFFFFF;
+}
+
+/**
+ * @brief Model state allocation.
+ * @param priv - Model state.
+ * @param param - struct sim_ad7124_param, NULL for an AD7124-4.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int sim_ad7124_init(void **priv, const void *param)
+{
+	struct sim_ad7124 *st;
+
+	st = no_os_calloc(1, sizeof(*st));
+	if (!st)
+		return -ENOMEM;
+
+	if (param)
+		st->param = *(const struct sim_ad7124_param *)param;
+	if (!st->param.id)
+		st->param.id = AD7124_4_ID;
+
+	no_os_crc8_populate_msb(sim_ad7124_crc,
+				AD7124_CRC8_POLYNOMIAL_REPRESENTATION);
+	sim_ad7124_reset(st);
+	*priv = st;
+
+	return 0;
+}
+
+/**
+ * @brief Serve one SPI frame.
+ * @param priv - Model state.
+ * @param tx - Bytes on DIN.
+ * @param rx - Bytes on DOUT.
+ * @param len - Frame length.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int sim_ad7124_spi_xfer(void *priv, const uint8_t *tx, uint8_t *rx,
+			       uint32_t len)
+{
+	struct sim_ad7124 *st = priv;
+	uint8_t frame[8];
+	bool crc_en;
+	uint32_t value;
+	uint32_t addr;
+	uint32_t size;
+	uint32_t i;
+	uint32_t n;
+
+	for (i = 0; i < len && tx[i] == 0xFF; i++)
+		;
+	if (i == len) {
+		st->ones += len;
+		if (st->ones >= SIM_AD7124_RESET_BYTES) {
+			sim_ad7124_reset(st);
+			st->ones = 0;
+		}
+		return 0;
+	}
+	st->ones = 0;
+
+	addr = AD7124_COMM_REG_RA(tx[0]);
+	if (addr >= SIM_AD7124_NB_REGS)
+		return 0;
+
+	size = sim_ad7124_size[addr];
+	crc_en = st->regs[AD7124_ERREN_REG] & AD7124_ERREN_REG_SPI_CRC_ERR_EN;
+
+	if (!(tx[0] & AD7124_COMM_REG_RD)) {
+		if (len < size + 1)
+			return 0;
+		if (crc_en && (len < size + 2 ||
+			       no_os_crc8(sim_ad7124_crc, tx, size + 2, 0))) {
+			st->regs[AD7124_ERR_REG] |= AD7124_ERR_REG_SPI_CRC_ERR;
+			return 0;
+		}
+
+		/* Status, data, ID, error and MCLK count are read only */
+		if (addr == AD7124_STATUS_REG || addr == AD7124_DATA_REG ||
+		    addr == AD7124_ID_REG || addr == AD7124_ERR_REG ||
+		    addr == SIM_AD7124_MCLK_CNT_REG)
+			return 0;
+
+		for (value = 0, i = 1; i <= size; i++)
+			value = (value << 8) | tx[i];
+		st->regs[addr] = value;
+
+		return 0;
+	}
+
+	if (addr == AD7124_DATA_REG)
+		st->regs[AD7124_DATA_REG] = sim_ad7124_convert(st);
+	value = st->regs[addr];
+
+	/* Build command + data (+ status) (+ CRC) the way the part shifts it out */
+	n = 0;
+	frame[n++] = tx[0];
+	for (i = size; i > 0; i--)
+		frame[n++] = value >> (8 * (i - 1));
+	if (addr == AD7124_DATA_REG &&
+	    (st->regs[AD7124_ADC_CTRL_REG] & AD7124_ADC_CTRL_REG_DATA_STATUS))
+		frame[n++] = st->regs[AD7124_STATUS_REG];
+	if (crc_en) {
+		frame[n] = no_os_crc8(sim_ad7124_crc, frame, n, 0);
+		n++;
+	}
+
+	rx[0] = 0;
+	memcpy(&rx[1], &frame[1], no_os_min(n - 1, len - 1));
+
+	/* Reading the status register clears the power-on flag */
+	if (addr == AD7124_STATUS_REG)
+		st->regs[AD7124_STATUS_REG] &= ~AD7124_STATUS_REG_POR_FLAG;
+
+	return 0;
+}
+
+/**
+ * @brief Free the model state.
+ * @param priv - Model state.
+ */
+static void sim_ad7124_remove(void *priv)
+{
+	no_os_free(priv);
+}
+
+/**
+ * @brief AD7124 model.
+ */
+const struct sim_device_model sim_ad7124_model = {
+	.name = "ad7124",
+	.init = sim_ad7124_init,
+	.spi_xfer = sim_ad7124_spi_xfer,
+	.remove = sim_ad7124_remove,
+};
@@ -0,0 +1,275 @@
+/***************************************************************************//**
+ *   @file   sim/sim_ad74413r.c
+ *   @brief  Register-level model of the AD74413R.
+********************************************************************************
+ * Copyright 2023(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <string.h>
+#include "sim_models.h"
+#include "ad74413r.h"
+#include "no_os_alloc.h"
+#include "no_os_crc8.h"
+#include "no_os_error.h"
+#include "no_os_util.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define SIM_AD74413R_NB_REGS		(AD74413R_SILICON_REV + 1)
+#define SIM_AD74413R_FRAME_SIZE		4
+#define SIM_AD74413R_CRC_POLY		0x07
+#define SIM_AD74413R_ALERT_FLAG		NO_OS_BIT(7)
+#define SIM_AD74413R_RESET_OCCURRED	NO_OS_BIT(15)
+#define SIM_AD74413R_ADC_DATA_RDY	NO_OS_BIT(14)
+#define SIM_AD74413R_READBACK_MASK	NO_OS_GENMASK(7, 0)
+#define SIM_AD74413R_AUTO_RD_EN		NO_OS_BIT(9)
+#define SIM_AD74413R_SILICON_REV	0x0008
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct sim_ad74413r
+ * @brief AD74413R model state.
+ */
+struct sim_ad74413r {
+	struct sim_ad74413r_param param;
+	uint16_t regs[SIM_AD74413R_NB_REGS];
+	/** CMD_KEY value of the previous write, for two-step commands */
+	uint16_t last_key;
+	/** Frame shifted out on SDO during the next frame */
+	uint8_t sdo[SIM_AD74413R_FRAME_SIZE];
+	/** Free running counter for the default ramp */
+	uint32_t ramp;
+};
+
+/******************************************************************************/
+/************************ Variable Declarations *******************************/
+/******************************************************************************/
+
+NO_OS_DECLARE_CRC8_TABLE(sim_ad74413r_crc);
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Bring the register file to its power-on state.
+ * @param st - Model state.
+ */
+static void sim_ad74413r_reset(struct sim_ad74413r *st)
+{
+	memset(st->regs, 0, sizeof(st->regs));
+	st->regs[AD74413R_ALERT_STATUS] = SIM_AD74413R_RESET_OCCURRED;
+	st->regs[AD74413R_LIVE_STATUS] = SIM_AD74413R_ADC_DATA_RDY;
+	st->regs[AD74413R_SILICON_REV] = SIM_AD74413R_SILICON_REV;
+	st->last_key = 0;
+}
+
+/**
+ * @brief Read one register, with the side effects of the access.
+ * @param st - Model state.
+ * @param addr - Register address.
+ * @return Register value.
+ */
+static uint16_t sim_ad74413r_reg_read(struct sim_ad74413r *st, uint8_t addr)
+{
+	uint32_t ch;
+
+	if (addr >= SIM_AD74413R_NB_REGS)
+		return 0;
+
+	if (addr >= AD74413R_ADC_RESULT(0) &&
+	    addr <= AD74413R_DIAG_RESULT(AD74413R_N_DIAG_CHANNELS - 1)) {
+		ch = addr - AD74413R_ADC_RESULT(0);
+		if (st->param.sample)
+			st->regs[addr] = st->param.sample(st->param.ctx, ch);
+		else
+			st->regs[addr] = (ch << 12) + (st->ramp++ & 0xFFF);
+	}
+
+	return st->regs[addr];
+}
+
+/**
+ * @brief Write one register, with the side effects of the access.
+ * @param st - Model state.
+ * @param addr - Register address.
+ * @param val - Register value.
+ */
+static void sim_ad74413r_reg_write(struct sim_ad74413r *st, uint8_t addr,
+				   uint16_t val)
+{
+	if (addr == AD74413R_NOP || addr >= SIM_AD74413R_NB_REGS)
+		return;
+
+	switch (addr) {
+	case AD74413R_ALERT_STATUS:
+		/* Write 1 to clear */
+		st->regs[addr] &= ~val;
+		return;
+	case AD74413R_CMD_KEY:
+		if (st->last_key == AD74413R_CMD_KEY_RESET_1 &&
+		    val == AD74413R_CMD_KEY_RESET_2) {
+			sim_ad74413r_reset(st);
+			return;
+		}
+		st->last_key = val;
+		return;
+	case AD74413R_LIVE_STATUS:
+	case AD74413R_SILICON_REV:
+	case AD74413R_DIN_COMP_OUT:
+		return;
+	default:
+		break;
+	}
+
+	if (addr >= AD74413R_ADC_RESULT(0) &&
+	    addr <= AD74413R_DIAG_RESULT(AD74413R_N_DIAG_CHANNELS - 1))
+		return;
+
+	st->regs[addr] = val;
+}
+
+/**
+ * @brief Prepare the readback frame for the register selected by READ_SELECT.
+ * @param st - Model state.
+ */
+static void sim_ad74413r_load_sdo(struct sim_ad74413r *st)
+{
+	uint16_t sel = st->regs[AD74413R_READ_SELECT];
+	uint8_t addr = no_os_field_get(SIM_AD74413R_READBACK_MASK, sel);
+	uint16_t val;
+
+	val = sim_ad74413r_reg_read(st, addr);
+
+	if (sel & AD74413R_SPI_RD_RET_INFO_MASK)
+		st->sdo[0] = (st->regs[AD74413R_LIVE_STATUS] >> 8) & 0x7F;
+	else
+		st->sdo[0] = addr & 0x7F;
+	if (st->regs[AD74413R_ALERT_STATUS])
+		st->sdo[0] |= SIM_AD74413R_ALERT_FLAG;
+	no_os_put_unaligned_be16(val, &st->sdo[1]);
+	st->sdo[3] = no_os_crc8(sim_ad74413r_crc, st->sdo, 3, 0);
+
+	/* Auto read advances to the next register for the following frame */
+	if (sel & SIM_AD74413R_AUTO_RD_EN)
+		st->regs[AD74413R_READ_SELECT] =
+			(sel & ~SIM_AD74413R_READBACK_MASK) | ((addr + 1) & 0xFF);
+}
+
+/**
+ * @brief Model state allocation.
+ * @param priv - Model state.
+ * @param param - struct sim_ad74413r_param (may be NULL).
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int sim_ad74413r_init(void **priv, const void *param)
+{
+	struct sim_ad74413r *st;
+
+	st = no_os_calloc(1, sizeof(*st));
+	if (!st)
+		return -ENOMEM;
+
+	if (param)
+		st->param = *(const struct sim_ad74413r_param *)param;
+
+	no_os_crc8_populate_msb(sim_ad74413r_crc, SIM_AD74413R_CRC_POLY);
+	sim_ad74413r_reset(st);
+	sim_ad74413r_load_sdo(st);
+	*priv = st;
+
+	return 0;
+}
+
+/**
+ * @brief Serve one SPI frame. Every 32-bit word shifts in a CRC protected
+ * write and shifts out the readback prepared by the previous word.
+ * @param priv - Model state.
+ * @param tx - Bytes on SDI.
+ * @param rx - Bytes on SDO.
+ * @param len - Frame length.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int sim_ad74413r_spi_xfer(void *priv, const uint8_t *tx, uint8_t *rx,
+				 uint32_t len)
+{
+	struct sim_ad74413r *st = priv;
+	const uint8_t *word;
+	uint32_t i;
+
+	for (i = 0; i + SIM_AD74413R_FRAME_SIZE <= len;
+	     i += SIM_AD74413R_FRAME_SIZE) {
+		word = &tx[i];
+		memcpy(&rx[i], st->sdo, SIM_AD74413R_FRAME_SIZE);
+
+		if (no_os_crc8(sim_ad74413r_crc, word, 3, 0) != word[3]) {
+			st->regs[AD74413R_ALERT_STATUS] |= AD74413R_SPI_CRC_ERR_MASK;
+			continue;
+		}
+
+		sim_ad74413r_reg_write(st, word[0],
+				       no_os_get_unaligned_be16((uint8_t *)&word[1]));
+		sim_ad74413r_load_sdo(st);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Free the model state.
+ * @param priv - Model state.
+ */
+static void sim_ad74413r_remove(void *priv)
+{
+	no_os_free(priv);
+}
+
+/**
+ * @brief AD74413R model.
+ */
+const struct sim_device_model sim_ad74413r_model = {
+	.name = "ad74413r",
+	.init = sim_ad74413r_init,
+	.spi_xfer = sim_ad74413r_spi_xfer,
+	.remove = sim_ad74413r_remove,
+};
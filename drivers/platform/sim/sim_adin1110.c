@@ -0,0 +1,463 @@
+/***************************************************************************//**
+ *   @file   sim/sim_adin1110.c
+ *   @brief  Register-level model of the ADIN1110/ADIN2111 MAC-PHY.
+********************************************************************************
+ * Copyright 2023(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <string.h>
+#include "sim_models.h"
+#include "adin1110.h"
+#include "no_os_alloc.h"
+#include "no_os_crc8.h"
+#include "no_os_error.h"
+#include "no_os_util.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define SIM_ADIN1110_NB_REGS		0x100
+#define SIM_ADIN1110_CRC_POLY		0x07
+/* TX FIFO space in 16-bit words reported while the FIFO is empty */
+#define SIM_ADIN1110_TX_SPACE		0x0FFF
+#define SIM_ADIN1110_RX_DEPTH		4
+#define SIM_ADIN1110_MDIO_REGS		16
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct sim_adin1110_frame
+ * @brief Frame held in an RX FIFO, including the 2 byte frame header.
+ */
+struct sim_adin1110_frame {
+	uint8_t data[ADIN1110_BUFF_LEN];
+	uint32_t len;
+};
+
+/**
+ * @struct sim_adin1110_rx_fifo
+ * @brief Per port RX FIFO.
+ */
+struct sim_adin1110_rx_fifo {
+	struct sim_adin1110_frame frames[SIM_ADIN1110_RX_DEPTH];
+	uint32_t head;
+	uint32_t count;
+};
+
+/**
+ * @struct sim_adin1110_mmd
+ * @brief PHY (clause 45) register written by the host.
+ */
+struct sim_adin1110_mmd {
+	uint32_t key;
+	uint16_t val;
+};
+
+/**
+ * @struct sim_adin1110
+ * @brief ADIN1110 model state.
+ */
+struct sim_adin1110 {
+	struct sim_adin1110_param param;
+	uint32_t regs[SIM_ADIN1110_NB_REGS];
+	/** Previous SOFT_RST key, for two-step sequences */
+	uint32_t last_key;
+	/** Clause 45 address latched by an MDIO address operation */
+	uint32_t mmd_addr;
+	struct sim_adin1110_mmd mmd[SIM_ADIN1110_MDIO_REGS];
+	uint32_t nb_mmd;
+	struct sim_adin1110_rx_fifo rx[ADIN2111_PORTS];
+};
+
+/******************************************************************************/
+/************************ Variable Declarations *******************************/
+/******************************************************************************/
+
+NO_OS_DECLARE_CRC8_TABLE(sim_adin1110_crc);
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Bring the MAC to its power-on state.
+ * @param st - Model state.
+ */
+static void sim_adin1110_reset(struct sim_adin1110 *st)
+{
+	memset(st->regs, 0, sizeof(st->regs));
+	memset(st->rx, 0, sizeof(st->rx));
+	st->regs[ADIN1110_PHY_ID_REG] = st->param.phy_id;
+	st->regs[ADIN1110_STATUS0_REG] = ADIN1110_RESETC_MASK;
+	st->regs[ADIN1110_TX_SPACE_REG] = SIM_ADIN1110_TX_SPACE;
+	st->last_key = 0;
+	st->nb_mmd = 0;
+}
+
+/**
+ * @brief Number of ports of the modelled part.
+ * @param st - Model state.
+ * @return 1 for ADIN1110, 2 for ADIN2111.
+ */
+static uint32_t sim_adin1110_ports(struct sim_adin1110 *st)
+{
+	return st->param.phy_id == ADIN2111_PHY_ID ? ADIN2111_PORTS :
+	       ADIN1110_PORTS;
+}
+
+/**
+ * @brief Execute an MDIO transaction written to an MDIOACC register.
+ * @param st - Model state.
+ * @param val - MDIOACC value written by the host.
+ * @return The MDIOACC value with the transaction completed.
+ */
+static uint32_t sim_adin1110_mdio(struct sim_adin1110 *st, uint32_t val)
+{
+	uint32_t op = no_os_field_get(ADIN1110_MDIO_OP, val);
+	uint32_t key;
+	uint16_t data = 0;
+	uint32_t i;
+
+	key = val & (ADIN1110_MDIO_PRTAD | ADIN1110_MDIO_DEVAD);
+	if (no_os_field_get(ADIN1110_MDIO_ST, val))
+		/* Clause 22: the register number is carried in DEVAD */
+		key |= NO_OS_BIT(31);
+	else
+		key |= st->mmd_addr;
+
+	switch (op) {
+	case ADIN1110_MDIO_OP_ADDR:
+		st->mmd_addr = no_os_field_get(ADIN1110_MDIO_DATA, val);
+		break;
+	case ADIN1110_MDIO_OP_WR:
+		data = no_os_field_get(ADIN1110_MDIO_DATA, val);
+		for (i = 0; i < st->nb_mmd && st->mmd[i].key != key; i++)
+			;
+		if (i == st->nb_mmd) {
+			if (i == SIM_ADIN1110_MDIO_REGS)
+				break;
+			st->nb_mmd++;
+		}
+		st->mmd[i].key = key;
+		st->mmd[i].val = data;
+		break;
+	case ADIN1110_MDIO_OP_RD:
+		for (i = 0; i < st->nb_mmd; i++)
+			if (st->mmd[i].key == key)
+				data = st->mmd[i].val;
+		break;
+	default:
+		break;
+	}
+
+	val &= ~ADIN1110_MDIO_DATA;
+	val |= no_os_field_prep(ADIN1110_MDIO_DATA, data);
+
+	return val | ADIN1110_MDIO_TRDONE;
+}
+
+/**
+ * @brief Read one MAC register.
+ * @param st - Model state.
+ * @param addr - Register address.
+ * @return Register value.
+ */
+static uint32_t sim_adin1110_reg_read(struct sim_adin1110 *st, uint32_t addr)
+{
+	uint32_t val;
+
+	if (addr >= SIM_ADIN1110_NB_REGS)
+		return 0;
+
+	switch (addr) {
+	case ADIN1110_STATUS1_REG:
+		val = st->regs[addr] | ADIN1110_LINK_STATE_MASK;
+		if (st->rx[0].count)
+			val |= ADIN1110_RX_RDY;
+		if (st->rx[1].count)
+			val |= ADIN2111_P2_RX_RDY;
+		return val;
+	case ADIN1110_RX_FSIZE_REG:
+		return st->rx[0].count ?
+		       st->rx[0].frames[st->rx[0].head].len : 0;
+	case ADIN2111_RX_P2_FSIZE_REG:
+		return st->rx[1].count ?
+		       st->rx[1].frames[st->rx[1].head].len : 0;
+	default:
+		return st->regs[addr];
+	}
+}
+
+/**
+ * @brief Write one MAC register.
+ * @param st - Model state.
+ * @param addr - Register address.
+ * @param val - Register value.
+ */
+static void sim_adin1110_reg_write(struct sim_adin1110 *st, uint32_t addr,
+				   uint32_t val)
+{
+	if (addr >= SIM_ADIN1110_NB_REGS)
+		return;
+
+	switch (addr) {
+	case ADIN1110_PHY_ID_REG:
+	case ADIN1110_TX_SPACE_REG:
+	case ADIN1110_MAC_RST_STATUS_REG:
+	case ADIN1110_RX_FSIZE_REG:
+	case ADIN2111_RX_P2_FSIZE_REG:
+		return;
+	case ADIN1110_RESET_REG:
+		if (val & ADIN1110_SWRESET)
+			sim_adin1110_reset(st);
+		return;
+	case ADIN1110_SOFT_RST_REG:
+		if (st->last_key == ADIN1110_SWRESET_KEY1 &&
+		    val == ADIN1110_SWRESET_KEY2)
+			st->regs[ADIN1110_MAC_RST_STATUS_REG] = 0;
+		if (st->last_key == ADIN1110_SWRELEASE_KEY1 &&
+		    val == ADIN1110_SWRELEASE_KEY2)
+			st->regs[ADIN1110_MAC_RST_STATUS_REG] = 1;
+		st->last_key = val;
+		return;
+	case ADIN1110_STATUS0_REG:
+	case ADIN1110_STATUS1_REG:
+		/* Write 1 to clear */
+		st->regs[addr] &= ~val;
+		return;
+	case ADIN1110_FIFO_CLR_REG:
+		if (val & ADIN1110_FIFO_CLR_RX_MASK)
+			memset(st->rx, 0, sizeof(st->rx));
+		return;
+	case ADIN1110_MDIOACC(0):
+	case ADIN1110_MDIOACC(1):
+		st->regs[addr] = sim_adin1110_mdio(st, val);
+		return;
+	default:
+		st->regs[addr] = val;
+		return;
+	}
+}
+
+/**
+ * @brief Accept a frame written to the TX FIFO.
+ * @param st - Model state.
+ * @param data - Frame header followed by the frame.
+ * @param len - Number of bytes available (multiple of 4, may be padded).
+ */
+static void sim_adin1110_tx(struct sim_adin1110 *st, const uint8_t *data,
+			    uint32_t len)
+{
+	struct sim_adin1110_rx_fifo *fifo;
+	struct sim_adin1110_frame *frame;
+	uint32_t fsize = st->regs[ADIN1110_TX_FSIZE_REG];
+	uint32_t port;
+
+	if (fsize < ADIN1110_FRAME_HEADER_LEN || fsize > len ||
+	    fsize > ADIN1110_BUFF_LEN)
+		return;
+
+	st->regs[ADIN1110_TX_FRM_CNT_REG]++;
+	if (!st->param.loopback)
+		return;
+
+	port = ((data[0] << 8) | data[1]) & 0x1;
+	if (port >= sim_adin1110_ports(st))
+		return;
+
+	fifo = &st->rx[port];
+	if (fifo->count == SIM_ADIN1110_RX_DEPTH) {
+		st->regs[ADIN1110_RX_DROP_FULL_CNT_REG]++;
+		return;
+	}
+
+	frame = &fifo->frames[(fifo->head + fifo->count) % SIM_ADIN1110_RX_DEPTH];
+	memcpy(frame->data, data, fsize);
+	frame->len = fsize;
+	fifo->count++;
+	st->regs[ADIN1110_RX_FRM_CNT_REG]++;
+}
+
+/**
+ * @brief Pop the head frame of an RX FIFO.
+ * @param st - Model state.
+ * @param port - Port index.
+ * @param data - Frame header followed by the frame, zero padded.
+ * @param len - Number of bytes clocked out.
+ */
+static void sim_adin1110_rx(struct sim_adin1110 *st, uint32_t port,
+			    uint8_t *data, uint32_t len)
+{
+	struct sim_adin1110_rx_fifo *fifo = &st->rx[port];
+	struct sim_adin1110_frame *frame;
+
+	memset(data, 0, len);
+	if (!fifo->count)
+		return;
+
+	frame = &fifo->frames[fifo->head];
+	memcpy(data, frame->data, no_os_min(len, frame->len));
+	fifo->head = (fifo->head + 1) % SIM_ADIN1110_RX_DEPTH;
+	fifo->count--;
+}
+
+/**
+ * @brief Model state allocation.
+ * @param priv - Model state.
+ * @param param - struct sim_adin1110_param, NULL for an ADIN1110 without CRC.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int sim_adin1110_init(void **priv, const void *param)
+{
+	struct sim_adin1110 *st;
+
+	st = no_os_calloc(1, sizeof(*st));
+	if (!st)
+		return -ENOMEM;
+
+	if (param)
+		st->param = *(const struct sim_adin1110_param *)param;
+	if (!st->param.phy_id)
+		st->param.phy_id = ADIN1110_PHY_ID;
+
+	no_os_crc8_populate_msb(sim_adin1110_crc, SIM_ADIN1110_CRC_POLY);
+	sim_adin1110_reset(st);
+	*priv = st;
+
+	return 0;
+}
+
+/**
+ * @brief Serve one SPI frame (OPEN Alliance generic SPI protocol). Register
+ * accesses auto-increment, TX_REG/RX_REG accesses move whole frames.
+ * @param priv - Model state.
+ * @param tx - Bytes on SDI.
+ * @param rx - Bytes on SDO.
+ * @param len - Frame length.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int sim_adin1110_spi_xfer(void *priv, const uint8_t *tx, uint8_t *rx,
+				 uint32_t len)
+{
+	struct sim_adin1110 *st = priv;
+	uint32_t word_len = ADIN1110_REG_LEN;
+	uint32_t off = ADIN1110_WR_HEADER_LEN;
+	uint32_t addr;
+	uint32_t val;
+
+	if (len < ADIN1110_WR_HEADER_LEN || !(tx[0] & ADIN1110_SPI_CD))
+		return 0;
+
+	addr = ((tx[0] << 8) | tx[1]) & ADIN1110_ADDR_MASK;
+
+	if (st->param.crc) {
+		if (len < off + 1 ||
+		    no_os_crc8(sim_adin1110_crc, tx, ADIN1110_WR_HEADER_LEN, 0) !=
+		    tx[off]) {
+			st->regs[ADIN1110_STATUS1_REG] |= ADIN1110_SPI_ERR;
+			return 0;
+		}
+		off++;
+		word_len += ADIN1110_CRC_LEN;
+	}
+
+	if (tx[0] & ADIN1110_SPI_RW) {
+		if (addr == ADIN1110_TX_REG) {
+			sim_adin1110_tx(st, &tx[off], len - off);
+			return 0;
+		}
+
+		for (; off + word_len <= len; off += word_len, addr++) {
+			if (st->param.crc &&
+			    no_os_crc8(sim_adin1110_crc, &tx[off],
+				       ADIN1110_REG_LEN, 0) !=
+			    tx[off + ADIN1110_REG_LEN]) {
+				st->regs[ADIN1110_STATUS1_REG] |= ADIN1110_SPI_ERR;
+				return 0;
+			}
+			val = no_os_get_unaligned_be32((uint8_t *)&tx[off]);
+			sim_adin1110_reg_write(st, addr, val);
+		}
+
+		return 0;
+	}
+
+	/* Turnaround byte */
+	off++;
+	if (off > len)
+		return 0;
+
+	if (addr == ADIN1110_RX_REG || addr == ADIN2111_RX_P2_REG) {
+		sim_adin1110_rx(st, addr == ADIN1110_RX_REG ? 0 : 1, &rx[off],
+				len - off);
+		return 0;
+	}
+
+	for (; off + word_len <= len; off += word_len, addr++) {
+		val = sim_adin1110_reg_read(st, addr);
+		no_os_put_unaligned_be32(val, &rx[off]);
+		if (st->param.crc)
+			rx[off + ADIN1110_REG_LEN] =
+				no_os_crc8(sim_adin1110_crc, &rx[off],
+					   ADIN1110_REG_LEN, 0);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Free the model state.
+ * @param priv - Model state.
+ */
+static void sim_adin1110_remove(void *priv)
+{
+	no_os_free(priv);
+}
+
+/**
+ * @brief ADIN1110/ADIN2111 model.
+ */
+const struct sim_device_model sim_adin1110_model = {
+	.name = "adin1110",
+	.init = sim_adin1110_init,
+	.spi_xfer = sim_adin1110_spi_xfer,
+	.remove = sim_adin1110_remove,
+};
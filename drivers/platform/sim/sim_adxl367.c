@@ -0,0 +1,389 @@
+/***************************************************************************//**
+ *   @file   sim/sim_adxl367.c
+ *   @brief  Register-level model of the ADXL367.
+********************************************************************************
+ * Copyright 2023(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <string.h>
+#include "sim_models.h"
+#include "adxl367.h"
+#include "no_os_alloc.h"
+#include "no_os_error.h"
+#include "no_os_util.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define SIM_ADXL367_NB_REGS	(ADXL367_REG_STATUS_2 + 1)
+#define SIM_ADXL367_FIFO_DEPTH	512
+#define SIM_ADXL367_REVID	0x03
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct sim_adxl367
+ * @brief ADXL367 model state.
+ */
+struct sim_adxl367 {
+	struct sim_adxl367_param param;
+	uint8_t regs[SIM_ADXL367_NB_REGS];
+	/** I2C register pointer */
+	uint8_t ptr;
+	/** Next FIFO entry within the sample set */
+	uint32_t fifo_slot;
+	/** Free running counter for the default ramp */
+	uint32_t ramp;
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Bring the register file to its power-on state.
+ * @param st - Model state.
+ */
+static void sim_adxl367_reset(struct sim_adxl367 *st)
+{
+	memset(st->regs, 0, sizeof(st->regs));
+	st->regs[ADXL367_REG_DEVID_AD] = ADXL367_DEVICE_AD;
+	st->regs[ADXL367_REG_DEVID_MST] = ADXL367_DEVICE_MST;
+	st->regs[ADXL367_REG_PARTID] = ADXL367_PART_ID;
+	st->regs[ADXL367_REG_REVID] = SIM_ADXL367_REVID;
+	st->regs[ADXL367_REG_FIFO_SAMPLES] = 0x80;
+	st->regs[ADXL367_REG_FILTER_CTL] = 0x13;
+	st->fifo_slot = 0;
+}
+
+/**
+ * @brief Get a 14-bit code for an axis (0..2) or the temperature (3).
+ * @param st - Model state.
+ * @param channel - Channel index.
+ * @return The 14-bit code.
+ */
+static uint16_t sim_adxl367_sample(struct sim_adxl367 *st, uint32_t channel)
+{
+	if (st->param.sample)
+		return st->param.sample(st->param.ctx, channel) & 0x3FFF;
+
+	return ((channel << 10) + (st->ramp++ & 0x3FF)) & 0x3FFF;
+}
+
+/**
+ * @brief Refresh the output data registers, as done at the end of a
+ * conversion.
+ * @param st - Model state.
+ */
+static void sim_adxl367_convert(struct sim_adxl367 *st)
+{
+	uint16_t code;
+	uint32_t i;
+
+	for (i = 0; i < 4; i++) {
+		code = sim_adxl367_sample(st, i) << 2;
+		st->regs[ADXL367_REG_XDATA_H + 2 * i] = code >> 8;
+		st->regs[ADXL367_REG_XDATA_H + 2 * i + 1] = code & 0xFF;
+		if (i < 3)
+			st->regs[ADXL367_REG_XDATA + i] = code >> 8;
+	}
+}
+
+/**
+ * @brief Number of channels stored per FIFO sample set.
+ * @param st - Model state.
+ * @param nb_axes - Number of axes in the set.
+ * @return Number of FIFO entries per sample set.
+ */
+static uint32_t sim_adxl367_fifo_channels(struct sim_adxl367 *st,
+		uint32_t *nb_axes)
+{
+	uint32_t format;
+
+	format = no_os_field_get(ADXL367_FIFO_CONTROL_FIFO_CHANNEL_MSK,
+				 st->regs[ADXL367_REG_FIFO_CONTROL]);
+	*nb_axes = (format & 0x3) ? 1 : 3;
+
+	return *nb_axes + ((format >> 2) ? 1 : 0);
+}
+
+/**
+ * @brief Number of FIFO entries ready. Once armed, the FIFO is always
+ * reported at its watermark so every poll finds a full batch.
+ * @param st - Model state.
+ * @return Number of 16-bit entries.
+ */
+static uint16_t sim_adxl367_fifo_entries(struct sim_adxl367 *st)
+{
+	uint8_t ctl = st->regs[ADXL367_REG_FIFO_CONTROL];
+	uint32_t nb_axes, nb_ch;
+	uint32_t sets;
+
+	if (!no_os_field_get(ADXL367_FIFO_CONTROL_FIFO_MODE_MSK, ctl) ||
+	    !no_os_field_get(ADXL367_POWER_CTL_MEASURE_MSK,
+			     st->regs[ADXL367_REG_POWER_CTL]))
+		return 0;
+
+	sets = st->regs[ADXL367_REG_FIFO_SAMPLES];
+	if (ctl & ADXL367_FIFO_CONTROL_FIFO_SAMPLES)
+		sets |= NO_OS_BIT(8);
+
+	nb_ch = sim_adxl367_fifo_channels(st, &nb_axes);
+
+	return no_os_min(sets * nb_ch, SIM_ADXL367_FIFO_DEPTH / nb_ch * nb_ch);
+}
+
+/**
+ * @brief Pop one 14-bit + channel ID FIFO entry.
+ * @param st - Model state.
+ * @return The entry, MSB first.
+ */
+static uint16_t sim_adxl367_fifo_pop(struct sim_adxl367 *st)
+{
+	static const uint8_t axes[4][3] = {
+		{ ADXL367_FIFO_X_ID, ADXL367_FIFO_Y_ID, ADXL367_FIFO_Z_ID },
+		{ ADXL367_FIFO_X_ID }, { ADXL367_FIFO_Y_ID }, { ADXL367_FIFO_Z_ID },
+	};
+	uint32_t format, nb_axes, nb_ch, id;
+
+	format = no_os_field_get(ADXL367_FIFO_CONTROL_FIFO_CHANNEL_MSK,
+				 st->regs[ADXL367_REG_FIFO_CONTROL]);
+	nb_ch = sim_adxl367_fifo_channels(st, &nb_axes);
+
+	if (st->fifo_slot >= nb_ch)
+		st->fifo_slot = 0;
+	if (st->fifo_slot < nb_axes)
+		id = axes[format & 0x3][st->fifo_slot];
+	else
+		id = ADXL367_FIFO_TEMP_ADC_ID;
+	st->fifo_slot++;
+
+	return (id << 14) | sim_adxl367_sample(st, id);
+}
+
+/**
+ * @brief Read one register, with the side effects of the access.
+ * @param st - Model state.
+ * @param addr - Register address.
+ * @return Register value.
+ */
+static uint8_t sim_adxl367_reg_read(struct sim_adxl367 *st, uint8_t addr)
+{
+	uint16_t entries;
+
+	if (addr >= SIM_ADXL367_NB_REGS)
+		return 0;
+
+	switch (addr) {
+	case ADXL367_REG_XDATA:
+	case ADXL367_REG_XDATA_H:
+		sim_adxl367_convert(st);
+		break;
+	case ADXL367_REG_FIFO_ENTRIES_L:
+	case ADXL367_REG_FIFO_ENTRIES_H:
+		entries = sim_adxl367_fifo_entries(st);
+		st->regs[ADXL367_REG_FIFO_ENTRIES_L] = entries & 0xFF;
+		st->regs[ADXL367_REG_FIFO_ENTRIES_H] = entries >> 8;
+		break;
+	default:
+		break;
+	}
+
+	return st->regs[addr];
+}
+
+/**
+ * @brief Write one register, with the side effects of the access.
+ * @param st - Model state.
+ * @param addr - Register address.
+ * @param val - Register value.
+ */
+static void sim_adxl367_reg_write(struct sim_adxl367 *st, uint8_t addr,
+				  uint8_t val)
+{
+	/* Identification, data and status registers are read only */
+	if (addr < ADXL367_REG_SOFT_RESET || addr >= SIM_ADXL367_NB_REGS)
+		return;
+
+	if (addr == ADXL367_REG_SOFT_RESET) {
+		if (val == ADXL367_RESET_KEY)
+			sim_adxl367_reset(st);
+		return;
+	}
+
+	st->regs[addr] = val;
+}
+
+/**
+ * @brief Model state allocation.
+ * @param priv - Model state.
+ * @param param - struct sim_adxl367_param (may be NULL).
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int sim_adxl367_init(void **priv, const void *param)
+{
+	struct sim_adxl367 *st;
+
+	st = no_os_calloc(1, sizeof(*st));
+	if (!st)
+		return -ENOMEM;
+
+	if (param)
+		st->param = *(const struct sim_adxl367_param *)param;
+
+	sim_adxl367_reset(st);
+	*priv = st;
+
+	return 0;
+}
+
+/**
+ * @brief Serve one SPI frame: register write/read with auto-increment or a
+ * FIFO burst read.
+ * @param priv - Model state.
+ * @param tx - Bytes on MOSI.
+ * @param rx - Bytes on MISO.
+ * @param len - Frame length.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int sim_adxl367_spi_xfer(void *priv, const uint8_t *tx, uint8_t *rx,
+				uint32_t len)
+{
+	struct sim_adxl367 *st = priv;
+	uint16_t entry;
+	uint32_t i;
+
+	switch (tx[0]) {
+	case ADXL367_WRITE_REG:
+		for (i = 2; i < len; i++)
+			sim_adxl367_reg_write(st, tx[1] + i - 2, tx[i]);
+		break;
+	case ADXL367_READ_REG:
+		for (i = 2; i < len; i++)
+			rx[i] = sim_adxl367_reg_read(st, tx[1] + i - 2);
+		break;
+	case ADXL367_READ_FIFO:
+		for (i = 1; i + 1 < len; i += 2) {
+			entry = sim_adxl367_fifo_pop(st);
+			rx[i] = entry >> 8;
+			rx[i + 1] = entry & 0xFF;
+		}
+		break;
+	default:
+		break;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief I2C write: register pointer followed by data to store.
+ * @param priv - Model state.
+ * @param data - Bytes written by the master.
+ * @param len - Number of bytes.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int sim_adxl367_i2c_write(void *priv, const uint8_t *data, uint32_t len)
+{
+	struct sim_adxl367 *st = priv;
+	uint32_t i;
+
+	if (!len)
+		return 0;
+
+	st->ptr = data[0];
+	for (i = 1; i < len; i++)
+		sim_adxl367_reg_write(st, st->ptr++, data[i]);
+
+	return 0;
+}
+
+/**
+ * @brief I2C read from the register pointer. The I2C_FIFO_DATA register does
+ * not auto-increment and streams FIFO entries.
+ * @param priv - Model state.
+ * @param data - Bytes read by the master.
+ * @param len - Number of bytes.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int sim_adxl367_i2c_read(void *priv, uint8_t *data, uint32_t len)
+{
+	struct sim_adxl367 *st = priv;
+	uint16_t entry = 0;
+	uint32_t i;
+
+	for (i = 0; i < len; i++) {
+		if (st->ptr != ADXL367_REG_I2C_FIFO_DATA) {
+			data[i] = sim_adxl367_reg_read(st, st->ptr++);
+			continue;
+		}
+
+		if (!(i & 1)) {
+			entry = sim_adxl367_fifo_pop(st);
+			data[i] = entry >> 8;
+		} else {
+			data[i] = entry & 0xFF;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Free the model state.
+ * @param priv - Model state.
+ */
+static void sim_adxl367_remove(void *priv)
+{
+	no_os_free(priv);
+}
+
+/**
+ * @brief ADXL367 model.
+ */
+const struct sim_device_model sim_adxl367_model = {
+	.name = "adxl367",
+	.init = sim_adxl367_init,
+	.spi_xfer = sim_adxl367_spi_xfer,
+	.i2c_write = sim_adxl367_i2c_write,
+	.i2c_read = sim_adxl367_i2c_read,
+	.remove = sim_adxl367_remove,
+};
@@ -0,0 +1,129 @@
+/***************************************************************************//**
+ *   @file   sim/sim_device.c
+ *   @brief  Model instance helpers for the simulation platform.
+********************************************************************************
+ * Copyright 2023(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include "sim_device.h"
+#include "no_os_alloc.h"
+#include "no_os_delay.h"
+#include "no_os_error.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Create a model instance.
+ * @param dev - The model instance.
+ * @param model - The model implementation.
+ * @param param - Model specific initialization parameters (may be NULL).
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int sim_device_init(struct sim_device **dev,
+		    const struct sim_device_model *model,
+		    const void *param)
+{
+	struct sim_device *sdev;
+	int ret;
+
+	if (!dev || !model)
+		return -EINVAL;
+
+	sdev = no_os_calloc(1, sizeof(*sdev));
+	if (!sdev)
+		return -ENOMEM;
+
+	sdev->model = model;
+	if (model->init) {
+		ret = model->init(&sdev->priv, param);
+		if (ret) {
+			no_os_free(sdev);
+			return ret;
+		}
+	}
+
+	*dev = sdev;
+
+	return 0;
+}
+
+/**
+ * @brief Free a model instance.
+ * @param dev - The model instance.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int sim_device_remove(struct sim_device *dev)
+{
+	if (!dev)
+		return -EINVAL;
+
+	if (dev->model->remove)
+		dev->model->remove(dev->priv);
+
+	no_os_free(dev);
+
+	return 0;
+}
+
+/**
+ * @brief Account a transfer in the bus statistics.
+ * @param stats - The bus statistics.
+ * @param debt_ns - Modelled time not yet spent in real time.
+ * @param bytes - Number of data bytes exchanged.
+ * @param time_ns - Modelled duration of the transfer.
+ * @param realtime - Stall the caller for the modelled duration.
+ */
+void sim_bus_account(struct sim_bus_stats *stats, uint64_t *debt_ns,
+		     uint32_t bytes, uint64_t time_ns, bool realtime)
+{
+	stats->frames++;
+	stats->bytes += bytes;
+	stats->bus_time_ns += time_ns;
+
+	if (!realtime)
+		return;
+
+	/* Sub-microsecond frames are paid for once enough of them add up */
+	*debt_ns += time_ns;
+	if (*debt_ns >= 1000) {
+		no_os_udelay(*debt_ns / 1000);
+		*debt_ns %= 1000;
+	}
+}
@@ -0,0 +1,121 @@
+/***************************************************************************//**
+ *   @file   sim/sim_device.h
+ *   @brief  Register-level device models for the simulation platform.
+********************************************************************************
+ * Copyright 2023(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef SIM_DEVICE_H_
+#define SIM_DEVICE_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct sim_device_model
+ * @brief Behavioural model of a device attached to the simulated buses.
+ * All callbacks are optional, a model only implements the interfaces exposed
+ * by the real part.
+ */
+struct sim_device_model {
+	/** Part name */
+	const char *name;
+	/** Allocate the model state and bring it to the power-on state */
+	int (*init)(void **priv, const void *param);
+	/**
+	 * One SPI frame, from CS assert to CS deassert. tx and rx never alias
+	 * and are both len bytes long.
+	 */
+	int (*spi_xfer)(void *priv, const uint8_t *tx, uint8_t *rx, uint32_t len);
+	/** I2C write addressed to the device */
+	int (*i2c_write)(void *priv, const uint8_t *data, uint32_t len);
+	/** I2C read addressed to the device */
+	int (*i2c_read)(void *priv, uint8_t *data, uint32_t len);
+	/** A GPIO connected to the device was driven by the host */
+	int (*gpio_set)(void *priv, uint32_t line, uint8_t value);
+	/** A GPIO driven by the device is sampled by the host */
+	int (*gpio_get)(void *priv, uint32_t line, uint8_t *value);
+	/** Free the model state */
+	void (*remove)(void *priv);
+};
+
+/**
+ * @struct sim_device
+ * @brief Model instance. The same instance may be referenced by several bus
+ * descriptors (e.g. the SPI interface and the reset GPIO of one part).
+ */
+struct sim_device {
+	/** Model implementation */
+	const struct sim_device_model *model;
+	/** Model state */
+	void *priv;
+};
+
+/**
+ * @struct sim_bus_stats
+ * @brief Traffic counters kept by the simulated bus controllers.
+ */
+struct sim_bus_stats {
+	/** Number of frames (SPI CS assertions or I2C start conditions) */
+	uint64_t frames;
+	/** Number of data bytes exchanged */
+	uint64_t bytes;
+	/** Time the transfers would have taken on a real bus */
+	uint64_t bus_time_ns;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Create a model instance. */
+int sim_device_init(struct sim_device **dev,
+		    const struct sim_device_model *model,
+		    const void *param);
+
+/* Free a model instance. */
+int sim_device_remove(struct sim_device *dev);
+
+/* Account a transfer and optionally stall for its modelled duration. */
+void sim_bus_account(struct sim_bus_stats *stats, uint64_t *debt_ns,
+		     uint32_t bytes, uint64_t time_ns, bool realtime);
+
+#endif // SIM_DEVICE_H_
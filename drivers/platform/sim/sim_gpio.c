@@ -0,0 +1,263 @@
+/***************************************************************************//**
+ *   @file   sim/sim_gpio.c
+ *   @brief  Implementation of the simulated GPIO controller.
+********************************************************************************
+ * Copyright 2023(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include "sim_gpio.h"
+#include "no_os_alloc.h"
+#include "no_os_error.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct sim_gpio_desc
+ * @brief Simulated GPIO specific descriptor.
+ */
+struct sim_gpio_desc {
+	/** Model the line is connected to */
+	struct sim_device *device;
+	/** Line direction */
+	uint8_t direction;
+	/** Output latch */
+	uint8_t value;
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Obtain a simulated GPIO. The line starts as an input.
+ * @param desc - The GPIO descriptor.
+ * @param param - GPIO initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_gpio_get(struct no_os_gpio_desc **desc,
+			    const struct no_os_gpio_init_param *param)
+{
+	struct sim_gpio_init_param *sim_param;
+	struct sim_gpio_desc *sim_desc;
+	struct no_os_gpio_desc *gpio_desc;
+
+	if (!desc || !param)
+		return -EINVAL;
+
+	gpio_desc = no_os_calloc(1, sizeof(*gpio_desc));
+	if (!gpio_desc)
+		return -ENOMEM;
+
+	sim_desc = no_os_calloc(1, sizeof(*sim_desc));
+	if (!sim_desc) {
+		no_os_free(gpio_desc);
+		return -ENOMEM;
+	}
+
+	sim_param = param->extra;
+	if (sim_param)
+		sim_desc->device = sim_param->device;
+	sim_desc->direction = NO_OS_GPIO_IN;
+
+	gpio_desc->port = param->port;
+	gpio_desc->number = param->number;
+	gpio_desc->pull = param->pull;
+	gpio_desc->extra = sim_desc;
+
+	*desc = gpio_desc;
+
+	return 0;
+}
+
+/**
+ * @brief Get the value of an optional GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param param - GPIO initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_gpio_get_optional(struct no_os_gpio_desc **desc,
+				     const struct no_os_gpio_init_param *param)
+{
+	if (!param) {
+		*desc = NULL;
+		return 0;
+	}
+
+	return sim_gpio_get(desc, param);
+}
+
+/**
+ * @brief Free the resources allocated by sim_gpio_get().
+ * @param desc - The GPIO descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_gpio_remove(struct no_os_gpio_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	no_os_free(desc->extra);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Set the value of a simulated GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param value - The value.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_gpio_set_value(struct no_os_gpio_desc *desc,
+				  uint8_t value)
+{
+	struct sim_gpio_desc *sim_desc;
+	struct sim_device *dev;
+
+	if (!desc)
+		return -EINVAL;
+
+	sim_desc = desc->extra;
+	sim_desc->value = value;
+
+	dev = sim_desc->device;
+	if (sim_desc->direction != NO_OS_GPIO_OUT || !dev || !dev->model->gpio_set)
+		return 0;
+
+	return dev->model->gpio_set(dev->priv, desc->number, value);
+}
+
+/**
+ * @brief Get the value of a simulated GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param value - The value.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_gpio_get_value(struct no_os_gpio_desc *desc,
+				  uint8_t *value)
+{
+	struct sim_gpio_desc *sim_desc;
+	struct sim_device *dev;
+
+	if (!desc || !value)
+		return -EINVAL;
+
+	sim_desc = desc->extra;
+	dev = sim_desc->device;
+	if (sim_desc->direction == NO_OS_GPIO_OUT || !dev ||
+	    !dev->model->gpio_get) {
+		*value = sim_desc->value;
+		return 0;
+	}
+
+	return dev->model->gpio_get(dev->priv, desc->number, value);
+}
+
+/**
+ * @brief Enable the input direction of a simulated GPIO.
+ * @param desc - The GPIO descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_gpio_direction_input(struct no_os_gpio_desc *desc)
+{
+	struct sim_gpio_desc *sim_desc;
+
+	if (!desc)
+		return -EINVAL;
+
+	sim_desc = desc->extra;
+	sim_desc->direction = NO_OS_GPIO_IN;
+
+	return 0;
+}
+
+/**
+ * @brief Enable the output direction of a simulated GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param value - The initial value.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_gpio_direction_output(struct no_os_gpio_desc *desc,
+		uint8_t value)
+{
+	struct sim_gpio_desc *sim_desc;
+
+	if (!desc)
+		return -EINVAL;
+
+	sim_desc = desc->extra;
+	sim_desc->direction = NO_OS_GPIO_OUT;
+
+	return sim_gpio_set_value(desc, value);
+}
+
+/**
+ * @brief Get the direction of a simulated GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param direction - The direction.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_gpio_get_direction(struct no_os_gpio_desc *desc,
+				      uint8_t *direction)
+{
+	struct sim_gpio_desc *sim_desc;
+
+	if (!desc || !direction)
+		return -EINVAL;
+
+	sim_desc = desc->extra;
+	*direction = sim_desc->direction;
+
+	return 0;
+}
+
+/**
+ * @brief Simulated GPIO platform ops structure
+ */
+const struct no_os_gpio_platform_ops sim_gpio_ops = {
+	.gpio_ops_get = &sim_gpio_get,
+	.gpio_ops_get_optional = &sim_gpio_get_optional,
+	.gpio_ops_remove = &sim_gpio_remove,
+	.gpio_ops_direction_input = &sim_gpio_direction_input,
+	.gpio_ops_direction_output = &sim_gpio_direction_output,
+	.gpio_ops_get_direction = &sim_gpio_get_direction,
+	.gpio_ops_set_value = &sim_gpio_set_value,
+	.gpio_ops_get_value = &sim_gpio_get_value
+};
@@ -0,0 +1,308 @@
+/***************************************************************************//**
+ *   @file   sim/sim_i2c.c
+ *   @brief  Implementation of the simulated I2C controller.
+********************************************************************************
+ * Copyright 2023(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <string.h>
+#include "sim_i2c.h"
+#include "no_os_alloc.h"
+#include "no_os_error.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct sim_i2c_desc
+ * @brief Simulated I2C specific descriptor.
+ */
+struct sim_i2c_desc {
+	/** Model answering on the slave address */
+	struct sim_device *device;
+	/** Stall the caller for the modelled bus time */
+	bool realtime;
+	/** Modelled time not yet spent in real time */
+	uint64_t debt_ns;
+	/** Traffic counters */
+	struct sim_bus_stats stats;
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Initialize a simulated I2C device.
+ * @param desc - The I2C descriptor.
+ * @param param - The structure that contains the I2C parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_i2c_init(struct no_os_i2c_desc **desc,
+			    const struct no_os_i2c_init_param *param)
+{
+	struct sim_i2c_init_param *sim_param;
+	struct sim_i2c_desc *sim_desc;
+	struct no_os_i2c_desc *i2c_desc;
+
+	if (!desc || !param || !param->extra)
+		return -EINVAL;
+
+	sim_param = param->extra;
+	if (!sim_param->device)
+		return -EINVAL;
+
+	i2c_desc = no_os_calloc(1, sizeof(*i2c_desc));
+	if (!i2c_desc)
+		return -ENOMEM;
+
+	sim_desc = no_os_calloc(1, sizeof(*sim_desc));
+	if (!sim_desc) {
+		no_os_free(i2c_desc);
+		return -ENOMEM;
+	}
+
+	sim_desc->device = sim_param->device;
+	sim_desc->realtime = sim_param->realtime;
+
+	i2c_desc->device_id = param->device_id;
+	i2c_desc->max_speed_hz = param->max_speed_hz;
+	i2c_desc->slave_address = param->slave_address;
+	i2c_desc->extra = sim_desc;
+
+	*desc = i2c_desc;
+
+	return 0;
+}
+
+/**
+ * @brief Account one addressed transfer in the bus statistics.
+ * @param desc - The I2C descriptor.
+ * @param len - Number of data bytes.
+ * @param stop_bit - Transfer ends with a stop condition.
+ */
+static void sim_i2c_account(struct no_os_i2c_desc *desc, uint32_t len,
+			    uint8_t stop_bit)
+{
+	struct sim_i2c_desc *sim_desc = desc->extra;
+	uint64_t time_ns = 0;
+	uint64_t bits;
+
+	/* (Repeated) start, address + ACK, data + ACK, optional stop */
+	bits = 1 + 9 * (1 + (uint64_t)len) + (stop_bit ? 1 : 0);
+	if (desc->max_speed_hz)
+		time_ns = bits * 1000000000ull / desc->max_speed_hz;
+
+	sim_bus_account(&sim_desc->stats, &sim_desc->debt_ns, len, time_ns,
+			sim_desc->realtime);
+}
+
+/**
+ * @brief Write data to a simulated I2C device.
+ * @param desc - The I2C descriptor.
+ * @param data - Buffer that stores the transmission data.
+ * @param bytes_number - Number of bytes to write.
+ * @param stop_bit - Stop condition control.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_i2c_write(struct no_os_i2c_desc *desc,
+			     uint8_t *data,
+			     uint8_t bytes_number,
+			     uint8_t stop_bit)
+{
+	struct sim_i2c_desc *sim_desc;
+	struct sim_device *dev;
+	int ret;
+
+	if (!desc || !data)
+		return -EINVAL;
+
+	sim_desc = desc->extra;
+	dev = sim_desc->device;
+	if (!dev->model->i2c_write)
+		return -ENOSYS;
+
+	ret = dev->model->i2c_write(dev->priv, data, bytes_number);
+	if (ret)
+		return ret;
+
+	sim_i2c_account(desc, bytes_number, stop_bit);
+
+	return 0;
+}
+
+/**
+ * @brief Read data from a simulated I2C device.
+ * @param desc - The I2C descriptor.
+ * @param data - Buffer that will store the received data.
+ * @param bytes_number - Number of bytes to read.
+ * @param stop_bit - Stop condition control.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_i2c_read(struct no_os_i2c_desc *desc,
+			    uint8_t *data,
+			    uint8_t bytes_number,
+			    uint8_t stop_bit)
+{
+	struct sim_i2c_desc *sim_desc;
+	struct sim_device *dev;
+	int ret;
+
+	if (!desc || !data)
+		return -EINVAL;
+
+	sim_desc = desc->extra;
+	dev = sim_desc->device;
+	if (!dev->model->i2c_read)
+		return -ENOSYS;
+
+	ret = dev->model->i2c_read(dev->priv, data, bytes_number);
+	if (ret)
+		return ret;
+
+	sim_i2c_account(desc, bytes_number, stop_bit);
+
+	return 0;
+}
+
+/**
+ * @brief Perform a combined transfer, a stop is only issued after the last
+ * message.
+ * @param desc - The I2C descriptor.
+ * @param msgs - Array of messages.
+ * @param len - Number of messages in the array.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_i2c_transfer(struct no_os_i2c_desc *desc,
+				struct no_os_i2c_msg *msgs,
+				uint32_t len)
+{
+	struct sim_i2c_desc *sim_desc;
+	struct sim_device *dev;
+	uint32_t i;
+	int ret;
+
+	if (!desc || !msgs)
+		return -EINVAL;
+
+	sim_desc = desc->extra;
+	dev = sim_desc->device;
+
+	for (i = 0; i < len; i++) {
+		if (msgs[i].flags & NO_OS_I2C_M_RD)
+			ret = dev->model->i2c_read ?
+			      dev->model->i2c_read(dev->priv, msgs[i].buf,
+						   msgs[i].len) : -ENOSYS;
+		else
+			ret = dev->model->i2c_write ?
+			      dev->model->i2c_write(dev->priv, msgs[i].buf,
+						    msgs[i].len) : -ENOSYS;
+		if (ret)
+			return ret;
+
+		sim_i2c_account(desc, msgs[i].len, i == len - 1);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by sim_i2c_init().
+ * @param desc - The I2C descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_i2c_remove(struct no_os_i2c_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	no_os_free(desc->extra);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Get the traffic counters of a simulated I2C device.
+ * @param desc - The I2C descriptor.
+ * @param stats - The traffic counters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int sim_i2c_get_stats(struct no_os_i2c_desc *desc,
+		      struct sim_bus_stats *stats)
+{
+	struct sim_i2c_desc *sim_desc;
+
+	if (!desc || !stats)
+		return -EINVAL;
+
+	sim_desc = desc->extra;
+	*stats = sim_desc->stats;
+
+	return 0;
+}
+
+/**
+ * @brief Clear the traffic counters of a simulated I2C device.
+ * @param desc - The I2C descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int sim_i2c_reset_stats(struct no_os_i2c_desc *desc)
+{
+	struct sim_i2c_desc *sim_desc;
+
+	if (!desc)
+		return -EINVAL;
+
+	sim_desc = desc->extra;
+	memset(&sim_desc->stats, 0, sizeof(sim_desc->stats));
+
+	return 0;
+}
+
+/**
+ * @brief Simulated I2C platform ops structure
+ */
+const struct no_os_i2c_platform_ops sim_i2c_ops = {
+	.i2c_ops_init = &sim_i2c_init,
+	.i2c_ops_write = &sim_i2c_write,
+	.i2c_ops_read = &sim_i2c_read,
+	.i2c_ops_remove = &sim_i2c_remove,
+	.i2c_ops_transfer = &sim_i2c_transfer
+};
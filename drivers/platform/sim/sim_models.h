@@ -0,0 +1,117 @@
+/***************************************************************************//**
+ *   @file   sim/sim_models.h
+ *   @brief  Device models available on the simulation platform.
+********************************************************************************
+ * Copyright 2023(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef SIM_MODELS_H_
+#define SIM_MODELS_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sim_device.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Conversion result source. Returns the raw code for a channel (or
+ * axis); the models fall back to a per-channel ramp when no source is given.
+ */
+typedef uint32_t (*sim_sample_cb)(void *ctx, uint32_t channel);
+
+/**
+ * @struct sim_ad7124_param
+ * @brief AD7124 model parameters.
+ */
+struct sim_ad7124_param {
+	/** ID register value (AD7124_4_ID or AD7124_8_ID) */
+	uint8_t id;
+	/** Conversion result source (24-bit codes) */
+	sim_sample_cb sample;
+	void *ctx;
+};
+
+/**
+ * @struct sim_adxl367_param
+ * @brief ADXL367 model parameters.
+ */
+struct sim_adxl367_param {
+	/** Axis/temperature source (14-bit codes, channel 0..3 = x, y, z, temp) */
+	sim_sample_cb sample;
+	void *ctx;
+};
+
+/**
+ * @struct sim_ad74413r_param
+ * @brief AD74413R model parameters.
+ */
+struct sim_ad74413r_param {
+	/** ADC result source (16-bit codes) */
+	sim_sample_cb sample;
+	void *ctx;
+};
+
+/**
+ * @struct sim_adin1110_param
+ * @brief ADIN1110/ADIN2111 model parameters.
+ */
+struct sim_adin1110_param {
+	/** PHY ID reported by the part (ADIN1110_PHY_ID or ADIN2111_PHY_ID) */
+	uint32_t phy_id;
+	/** SPI CRC protection enabled (matches the driver's append_crc) */
+	bool crc;
+	/** Loop transmitted frames back to the RX FIFO of the same port */
+	bool loopback;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/** AD7124-4/AD7124-8 sigma-delta ADC (SPI, optional CRC) */
+extern const struct sim_device_model sim_ad7124_model;
+/** ADXL367 accelerometer (SPI and I2C, FIFO) */
+extern const struct sim_device_model sim_adxl367_model;
+/** AD74413R software configurable I/O (SPI, CRC protected frames) */
+extern const struct sim_device_model sim_ad74413r_model;
+/** ADIN1110/ADIN2111 10BASE-T1L MAC-PHY (SPI, register and frame FIFOs) */
+extern const struct sim_device_model sim_adin1110_model;
+
+#endif // SIM_MODELS_H_
@@ -0,0 +1,311 @@
+/***************************************************************************//**
+ *   @file   sim/sim_spi.c
+ *   @brief  Implementation of the simulated SPI controller.
+********************************************************************************
+ * Copyright 2023(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <string.h>
+#include "sim_spi.h"
+#include "no_os_alloc.h"
+#include "no_os_error.h"
+#include "no_os_util.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct sim_spi_desc
+ * @brief Simulated SPI specific descriptor.
+ */
+struct sim_spi_desc {
+	/** Model answering on this chip select */
+	struct sim_device *device;
+	/** Timing parameters */
+	uint32_t cs_setup_ns;
+	uint32_t cs_hold_ns;
+	bool realtime;
+	/** Modelled time not yet spent in real time */
+	uint64_t debt_ns;
+	/** Traffic counters */
+	struct sim_bus_stats stats;
+	/** Frame assembly buffers */
+	uint8_t tx[SIM_SPI_MAX_FRAME];
+	uint8_t rx[SIM_SPI_MAX_FRAME];
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Initialize a simulated SPI device.
+ * @param desc - The SPI descriptor.
+ * @param param - The structure that contains the SPI parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_spi_init(struct no_os_spi_desc **desc,
+			    const struct no_os_spi_init_param *param)
+{
+	struct sim_spi_init_param *sim_param;
+	struct sim_spi_desc *sim_desc;
+	struct no_os_spi_desc *spi_desc;
+
+	if (!desc || !param || !param->extra)
+		return -EINVAL;
+
+	sim_param = param->extra;
+	if (!sim_param->device)
+		return -EINVAL;
+
+	spi_desc = no_os_calloc(1, sizeof(*spi_desc));
+	if (!spi_desc)
+		return -ENOMEM;
+
+	sim_desc = no_os_calloc(1, sizeof(*sim_desc));
+	if (!sim_desc) {
+		no_os_free(spi_desc);
+		return -ENOMEM;
+	}
+
+	sim_desc->device = sim_param->device;
+	sim_desc->cs_setup_ns = sim_param->cs_setup_ns;
+	sim_desc->cs_hold_ns = sim_param->cs_hold_ns;
+	sim_desc->realtime = sim_param->realtime;
+
+	spi_desc->device_id = param->device_id;
+	spi_desc->max_speed_hz = param->max_speed_hz;
+	spi_desc->chip_select = param->chip_select;
+	spi_desc->mode = param->mode;
+	spi_desc->bit_order = param->bit_order;
+	spi_desc->extra = sim_desc;
+
+	*desc = spi_desc;
+
+	return 0;
+}
+
+/**
+ * @brief Hand one assembled frame to the model and account its bus time.
+ * @param desc - The SPI descriptor.
+ * @param len - Frame length in bytes.
+ * @param extra_ns - Frame specific CS delays.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int sim_spi_frame(struct no_os_spi_desc *desc, uint32_t len,
+			 uint64_t extra_ns)
+{
+	struct sim_spi_desc *sim_desc = desc->extra;
+	struct sim_device *dev = sim_desc->device;
+	uint64_t time_ns;
+	int ret;
+
+	if (!dev->model->spi_xfer)
+		return -ENOSYS;
+
+	/* An idle slave leaves MISO pulled up */
+	memset(sim_desc->rx, 0xFF, len);
+	ret = dev->model->spi_xfer(dev->priv, sim_desc->tx, sim_desc->rx, len);
+	if (ret)
+		return ret;
+
+	time_ns = sim_desc->cs_setup_ns + sim_desc->cs_hold_ns + extra_ns;
+	if (desc->max_speed_hz)
+		time_ns += (uint64_t)len * 8 * 1000000000ull / desc->max_speed_hz;
+
+	sim_bus_account(&sim_desc->stats, &sim_desc->debt_ns, len, time_ns,
+			sim_desc->realtime);
+
+	return 0;
+}
+
+/**
+ * @brief Write and read data to/from a simulated SPI device.
+ * @param desc - The SPI descriptor.
+ * @param data - The buffer with the transmitted/received data.
+ * @param bytes_number - Number of bytes to write/read.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_spi_write_and_read(struct no_os_spi_desc *desc,
+				      uint8_t *data,
+				      uint16_t bytes_number)
+{
+	struct sim_spi_desc *sim_desc;
+	int ret;
+
+	if (!desc || !data)
+		return -EINVAL;
+
+	sim_desc = desc->extra;
+	if (bytes_number > SIM_SPI_MAX_FRAME)
+		return -EINVAL;
+
+	memcpy(sim_desc->tx, data, bytes_number);
+	ret = sim_spi_frame(desc, bytes_number, 0);
+	if (ret)
+		return ret;
+
+	memcpy(data, sim_desc->rx, bytes_number);
+
+	return 0;
+}
+
+/**
+ * @brief Transfer a list of messages. Consecutive messages without cs_change
+ * are joined into a single frame, as a real controller would keep CS asserted.
+ * @param desc - The SPI descriptor.
+ * @param msgs - Array of messages.
+ * @param len - Number of messages in the array.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_spi_transfer(struct no_os_spi_desc *desc,
+				struct no_os_spi_msg *msgs,
+				uint32_t len)
+{
+	struct sim_spi_desc *sim_desc;
+	uint32_t first = 0;
+	uint32_t offset = 0;
+	uint64_t extra_ns;
+	uint32_t i, j;
+	int ret;
+
+	if (!desc || !msgs)
+		return -EINVAL;
+
+	sim_desc = desc->extra;
+
+	for (i = 0; i < len; i++) {
+		if (offset + msgs[i].bytes_number > SIM_SPI_MAX_FRAME)
+			return -EINVAL;
+
+		if (msgs[i].tx_buff)
+			memcpy(&sim_desc->tx[offset], msgs[i].tx_buff,
+			       msgs[i].bytes_number);
+		else
+			memset(&sim_desc->tx[offset], 0, msgs[i].bytes_number);
+		offset += msgs[i].bytes_number;
+
+		if (!msgs[i].cs_change && i != len - 1)
+			continue;
+
+		extra_ns = ((uint64_t)msgs[first].cs_delay_first +
+			    msgs[i].cs_delay_last + msgs[i].cs_change_delay) * 1000;
+		ret = sim_spi_frame(desc, offset, extra_ns);
+		if (ret)
+			return ret;
+
+		/* Scatter the frame back to the messages it was built from */
+		offset = 0;
+		for (j = first; j <= i; j++) {
+			if (msgs[j].rx_buff)
+				memcpy(msgs[j].rx_buff, &sim_desc->rx[offset],
+				       msgs[j].bytes_number);
+			offset += msgs[j].bytes_number;
+		}
+
+		offset = 0;
+		first = i + 1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by sim_spi_init().
+ * @param desc - The SPI descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_spi_remove(struct no_os_spi_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	no_os_free(desc->extra);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Get the traffic counters of a simulated SPI device.
+ * @param desc - The SPI descriptor.
+ * @param stats - The traffic counters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int sim_spi_get_stats(struct no_os_spi_desc *desc,
+		      struct sim_bus_stats *stats)
+{
+	struct sim_spi_desc *sim_desc;
+
+	if (!desc || !stats)
+		return -EINVAL;
+
+	sim_desc = desc->extra;
+	*stats = sim_desc->stats;
+
+	return 0;
+}
+
+/**
+ * @brief Clear the traffic counters of a simulated SPI device.
+ * @param desc - The SPI descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int sim_spi_reset_stats(struct no_os_spi_desc *desc)
+{
+	struct sim_spi_desc *sim_desc;
+
+	if (!desc)
+		return -EINVAL;
+
+	sim_desc = desc->extra;
+	memset(&sim_desc->stats, 0, sizeof(sim_desc->stats));
+
+	return 0;
+}
+
+/**
+ * @brief Simulated SPI platform ops structure
+ */
+const struct no_os_spi_platform_ops sim_spi_ops = {
+	.init = &sim_spi_init,
+	.write_and_read = &sim_spi_write_and_read,
+	.transfer = &sim_spi_transfer,
+	.remove = &sim_spi_remove
+};
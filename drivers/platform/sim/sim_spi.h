@@ -0,0 +1,95 @@
+/***************************************************************************//**
+ *   @file   sim/sim_spi.h
+ *   @brief  Header file for the simulated SPI controller.
+********************************************************************************
+ * Copyright 2023(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef SIM_SPI_H_
+#define SIM_SPI_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "no_os_spi.h"
+#include "sim_device.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/** Longest SPI frame (CS assertion) handed to a model */
+#define SIM_SPI_MAX_FRAME	4096
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct sim_spi_init_param
+ * @brief Simulated SPI specific initialization parameters. The SCLK rate used
+ * for timing is the max_speed_hz of the generic init parameter, a value of 0
+ * models an infinitely fast bus.
+ */
+struct sim_spi_init_param {
+	/** Model answering on this chip select */
+	struct sim_device *device;
+	/** CS assert to first SCLK edge, added to every frame */
+	uint32_t cs_setup_ns;
+	/** Last SCLK edge to CS deassert, added to every frame */
+	uint32_t cs_hold_ns;
+	/** Stall the caller for the modelled bus time */
+	bool realtime;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Get the traffic counters of a simulated SPI device. */
+int sim_spi_get_stats(struct no_os_spi_desc *desc,
+		      struct sim_bus_stats *stats);
+
+/* Clear the traffic counters of a simulated SPI device. */
+int sim_spi_reset_stats(struct no_os_spi_desc *desc);
+
+/**
+ * @brief Simulated SPI platform ops. Each chip select is served by the
+ * register-level model given in the extra init parameter.
+ */
+extern const struct no_os_spi_platform_ops sim_spi_ops;
+
+#endif // SIM_SPI_H_
@@ -689,6 +689,328 @@ const char *ad9361_ensm_states[] = {
 	"rx", "rx_flush", "fdd", "fdd_flush"
 };
 
+/**
+ * Registers that change behind the driver's back (status, readback and
+ * calibration results) or whose writes have side effects (strobes, program
+ * ports, calibration and synthesizer triggers). These always go on the bus.
+ */
+static const struct {
+	uint16_t first;
+	uint16_t last;
+} ad9361_volatile_regs[] = {
+	{0x000, 0x001},	/* SPI Configuration, MCS */
+	{0x00C, 0x00E},	/* Temperature */
+	{0x013, 0x014},	/* ENSM Mode, ENSM Config 1 */
+	{0x016, 0x017},	/* Calibration Control, State */
+	{0x01E, 0x01F},	/* AuxADC Word */
+	{0x03F, 0x03F},	/* SDM Control 1 (BBPLL reset) */
+	{0x05E, 0x065},	/* Overflow, TX Filter Coefficient Program */
+	{0x06B, 0x06D},	/* TX RSSI */
+	{0x073, 0x07C},	/* TX Attenuation */
+	{0x08E, 0x0A9},	/* TX Quadrature Calibration */
+	{0x0C0, 0x0CC},	/* TX BBF Tune */
+	{0x0F0, 0x0F5},	/* RX Filter Coefficient Program */
+	{0x130, 0x149},	/* Gain Table, Gm Sub Table, Gain Step Calibration */
+	{0x160, 0x163},	/* Power Measurement */
+	{0x170, 0x1AE},	/* RX Quadrature and DC Tracking, RSSI */
+	{0x1C8, 0x1D2},	/* RF DC Offset Words */
+	{0x1DC, 0x1F3},	/* TIA and RX BBF Tune */
+	{0x226, 0x226},	/* Reset */
+	{0x231, 0x23A},	/* RX Synthesizer Words, Force ALC/VCO Tune */
+	{0x23D, 0x23D},	/* RX CP Config */
+	{0x241, 0x241},	/* RX Dither/CP Cal */
+	{0x244, 0x244},	/* RX Cal Status */
+	{0x247, 0x247},	/* RX CP Overrange/VCO Lock */
+	{0x249, 0x249},	/* RX VCO Cal */
+	{0x24E, 0x24F},	/* RX Correction Words */
+	{0x25A, 0x25F},	/* RX Fast Lock */
+	{0x271, 0x27A},	/* TX Synthesizer Words, Force ALC/VCO Tune */
+	{0x27D, 0x27D},	/* TX CP Config */
+	{0x281, 0x281},	/* TX Dither/CP Cal */
+	{0x284, 0x284},	/* TX Cal Status */
+	{0x287, 0x287},	/* TX CP Overrange/VCO Lock */
+	{0x289, 0x289},	/* TX VCO Cal */
+	{0x28E, 0x28F},	/* TX Correction Words */
+	{0x292, 0x29F},	/* DCXO, TX Fast Lock */
+	{0x2B0, 0x2B9},	/* Gain Readback, Overrange */
+};
+
+#define AD9361_SHADOW_MAX_DEV	4
+
+static struct ad9361_spi_shadow *ad9361_shadows[AD9361_SHADOW_MAX_DEV];
+
+/**
+ * Check if a register must bypass the shadow.
+ * @param reg The register address.
+ * @return true if the register is volatile.
+ */
+static bool ad9361_reg_volatile(uint32_t reg)
+{
+	uint32_t i;
+
+	if (reg >= AD9361_REG_NUM)
+		return true;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(ad9361_volatile_regs); i++) {
+		if (reg < ad9361_volatile_regs[i].first)
+			return false;
+		if (reg <= ad9361_volatile_regs[i].last)
+			return true;
+	}
+
+	return false;
+}
+
+/**
+ * Find the register shadow of a device.
+ * @param spi The device SPI descriptor.
+ * @return The shadow, or NULL if the device has none.
+ */
+static struct ad9361_spi_shadow *ad9361_shadow_get(struct no_os_spi_desc *spi)
+{
+	uint32_t i;
+
+	for (i = 0; i < AD9361_SHADOW_MAX_DEV; i++)
+		if (ad9361_shadows[i] && ad9361_shadows[i]->spi == spi)
+			return ad9361_shadows[i];
+
+	return NULL;
+}
+
+/**
+ * Test a register bit in a shadow bitmap.
+ * @param map The bitmap.
+ * @param reg The register address.
+ * @return true if the bit is set.
+ */
+static inline bool ad9361_shadow_test(const uint8_t *map, uint32_t reg)
+{
+	return map[reg >> 3] & NO_OS_BIT(reg & 7);
+}
+
+/**
+ * Set or clear a register bit in a shadow bitmap.
+ * @param map The bitmap.
+ * @param reg The register address.
+ * @param set Set (true) or clear (false) the bit.
+ * @return None.
+ */
+static inline void ad9361_shadow_assign(uint8_t *map, uint32_t reg, bool set)
+{
+	if (set)
+		map[reg >> 3] |= NO_OS_BIT(reg & 7);
+	else
+		map[reg >> 3] &= ~NO_OS_BIT(reg & 7);
+}
+
+/**
+ * Record a register value read from or written to the device.
+ * @param sh The register shadow.
+ * @param reg The register address.
+ * @param val The register value.
+ * @return None.
+ */
+static void ad9361_shadow_update(struct ad9361_spi_shadow *sh, uint32_t reg,
+				 uint8_t val)
+{
+	if (ad9361_reg_volatile(reg))
+		return;
+
+	sh->val[reg] = val;
+	ad9361_shadow_assign(sh->valid, reg, true);
+}
+
+/**
+ * SPI multiple bytes register write, bypassing the register shadow.
+ * @param spi
+ * @param reg The register address.
+ * @param tbuf The data buffer.
+ * @param num The number of bytes to write.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t __ad9361_spi_writem(struct no_os_spi_desc *spi,
+				   uint32_t reg, uint8_t *tbuf, uint32_t num)
+{
+	uint8_t buf[10];
+	int32_t ret;
+	uint16_t cmd;
+
+	if (num > MAX_MBYTE_SPI)
+		return -EINVAL;
+
+	cmd = AD_WRITE | AD_CNT(num) | AD_ADDR(reg);
+	buf[0] = cmd >> 8;
+	buf[1] = cmd & 0xFF;
+
+#ifndef ALTERA_PLATFORM
+	memcpy(&buf[2], tbuf, num);
+#else
+	int32_t i;
+	for (i = 0; i < num; i++)
+		buf[2 + i] =  tbuf[i];
+#endif
+	ret = no_os_spi_write_and_read(spi, buf, num + 2);
+	if (ret < 0) {
+		dev_err(&spi->dev, "Write Error %"PRId32, ret);
+		return ret;
+	}
+
+#ifdef _DEBUG
+	{
+		int32_t i;
+		for (i = 0; i < num; i++)
+			dev_dbg(&spi->dev, "Reg 0x%"PRIX32" val 0x%X", reg--, tbuf[i]);
+	}
+#endif
+
+	return 0;
+}
+
+/**
+ * Write the register values deferred by a batch, merging runs of adjacent
+ * registers into multi-byte transfers.
+ * @param spi
+ * @param sh The register shadow.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ad9361_shadow_flush(struct no_os_spi_desc *spi,
+				   struct ad9361_spi_shadow *sh)
+{
+	uint8_t buf[MAX_MBYTE_SPI];
+	int32_t reg, num, ret;
+
+	if (!sh->pending)
+		return 0;
+
+	sh->pending = false;
+
+	for (reg = AD9361_REG_NUM - 1; reg >= 0; reg--) {
+		if (!sh->dirty[reg >> 3]) {
+			reg &= ~7;
+			continue;
+		}
+		if (!ad9361_shadow_test(sh->dirty, reg))
+			continue;
+
+		/* Multi-byte writes go to descending addresses */
+		for (num = 0; num < MAX_MBYTE_SPI && reg - num >= 0 &&
+		     ad9361_shadow_test(sh->dirty, reg - num); num++) {
+			buf[num] = sh->val[reg - num];
+			ad9361_shadow_assign(sh->dirty, reg - num, false);
+		}
+
+		ret = __ad9361_spi_writem(spi, reg, buf, num);
+		if (ret < 0)
+			return ret;
+
+		sh->writes_merged += num - 1;
+		reg -= num - 1;
+	}
+
+	return 0;
+}
+
+/**
+ * Allocate the register shadow of a device.
+ * @param phy The AD9361 state structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_spi_shadow_init(struct ad9361_rf_phy *phy)
+{
+	struct ad9361_spi_shadow *sh;
+	uint32_t i;
+
+	for (i = 0; i < AD9361_SHADOW_MAX_DEV; i++)
+		if (!ad9361_shadows[i])
+			break;
+	if (i == AD9361_SHADOW_MAX_DEV)
+		return -EBUSY;
+
+	sh = no_os_calloc(1, sizeof(*sh));
+	if (!sh)
+		return -ENOMEM;
+
+	sh->spi = phy->spi;
+	ad9361_shadows[i] = sh;
+	phy->spi_shadow = sh;
+
+	return 0;
+}
+
+/**
+ * Free the register shadow of a device.
+ * @param phy The AD9361 state structure.
+ * @return None.
+ */
+void ad9361_spi_shadow_remove(struct ad9361_rf_phy *phy)
+{
+	uint32_t i;
+
+	if (!phy->spi_shadow)
+		return;
+
+	for (i = 0; i < AD9361_SHADOW_MAX_DEV; i++)
+		if (ad9361_shadows[i] == phy->spi_shadow)
+			ad9361_shadows[i] = NULL;
+
+	no_os_free(phy->spi_shadow);
+	phy->spi_shadow = NULL;
+}
+
+/**
+ * Drop the cached register values, e.g. after a device reset. Deferred
+ * writes are dropped as well.
+ * @param spi
+ * @return None.
+ */
+void ad9361_spi_shadow_invalidate(struct no_os_spi_desc *spi)
+{
+	struct ad9361_spi_shadow *sh = ad9361_shadow_get(spi);
+
+	if (!sh)
+		return;
+
+	memset(sh->valid, 0, sizeof(sh->valid));
+	memset(sh->dirty, 0, sizeof(sh->dirty));
+	sh->pending = false;
+}
+
+/**
+ * Start a write batch: until ad9361_spi_batch_end(), writes of non-volatile
+ * registers only update the shadow. Accesses to volatile registers and
+ * multi-byte accesses write the pending values out first, so the batch never
+ * reorders a write around them; it must not span delays the device relies
+ * on.
+ * @param spi
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_spi_batch_begin(struct no_os_spi_desc *spi)
+{
+	struct ad9361_spi_shadow *sh = ad9361_shadow_get(spi);
+
+	if (sh)
+		sh->batch = true;
+
+	return 0;
+}
+
+/**
+ * End a write batch and write the pending register values.
+ * @param spi
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_spi_batch_end(struct no_os_spi_desc *spi)
+{
+	struct ad9361_spi_shadow *sh = ad9361_shadow_get(spi);
+
+	if (!sh)
+		return 0;
+
+	sh->batch = false;
+
+	return ad9361_shadow_flush(spi, sh);
+}
+
 /**
  * SPI multiple bytes register read.
  * @param spi
@@ -700,26 +1022,40 @@ const char *ad9361_ensm_states[] = {
 int32_t ad9361_spi_readm(struct no_os_spi_desc *spi, uint32_t reg,
 			 uint8_t *rbuf, uint32_t num)
 {
+	struct ad9361_spi_shadow *sh = ad9361_shadow_get(spi);
+	uint8_t rbuffer[MAX_MBYTE_SPI + 2];
 	int32_t ret = 0;
+	uint32_t i;
 	uint16_t cmd;
-	uint8_t *rbuffer;
 	if (num > MAX_MBYTE_SPI)
 		return -EINVAL;
 
+	if (sh) {
+		if (num == 1 && !ad9361_reg_volatile(reg) &&
+		    ad9361_shadow_test(sh->valid, reg)) {
+			rbuf[0] = sh->val[reg];
+			sh->reads_saved++;
+			return 0;
+		}
+
+		ret = ad9361_shadow_flush(spi, sh);
+		if (ret < 0)
+			return ret;
+	}
+
 	cmd = AD_READ | AD_CNT(num) | AD_ADDR(reg);
-	rbuffer = no_os_malloc(num + 2);
-	if(!rbuffer)
-		return -ENOMEM;
 	rbuffer[0] = cmd >> 8;
 	rbuffer[1] = cmd & 0xFF;
 	ret = no_os_spi_write_and_read(spi, &rbuffer[0], 2 + num);
 
-	if (ret < 0)
+	if (ret < 0) {
 		dev_err(&spi->dev, "Read Error %"PRId32, ret);
-	else
+	} else {
 		memcpy(rbuf, &rbuffer[2], num);
+		for (i = 0; sh && i < num; i++)
+			ad9361_shadow_update(sh, reg - i, rbuf[i]);
+	}
 
-	no_os_free(rbuffer);
 #ifdef _DEBUG
 	{
 		int32_t i;
@@ -759,8 +1095,13 @@ int32_t ad9361_spi_read(struct no_os_spi_desc *spi, uint32_t reg)
  */
 int32_t ad9361_reg_read(struct ad9361_rf_phy *phy, uint32_t reg, uint32_t *val)
 {
+	struct ad9361_spi_shadow *sh = phy->spi_shadow;
 	int32_t ret;
 
+	/* Debug reads always come from the device */
+	if (sh && reg < AD9361_REG_NUM)
+		ad9361_shadow_assign(sh->valid, reg, false);
+
 	ret = ad9361_spi_read(phy->spi, reg);
 	if (ret < 0)
 		return ret;
@@ -817,10 +1158,34 @@ static int32_t __ad9361_spi_readf(struct no_os_spi_desc *spi, uint32_t reg,
 int32_t ad9361_spi_write(struct no_os_spi_desc *spi,
 			 uint32_t reg, uint32_t val)
 {
+	struct ad9361_spi_shadow *sh = ad9361_shadow_get(spi);
 	uint8_t buf[3];
 	int32_t ret;
 	uint16_t cmd;
 
+	if (sh && !ad9361_reg_volatile(reg)) {
+		if (ad9361_shadow_test(sh->valid, reg) &&
+		    sh->val[reg] == (uint8_t)val) {
+			sh->writes_saved++;
+			return 0;
+		}
+
+		if (sh->batch) {
+			if (ad9361_shadow_test(sh->dirty, reg))
+				sh->writes_merged++;
+			ad9361_shadow_update(sh, reg, val);
+			ad9361_shadow_assign(sh->dirty, reg, true);
+			sh->pending = true;
+			return 0;
+		}
+	}
+
+	if (sh) {
+		ret = ad9361_shadow_flush(spi, sh);
+		if (ret < 0)
+			return ret;
+	}
+
 	cmd = AD_WRITE | AD_CNT(1) | AD_ADDR(reg);
 	buf[0] = cmd >> 8;
 	buf[1] = cmd & 0xFF;
@@ -832,6 +1197,13 @@ int32_t ad9361_spi_write(struct no_os_spi_desc *spi,
 		return ret;
 	}
 
+	if (sh) {
+		if (reg == REG_SPI_CONF && (val & SOFT_RESET))
+			ad9361_spi_shadow_invalidate(spi);
+		else
+			ad9361_shadow_update(sh, reg, val);
+	}
+
 #ifdef _DEBUG
 	dev_dbg(&spi->dev, "%s: reg 0x%"PRIX32" val 0x%X", __func__, reg, buf[2]);
 #endif
@@ -896,43 +1268,28 @@ static int32_t __ad9361_spi_writef(struct no_os_spi_desc *spi, uint32_t reg,
  * @param spi
  * @param reg The register address.
  * @param tbuf The data buffer.
- * @param num The number of bytes to read.
+ * @param num The number of bytes to write.
  * @return 0 in case of success, negative error code otherwise.
  */
 static int32_t ad9361_spi_writem(struct no_os_spi_desc *spi,
 				 uint32_t reg, uint8_t *tbuf, uint32_t num)
 {
-	uint8_t buf[10];
+	struct ad9361_spi_shadow *sh = ad9361_shadow_get(spi);
+	uint32_t i;
 	int32_t ret;
-	uint16_t cmd;
-
-	if (num > MAX_MBYTE_SPI)
-		return -EINVAL;
 
-	cmd = AD_WRITE | AD_CNT(num) | AD_ADDR(reg);
-	buf[0] = cmd >> 8;
-	buf[1] = cmd & 0xFF;
+	if (sh) {
+		ret = ad9361_shadow_flush(spi, sh);
+		if (ret < 0)
+			return ret;
+	}
 
-#ifndef ALTERA_PLATFORM
-	memcpy(&buf[2], tbuf, num);
-#else
-	int32_t i;
-	for (i = 0; i < num; i++)
-		buf[2 + i] =  tbuf[i];
-#endif
-	ret = no_os_spi_write_and_read(spi, buf, num + 2);
-	if (ret < 0) {
-		dev_err(&spi->dev, "Write Error %"PRId32, ret);
+	ret = __ad9361_spi_writem(spi, reg, tbuf, num);
+	if (ret < 0)
 		return ret;
-	}
 
-#ifdef _DEBUG
-	{
-		int32_t i;
-		for (i = 0; i < num; i++)
-			dev_dbg(&spi->dev, "Reg 0x%"PRIX32" val 0x%X", reg--, tbuf[i]);
-	}
-#endif
+	for (i = 0; sh && i < num; i++)
+		ad9361_shadow_update(sh, reg - i, tbuf[i]);
 
 	return 0;
 }
@@ -1052,6 +1409,7 @@ int32_t ad9361_reset(struct ad9361_rf_phy *phy)
 		no_os_mdelay(1);
 		no_os_gpio_set_value(phy->gpio_desc_resetb, 1);
 		no_os_mdelay(1);
+		ad9361_spi_shadow_invalidate(phy->spi);
 		dev_dbg(&phy->spi->dev, "%s: by GPIO", __func__);
 		return 0;
 	}
@@ -1437,6 +1795,98 @@ static int find_table_index(struct ad9361_rf_phy *phy, int gain)
 	return -EINVAL;
 }
 
+/**
+ * Get the pre-serialized image of a band's gain table, building it on first
+ * use (or when the external LNA setting changed).
+ * @param phy The AD9361 state structure.
+ * @param band The gain table index.
+ * @param lna The DATA1 bits selecting the external LNA gain.
+ * @return The image in case of success, NULL otherwise.
+ */
+static struct ad9361_gt_image *ad9361_gt_image_get(struct ad9361_rf_phy *phy,
+		uint32_t band, uint8_t lna)
+{
+	struct ad9361_gt_image *img;
+	uint8_t (*tab)[3] = phy->gt_info[band].tab;
+	uint32_t i, nb_tables, lpf_tia_mask;
+
+	if (!phy->gt_image) {
+		for (nb_tables = 0; phy->gt_info[nb_tables].tab; nb_tables++)
+			;
+
+		phy->gt_image = no_os_calloc(nb_tables, sizeof(*phy->gt_image));
+		if (!phy->gt_image)
+			return NULL;
+	}
+
+	img = &phy->gt_image[band];
+	if (img->data && img->lna == lna)
+		return img;
+
+	if (!img->data) {
+		img->data = no_os_calloc(phy->gt_info[band].max_index,
+					 sizeof(*img->data));
+		if (!img->data)
+			return NULL;
+	}
+
+	/* TX QUAD Calibration */
+	if (phy->gt_info[band].split_table)
+		lpf_tia_mask = 0x20;
+	else
+		lpf_tia_mask = 0x3F;
+
+	img->tx_quad_lpf_tia_match = -EINVAL;
+	for (i = 0; i < phy->gt_info[band].max_index; i++) {
+		img->data[i][0] = tab[i][2]; /* DC Cal bit & Dig Gain Word */
+		img->data[i][1] = tab[i][1]; /* TIA & LPF Word */
+		img->data[i][2] = tab[i][0] | lna; /* Ext LNA, Int LNA, & Mixer Gain Word */
+		img->data[i][3] = i; /* Gain Table Index */
+
+		if ((tab[i][1] & lpf_tia_mask) == 0x20)
+			img->tx_quad_lpf_tia_match = i;
+	}
+	img->lna = lna;
+
+	return img;
+}
+
+/**
+ * Free the gain table images.
+ * @param phy The AD9361 state structure.
+ * @return None.
+ */
+void ad9361_free_gt_images(struct ad9361_rf_phy *phy)
+{
+	uint32_t i;
+
+	if (!phy->gt_image)
+		return;
+
+	for (i = 0; phy->gt_info[i].tab; i++)
+		no_os_free(phy->gt_image[i].data);
+
+	no_os_free(phy->gt_image);
+	phy->gt_image = NULL;
+}
+
+/**
+ * Multiple bytes register write, accounted in the gain table load statistics.
+ * @param phy The AD9361 state structure.
+ * @param reg The register address.
+ * @param buf The data buffer.
+ * @param num The number of bytes to write.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ad9361_gt_writem(struct ad9361_rf_phy *phy, uint32_t reg,
+				uint8_t *buf, uint32_t num)
+{
+	phy->gt_load_stats.spi_frames++;
+	phy->gt_load_stats.spi_bytes += num + 2;
+
+	return ad9361_spi_writem(phy->spi, reg, buf, num);
+}
+
 /**
  * Load the gain table for the selected frequency range and receiver.
  * @param phy The AD9361 state structure.
@@ -1448,9 +1898,13 @@ static int32_t ad9361_load_gt(struct ad9361_rf_phy *phy, uint64_t freq,
 			      uint32_t dest)
 {
 	struct no_os_spi_desc *spi = phy->spi;
-	uint8_t (*tab)[3];
-	uint32_t band, index_max, i, lna, lpf_tia_mask, set_gain;
+	struct ad9361_gt_image *img;
+	struct no_os_time start, end;
+	uint32_t band, index_max, i, lna, set_gain, len;
+	uint32_t adc_clk, sclk, req_ns, bit_ns, delay_us = 0;
+	uint8_t buf[MAX_MBYTE_SPI];
 	int32_t ret, rx1_gain, rx2_gain;
+	bool stream;
 
 	dev_dbg(&phy->spi->dev, "%s: frequency %"PRIu64, __func__, freq);
 
@@ -1460,12 +1914,24 @@ static int32_t ad9361_load_gt(struct ad9361_rf_phy *phy, uint64_t freq,
 		__func__, freq, band);
 
 	/* check if table is present */
-	if (phy->current_table == band)
+	if (phy->current_table == band) {
+		phy->gt_load_stats.skipped++;
 		return 0;
+	}
+
+	lna = phy->pdata->elna_ctrl.elna_in_gaintable_all_index_en ?
+	      EXT_LNA_CTRL : 0;
+
+	img = ad9361_gt_image_get(phy, band, lna);
+	if (!img)
+		return -ENOMEM;
 
-	tab = phy->gt_info[band].tab;
 	index_max = phy->gt_info[band].max_index;
 
+	start = no_os_get_time();
+	phy->gt_load_stats.spi_frames = 0;
+	phy->gt_load_stats.spi_bytes = 0;
+
 	ad9361_spi_writef(spi, REG_AGC_CONFIG_2,
 			  AGC_USE_FULL_GAIN_TABLE, !phy->pdata->split_gt);
 
@@ -1496,41 +1962,51 @@ static int32_t ad9361_load_gt(struct ad9361_rf_phy *phy, uint64_t freq,
 		rx2_gain = phy->gt_info[band].abs_gain_tbl[set_gain];
 	}
 
-	lna = phy->pdata->elna_ctrl.elna_in_gaintable_all_index_en ?
-	      EXT_LNA_CTRL : 0;
-
 	ad9361_spi_write(spi, REG_GAIN_TABLE_CONFIG, START_GAIN_TABLE_CLOCK |
 			 RECEIVER_SELECT(dest)); /* Start Gain Table Clock */
 
-	/* TX QUAD Calibration */
-	if (phy->pdata->split_gt)
-		lpf_tia_mask = 0x20;
-	else
-		lpf_tia_mask = 0x3F;
+	phy->tx_quad_lpf_tia_match = img->tx_quad_lpf_tia_match;
 
-	phy->tx_quad_lpf_tia_match = -EINVAL;
-
-	for (i = 0; i < index_max; i++) {
-		ad9361_spi_write(spi, REG_GAIN_TABLE_ADDRESS, i); /* Gain Table Index */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_WRITE_DATA1,
-				 tab[i][0] | lna); /* Ext LNA, Int LNA, & Mixer Gain Word */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_WRITE_DATA2,
-				 tab[i][1]); /* TIA & LPF Word */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_WRITE_DATA3,
-				 tab[i][2]); /* DC Cal bit & Dig Gain Word */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_CONFIG,
-				 START_GAIN_TABLE_CLOCK |
-				 WRITE_GAIN_TABLE |
-				 RECEIVER_SELECT(dest)); /* Gain Table Index */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_READ_DATA1,
-				 0); /* Dummy Write to delay 3 ADCCLK/16 cycles */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_READ_DATA1,
-				 0); /* Dummy Write to delay ~1u */
+	/*
+	 * After each write strobe, the next index must not be loaded before
+	 * 3 ADCCLK/16 cycles plus ~1us have passed. A descending 8-byte write
+	 * starting at GAIN_TABLE_CONFIG strobes the previous index, clocks
+	 * 3 dummy bytes (READ_DATA3..1) and then loads the next index, so one
+	 * frame per index is enough when those 32 SCLK cycles cover the delay.
+	 * Otherwise the strobe and the next index go in separate frames.
+	 */
+	adc_clk = clk_get_rate(phy, phy->ref_clk_scale[ADC_CLK]);
+	req_ns = adc_clk >= 1000 ? 48000000UL / (adc_clk / 1000) + 1000 : 3000;
+	sclk = spi->max_speed_hz ? spi->max_speed_hz : 1000000;
+	bit_ns = NO_OS_DIV_ROUND_UP(1000000000UL, sclk);
+	stream = 32 * bit_ns >= req_ns;
+	if (!stream && req_ns > 48 * bit_ns)
+		delay_us = NO_OS_DIV_ROUND_UP(req_ns - 48 * bit_ns, 1000);
+
+	memset(buf, 0, sizeof(buf));
+	buf[0] = START_GAIN_TABLE_CLOCK | WRITE_GAIN_TABLE |
+		 RECEIVER_SELECT(dest);
+
+	ret = ad9361_gt_writem(phy, REG_GAIN_TABLE_WRITE_DATA3, img->data[0], 4);
+	for (i = 1; !ret && i <= index_max; i++) {
+		len = 4;
+		if (stream && i < index_max) {
+			memcpy(&buf[4], img->data[i], 4);
+			len = 8;
+		}
 
-		if ((tab[i][1] & lpf_tia_mask) == 0x20)
-			phy->tx_quad_lpf_tia_match = i;
+		ret = ad9361_gt_writem(phy, REG_GAIN_TABLE_CONFIG, buf, len);
+		if (ret || stream || i == index_max)
+			continue;
+
+		if (delay_us)
+			no_os_udelay(delay_us);
 
+		ret = ad9361_gt_writem(phy, REG_GAIN_TABLE_WRITE_DATA3,
+				       img->data[i], 4);
 	}
+	if (ret < 0)
+		return ret;
 
 	ad9361_spi_write(spi, REG_GAIN_TABLE_CONFIG, START_GAIN_TABLE_CLOCK |
 			 RECEIVER_SELECT(dest)); /* Clear Write Bit */
@@ -1556,6 +2032,11 @@ static int32_t ad9361_load_gt(struct ad9361_rf_phy *phy, uint64_t freq,
 	ad9361_spi_write(spi, REG_RX2_MANUAL_LMT_FULL_GAIN,
 			 ret); /* Rx2 Full/LMT Gain Index */
 
+	end = no_os_get_time();
+	phy->gt_load_stats.loads++;
+	phy->gt_load_stats.band = band;
+	phy->gt_load_stats.time_us = (end.s - start.s) * 1000000 + end.us - start.us;
+
 	return 0;
 }
 
@@ -2726,6 +3207,8 @@ static int32_t ad9361_rx_bb_analog_filter_calib(struct ad9361_rf_phy *phy,
 	phy->rxbbf_div = no_os_min_t(uint32_t, 511UL, NO_OS_DIV_ROUND_UP(bbpll_freq,
 				     target));
 
+	ad9361_spi_batch_begin(phy->spi);
+
 	/* Set RX baseband filter divide value */
 	ad9361_spi_write(phy->spi, REG_RX_BBF_TUNE_DIVIDE, phy->rxbbf_div);
 	ad9361_spi_writef(phy->spi, REG_RX_BBF_TUNE_CONFIG, NO_OS_BIT(0),
@@ -2742,6 +3225,10 @@ static int32_t ad9361_rx_bb_analog_filter_calib(struct ad9361_rf_phy *phy,
 	ad9361_spi_write(phy->spi, REG_RX_MIX_GM_CONFIG,
 			 RX_MIX_GM_PLOAD(3)); /* Set GM common mode */
 
+	ret = ad9361_spi_batch_end(phy->spi);
+	if (ret < 0)
+		return ret;
+
 	/* Enable the RX BBF tune circuit by writing 0x1E2=0x02 and 0x1E3=0x02 */
 	ad9361_spi_write(phy->spi, REG_RX1_TUNE_CTRL, RX1_TUNE_RESAMPLE);
 	ad9361_spi_write(phy->spi, REG_RX2_TUNE_CTRL, RX2_TUNE_RESAMPLE);
@@ -2881,9 +3368,12 @@ static int32_t ad9361_txrx_synth_cp_calib(struct ad9361_rf_phy *phy,
 {
 	uint32_t offs = tx ? 0x40 : 0;
 	uint32_t vco_cal_cnt;
+	int32_t ret;
 	dev_dbg(&phy->spi->dev, "%s : ref_clk_hz %"PRIu32" : is_tx %d",
 		__func__, ref_clk_hz, tx);
 
+	ad9361_spi_batch_begin(phy->spi);
+
 	/* REVIST: */
 	ad9361_spi_write(phy->spi, REG_RX_CP_LEVEL_DETECT + offs, 0x17);
 
@@ -2894,6 +3384,9 @@ static int32_t ad9361_txrx_synth_cp_calib(struct ad9361_rf_phy *phy,
 	ad9361_spi_write(phy->spi, REG_RX_VCO_PD_OVERRIDES + offs, 0x02);
 	ad9361_spi_write(phy->spi, REG_RX_CP_CURRENT + offs, 0x80);
 	ad9361_spi_write(phy->spi, REG_RX_CP_CONFIG + offs, CP_OFFSET_OFF);
+	ret = ad9361_spi_batch_end(phy->spi);
+	if (ret < 0)
+		return ret;
 
 	/* see Table 70 Example Calibration Times for RF VCO Cal */
 	if (phy->pdata->fdd) {
@@ -3729,9 +4222,13 @@ static int32_t ad9361_gc_setup(struct ad9361_rf_phy *phy,
 {
 	struct no_os_spi_desc *spi = phy->spi;
 	uint32_t reg, tmp1, tmp2;
+	int32_t ret;
 
 	dev_dbg(&phy->spi->dev, "%s", __func__);
 
+	/* Plain configuration registers: merge the field updates */
+	ad9361_spi_batch_begin(spi);
+
 	reg = DEC_PWR_FOR_GAIN_LOCK_EXIT | DEC_PWR_FOR_LOCK_LEVEL |
 	      DEC_PWR_FOR_LOW_PWR;
 
@@ -4063,6 +4560,10 @@ static int32_t ad9361_gc_setup(struct ad9361_rf_phy *phy,
 	ad9361_spi_writef(spi, REG_RX1_MANUAL_LMT_FULL_GAIN,
 			  POWER_MEAS_IN_STATE_5_MSB, reg >> 3);
 
+	ret = ad9361_spi_batch_end(spi);
+	if (ret < 0)
+		return ret;
+
 	return ad9361_gc_update(phy);
 }
 
@@ -5244,6 +5745,286 @@ int32_t ad9361_fastlock_save(struct ad9361_rf_phy *phy, bool tx,
 	return 0;
 }
 
+/**
+ * Pick the hardware slot to overwrite with a new hop profile: an empty slot,
+ * otherwise the one holding the hop that is furthest away in plan order.
+ * The slot the synthesizer currently runs from is never chosen.
+ * @param plan The hop plan.
+ * @param index The hop the distances are measured from.
+ * @param dist The distance of the chosen slot (plan->n for an empty slot).
+ * @return The hardware slot.
+ */
+static uint32_t ad9361_hop_victim(struct ad9361_hop_plan *plan,
+				  uint32_t index, uint32_t *dist)
+{
+	uint32_t i, d, best = 0;
+	uint8_t active = plan->phy->fastlock.current_profile[plan->tx];
+
+	*dist = 0;
+	for (i = 0; i < AD9361_HOP_HW_SLOTS; i++) {
+		if (i + 1 == active)
+			continue;
+		if (plan->slot[i] < 0)
+			d = plan->n;
+		else
+			d = (plan->slot[i] + plan->n - index) % plan->n;
+
+		if (d > *dist) {
+			*dist = d;
+			best = i;
+		}
+	}
+
+	return best;
+}
+
+/**
+ * Find the hardware slot holding a hop profile.
+ * @param plan The hop plan.
+ * @param index The hop index.
+ * @return The hardware slot, or -1 if the hop is not resident.
+ */
+static int32_t ad9361_hop_find(struct ad9361_hop_plan *plan, uint32_t index)
+{
+	int32_t i;
+
+	for (i = 0; i < AD9361_HOP_HW_SLOTS; i++)
+		if (plan->slot[i] == (int32_t)index)
+			return i;
+
+	return -1;
+}
+
+/**
+ * Remove a frequency hop plan, leaving fastlock mode.
+ * @param phy The AD9361 state structure.
+ * @param tx Remove the TX plan (true) or the RX plan (false).
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_hop_plan_remove(struct ad9361_rf_phy *phy, bool tx)
+{
+	struct ad9361_hop_plan *plan = phy->hop_plan[tx];
+
+	if (!plan)
+		return 0;
+
+	ad9361_fastlock_prepare(phy, tx, 0, false);
+
+	no_os_free(plan->words);
+	no_os_free(plan->freq);
+	no_os_free(plan);
+	phy->hop_plan[tx] = NULL;
+
+	return 0;
+}
+
+/**
+ * Create a frequency hop plan. Each LO frequency is tuned and VCO calibrated
+ * once, its fastlock profile words are kept in a software cache, and the
+ * first hops are loaded into the hardware profile slots. The synthesizer is
+ * left on hop 0.
+ * @param phy The AD9361 state structure.
+ * @param tx Create the TX plan (true) or the RX plan (false).
+ * @param freq The LO frequencies (Hz), in hop order.
+ * @param n The number of hops.
+ * @param lookahead The number of upcoming hops to keep resident in hardware
+ * 		    (at most AD9361_HOP_HW_SLOTS - 1).
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_hop_plan_init(struct ad9361_rf_phy *phy, bool tx,
+			     const uint64_t *freq, uint32_t n, uint32_t lookahead)
+{
+	struct ad9361_hop_plan *plan;
+	uint32_t i;
+	int32_t ret;
+
+	if (!freq || !n)
+		return -EINVAL;
+
+	ad9361_hop_plan_remove(phy, tx);
+
+	plan = no_os_calloc(1, sizeof(*plan));
+	if (!plan)
+		return -ENOMEM;
+
+	plan->freq = no_os_calloc(n, sizeof(*plan->freq));
+	plan->words = no_os_calloc(n, sizeof(*plan->words));
+	if (!plan->freq || !plan->words) {
+		ret = -ENOMEM;
+		goto error;
+	}
+
+	plan->phy = phy;
+	plan->tx = tx;
+	plan->n = n;
+	plan->lookahead = no_os_min_t(uint32_t, lookahead, AD9361_HOP_HW_SLOTS - 1);
+
+	/* Calibrate every hop once, using slot 0 as scratch */
+	for (i = 0; i < n; i++) {
+		plan->freq[i] = freq[i];
+		ret = no_os_clk_set_rate(phy,
+					 phy->ref_clk_scale[tx ? TX_RFPLL : RX_RFPLL],
+					 ad9361_to_clk(freq[i]));
+		if (ret < 0)
+			goto error;
+		ret = ad9361_fastlock_store(phy, tx, 0);
+		if (ret < 0)
+			goto error;
+		ret = ad9361_fastlock_save(phy, tx, 0, plan->words[i]);
+		if (ret < 0)
+			goto error;
+	}
+
+	for (i = 0; i < AD9361_HOP_HW_SLOTS; i++) {
+		if (i < n) {
+			ret = ad9361_fastlock_load(phy, tx, i, plan->words[i]);
+			if (ret < 0)
+				goto error;
+			plan->slot[i] = i;
+		} else {
+			plan->slot[i] = -1;
+		}
+	}
+
+	phy->hop_plan[tx] = plan;
+
+	ret = ad9361_hop_to(phy, tx, 0);
+	if (ret < 0) {
+		ad9361_hop_plan_remove(phy, tx);
+		return ret;
+	}
+	plan->hops = 0;
+
+	return 0;
+
+error:
+	no_os_free(plan->words);
+	no_os_free(plan->freq);
+	no_os_free(plan);
+
+	return ret;
+}
+
+/**
+ * Hop to an entry of the frequency hop plan. The entry's profile is recalled
+ * (loaded first if it is not resident), then the next plan->lookahead hops
+ * are paged into the hardware slots so that the following hops only cost a
+ * profile recall.
+ * @param phy The AD9361 state structure.
+ * @param tx Hop the TX LO (true) or the RX LO (false).
+ * @param index The hop index.
+ * @return The hardware slot now in use, negative error code otherwise.
+ */
+int32_t ad9361_hop_to(struct ad9361_rf_phy *phy, bool tx, uint32_t index)
+{
+	struct ad9361_hop_plan *plan = phy->hop_plan[tx];
+	uint32_t i, next, dist, victim;
+	int32_t slot, ret;
+
+	if (!plan || index >= plan->n)
+		return -EINVAL;
+
+	slot = ad9361_hop_find(plan, index);
+	if (slot < 0) {
+		plan->misses++;
+		slot = ad9361_hop_victim(plan, index, &dist);
+		ret = ad9361_fastlock_load(phy, tx, slot, plan->words[index]);
+		if (ret < 0)
+			return ret;
+		plan->slot[slot] = index;
+	}
+
+	ret = ad9361_fastlock_recall(phy, tx, slot);
+	if (ret < 0)
+		return ret;
+
+	plan->pos = index;
+	plan->hops++;
+
+	/* Recall does not go through ad9361_rfpll_set_rate() */
+	if (!tx) {
+		ret = ad9361_load_gt(phy, plan->freq[index], GT_RX1 + GT_RX2);
+		if (ret < 0)
+			return ret;
+	}
+
+	for (i = 1; i <= plan->lookahead && i < plan->n; i++) {
+		next = (index + i) % plan->n;
+		if (ad9361_hop_find(plan, next) >= 0)
+			continue;
+
+		victim = ad9361_hop_victim(plan, index, &dist);
+		if (dist <= i)
+			break;
+		ret = ad9361_fastlock_load(phy, tx, victim, plan->words[next]);
+		if (ret < 0)
+			return ret;
+		plan->slot[victim] = next;
+	}
+
+	return slot;
+}
+
+/**
+ * Hop to the next entry of the frequency hop plan, wrapping around.
+ * @param phy The AD9361 state structure.
+ * @param tx Hop the TX LO (true) or the RX LO (false).
+ * @return The hardware slot now in use, negative error code otherwise.
+ */
+int32_t ad9361_hop_next(struct ad9361_rf_phy *phy, bool tx)
+{
+	struct ad9361_hop_plan *plan = phy->hop_plan[tx];
+
+	if (!plan)
+		return -EINVAL;
+
+	return ad9361_hop_to(phy, tx, (plan->pos + 1) % plan->n);
+}
+
+/**
+ * Do the hops requested by ad9361_hop_handler() since the last call. A hop
+ * takes SPI transfers and, for RX, a gain table load, so this has to be
+ * called from thread context (e.g. the main loop), never from an interrupt.
+ * If several requests are pending, the plan skips to the hop of the last one.
+ * @param phy The AD9361 state structure.
+ * @param tx Hop the TX LO (true) or the RX LO (false).
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_hop_process(struct ad9361_rf_phy *phy, bool tx)
+{
+	struct ad9361_hop_plan *plan = phy->hop_plan[tx];
+	uint32_t pending;
+	int32_t ret;
+
+	if (!plan)
+		return -EINVAL;
+
+	/* Only the interrupt writes requests, only this writes requests_done */
+	pending = plan->requests - plan->requests_done;
+	if (!pending)
+		return 0;
+
+	plan->requests_done += pending;
+	ret = ad9361_hop_to(phy, tx, (plan->pos + pending) % plan->n);
+
+	return ret < 0 ? ret : 0;
+}
+
+/**
+ * Frequency hop request, to be registered with a timer interrupt or with the
+ * interrupt backing an IIO hardware trigger (struct no_os_callback_desc, ctx
+ * set to phy->hop_plan[tx]). It only records the request, the hop is done by
+ * ad9361_hop_process().
+ * @param plan The hop plan.
+ * @return None.
+ */
+void ad9361_hop_handler(void *plan)
+{
+	struct ad9361_hop_plan *p = plan;
+
+	p->requests++;
+}
+
 /**
  * Multi Chip Sync (MCS) config.
  * @param phy The AD9361 state structure.
@@ -2889,6 +2889,30 @@ struct gain_table_info {
 	uint8_t (*tab)[3];
 };
 
+/**
+ * Gain table pre-serialized for one band: {DATA3, DATA2, DATA1, ADDRESS} per
+ * index, in the order a descending multi-byte write puts them on the bus.
+ */
+struct ad9361_gt_image {
+	uint8_t (*data)[4];
+	uint8_t lna;
+	int32_t tx_quad_lpf_tia_match;
+};
+
+/**
+ * Gain table load diagnostics, updated by ad9361_load_gt().
+ */
+struct ad9361_gt_load_stats {
+	/* Number of table loads and of skipped (same band) loads */
+	uint32_t loads;
+	uint32_t skipped;
+	/* Last load: band, table stream SPI frames and bytes, duration */
+	uint32_t band;
+	uint32_t spi_frames;
+	uint32_t spi_bytes;
+	uint32_t time_us;
+};
+
 enum fir_dest {
 	FIR_TX1 = 0x01,
 	FIR_TX2 = 0x02,
@@ -3297,6 +3321,27 @@ struct ad9361_debugfs_entry {
 	uint8_t cmd;
 };
 
+#define AD9361_REG_NUM	0x400
+
+/**
+ * Shadow of the non-volatile part of the register space. Single register
+ * reads and read-modify-writes of cached registers do not go on the bus,
+ * writes of an unchanged value are dropped, and writes issued inside a
+ * batch are deferred and merged into multi-byte transfers.
+ */
+struct ad9361_spi_shadow {
+	struct no_os_spi_desc *spi;
+	uint8_t val[AD9361_REG_NUM];
+	uint8_t valid[AD9361_REG_NUM / 8];
+	uint8_t dirty[AD9361_REG_NUM / 8];
+	bool batch;
+	bool pending;
+	/* Bus accesses avoided */
+	uint32_t reads_saved;
+	uint32_t writes_saved;
+	uint32_t writes_merged;
+};
+
 struct ad9361_fastlock_entry {
 #define FASTLOOK_INIT	1
 	uint8_t flags;
@@ -3310,6 +3355,32 @@ struct ad9361_fastlock {
 	struct ad9361_fastlock_entry entry[2][8];
 };
 
+#define AD9361_HOP_HW_SLOTS	8
+
+/**
+ * Frequency hop plan: software cache of the fastlock profile words of every
+ * hop, paged into the 8 hardware profile slots ahead of use.
+ */
+struct ad9361_hop_plan {
+	struct ad9361_rf_phy *phy;
+	bool tx;
+	uint32_t n;
+	uint64_t *freq;
+	uint8_t (*words)[RX_FAST_LOCK_CONFIG_WORD_NUM];
+	/* Index of the current hop */
+	uint32_t pos;
+	/* Number of upcoming hops kept resident in hardware */
+	uint32_t lookahead;
+	/* Hop index held by each hardware slot, -1 if none */
+	int32_t slot[AD9361_HOP_HW_SLOTS];
+	/* Hops done and hops that had to wait for a profile load */
+	uint32_t hops;
+	uint32_t misses;
+	/* Hops requested by ad9361_hop_handler() and hops done for them */
+	volatile uint32_t requests;
+	uint32_t requests_done;
+};
+
 enum dig_tune_flags {
 	BE_VERBOSE = 1,
 	BE_MOREVERBOSE = 2,
@@ -3365,6 +3436,8 @@ struct ad9361_rf_phy {
 	int32_t			tx_quad_lpf_tia_match;
 	uint32_t		current_table;
 	struct gain_table_info  *gt_info;
+	struct ad9361_gt_image	*gt_image;
+	struct ad9361_gt_load_stats	gt_load_stats;
 	bool 			ensm_pin_ctl_en;
 
 	bool			auto_cal_en;
@@ -3405,6 +3478,8 @@ struct ad9361_rf_phy {
 	uint32_t 			tx1_atten_cached;
 	uint32_t 			tx2_atten_cached;
 	struct ad9361_fastlock	fastlock;
+	struct ad9361_spi_shadow	*spi_shadow;
+	struct ad9361_hop_plan	*hop_plan[2];
 	struct axiadc_converter	*adc_conv;
 	struct axiadc_state		*adc_state;
 	int32_t					bist_loopback_mode;
@@ -3449,11 +3524,17 @@ int32_t ad9361_spi_write(struct no_os_spi_desc *spi,
 			 uint32_t reg, uint32_t val);
 int32_t ad9361_reg_write(struct ad9361_rf_phy *phy,
 			 uint32_t reg, uint32_t val);
+int32_t ad9361_spi_shadow_init(struct ad9361_rf_phy *phy);
+void ad9361_spi_shadow_remove(struct ad9361_rf_phy *phy);
+void ad9361_spi_shadow_invalidate(struct no_os_spi_desc *spi);
+int32_t ad9361_spi_batch_begin(struct no_os_spi_desc *spi);
+int32_t ad9361_spi_batch_end(struct no_os_spi_desc *spi);
 int32_t ad9361_reset(struct ad9361_rf_phy *phy);
 int32_t ad9361_register_clocks(struct ad9361_rf_phy *phy);
 int32_t ad9361_unregister_clocks(struct ad9361_rf_phy *phy);
 uint32_t ad9361_gt(struct ad9361_rf_phy *phy);
 int32_t ad9361_init_gain_tables(struct ad9361_rf_phy *phy);
+void ad9361_free_gt_images(struct ad9361_rf_phy *phy);
 int32_t ad9361_setup(struct ad9361_rf_phy *phy);
 int32_t ad9361_post_setup(struct ad9361_rf_phy *phy);
 int32_t ad9361_set_ensm_mode(struct ad9361_rf_phy *phy, bool fdd, bool pinctrl);
@@ -3541,6 +3622,13 @@ int32_t ad9361_fastlock_load(struct ad9361_rf_phy *phy, bool tx,
 			     uint32_t profile, uint8_t *values);
 int32_t ad9361_fastlock_save(struct ad9361_rf_phy *phy, bool tx,
 			     uint32_t profile, uint8_t *values);
+int32_t ad9361_hop_plan_init(struct ad9361_rf_phy *phy, bool tx,
+			     const uint64_t *freq, uint32_t n, uint32_t lookahead);
+int32_t ad9361_hop_plan_remove(struct ad9361_rf_phy *phy, bool tx);
+int32_t ad9361_hop_to(struct ad9361_rf_phy *phy, bool tx, uint32_t index);
+int32_t ad9361_hop_next(struct ad9361_rf_phy *phy, bool tx);
+int32_t ad9361_hop_process(struct ad9361_rf_phy *phy, bool tx);
+void ad9361_hop_handler(void *plan);
 void ad9361_ensm_force_state(struct ad9361_rf_phy *phy, uint8_t ensm_state);
 uint8_t ad9361_ensm_get_state(struct ad9361_rf_phy *phy);
 void ad9361_ensm_restore_state(struct ad9361_rf_phy *phy, uint8_t ensm_state);
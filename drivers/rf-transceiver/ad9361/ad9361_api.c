@@ -507,6 +507,10 @@ int32_t ad9361_init (struct ad9361_rf_phy **ad9361_phy,
 
 	no_os_spi_init(&phy->spi, &init_param->spi_param);
 
+	ret = ad9361_spi_shadow_init(phy);
+	if (ret < 0)
+		goto out;
+
 	phy->pdata->port_ctrl.digital_io_ctrl = 0;
 	phy->pdata->port_ctrl.lvds_invert[0] = init_param->lvds_invert1_control;
 	phy->pdata->port_ctrl.lvds_invert[1] = init_param->lvds_invert2_control;
@@ -582,6 +586,8 @@ int32_t ad9361_init (struct ad9361_rf_phy **ad9361_phy,
 out_clk:
 	ad9361_unregister_clocks(phy);
 out:
+	ad9361_spi_shadow_remove(phy);
+	ad9361_free_gt_images(phy);
 #ifndef AXI_ADC_NOT_PRESENT
 	no_os_free(phy->adc_conv);
 	no_os_free(phy->adc_state);
@@ -601,7 +607,11 @@ out:
  */
 int32_t ad9361_remove(struct ad9361_rf_phy *phy)
 {
+	ad9361_hop_plan_remove(phy, 0);
+	ad9361_hop_plan_remove(phy, 1);
 	ad9361_unregister_clocks(phy);
+	ad9361_free_gt_images(phy);
+	ad9361_spi_shadow_remove(phy);
 	no_os_spi_remove(phy->spi);
 	no_os_gpio_remove(phy->gpio_desc_resetb);
 	no_os_gpio_remove(phy->gpio_desc_sync);
@@ -1343,6 +1353,53 @@ int32_t ad9361_rx_fastlock_save(struct ad9361_rf_phy *phy, uint32_t profile,
 	return ad9361_fastlock_save(phy, 0, profile, values);
 }
 
+/**
+ * Set up RX frequency hopping. Every LO frequency is calibrated once and its
+ * fastlock profile cached in software; profiles are paged into the 8 hardware
+ * slots ahead of use, so that a hop only costs a profile recall. The LO is
+ * left on the first frequency.
+ * @param phy The AD9361 state structure.
+ * @param freq The LO frequencies (Hz), in hop order.
+ * @param n The number of frequencies.
+ * @param lookahead The number of upcoming hops to keep loaded (0 - 7).
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_rx_hop_plan_init(struct ad9361_rf_phy *phy,
+				const uint64_t *freq, uint32_t n,
+				uint32_t lookahead)
+{
+	return ad9361_hop_plan_init(phy, 0, freq, n, lookahead);
+}
+
+/**
+ * Hop the RX LO to an entry of the frequency hop plan. To step through the
+ * plan on a timer or trigger interrupt, use ad9361_hop_handler()
+ * (ctx: phy->hop_plan[0]) as interrupt callback and call
+ * ad9361_rx_hop_process() from the main loop.
+ * @param phy The AD9361 state structure.
+ * @param index The index of the frequency in the hop plan.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_rx_hop_to(struct ad9361_rf_phy *phy, uint32_t index)
+{
+	int32_t ret;
+
+	ret = ad9361_hop_to(phy, 0, index);
+
+	return ret < 0 ? ret : 0;
+}
+
+/**
+ * Do the RX hops requested by ad9361_hop_handler() since the last call.
+ * Must be called from thread context, not from an interrupt.
+ * @param phy The AD9361 state structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_rx_hop_process(struct ad9361_rf_phy *phy)
+{
+	return ad9361_hop_process(phy, 0);
+}
+
 /**
  * Power down the RX Local Oscillator.
  * @param phy The AD9361 state structure.
@@ -1858,6 +1915,53 @@ int32_t ad9361_tx_fastlock_save(struct ad9361_rf_phy *phy, uint32_t profile,
 	return ad9361_fastlock_save(phy, 1, profile, values);
 }
 
+/**
+ * Set up TX frequency hopping. Every LO frequency is calibrated once and its
+ * fastlock profile cached in software; profiles are paged into the 8 hardware
+ * slots ahead of use, so that a hop only costs a profile recall. The LO is
+ * left on the first frequency.
+ * @param phy The AD9361 state structure.
+ * @param freq The LO frequencies (Hz), in hop order.
+ * @param n The number of frequencies.
+ * @param lookahead The number of upcoming hops to keep loaded (0 - 7).
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_tx_hop_plan_init(struct ad9361_rf_phy *phy,
+				const uint64_t *freq, uint32_t n,
+				uint32_t lookahead)
+{
+	return ad9361_hop_plan_init(phy, 1, freq, n, lookahead);
+}
+
+/**
+ * Hop the TX LO to an entry of the frequency hop plan. To step through the
+ * plan on a timer or trigger interrupt, use ad9361_hop_handler()
+ * (ctx: phy->hop_plan[1]) as interrupt callback and call
+ * ad9361_tx_hop_process() from the main loop.
+ * @param phy The AD9361 state structure.
+ * @param index The index of the frequency in the hop plan.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_tx_hop_to(struct ad9361_rf_phy *phy, uint32_t index)
+{
+	int32_t ret;
+
+	ret = ad9361_hop_to(phy, 1, index);
+
+	return ret < 0 ? ret : 0;
+}
+
+/**
+ * Do the TX hops requested by ad9361_hop_handler() since the last call.
+ * Must be called from thread context, not from an interrupt.
+ * @param phy The AD9361 state structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_tx_hop_process(struct ad9361_rf_phy *phy)
+{
+	return ad9361_hop_process(phy, 1);
+}
+
 /**
  * Power down the TX Local Oscillator.
  * @param phy The AD9361 state structure.
@@ -2233,3 +2337,19 @@ int32_t ad9361_get_temperature(struct ad9361_rf_phy *phy,
 
 	return 0;
 }
+
+/**
+ * Get the RX gain table load diagnostics.
+ * @param phy The AD9361 current state structure.
+ * @param stats The number of table loads (and of loads skipped because the
+ * 		band did not change), along with the SPI traffic and the duration
+ * 		of the last load.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_get_gain_table_load_stats(struct ad9361_rf_phy *phy,
+		struct ad9361_gt_load_stats *stats)
+{
+	*stats = phy->gt_load_stats;
+
+	return 0;
+}
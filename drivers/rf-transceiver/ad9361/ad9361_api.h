@@ -454,6 +454,14 @@ int32_t ad9361_rx_fastlock_load(struct ad9361_rf_phy *phy, uint32_t profile,
 /* Save RX fastlock profile. */
 int32_t ad9361_rx_fastlock_save(struct ad9361_rf_phy *phy, uint32_t profile,
 				uint8_t *values);
+/* Set up RX frequency hopping on fastlock profiles. */
+int32_t ad9361_rx_hop_plan_init(struct ad9361_rf_phy *phy,
+				const uint64_t *freq, uint32_t n,
+				uint32_t lookahead);
+/* Hop the RX LO to an entry of the hop plan. */
+int32_t ad9361_rx_hop_to(struct ad9361_rf_phy *phy, uint32_t index);
+/* Do the RX hops requested from the hop interrupt. */
+int32_t ad9361_rx_hop_process(struct ad9361_rf_phy *phy);
 /* Power down the RX Local Oscillator. */
 int32_t ad9361_rx_lo_powerdown(struct ad9361_rf_phy *phy, uint8_t option);
 /* Get the RX Local Oscillator power status. */
@@ -516,6 +524,14 @@ int32_t ad9361_tx_fastlock_load(struct ad9361_rf_phy *phy, uint32_t profile,
 /* Save TX fastlock profile. */
 int32_t ad9361_tx_fastlock_save(struct ad9361_rf_phy *phy, uint32_t profile,
 				uint8_t *values);
+/* Set up TX frequency hopping on fastlock profiles. */
+int32_t ad9361_tx_hop_plan_init(struct ad9361_rf_phy *phy,
+				const uint64_t *freq, uint32_t n,
+				uint32_t lookahead);
+/* Hop the TX LO to an entry of the hop plan. */
+int32_t ad9361_tx_hop_to(struct ad9361_rf_phy *phy, uint32_t index);
+/* Do the TX hops requested from the hop interrupt. */
+int32_t ad9361_tx_hop_process(struct ad9361_rf_phy *phy);
 /* Power down the TX Local Oscillator. */
 int32_t ad9361_tx_lo_powerdown(struct ad9361_rf_phy *phy, uint8_t option);
 /* Get the TX Local Oscillator power status. */
@@ -552,4 +568,7 @@ int32_t ad9361_do_dcxo_tune_fine(struct ad9361_rf_phy *phy,
 /* Get the temperature. */
 int32_t ad9361_get_temperature(struct ad9361_rf_phy *phy,
 			       int32_t *temp);
+/* Get the RX gain table load diagnostics. */
+int32_t ad9361_get_gain_table_load_stats(struct ad9361_rf_phy *phy,
+		struct ad9361_gt_load_stats *stats);
 #endif
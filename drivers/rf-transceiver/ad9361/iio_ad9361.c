@@ -630,6 +630,27 @@ static int get_fastlock_recall(void *device, char *buf, uint32_t len,
 			ad9361_phy->fastlock.current_profile[channel->ch_num]);
 }
 
+/**
+ * @brief get_fastlock_hop().
+ * @param device - Physical instance of a iio_axi_adc device.
+ * @param buf - Where value is stored.
+ * @param len -	Maximum length of value to be stored in buf.
+ * @param channel - Channel properties.
+ * @return Length of chars written in buf, or negative value on failure.
+ */
+static int get_fastlock_hop(void *device, char *buf, uint32_t len,
+			    const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct ad9361_rf_phy *ad9361_phy = (struct ad9361_rf_phy *)device;
+	struct ad9361_hop_plan *plan = ad9361_phy->hop_plan[channel->ch_num];
+
+	if (!plan)
+		return -ENODEV;
+
+	return snprintf(buf, len, "%"PRIu32" %"PRIu32" %"PRIu32"",
+			plan->pos, plan->hops, plan->misses);
+}
+
 /**
  * @brief get_temp0_input().
  * @param device - Physical instance of a iio_axi_adc device.
@@ -1303,6 +1324,31 @@ static int set_fastlock_recall(void *device, char *buf, uint32_t len,
 	return len;
 }
 
+/**
+ * @brief set_fastlock_hop().
+ * @param device - Physical instance of a iio_axi_dac device.
+ * @param buf - Value to be written to attribute.
+ * @param len - Length of the data in "buf".
+ * @param channel - Channel properties.
+ * @return Number of bytes written to device, or negative value on failure.
+ */
+static int set_fastlock_hop(void *device, char *buf, uint32_t len,
+			    const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct ad9361_rf_phy *ad9361_phy = (struct ad9361_rf_phy *)device;
+	int32_t ret;
+
+	if (!strncmp(buf, "next", 4))
+		ret = ad9361_hop_next(ad9361_phy, channel->ch_num == 1);
+	else
+		ret = ad9361_hop_to(ad9361_phy, channel->ch_num == 1,
+				    no_os_str_to_uint32(buf));
+	if (ret < 0)
+		return ret;
+
+	return len;
+}
+
 /**
  * @brief set_voltage_filter_fir_en().
  * @param device - Physical instance of a iio_axi_dac device.
@@ -2055,6 +2101,11 @@ struct iio_attribute altvoltage_attributes[] = {
 		.show = get_fastlock_recall,
 		.store = set_fastlock_recall,
 	},
+	{
+		.name = "fastlock_hop",
+		.show = get_fastlock_hop,
+		.store = set_fastlock_hop,
+	},
 	END_ATTRIBUTES_ARRAY
 };
 
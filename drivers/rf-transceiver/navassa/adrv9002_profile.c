@@ -0,0 +1,187 @@
+/***************************************************************************//**
+ *   @file   adrv9002_profile.c
+ *   @brief  Compiled (binary) ADRV9002 device profile loader.
+********************************************************************************
+ * Copyright 2023(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include "adrv9002_profile.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+/**
+ * @brief Update a CRC-32 (IEEE 802.3, reflected) with a data buffer.
+ * @param crc - Current CRC value, 0 for a new computation.
+ * @param data - Data buffer.
+ * @param len - Number of bytes.
+ * @return The updated CRC value.
+ */
+static uint32_t adrv9002_profile_bin_crc(uint32_t crc, const uint8_t *data,
+		uint32_t len)
+{
+	uint32_t i;
+
+	crc = ~crc;
+	while (len--) {
+		crc ^= *data++;
+		for (i = 0; i < 8; i++)
+			crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+	}
+
+	return ~crc;
+}
+
+/**
+ * @brief Signature of the adi_adrv9001_Init_t layout of this build: sizes and
+ * offsets of the profile sections, enum and bool sizes, and byte order. A
+ * binary profile is only accepted by a build with the same signature.
+ * @return The layout signature.
+ */
+uint32_t adrv9002_profile_bin_layout(void)
+{
+	const uint32_t endian = 0x01020304;
+	const uint32_t layout[] = {
+		sizeof(adi_adrv9001_Init_t),
+		offsetof(adi_adrv9001_Init_t, clocks),
+		offsetof(adi_adrv9001_Init_t, rx),
+		offsetof(adi_adrv9001_Init_t, tx),
+		offsetof(adi_adrv9001_Init_t, sysConfig),
+		offsetof(adi_adrv9001_Init_t, pfirBuffer),
+		sizeof(adi_adrv9001_ClockSettings_t),
+		sizeof(adi_adrv9001_RxSettings_t),
+		sizeof(adi_adrv9001_RxChannelCfg_t),
+		sizeof(adi_adrv9001_TxSettings_t),
+		sizeof(adi_adrv9001_TxProfile_t),
+		sizeof(adi_adrv9001_DeviceSysConfig_t),
+		sizeof(adi_adrv9001_PfirBuffer_t),
+		sizeof(adi_adrv9001_RxSignalType_e),
+		sizeof(bool),
+		*(const uint8_t *)&endian,
+	};
+
+	return adrv9002_profile_bin_crc(0, (const uint8_t *)layout, sizeof(layout));
+}
+
+/**
+ * @brief Compile a profile into its binary form.
+ * @param init - Profile, as filled by adi_adrv9001_profileutil_Parse().
+ * @param blob - Output buffer.
+ * @param len - Size of the output buffer.
+ * @return Size of the binary profile, negative error code otherwise.
+ */
+int adrv9002_profile_bin_build(const adi_adrv9001_Init_t *init, uint8_t *blob,
+			       uint32_t len)
+{
+	struct adrv9002_profile_bin_hdr hdr = {
+		.magic = ADRV9002_PROFILE_BIN_MAGIC,
+		.version = ADRV9002_PROFILE_BIN_VERSION,
+		.hdr_size = sizeof(hdr),
+		.size = sizeof(*init),
+	};
+
+	if (!init || !blob)
+		return -EINVAL;
+	if (len < sizeof(hdr) + sizeof(*init))
+		return -ENOMEM;
+
+	hdr.layout = adrv9002_profile_bin_layout();
+	hdr.crc = adrv9002_profile_bin_crc(0, (const uint8_t *)init, sizeof(*init));
+
+	memcpy(blob, &hdr, sizeof(hdr));
+	memcpy(blob + sizeof(hdr), init, sizeof(*init));
+
+	return sizeof(hdr) + sizeof(*init);
+}
+
+/**
+ * @brief Check a binary profile header against this build.
+ * @param hdr - Profile header.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int adrv9002_profile_bin_check(const struct adrv9002_profile_bin_hdr *hdr)
+{
+	if (hdr->magic != ADRV9002_PROFILE_BIN_MAGIC)
+		return -EINVAL;
+	if (hdr->version != ADRV9002_PROFILE_BIN_VERSION ||
+	    hdr->hdr_size < sizeof(*hdr))
+		return -ENOTSUP;
+	/* Built against other API headers or for another ABI */
+	if (hdr->layout != adrv9002_profile_bin_layout() ||
+	    hdr->size != sizeof(adi_adrv9001_Init_t))
+		return -EFAULT;
+
+	return 0;
+}
+
+/**
+ * @brief Load a binary profile from memory (e.g. a const array linked in the
+ * application image). The profile image is copied as is into the init
+ * structure; no parsing takes place.
+ * @param init - Profile to fill.
+ * @param blob - Binary profile.
+ * @param len - Size of the binary profile.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int adrv9002_profile_bin_load(adi_adrv9001_Init_t *init, const uint8_t *blob,
+			      uint32_t len)
+{
+	struct adrv9002_profile_bin_hdr hdr;
+	int ret;
+
+	if (!init || !blob || len < sizeof(hdr))
+		return -EINVAL;
+
+	memcpy(&hdr, blob, sizeof(hdr));
+	ret = adrv9002_profile_bin_check(&hdr);
+	if (ret)
+		return ret;
+
+	if (len < hdr.hdr_size + hdr.size)
+		return -EINVAL;
+
+	blob += hdr.hdr_size;
+	if (adrv9002_profile_bin_crc(0, blob, hdr.size) != hdr.crc)
+		return -EBADMSG;
+
+	memcpy(init, blob, hdr.size);
+
+	return 0;
+}
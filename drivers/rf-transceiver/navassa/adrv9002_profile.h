@@ -0,0 +1,93 @@
+/***************************************************************************//**
+ *   @file   adrv9002_profile.h
+ *   @brief  Compiled (binary) ADRV9002 device profile format.
+********************************************************************************
+ * Copyright 2023(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef ADRV9002_PROFILE_H_
+#define ADRV9002_PROFILE_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include "adi_adrv9001_profile_types.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+#define ADRV9002_PROFILE_BIN_MAGIC	0x42503941 /* "A9PB" */
+#define ADRV9002_PROFILE_BIN_VERSION	1
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+/**
+ * @struct adrv9002_profile_bin_hdr
+ * @brief Header of a compiled profile. It is followed by an image of
+ * adi_adrv9001_Init_t, which is only accepted by a build whose structure
+ * layout matches the one of the build that produced it.
+ */
+struct adrv9002_profile_bin_hdr {
+	/** ADRV9002_PROFILE_BIN_MAGIC */
+	uint32_t magic;
+	/** ADRV9002_PROFILE_BIN_VERSION */
+	uint16_t version;
+	/** Size of this header */
+	uint16_t hdr_size;
+	/** Layout signature, see adrv9002_profile_bin_layout() */
+	uint32_t layout;
+	/** Size of the profile image */
+	uint32_t size;
+	/** CRC-32 of the profile image */
+	uint32_t crc;
+	/** Reserved, 0 */
+	uint32_t reserved;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+/* Signature of the adi_adrv9001_Init_t layout of this build. */
+uint32_t adrv9002_profile_bin_layout(void);
+
+/* Compile a profile into its binary form. */
+int adrv9002_profile_bin_build(const adi_adrv9001_Init_t *init, uint8_t *blob,
+			       uint32_t len);
+
+/* Load a binary profile from memory. */
+int adrv9002_profile_bin_load(adi_adrv9001_Init_t *init, const uint8_t *blob,
+			      uint32_t len);
+
+#endif /* ADRV9002_PROFILE_H_ */
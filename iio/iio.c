@@ -55,17 +55,17 @@
 #include "no_os_error.h"
 #include "no_os_alloc.h"
 #include "no_os_circular_buffer.h"
+#include "no_os_delay.h"
 #include <inttypes.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <string.h>
 
 #ifdef NO_OS_NETWORKING
-#include "no_os_delay.h"
 #include "tcp_socket.h"
 #endif
 
 #ifdef NO_OS_LWIP_NETWORKING
-#include "no_os_delay.h"
 #include "tcp_socket.h"
 #include "lwip_socket.h"
 #endif
@@ -78,6 +78,10 @@
 #define MAX_SOCKET_TO_HANDLE	10
 #define REG_ACCESS_ATTRIBUTE	"direct_reg_access"
 #define IIOD_CONN_BUFFER_SIZE	0x1000
+/* Default bytes a streaming connection may move in one iio_step */
+#define IIO_STREAM_QUANTUM	0x4000
+/* Values read and written with the typed direct client API */
+#define IIO_DIRECT_ATTR_LEN	128
 #define NO_TRIGGER				(uint32_t)-1
 
 #define NO_OS_STRINGIFY(x) #x
@@ -131,6 +135,7 @@ static const char * const iio_chan_type_string[] = {
 	[IIO_COUNT] = "count",
 	[IIO_DELTA_ANGL] = "deltaangl",
 	[IIO_DELTA_VELOCITY] = "deltavelocity",
+	[IIO_TIMESTAMP] = "timestamp",
 };
 
 static const char * const iio_modifier_names[] = {
@@ -149,6 +154,24 @@ struct attr_fun_params {
 	char			*buf;
 	uint32_t			len;
 	struct iio_ch_info	*ch_info;
+	/* Device owning the attributes, NULL for triggers */
+	struct iio_dev_priv	*dev;
+	/* Channel owning the attributes, NULL for device attributes */
+	struct iio_channel	*ch;
+};
+
+struct iio_attr_cache_entry {
+	/* Cached attribute, NULL if the entry is unused */
+	struct iio_attribute	*attr;
+	/* Channel the value was read for */
+	struct iio_channel	*ch;
+	/* Time of the read in milliseconds */
+	uint32_t		stamp;
+	/* Length of the value, without the null terminator */
+	uint32_t		len;
+	/* Allocated size of val */
+	uint32_t		size;
+	char			*val;
 };
 
 struct iio_buffer_priv {
@@ -188,6 +211,20 @@ struct iio_dev_priv {
 	struct iio_buffer_priv buffer;
 	/* Set to -1 when no trigger is set*/
 	uint32_t		trig_idx;
+	/* Values of cacheable attributes, allocated on first use */
+	struct iio_attr_cache_entry *attr_cache;
+	/* One entry per cacheable attribute of the device and its channels */
+	uint32_t		attr_cache_size;
+	/* Set when dev_descriptor is a copy extended by iio */
+	bool			own_descriptor;
+	/* Reads that found the input buffer overrun */
+	uint32_t		overruns;
+	/* Times the device found the output buffer empty */
+	uint32_t		underruns;
+	/* Set while the output buffer is empty, to count an underrun once */
+	bool			starved;
+	/* Histogram of the asynchronous trigger dispatch latency */
+	uint32_t		trig_latency[IIO_STATS_LATENCY_BUCKETS];
 };
 
 /**
@@ -204,8 +241,10 @@ struct iio_trig_priv {
 	void	*instance;
 	/** Trigger descriptor(describes type of trigger and its attributes) */
 	struct iio_trigger *descriptor;
-	/** Set to true when the triggering condition is met */
-	bool	triggered;
+	/** Devices using this trigger */
+	struct iio_dev_priv **subs;
+	/** Number of devices in subs */
+	uint32_t nb_subs;
 };
 
 struct iio_desc {
@@ -220,11 +259,25 @@ struct iio_desc {
 	uint32_t		nb_devs;
 	struct iio_trig_priv	*trigs;
 	uint32_t		nb_trigs;
+	/* Bit n set when asynchronous trigger n fired and is not handled yet */
+	volatile uint32_t	*trig_pending;
+	/* Storage for the subs arrays of the triggers */
+	struct iio_dev_priv	**trig_subs;
+	/* Exported as context attribute if a device has timestamps */
+	const char		*timestamp_clock_name;
 	struct no_os_uart_desc	*uart_desc;
 	int (*recv)(void *conn, uint8_t *buf, uint32_t len);
 	int (*send)(void *conn, uint8_t *buf, uint32_t len);
 	/* FIFO for socket descriptors */
 	struct no_os_circular_buffer	*conns;
+	/* Size of the iiod connection table */
+	uint32_t		max_conns;
+	/* Payload buffer size of each connection */
+	uint32_t		conn_buf_size;
+	/* Bytes a connection may move in one step, see iio_serve_conn() */
+	uint32_t		stream_quantum;
+	/* UART payload buffer, when not the static one */
+	char			*uart_buff;
 #if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
 	struct tcp_socket_desc	*current_sock;
 	/* Instance of server socket */
@@ -382,95 +435,369 @@ static int iio_set_buffers_count(struct iiod_ctx *ctx, const char *device,
 	return 0;
 }
 
+/* Clock used to timestamp scans. NULL to use no_os_get_time() */
+static int64_t (*iio_timestamp_clock)(void);
+
 /**
- * @brief Read all attributes from an attribute list.
- * @param device - Physical instance of a device.
- * @param buf - Buffer where values are read.
- * @param len - Maximum length of value to be stored in buf.
- * @param channel - Channel properties.
- * @param attributes - List of attributes to be read.
- * @return Number of bytes read or negative value in case of error.
+ * @brief Read the clock used to timestamp scans.
+ * @return Time in ns.
  */
-static int iio_read_all_attr(struct attr_fun_params *params,
-			     struct iio_attribute *attributes)
+int64_t iio_get_timestamp(void)
 {
-	/* TODO Not sure if working corectly */
-	return -EINVAL;
+	struct no_os_time t;
 
-#if 0
-	int16_t i = 0, j = 0;
-	char local_buf[256];
-	int attr_length;
-	uint32_t *pattr_length;
+	if (iio_timestamp_clock)
+		return iio_timestamp_clock();
 
-	while (attributes[i].name) {
-		attr_length = attributes[i].show(params->dev_instance,
-						 local_buf, params->len,
-						 params->ch_info,
-						 attributes[i].priv);
-		if (NO_OS_IS_ERR_VALUE(attr_length))
-			attr_length = snprintf(local_buf, params->len, "%d",
-					       attr_length);
-
-		attr_length += 1;//Add '\0' to the count
-		pattr_length = (uint32_t *)(params->buf + j);
-		if (j + 4 > params->len)
-			return -EINVAL;
-		*pattr_length = no_os_bswap_constant_32(attr_length);
-		j += 4;
-		if (attr_length >= 0) {
-			if (attr_length + j > params->len)
-				return -EINVAL;
-			sprintf(params->buf + j, "%s", local_buf);
-			if (attr_length & 0x3) /* multiple of 4 */
-				attr_length = ((attr_length >> 2) + 1) << 2;
-			j += attr_length;
-		}
-		i++;
+	t = no_os_get_time();
+
+	return (int64_t)t.s * 1000000000 + (int64_t)t.us * 1000;
+}
+
+/*
+ * Reading the raw attribute of the timestamp channel returns the current time,
+ * so the host can correlate the timestamps with its own clock.
+ */
+static int iio_timestamp_show(void *device, char *buf, uint32_t len,
+			      const struct iio_ch_info *channel, intptr_t priv)
+{
+	return snprintf(buf, len, "%"PRId64, iio_get_timestamp());
+}
+
+static struct scan_type iio_timestamp_scan_type = {
+	.sign = 's',
+	.realbits = 64,
+	.storagebits = 64,
+	.shift = 0,
+	.is_big_endian = false
+};
+
+static struct iio_attribute iio_timestamp_attrs[] = {
+	{
+		.name = "raw",
+		.show = iio_timestamp_show
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+static int iio_watermark_show(void *device, char *buf, uint32_t len,
+			      const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct iio_dev_priv *dev = (struct iio_dev_priv *)priv;
+
+	return snprintf(buf, len, "%"PRIu32, dev->buffer.public.watermark);
+}
+
+static int iio_watermark_store(void *device, char *buf, uint32_t len,
+			       const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct iio_dev_priv *dev = (struct iio_dev_priv *)priv;
+	int32_t val;
+	int ret;
+
+	iio_parse_value(buf, IIO_VAL_INT, &val, NULL);
+	if (val < 1)
+		return -EINVAL;
+
+	ret = dev->dev_descriptor->set_watermark(device, val);
+	if (ret)
+		return ret;
+
+	dev->buffer.public.watermark = val;
+
+	return len;
+}
+
+static int iio_overruns_show(void *device, char *buf, uint32_t len,
+			     const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct iio_dev_priv *dev = (struct iio_dev_priv *)priv;
+
+	return snprintf(buf, len, "%"PRIu32, dev->overruns);
+}
+
+static int iio_underruns_show(void *device, char *buf, uint32_t len,
+			      const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct iio_dev_priv *dev = (struct iio_dev_priv *)priv;
+
+	return snprintf(buf, len, "%"PRIu32, dev->underruns);
+}
+
+/* Counts of the latency buckets: <10us <100us <1ms <10ms <100ms >=100ms */
+static int iio_trig_latency_show(void *device, char *buf, uint32_t len,
+				 const struct iio_ch_info *channel,
+				 intptr_t priv)
+{
+	struct iio_dev_priv *dev = (struct iio_dev_priv *)priv;
+	uint32_t i, j = 0;
+
+	for (i = 0; i < IIO_STATS_LATENCY_BUCKETS; i++)
+		j += snprintf(buf + j, no_os_max((int32_t)(len - j), 0),
+			      i ? " %"PRIu32 : "%"PRIu32,
+			      dev->trig_latency[i]);
+
+	return j < len ? (int)j : -EINVAL;
+}
+
+/* One line per used command: name count min_us avg_us max_us */
+static int iio_cmd_stats_show(void *device, char *buf, uint32_t len,
+			      const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct iio_desc *desc = (struct iio_desc *)priv;
+	struct iiod_cmd_stats stats;
+	uint32_t i, j = 0;
+
+	for (i = 0; i < IIOD_NB_CMDS; i++) {
+		iiod_get_cmd_stats(desc->iiod, i, &stats);
+		if (!stats.count)
+			continue;
+		j += snprintf(buf + j, no_os_max((int32_t)(len - j), 0),
+			      "%s%s %"PRIu32" %"PRIu32" %"PRIu64" %"PRIu32,
+			      j ? "\n" : "", iiod_cmd_name(i), stats.count,
+			      stats.min_us, stats.total_us / stats.count,
+			      stats.max_us);
 	}
-	if (j == 0)
-		return -ENOENT;
 
-	return j;
-#endif
+	return j < len ? (int)j : -EINVAL;
+}
+
+/* One line per connection: id bytes_in bytes_out commands */
+static int iio_conn_stats_show(void *device, char *buf, uint32_t len,
+			       const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct iio_desc *desc = (struct iio_desc *)priv;
+	struct iiod_conn_stats stats;
+	uint32_t i, j = 0;
+
+	for (i = 0; i < desc->max_conns; i++) {
+		if (iiod_conn_get_stats(desc->iiod, i, &stats))
+			continue;
+		j += snprintf(buf + j, no_os_max((int32_t)(len - j), 0),
+			      "%s%"PRIu32" %"PRIu64" %"PRIu64" %"PRIu32,
+			      j ? "\n" : "", i, stats.bytes_in,
+			      stats.bytes_out, stats.cmds);
+	}
+
+	return j < len ? (int)j : -EINVAL;
+}
+
+/*
+ * Statistics appended by iio to the debug attributes of buffered devices. The
+ * first ones are counters of the device. The iiod ones are for the whole
+ * context, so only the first buffered device gets them.
+ */
+#define IIO_STATS_DEV_ATTRS	3
+static const struct iio_attribute iio_stats_attrs[] = {
+	{
+		.name = "buffer_overruns",
+		.show = iio_overruns_show
+	},
+	{
+		.name = "buffer_underruns",
+		.show = iio_underruns_show
+	},
+	{
+		.name = "trigger_latency",
+		.show = iio_trig_latency_show
+	},
+	{
+		.name = "iiod_cmd_stats",
+		.show = iio_cmd_stats_show
+	},
+	{
+		.name = "iiod_conn_stats",
+		.show = iio_conn_stats_show
+	},
+};
+
+/*
+ * A null time (no time source on the platform) disables the attributes cached
+ * for a limited time, constant ones are still cached.
+ */
+static uint32_t iio_attr_cache_time_ms(void)
+{
+	struct no_os_time t = no_os_get_time();
+
+	return t.s * 1000 + t.us / 1000;
 }
 
 /**
- * @brief Write all attributes from an attribute list.
- * @param device - Physical instance of a device.
- * @param buf - Values to be written.
- * @param len - Length of buf.
- * @param channel - Channel properties.
- * @param attributes - List of attributes to be written.
- * @return Number of written bytes or negative value in case of error.
+ * @brief Drop all cached attribute values of a device.
+ * @param dev - Device whose attributes were changed.
  */
-static int iio_write_all_attr(struct attr_fun_params *params,
-			      struct iio_attribute *attributes)
+static void iio_attr_cache_invalidate(struct iio_dev_priv *dev)
 {
-	/* TODO Not sure if working corectly */
-	return -EINVAL;
+	uint32_t i;
 
-#if 0
-	int16_t i = 0, j = 0;
-	int16_t attr_length;
+	if (!dev || !dev->attr_cache)
+		return;
 
-	while (attributes[i].name) {
-		attr_length = no_os_bswap_constant_32((uint32_t)(params->buf + j));
-		j += 4;
-		attributes[i].store(params->dev_instance, (params->buf + j),
-				    attr_length, params->ch_info,
-				    attributes[i].priv);
-		j += attr_length;
-		if (j & 0x3)
-			j = ((j >> 2) + 1) << 2;
-		i++;
+	for (i = 0; i < dev->attr_cache_size; i++)
+		dev->attr_cache[i].attr = NULL;
+}
+
+/**
+ * @brief Count the cacheable attributes of an array.
+ * @param attrs - Attributes, ending with a NULL name. May be NULL.
+ * @return Number of attributes that are not IIO_ATTR_VOLATILE.
+ */
+static uint32_t iio_attr_cache_count(struct iio_attribute *attrs)
+{
+	uint32_t n = 0;
+
+	for (; attrs && attrs->name; attrs++)
+		if (attrs->cache_ms != IIO_ATTR_VOLATILE)
+			n++;
+
+	return n;
+}
+
+/**
+ * @brief Number of cache entries needed to hold every cacheable attribute of
+ * a device, so that cached values are never evicted.
+ * @param d - Device descriptor.
+ * @return Number of entries.
+ */
+static uint32_t iio_attr_cache_entries(struct iio_device *d)
+{
+	uint32_t n, i;
+
+	n = iio_attr_cache_count(d->attributes) +
+	    iio_attr_cache_count(d->debug_attributes) +
+	    iio_attr_cache_count(d->buffer_attributes);
+	for (i = 0; d->channels && i < d->num_ch; i++)
+		n += iio_attr_cache_count(d->channels[i].attributes);
+
+	return n;
+}
+
+/**
+ * @brief Find the cache entry of an attribute.
+ * @param params - Attribute owner.
+ * @param attr - Attribute.
+ * @param alloc - If no entry is found, return a free one.
+ * @return Cache entry or NULL.
+ */
+static struct iio_attr_cache_entry *iio_attr_cache_find(
+	struct attr_fun_params *params, struct iio_attribute *attr, bool alloc)
+{
+	struct iio_dev_priv *dev = params->dev;
+	struct iio_attr_cache_entry *entry;
+	uint32_t i, n;
+
+	if (!dev->attr_cache) {
+		if (!alloc)
+			return NULL;
+		n = iio_attr_cache_entries(dev->dev_descriptor);
+		if (!n)
+			return NULL;
+		dev->attr_cache = no_os_calloc(n, sizeof(*dev->attr_cache));
+		if (!dev->attr_cache)
+			return NULL;
+		dev->attr_cache_size = n;
 	}
 
-	if (params->len == 0)
+	for (i = 0; i < dev->attr_cache_size; i++) {
+		entry = &dev->attr_cache[i];
+		if (entry->attr == attr && entry->ch == params->ch)
+			return entry;
+	}
+
+	if (!alloc)
+		return NULL;
+
+	for (i = 0; i < dev->attr_cache_size; i++)
+		if (!dev->attr_cache[i].attr)
+			return &dev->attr_cache[i];
+
+	return NULL;
+}
+
+/**
+ * @brief Read an attribute, from the cache if it holds a valid value.
+ * @param params - Structure describing parameters for the show function.
+ * @param attr - Attribute to be read.
+ * @return Length of chars read or negative value in case of error.
+ */
+static int iio_attr_show(struct attr_fun_params *params,
+			 struct iio_attribute *attr)
+{
+	struct iio_attr_cache_entry *entry;
+	bool cacheable;
+	uint32_t now = 0;
+	int ret;
+
+	if (!attr->show)
 		return -ENOENT;
 
-	return params->len;
-#endif
+	cacheable = params->dev && attr->cache_ms != IIO_ATTR_VOLATILE;
+	if (cacheable && attr->cache_ms != IIO_ATTR_CONST) {
+		now = iio_attr_cache_time_ms();
+		cacheable = now != 0;
+	}
+
+	if (cacheable) {
+		entry = iio_attr_cache_find(params, attr, false);
+		if (entry && entry->len < params->len &&
+		    (attr->cache_ms == IIO_ATTR_CONST ||
+		     now - entry->stamp < attr->cache_ms)) {
+			memcpy(params->buf, entry->val, entry->len + 1);
+			return entry->len;
+		}
+	}
+
+	ret = attr->show(params->dev_instance, params->buf, params->len,
+			 params->ch_info, attr->priv);
+	if (!cacheable || ret < 0 || (uint32_t)ret >= params->len)
+		return ret;
+
+	entry = iio_attr_cache_find(params, attr, true);
+	if (!entry)
+		return ret;
+
+	if (entry->size < (uint32_t)ret + 1) {
+		no_os_free(entry->val);
+		entry->attr = NULL;
+		entry->size = 0;
+		entry->val = no_os_malloc(ret + 1);
+		if (!entry->val)
+			return ret;
+		entry->size = ret + 1;
+	}
+
+	memcpy(entry->val, params->buf, ret);
+	entry->val[ret] = '\0';
+	entry->len = ret;
+	entry->stamp = now;
+	entry->attr = attr;
+	entry->ch = params->ch;
+
+	return ret;
+}
+
+/**
+ * @brief Write an attribute and drop the cached values of its device.
+ * @param params - Structure describing parameters for the store function.
+ * @param attr - Attribute to be written.
+ * @param buf - Value to be written.
+ * @param len - Length of the value.
+ * @return Length of chars written or negative value in case of error.
+ */
+static int iio_attr_store(struct attr_fun_params *params,
+			  struct iio_attribute *attr, char *buf, uint32_t len)
+{
+	int ret;
+
+	if (!attr->store)
+		return -ENOENT;
+
+	ret = attr->store(params->dev_instance, buf, len, params->ch_info,
+			  attr->priv);
+	if (ret >= 0)
+		iio_attr_cache_invalidate(params->dev);
+
+	return ret;
 }
 
 /**
@@ -499,20 +826,11 @@ static int iio_rd_wr_attribute(struct attr_fun_params *params,
 	if (!attributes[i].name)
 		return -ENOENT;
 
-	if (is_write) {
-		if (!attributes[i].store)
-			return -ENOENT;
+	if (is_write)
+		return iio_attr_store(params, &attributes[i], params->buf,
+				      params->len);
 
-		return attributes[i].store(params->dev_instance, params->buf,
-					   params->len, params->ch_info,
-					   attributes[i].priv);
-	} else {
-		if (!attributes[i].show)
-			return -ENOENT;
-		return attributes[i].show(params->dev_instance, params->buf,
-					  params->len, params->ch_info,
-					  attributes[i].priv);
-	}
+	return iio_attr_show(params, &attributes[i]);
 }
 
 /* Read a device register. The register address to read is set on
@@ -572,153 +890,130 @@ static int32_t debug_reg_write(struct iio_dev_priv *dev, const char *buf,
 	return len;
 }
 
-static int32_t __iio_str_parse(char *buf, int32_t *integer, int32_t *_fract,
-			       bool scale_db)
+/**
+ * @brief Read all attributes from an attribute list, in the bulk format used
+ * by libiio: for each attribute, in the order of the XML description, a 32 bit
+ * big endian length (negative for errors) followed by the null terminated value
+ * padded to a multiple of 4 bytes.
+ * @param params - Structure describing parameters for show functions.
+ * @param attributes - List of attributes to be read.
+ * @param reg_dev - Device whose direct_reg_access attribute follows the list,
+ * 		    or NULL.
+ * @return Number of bytes read or negative value in case of error.
+ */
+static int iio_read_all_attr(struct attr_fun_params *params,
+			     struct iio_attribute *attributes,
+			     struct iio_dev_priv *reg_dev)
 {
-	char *p;
-
-	p = strtok(buf, ".");
-	if (p == NULL)
-		return -EINVAL;
-
-	*integer = strtol(p, NULL, 0);
-
-	if (scale_db) {
-		p = strtok(NULL, "db");
-		if (p == NULL)
-			p = strtok(NULL, " db");
-	} else
-		p = strtok(NULL, "\n");
-
-	if (p == NULL)
-		return -EINVAL;
+	struct attr_fun_params entry_params = *params;
+	uint32_t j = 0;
+	int16_t i = 0;
+	char *value;
+	int ret;
 
-	*_fract = strtol(p, NULL, 10);
+	while ((attributes && attributes[i].name) || reg_dev) {
+		if (j + 4 > params->len)
+			return -EINVAL;
 
-	return 0;
-}
+		value = params->buf + j + 4;
+		if (!attributes || !attributes[i].name) {
+			if (reg_dev->dev_descriptor->debug_reg_read)
+				ret = debug_reg_read(reg_dev, value,
+						     params->len - j - 4);
+			else
+				ret = -ENOENT;
+			reg_dev = NULL;
+		} else {
+			entry_params.buf = value;
+			entry_params.len = params->len - j - 4;
+			ret = iio_attr_show(&entry_params, &attributes[i]);
+			i++;
+		}
 
-static int32_t _iio_fract_interpret(int32_t fract, int32_t subunits)
-{
-	int32_t temp = fract;
+		if (ret >= 0) {
+			/* Add '\0' to the count */
+			ret += 1;
+			if (j + 4 + ret > params->len)
+				return -EINVAL;
+		}
 
-	while ((subunits != 0) || (temp != 0)) {
-		temp /= 10;
-		subunits /= 10;
-		if (!temp)
-			break;
-		if (subunits <= 1)
-			fract /= 10;
+		no_os_put_unaligned_be32(ret, (uint8_t *)params->buf + j);
+		j += 4;
+		if (ret > 0)
+			j += (ret + 3) & ~3;
 	}
 
-	return fract * subunits;
+	if (j == 0)
+		return -ENOENT;
+
+	return no_os_min(j, params->len);
 }
 
-int32_t iio_parse_value(char *buf, enum iio_val fmt, int32_t *val,
-			int32_t *val2)
+/**
+ * @brief Write all attributes from an attribute list, from the bulk format
+ * used by libiio (see iio_read_all_attr()). Entries with a length smaller than
+ * 1 are skipped.
+ * @param params - Structure describing parameters for store functions.
+ * @param attributes - List of attributes to be written.
+ * @param reg_dev - Device whose direct_reg_access attribute follows the list,
+ * 		    or NULL.
+ * @return Number of written bytes or negative value in case of error.
+ */
+static int iio_write_all_attr(struct attr_fun_params *params,
+			      struct iio_attribute *attributes,
+			      struct iio_dev_priv *reg_dev)
 {
-	int32_t ret = 0;
-	int32_t integer, _fract = 0;
-	char ch;
+	uint32_t j = 0;
+	int16_t i = 0;
+	int32_t length;
+	char *value;
+	char next;
+	int ret;
 
-	switch (fmt) {
-	case IIO_VAL_INT:
-		integer = strtol(buf, NULL, 0);
-		break;
-	case IIO_VAL_INT_PLUS_MICRO_DB:
-		ret = __iio_str_parse(buf, &integer, &_fract, true);
-		if (ret < 0)
-			return ret;
-		_fract = _iio_fract_interpret(_fract, 1000000);
-		break;
-	case IIO_VAL_INT_PLUS_MICRO:
-		ret = __iio_str_parse(buf, &integer, &_fract, false);
-		if (ret < 0)
-			return ret;
-		_fract = _iio_fract_interpret(_fract, 1000000);
-		break;
-	case IIO_VAL_INT_PLUS_NANO:
-		ret = __iio_str_parse(buf, &integer, &_fract, false);
-		if (ret < 0)
-			return ret;
-		_fract = _iio_fract_interpret(_fract, 1000000000);
-		break;
-	case IIO_VAL_FRACTIONAL:
-		ret = __iio_str_parse(buf, &integer, &_fract, false);
-		if (ret < 0)
-			return ret;
-		break;
-	case IIO_VAL_CHAR:
-		if (sscanf(buf, "%c", &ch) != 1)
+	while ((attributes && attributes[i].name) || reg_dev) {
+		if (j + 4 > params->len)
 			return -EINVAL;
-		integer = ch;
-		break;
-	default:
-		return -EINVAL;
-	}
 
-	if (val)
-		*val = integer;
-	if (val2)
-		*val2 = _fract;
+		length = no_os_get_unaligned_be32((uint8_t *)params->buf + j);
+		j += 4;
+		if (length > 0 && (uint32_t)length > params->len - j)
+			return -EINVAL;
 
-	return ret;
-}
+		value = params->buf + j;
+		if (length > 0) {
+			/* Values are not null terminated when the length is aligned */
+			next = value[length];
+			value[length] = '\0';
+		}
 
-int iio_format_value(char *buf, uint32_t len, enum iio_val fmt,
-		     int32_t size, int32_t *vals)
-{
-	int64_t tmp;
-	int32_t integer, fractional;
-	bool dB = false;
-	int32_t i = 0;
-	uint32_t l = 0;
-
-	switch (fmt) {
-	case IIO_VAL_INT:
-		return snprintf(buf, len, "%"PRIi32"", vals[0]);
-	case IIO_VAL_INT_PLUS_MICRO_DB:
-		dB = true;
-	/* intentional fall through */
-	case IIO_VAL_INT_PLUS_MICRO:
-		return snprintf(buf, len, "%"PRIi32".%06"PRIu32"%s", vals[0],
-				(uint32_t)vals[1], dB ? " dB" : "");
-	case IIO_VAL_INT_PLUS_NANO:
-		return snprintf(buf, len, "%"PRIi32".%09"PRIu32"", vals[0],
-				(uint32_t)vals[1]);
-	case IIO_VAL_FRACTIONAL:
-		tmp = no_os_div_s64((int64_t)vals[0] * 1000000000LL, vals[1]);
-		fractional = vals[1];
-		integer = (int32_t)no_os_div_s64_rem(tmp, 1000000000, &fractional);
-
-		if (integer == 0 && fractional < 0)
-			return snprintf(buf, len, "-0.%09u", abs(fractional));
-
-		return snprintf(buf, len, "%"PRIi32".%09u", integer,
-				abs(fractional));
-	case IIO_VAL_FRACTIONAL_LOG2:
-		tmp = no_os_shift_right((int64_t)vals[0] * 1000000000LL, vals[1]);
-		integer = (int32_t)no_os_div_s64_rem(tmp, 1000000000LL, &fractional);
-
-		if (integer == 0 && fractional < 0)
-			return snprintf(buf, len, "-0.%09u", abs(fractional));
-
-		return snprintf(buf, len, "%"PRIi32".%09u", integer,
-				abs(fractional));
-	case IIO_VAL_INT_MULTIPLE: {
-		while (i < size) {
-			l += snprintf(&buf[l], len - l, "%"PRIi32" ", vals[i]);
-			if (l >= len)
-				break;
+		if (!attributes || !attributes[i].name) {
+			ret = 0;
+			if (length > 0 && reg_dev->dev_descriptor->debug_reg_write) {
+				ret = debug_reg_write(reg_dev, value, length);
+				iio_attr_cache_invalidate(reg_dev);
+			}
+			reg_dev = NULL;
+		} else {
+			ret = 0;
+			if (length > 0 && attributes[i].store)
+				ret = iio_attr_store(params, &attributes[i],
+						     value, length);
 			i++;
 		}
-		return l;
-	}
-	case IIO_VAL_CHAR:
-		return snprintf(buf, len, "%c", (char)vals[0]);
-	default:
-		return 0;
+
+		if (length > 0) {
+			value[length] = next;
+			j += (length + 3) & ~3;
+		}
+
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
 	}
+
+	if (params->len == 0)
+		return -ENOENT;
+
+	return params->len;
 }
 
 static struct iio_attribute *get_attributes(enum iio_attr_type type,
@@ -743,6 +1038,20 @@ static struct iio_attribute *get_attributes(enum iio_attr_type type,
 	return NULL;
 }
 
+/* Device whose direct_reg_access attribute ends the debug attributes list */
+static struct iio_dev_priv *iio_reg_access_dev(enum iio_attr_type type,
+		struct iio_dev_priv *dev)
+{
+	if (type != IIO_ATTR_TYPE_DEBUG)
+		return NULL;
+
+	if (!dev->dev_descriptor->debug_reg_read &&
+	    !dev->dev_descriptor->debug_reg_write)
+		return NULL;
+
+	return dev;
+}
+
 /**
  * @brief Returns trigger attributes.
  * @param type - Attribute type.
@@ -814,9 +1123,12 @@ static int iio_read_attr(struct iiod_ctx *ctx, const char *device,
 		params.buf = buf;
 		params.len = len;
 		params.dev_instance = dev->dev_instance;
+		params.dev = dev;
+		params.ch = ch;
 		attributes = get_attributes(attr->type, dev, ch);
 		if (!strcmp(attr->name, ""))
-			return iio_read_all_attr(&params, attributes);
+			return iio_read_all_attr(&params, attributes,
+						 iio_reg_access_dev(attr->type, dev));
 		return iio_rd_wr_attribute(&params, attributes, attr->name, 0);
 	}
 
@@ -829,9 +1141,11 @@ static int iio_read_attr(struct iiod_ctx *ctx, const char *device,
 		params.buf = buf;
 		params.len = len;
 		params.dev_instance = trig_dev->instance;
+		params.dev = NULL;
+		params.ch = NULL;
 		attributes = get_trig_attributes(attr->type, trig_dev);
 		if (!strcmp(attr->name, ""))
-			return iio_read_all_attr(&params, attributes);
+			return iio_read_all_attr(&params, attributes, NULL);
 		return iio_rd_wr_attribute(&params, attributes, attr->name, 0);
 	}
 
@@ -866,8 +1180,10 @@ static int iio_write_attr(struct iiod_ctx *ctx, const char *device,
 
 		if (attr->type == IIO_ATTR_TYPE_DEBUG &&
 		    strcmp(attr->name, REG_ACCESS_ATTRIBUTE) == 0) {
-			if (dev->dev_descriptor->debug_reg_write)
+			if (dev->dev_descriptor->debug_reg_write) {
+				iio_attr_cache_invalidate(dev);
 				return debug_reg_write(dev, buf, len);
+			}
 			return -ENOENT;
 		}
 
@@ -891,9 +1207,12 @@ static int iio_write_attr(struct iiod_ctx *ctx, const char *device,
 		params.buf = (char *)buf;
 		params.len = len;
 		params.dev_instance = dev->dev_instance;
+		params.dev = dev;
+		params.ch = ch;
 		attributes = get_attributes(attr->type, dev, ch);
 		if (!strcmp(attr->name, ""))
-			return iio_write_all_attr(&params, attributes);
+			return iio_write_all_attr(&params, attributes,
+						  iio_reg_access_dev(attr->type, dev));
 		return iio_rd_wr_attribute(&params, attributes, attr->name, 1);
 	}
 
@@ -906,9 +1225,11 @@ static int iio_write_attr(struct iiod_ctx *ctx, const char *device,
 		params.buf = (char *)buf;
 		params.len = len;
 		params.dev_instance = trig_dev->instance;
+		params.dev = NULL;
+		params.ch = NULL;
 		attributes = get_trig_attributes(attr->type, trig_dev);
 		if (!strcmp(attr->name, ""))
-			return iio_read_all_attr(&params, attributes);
+			return iio_write_all_attr(&params, attributes, NULL);
 		return iio_rd_wr_attribute(&params, attributes, attr->name, 1);
 	}
 
@@ -957,34 +1278,119 @@ static uint32_t iio_get_trig_idx_by_name(struct iio_desc *desc,
 	return NO_TRIGGER;
 }
 
-/**
- * @brief Searches for active trigger of the given device and returns trigger name.
- * @param ctx     - IIO instance and conn instance.
- * @param device  - String containing device name.
- * @param trigger - Trigger name to be returned.
- * @param len     - Maximum length of value to be stored in name.
- * @return Number of bytes written in name.
+/*
+ * The pending bits are set from interrupt context and consumed by iio_step.
+ * Use atomic operations where the core has them, on the others (ARMv6-M) the
+ * window between the load and the store is a few instructions.
  */
-static int iio_get_trigger(struct iiod_ctx *ctx, const char *device,
-			   char *trigger, uint32_t len)
+#if defined(__GCC_ATOMIC_INT_LOCK_FREE) && __GCC_ATOMIC_INT_LOCK_FREE == 2
+static inline void iio_trig_set_pending(volatile uint32_t *word, uint32_t bit)
 {
-	struct iio_dev_priv *dev;
-	struct iio_trig_priv *trig;
-	struct iio_desc *desc = ctx->instance;
+	__atomic_fetch_or(word, bit, __ATOMIC_RELEASE);
+}
 
-	if (!desc->nb_trigs)
-		return -ENOENT;
+static inline uint32_t iio_trig_take_pending(volatile uint32_t *word)
+{
+	return __atomic_exchange_n(word, 0, __ATOMIC_ACQUIRE);
+}
+#else
+static inline void iio_trig_set_pending(volatile uint32_t *word, uint32_t bit)
+{
+	*word |= bit;
+}
 
-	trig = get_iio_trig_device(desc, device);
-	/* Device is a trigger and triggers cannot have other triggers */
-	if (trig)
-		return -ENOENT;
+static inline uint32_t iio_trig_take_pending(volatile uint32_t *word)
+{
+	uint32_t val = *word;
 
-	dev = get_iio_device(desc, device);
-	if (!dev)
-		return -ENODEV;
+	*word &= ~val;
 
-	if (dev->trig_idx == NO_TRIGGER) {
+	return val;
+}
+#endif
+
+/**
+ * @brief Set the trigger of a device and update the subscribers of the old and
+ * new trigger.
+ * @param desc     - IIO descriptor.
+ * @param dev      - Device.
+ * @param trig_idx - Trigger index or NO_TRIGGER.
+ */
+static void iio_attach_trigger(struct iio_desc *desc, struct iio_dev_priv *dev,
+			       uint32_t trig_idx)
+{
+	struct iio_trig_priv *trig;
+	uint32_t i;
+
+	if (dev->trig_idx != NO_TRIGGER) {
+		trig = &desc->trigs[dev->trig_idx];
+		for (i = 0; i < trig->nb_subs; i++) {
+			if (trig->subs[i] != dev)
+				continue;
+			trig->subs[i] = trig->subs[trig->nb_subs - 1];
+			trig->nb_subs--;
+			break;
+		}
+	}
+
+	dev->trig_idx = trig_idx;
+	if (trig_idx == NO_TRIGGER)
+		return;
+
+	/* Fill the slot before making it visible to the interrupt */
+	trig = &desc->trigs[trig_idx];
+	trig->subs[trig->nb_subs] = dev;
+	trig->nb_subs++;
+}
+
+/**
+ * @brief Get the handle of a trigger, to be passed to iio_process_trigger().
+ * @param desc         - IIO descriptor.
+ * @param trigger_name - Trigger name.
+ * @return Handle or negative error code.
+ */
+int iio_get_trigger_handle(struct iio_desc *desc, const char *trigger_name)
+{
+	uint32_t trig_id;
+
+	if (!desc)
+		return -EINVAL;
+
+	trig_id = iio_get_trig_idx_by_name(desc, trigger_name);
+	if (trig_id == NO_TRIGGER)
+		return -ENOENT;
+
+	return trig_id;
+}
+
+/**
+ * @brief Searches for active trigger of the given device and returns trigger name.
+ * @param ctx     - IIO instance and conn instance.
+ * @param device  - String containing device name.
+ * @param trigger - Trigger name to be returned.
+ * @param len     - Maximum length of value to be stored in name.
+ * @return Number of bytes written in name.
+ */
+static int iio_get_trigger(struct iiod_ctx *ctx, const char *device,
+			   char *trigger, uint32_t len)
+{
+	struct iio_dev_priv *dev;
+	struct iio_trig_priv *trig;
+	struct iio_desc *desc = ctx->instance;
+
+	if (!desc->nb_trigs)
+		return -ENOENT;
+
+	trig = get_iio_trig_device(desc, device);
+	/* Device is a trigger and triggers cannot have other triggers */
+	if (trig)
+		return -ENOENT;
+
+	dev = get_iio_device(desc, device);
+	if (!dev)
+		return -ENODEV;
+
+	if (dev->trig_idx == NO_TRIGGER) {
 		trigger[0] = '\0';
 
 		return 0;
@@ -1023,7 +1429,7 @@ static int iio_set_trigger(struct iiod_ctx *ctx, const char *device,
 		return -ENODEV;
 
 	if (trigger[0] == '\0') {
-		dev->trig_idx = NO_TRIGGER;
+		iio_attach_trigger(desc, dev, NO_TRIGGER);
 		return 0;
 	}
 
@@ -1031,33 +1437,98 @@ static int iio_set_trigger(struct iiod_ctx *ctx, const char *device,
 	if (i == NO_TRIGGER)
 		return -EINVAL;
 
-	dev->trig_idx = i;
+	if (i != dev->trig_idx)
+		iio_attach_trigger(desc, dev, i);
 
 	return len;
 }
 
 /**
- * @brief Asynchronous trigger processing routine.
+ * @brief Account the time elapsed since the trigger of a device fired. Bucket
+ * n counts latencies below 10^(n + 1) us, the last one all the others.
+ * @param dev - Device whose trigger handler is about to be called.
+ */
+static void iio_stats_trig_latency(struct iio_dev_priv *dev)
+{
+	int64_t us, limit = 10;
+	uint32_t i = 0;
+
+	us = (iio_get_timestamp() - dev->buffer.public.timestamp) / 1000;
+	while (i < IIO_STATS_LATENCY_BUCKETS - 1 && us >= limit) {
+		limit *= 10;
+		i++;
+	}
+
+	dev->trig_latency[i]++;
+}
+
+/**
+ * @brief Asynchronous trigger processing routine. Only the triggers that fired
+ * since the last call are visited.
  * @param desc - IIO descriptor.
  */
 static void iio_process_async_triggers(struct iio_desc *desc)
 {
+	struct iio_trig_priv *trig;
 	struct iio_dev_priv *dev;
+	uint32_t pending;
+	uint32_t i, j, bit;
+
+	for (i = 0; i < IIO_MASK_WORDS(desc->nb_trigs); i++) {
+		pending = iio_trig_take_pending(&desc->trig_pending[i]);
+		while (pending) {
+			bit = no_os_find_first_set_bit(pending);
+			pending &= ~NO_OS_BIT(bit);
+			trig = &desc->trigs[i * 32 + bit];
+			for (j = 0; j < trig->nb_subs; j++) {
+				dev = trig->subs[j];
+				if (!dev->dev_descriptor->trigger_handler)
+					continue;
+				iio_stats_trig_latency(dev);
+				dev->dev_descriptor->trigger_handler(&dev->dev_data);
+			}
+		}
+	}
+}
+
+/**
+ * @brief Process a trigger based on its type (sync or async with the
+ * interrupt). Takes the same time regardless of the number of devices and
+ * triggers in the context, so it can be called from interrupts.
+ * @param desc   - IIO descriptor.
+ * @param handle - Trigger handle, from iio_get_trigger_handle().
+ *
+ * @return ret - Result of the processing procedure.
+ */
+int iio_process_trigger(struct iio_desc *desc, uint32_t handle)
+{
+	struct iio_trig_priv *trig;
+	struct iio_dev_priv *dev;
+	int64_t timestamp;
 	uint32_t i;
 
-	for (i = 0; i < desc->nb_devs; i++) {
-		dev = desc->devs + i;
-		if (dev->trig_idx == NO_TRIGGER)
-			continue;
+	if (!desc || handle >= desc->nb_trigs)
+		return -EINVAL;
 
-		if (!desc->trigs[dev->trig_idx].triggered)
-			continue;
+	trig = &desc->trigs[handle];
+	if (!trig->nb_subs)
+		return 0;
 
-		if (dev->dev_descriptor->trigger_handler) {
+	/* Same time for all devices sharing the trigger */
+	timestamp = iio_get_timestamp();
+	for (i = 0; i < trig->nb_subs; i++) {
+		dev = trig->subs[i];
+		dev->buffer.public.timestamp = timestamp;
+		if (trig->descriptor->is_synchronous &&
+		    dev->dev_descriptor->trigger_handler)
 			dev->dev_descriptor->trigger_handler(&dev->dev_data);
-			desc->trigs[i].triggered = 0;
-		}
 	}
+
+	if (!trig->descriptor->is_synchronous)
+		iio_trig_set_pending(&desc->trig_pending[handle / 32],
+				     NO_OS_BIT(handle % 32));
+
+	return 0;
 }
 
 /**
@@ -1070,86 +1541,103 @@ static void iio_process_async_triggers(struct iio_desc *desc)
  */
 int iio_process_trigger_type(struct iio_desc *desc, char *trigger_name)
 {
-	uint32_t i;
-	uint32_t trig_id;
-	struct iio_trig_priv *trig;
+	int handle;
 
-	trig_id = iio_get_trig_idx_by_name(desc, trigger_name);
-
-	if (trig_id == NO_TRIGGER)
+	handle = iio_get_trigger_handle(desc, trigger_name);
+	if (handle < 0)
 		return -EINVAL;
 
-	struct iio_dev_priv *dev;
-
-	for (i = 0; i < desc->nb_devs; i++) {
-		dev = desc->devs + i;
-		if (dev->trig_idx == trig_id) {
-			trig = &desc->trigs[trig_id];
-			if (trig->descriptor->is_synchronous) {
-				if (dev->dev_descriptor->trigger_handler)
-					dev->dev_descriptor->trigger_handler(&dev->dev_data);
-			} else {
-				trig->triggered = 1;
-			}
-		}
-	}
-
-	return 0;
+	return iio_process_trigger(desc, handle);
 }
 
-static uint32_t bytes_per_scan(struct iio_channel *channels, uint32_t mask)
+static uint32_t bytes_per_scan(struct iio_channel *channels,
+			       const uint32_t *mask, uint32_t nb_words)
 {
-	uint32_t cnt, i;
+	uint32_t cnt, i, w, word;
 
 	cnt = 0;
-	i = 0;
-	while (mask) {
-		if ((mask & 1))
-			cnt += channels[i].scan_type->storagebits / 8;
-		mask >>= 1;
-		++i;
+	for (w = 0; w < nb_words; w++) {
+		word = mask[w];
+		i = w * 32;
+		while (word) {
+			if ((word & 1))
+				cnt += channels[i].scan_type->storagebits / 8;
+			word >>= 1;
+			++i;
+		}
 	}
 
 	return cnt;
 }
 
 /**
- * @brief  Open device.
- * @param ctx - IIO instance and conn instance
- * @param device - String containing device name.
+ * @brief  Open the buffer of a device.
+ * @param desc - IIO descriptor.
+ * @param dev - Device.
  * @param sample_size - Sample size.
  * @param mask - Channels to be opened.
+ * @param nb_words - Number of 32 bit words in mask.
  * @return 0, negative value in case of failure.
  */
-static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
-			uint32_t samples, uint32_t mask, bool cyclic)
+static int iio_dev_open(struct iio_desc *desc, struct iio_dev_priv *dev,
+			uint32_t samples, const uint32_t *mask,
+			uint32_t nb_words, bool cyclic)
 {
-	struct iio_desc *desc;
-	struct iio_dev_priv *dev;
 	struct iio_trig_priv *trig;
-	uint32_t ch_mask;
+	struct iio_buffer *buffer;
+	uint32_t ch_mask, active, word, i, ts_ch;
 	int32_t ret;
 	int8_t *buf;
 	uint32_t buf_size;
 
-	dev = get_iio_device(ctx->instance, device);
-	if (!dev)
-		return -ENODEV;
-
 	if (!dev->buffer.initalized)
 		return -EINVAL;
 
-	ch_mask = 0xFFFFFFFF >> (32 - dev->dev_descriptor->num_ch);
-	mask &= ch_mask;
-	if (!mask)
+	buffer = &dev->buffer.public;
+	ch_mask = dev->dev_descriptor->num_ch % 32 ?
+		  NO_OS_GENMASK(dev->dev_descriptor->num_ch % 32 - 1, 0) :
+		  0xFFFFFFFF;
+	for (i = 0; i < buffer->nb_mask_words; i++) {
+		word = i < nb_words ? mask[i] : 0;
+		if (i == buffer->nb_mask_words - 1)
+			word &= ch_mask;
+		buffer->active_masks[i] = word;
+	}
+
+	/* The timestamp is filled by iio, drivers only see their channels */
+	buffer->timestamp_en = false;
+	if (dev->dev_descriptor->timestamp) {
+		ts_ch = dev->dev_descriptor->num_ch - 1;
+		if (buffer->active_masks[ts_ch / 32] & NO_OS_BIT(ts_ch % 32)) {
+			/* Scans are only pushed by trigger_handler or submit */
+			if (dev->trig_idx == NO_TRIGGER &&
+			    !dev->dev_descriptor->submit)
+				return -EOPNOTSUPP;
+			buffer->active_masks[ts_ch / 32] &= ~NO_OS_BIT(ts_ch % 32);
+			buffer->timestamp_en = true;
+			/* The FIFO starts filling up from now on */
+			buffer->last_timestamp = iio_get_timestamp();
+		}
+	}
+	active = 0;
+	for (i = 0; i < buffer->nb_mask_words; i++)
+		active |= buffer->active_masks[i];
+	if (!active)
 		return -ENOENT;
 
 	dev->buffer.public.cyclic_info.is_cyclic = cyclic;
 	dev->buffer.public.cyclic_info.buff_index = 0;
-
-	dev->buffer.public.active_mask = mask;
-	dev->buffer.public.bytes_per_scan =
-		bytes_per_scan(dev->dev_descriptor->channels, mask);
+	dev->starved = false;
+
+	buffer->active_mask = buffer->active_masks[0];
+	buffer->data_bytes = bytes_per_scan(dev->dev_descriptor->channels,
+					    buffer->active_masks,
+					    buffer->nb_mask_words);
+	buffer->bytes_per_scan = buffer->data_bytes;
+	/* Same layout as libiio: the timestamp is aligned to its size */
+	if (buffer->timestamp_en)
+		buffer->bytes_per_scan = no_os_round_up(buffer->data_bytes, 8) *
+					 8 + 8;
 	dev->buffer.public.size = dev->buffer.public.bytes_per_scan * samples;
 	dev->buffer.public.samples = samples;
 	if (dev->buffer.raw_buf && dev->buffer.raw_buf_len) {
@@ -1182,8 +1670,15 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 		return ret;
 	}
 
-	if (dev->dev_descriptor->pre_enable) {
-		ret = dev->dev_descriptor->pre_enable(dev->dev_instance, mask);
+	if (dev->dev_descriptor->pre_enable_wide ||
+	    dev->dev_descriptor->pre_enable) {
+		if (dev->dev_descriptor->pre_enable_wide)
+			ret = dev->dev_descriptor->pre_enable_wide(
+				      dev->dev_instance, buffer->active_masks,
+				      buffer->nb_mask_words);
+		else
+			ret = dev->dev_descriptor->pre_enable(dev->dev_instance,
+							      buffer->active_mask);
 		if (NO_OS_IS_ERR_VALUE(ret) && dev->buffer.allocated) {
 			no_os_free(dev->buffer.cb.buff);
 			dev->buffer.allocated = 0;
@@ -1191,7 +1686,6 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 		}
 	}
 
-	desc = ctx->instance;
 	if (dev->trig_idx != NO_TRIGGER) {
 		trig = &desc->trigs[dev->trig_idx];
 		if (trig->descriptor->enable)
@@ -1202,21 +1696,38 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 }
 
 /**
- * @brief Close device.
+ * @brief  Open device.
  * @param ctx - IIO instance and conn instance
  * @param device - String containing device name.
+ * @param sample_size - Sample size.
+ * @param mask - Channels to be opened.
+ * @param nb_words - Number of 32 bit words in mask.
  * @return 0, negative value in case of failure.
  */
-static int iio_close_dev(struct iiod_ctx *ctx, const char *device)
+static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
+			uint32_t samples, const uint32_t *mask,
+			uint32_t nb_words, bool cyclic)
 {
-	struct iio_desc *desc;
 	struct iio_dev_priv *dev;
-	struct iio_trig_priv *trig;
-	int ret = 0;
 
 	dev = get_iio_device(ctx->instance, device);
 	if (!dev)
-		return -1;
+		return -ENODEV;
+
+	return iio_dev_open(ctx->instance, dev, samples, mask, nb_words,
+			    cyclic);
+}
+
+/**
+ * @brief Close the buffer of a device.
+ * @param desc - IIO descriptor.
+ * @param dev - Device.
+ * @return 0, negative value in case of failure.
+ */
+static int iio_dev_close(struct iio_desc *desc, struct iio_dev_priv *dev)
+{
+	struct iio_trig_priv *trig;
+	int ret = 0;
 
 	if (!dev->buffer.initalized)
 		return -EINVAL;
@@ -1227,7 +1738,6 @@ static int iio_close_dev(struct iiod_ctx *ctx, const char *device)
 		dev->buffer.allocated = 0;
 	}
 
-	desc = ctx->instance;
 	if(dev->trig_idx != NO_TRIGGER) {
 		trig = &desc->trigs[dev->trig_idx];
 		if (trig->descriptor->disable) {
@@ -1237,23 +1747,43 @@ static int iio_close_dev(struct iiod_ctx *ctx, const char *device)
 		}
 	}
 
+	memset(dev->buffer.public.active_masks, 0,
+	       dev->buffer.public.nb_mask_words * sizeof(uint32_t));
 	dev->buffer.public.active_mask = 0;
+	dev->buffer.public.timestamp_en = false;
 	if (dev->dev_descriptor->post_disable)
 		ret = dev->dev_descriptor->post_disable(dev->dev_instance);
 
 	return ret;
 }
 
-static int iio_call_submit(struct iiod_ctx *ctx, const char *device,
-			   enum iio_buffer_direction dir)
+/**
+ * @brief Close device.
+ * @param ctx - IIO instance and conn instance
+ * @param device - String containing device name.
+ * @return 0, negative value in case of failure.
+ */
+static int iio_close_dev(struct iiod_ctx *ctx, const char *device)
 {
 	struct iio_dev_priv *dev;
 
 	dev = get_iio_device(ctx->instance, device);
-	if (!dev || !dev->buffer.initalized)
+	if (!dev)
+		return -1;
+
+	return iio_dev_close(ctx->instance, dev);
+}
+
+static int iio_dev_submit(struct iio_dev_priv *dev,
+			  enum iio_buffer_direction dir)
+{
+	if (!dev->buffer.initalized)
 		return -EINVAL;
 
 	dev->buffer.public.dir = dir;
+	/* Without a trigger, scans are stamped with the time of the request */
+	if (dev->buffer.public.timestamp_en && dev->trig_idx == NO_TRIGGER)
+		dev->buffer.public.timestamp = iio_get_timestamp();
 	if (dev->dev_descriptor->submit && dev->trig_idx==NO_TRIGGER)
 		return dev->dev_descriptor->submit(&dev->dev_data);
 	else if ((dir == IIO_DIRECTION_INPUT && dev->dev_descriptor->read_dev
@@ -1275,158 +1805,836 @@ static int iio_call_submit(struct iiod_ctx *ctx, const char *device,
 		else
 			ret = dev->dev_descriptor->write_dev(dev->dev_instance,
 							     buff, buffer->samples);
+		if (ret == -EAGAIN) {
+			/* Device busy, hand out the same block on the retry */
+			if (dir == IIO_DIRECTION_INPUT)
+				no_os_cb_abort_async_write(buffer->buf);
+			else
+				no_os_cb_abort_async_read(buffer->buf);
+		}
 		if (NO_OS_IS_ERR_VALUE(ret))
 			return ret;
 
-		return iio_buffer_block_done(buffer);
-	}
+		return iio_buffer_block_done(buffer);
+	}
+
+	return 0;
+}
+
+static int iio_call_submit(struct iiod_ctx *ctx, const char *device,
+			   enum iio_buffer_direction dir)
+{
+	struct iio_dev_priv *dev;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev)
+		return -EINVAL;
+
+	return iio_dev_submit(dev, dir);
+}
+
+static int iio_push_buffer(struct iiod_ctx *ctx, const char *device)
+{
+	return iio_call_submit(ctx, device, IIO_DIRECTION_OUTPUT);
+}
+
+static int iio_refill_buffer(struct iiod_ctx *ctx, const char *device)
+{
+	return iio_call_submit(ctx, device, IIO_DIRECTION_INPUT);
+}
+
+/**
+ * @brief Read chunk of data from RAM to pbuf. Call
+ * "iio_transfer_dev_to_mem()" first.
+ * This function is probably called multiple times by libtinyiiod after a
+ * "iio_transfer_dev_to_mem" call, since we can only read "bytes_count" bytes.
+ * @param dev - Device.
+ * @param pbuf - Buffer where value is stored.
+ * @param offset - Offset to the remaining data after reading n chunks.
+ * @param bytes_count - Number of bytes to read.
+ * @return: Bytes_count or negative value in case of error.
+ */
+static int iio_dev_read_buffer(struct iio_dev_priv *dev, char *buf,
+			       uint32_t bytes)
+{
+	int32_t			ret;
+	uint32_t		size;
+
+	if (!dev->buffer.initalized)
+		return -EINVAL;
+
+	ret = no_os_cb_size(&dev->buffer.cb, &size);
+	if (ret == -NO_OS_EOVERRUN)
+		dev->overruns++;
+#ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
+#warning Buffer overrun error checking is disabled.
+	if (ret != -NO_OS_EOVERRUN)
+#endif
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+	bytes = no_os_min(size, bytes);
+	if (!bytes)
+		return -EAGAIN;
+
+	ret = no_os_cb_read(&dev->buffer.cb, buf, bytes);
+#ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
+	if (ret != -NO_OS_EOVERRUN)
+#endif
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+	return bytes;
+}
+
+static int iio_read_buffer(struct iiod_ctx *ctx, const char *device, char *buf,
+			   uint32_t bytes)
+{
+	struct iio_dev_priv	*dev;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev)
+		return -EINVAL;
+
+	return iio_dev_read_buffer(dev, buf, bytes);
+}
+
+
+/**
+ * @brief Write chunk of data into RAM.
+ * This function is probably called multiple times by libtinyiiod before a
+ * "iio_transfer_mem_to_dev" call, since we can only write "bytes_count" bytes
+ * at a time.
+ * @param dev - Device.
+ * @param buf - Values to write.
+ * @param offset - Offset in memory after the nth chunk of data.
+ * @param bytes_count - Number of bytes to write.
+ * @return Bytes_count or negative value in case of error.
+ */
+static int iio_dev_write_buffer(struct iio_dev_priv *dev, const char *buf,
+				uint32_t bytes)
+{
+	int32_t			ret;
+	uint32_t		available;
+	uint32_t		size;
+
+	if (!dev->buffer.initalized)
+		return -EINVAL;
+
+	ret = no_os_cb_size(&dev->buffer.cb, &size);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	available = dev->buffer.public.size - size;
+	bytes = no_os_min(available, bytes);
+	ret = no_os_cb_write(&dev->buffer.cb, buf, bytes);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	return bytes;
+}
+
+static int iio_write_buffer(struct iiod_ctx *ctx, const char *device,
+			    const char *buf, uint32_t bytes)
+{
+	struct iio_dev_priv	*dev;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev)
+		return -EINVAL;
+
+	return iio_dev_write_buffer(dev, buf, bytes);
+}
+
+int iio_buffer_get_block(struct iio_buffer *buffer, void **addr)
+{
+	uint32_t size;
+
+	if (!buffer)
+		return -EINVAL;
+
+	if (buffer->dir == IIO_DIRECTION_INPUT)
+		return no_os_cb_prepare_async_write(buffer->buf, buffer->size, addr, &size);
+
+	return no_os_cb_prepare_async_read(buffer->buf, buffer->size, addr, &size);
+}
+
+int iio_buffer_block_done(struct iio_buffer *buffer)
+{
+	if (!buffer)
+		return -EINVAL;
+
+	if (buffer->dir == IIO_DIRECTION_INPUT)
+		return no_os_cb_end_async_write(buffer->buf);
+
+	return no_os_cb_end_async_read(buffer->buf);
+}
+
+/* Check if channel ch is enabled in the current scan */
+bool iio_buffer_ch_active(struct iio_buffer *buffer, uint32_t ch)
+{
+	if (!buffer || ch >= buffer->nb_mask_words * 32)
+		return false;
+
+	if (ch < 32)
+		return buffer->active_mask & NO_OS_BIT(ch);
+
+	return buffer->active_masks[ch / 32] & NO_OS_BIT(ch % 32);
+}
+
+/* Write to buffer iio_buffer.bytes_per_scan bytes from data */
+int iio_buffer_push_scan(struct iio_buffer *buffer, void *data)
+{
+	if (!buffer)
+		return -EINVAL;
+
+	if (buffer->timestamp_en)
+		return iio_buffer_push_scan_ts(buffer, data, buffer->timestamp);
+
+	return no_os_cb_write(buffer->buf, data, buffer->bytes_per_scan);
+}
+
+/*
+ * Write iio_buffer.data_bytes bytes from data followed by the timestamp. The
+ * timestamp is dropped if it wasn't enabled.
+ */
+int iio_buffer_push_scan_ts(struct iio_buffer *buffer, void *data,
+			    int64_t timestamp)
+{
+	/* Up to 7 bytes of padding and the timestamp */
+	uint8_t tail[15] = {0};
+	uint32_t pad;
+	int ret;
+
+	if (!buffer)
+		return -EINVAL;
+
+	if (!buffer->timestamp_en)
+		return no_os_cb_write(buffer->buf, data, buffer->bytes_per_scan);
+
+	ret = no_os_cb_write(buffer->buf, data, buffer->data_bytes);
+	if (ret)
+		return ret;
+
+	pad = buffer->bytes_per_scan - 8 - buffer->data_bytes;
+	no_os_put_unaligned_le32((uint64_t)timestamp, tail + pad);
+	no_os_put_unaligned_le32((uint64_t)timestamp >> 32, tail + pad + 4);
+	buffer->last_timestamp = timestamp;
+
+	return no_os_cb_write(buffer->buf, tail, pad + 8);
+}
+
+/*
+ * Write nb_scans scans of iio_buffer.data_bytes bytes each from data, oldest
+ * first. Meant for draining a device FIFO in one go: the newest scan gets the
+ * time of the trigger and the older ones are spread evenly since the last
+ * pushed scan.
+ */
+int iio_buffer_push_scans(struct iio_buffer *buffer, void *data,
+			  uint32_t nb_scans)
+{
+	uint8_t *scan = data;
+	int64_t period;
+	uint32_t i;
+	int ret;
+
+	if (!buffer || !nb_scans)
+		return -EINVAL;
+
+	if (!buffer->timestamp_en)
+		return no_os_cb_write(buffer->buf, data,
+				      nb_scans * buffer->bytes_per_scan);
+
+	period = (buffer->timestamp - buffer->last_timestamp) / nb_scans;
+	if (period < 0)
+		period = 0;
+
+	for (i = 0; i < nb_scans; i++) {
+		ret = iio_buffer_push_scan_ts(buffer, scan, buffer->timestamp -
+					      (int64_t)(nb_scans - 1 - i) * period);
+		if (ret)
+			return ret;
+		scan += buffer->data_bytes;
+	}
+
+	return 0;
+}
+
+/*
+ * Read from buffer iio_buffer.bytes_per_scan bytes into data. If the client
+ * did not provide a whole scan yet, the device starves: an underrun is counted
+ * and -EAGAIN returned.
+ */
+int iio_buffer_pop_scan(struct iio_buffer *buffer, void *data)
+{
+	struct iio_dev_priv *dev;
+	uint32_t size;
+
+	if (!buffer)
+		return -EINVAL;
+
+	if(!buffer->cyclic_info.is_cyclic) {
+		dev = (struct iio_dev_priv *)((uint8_t *)buffer -
+					      offsetof(struct iio_dev_priv,
+						       buffer.public));
+		if (!no_os_cb_size(buffer->buf, &size) &&
+		    size < buffer->bytes_per_scan) {
+			if (!dev->starved)
+				dev->underruns++;
+			dev->starved = true;
+
+			return -EAGAIN;
+		}
+		dev->starved = false;
+
+		return no_os_cb_read(buffer->buf, data, buffer->bytes_per_scan);
+	}
+
+	memcpy(data,
+	       &buffer->buf->buff[buffer->cyclic_info.buff_index],
+	       buffer->bytes_per_scan);
+
+	buffer->cyclic_info.buff_index += buffer->bytes_per_scan;
+	if (buffer->size == buffer->cyclic_info.buff_index)
+		buffer->cyclic_info.buff_index = 0;
+
+	return 0;
+}
+
+/**
+ * @brief Get the handle of a device, to be used with the direct client API.
+ * @param desc - IIO descriptor.
+ * @param name - Device name or id (iio:deviceX).
+ * @return Device handle, negative error code if not found.
+ */
+int iio_direct_get_device(struct iio_desc *desc, const char *name)
+{
+	uint32_t i;
+
+	if (!desc || !name)
+		return -EINVAL;
+
+	for (i = 0; i < desc->nb_devs; i++)
+		if (!strcmp(desc->devs[i].dev_id, name) ||
+		    (desc->devs[i].name && !strcmp(desc->devs[i].name, name)))
+			return i;
+
+	return -ENODEV;
+}
+
+static struct iio_dev_priv *iio_direct_dev(struct iio_desc *desc, int dev)
+{
+	if (!desc || dev < 0 || (uint32_t)dev >= desc->nb_devs)
+		return NULL;
+
+	return &desc->devs[dev];
+}
+
+/**
+ * @brief Get the index of a channel of a device.
+ * @param desc - IIO descriptor.
+ * @param dev - Device handle.
+ * @param channel - Channel id (voltage0, temp, accel_x...).
+ * @param output - True for output channels.
+ * @return Channel index, which is also its bit in the buffer mask, negative
+ * error code if not found.
+ */
+int iio_direct_get_channel(struct iio_desc *desc, int dev, const char *channel,
+			   bool output)
+{
+	struct iio_dev_priv *ldev = iio_direct_dev(desc, dev);
+	struct iio_channel *ch;
+
+	if (!ldev || !channel)
+		return -EINVAL;
+
+	ch = iio_get_channel(channel, ldev->dev_descriptor, output);
+	if (!ch)
+		return -ENOENT;
+
+	return ch - ldev->dev_descriptor->channels;
+}
+
+static int iio_direct_find_attr(struct iio_desc *desc, int dev, int ch,
+				enum iio_attr_type type, const char *name,
+				struct iio_attr_handle *attr)
+{
+	struct iio_dev_priv *ldev = iio_direct_dev(desc, dev);
+	struct iio_attribute *attributes;
+	struct iio_channel *channel = NULL;
+	uint32_t i;
+
+	if (!ldev || !name || !attr)
+		return -EINVAL;
+
+	if (ch >= 0) {
+		if (ch >= ldev->dev_descriptor->num_ch)
+			return -EINVAL;
+		channel = &ldev->dev_descriptor->channels[ch];
+		type = channel->ch_out ? IIO_ATTR_TYPE_CH_OUT :
+		       IIO_ATTR_TYPE_CH_IN;
+	}
+
+	attributes = get_attributes(type, ldev, channel);
+	for (i = 0; attributes && attributes[i].name; i++) {
+		if (strcmp(attributes[i].name, name))
+			continue;
+		attr->dev = ldev;
+		attr->ch = channel;
+		attr->attr = &attributes[i];
+		return 0;
+	}
+
+	return -ENOENT;
+}
+
+/**
+ * @brief Find an attribute of a device or of one of its channels.
+ * @param desc - IIO descriptor.
+ * @param dev - Device handle.
+ * @param ch - Channel index, negative for device attributes.
+ * @param name - Attribute name.
+ * @param attr - Filled with the attribute handle.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int iio_direct_get_attr(struct iio_desc *desc, int dev, int ch,
+			const char *name, struct iio_attr_handle *attr)
+{
+	return iio_direct_find_attr(desc, dev, ch, IIO_ATTR_TYPE_DEVICE, name,
+				    attr);
+}
+
+/**
+ * @brief Find a buffer attribute of a device.
+ * @param desc - IIO descriptor.
+ * @param dev - Device handle.
+ * @param name - Attribute name.
+ * @param attr - Filled with the attribute handle.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int iio_direct_get_buffer_attr(struct iio_desc *desc, int dev,
+			       const char *name, struct iio_attr_handle *attr)
+{
+	return iio_direct_find_attr(desc, dev, -1, IIO_ATTR_TYPE_BUFFER, name,
+				    attr);
+}
+
+/**
+ * @brief Find a debug attribute of a device.
+ * @param desc - IIO descriptor.
+ * @param dev - Device handle.
+ * @param name - Attribute name.
+ * @param attr - Filled with the attribute handle.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int iio_direct_get_debug_attr(struct iio_desc *desc, int dev,
+			      const char *name, struct iio_attr_handle *attr)
+{
+	return iio_direct_find_attr(desc, dev, -1, IIO_ATTR_TYPE_DEBUG, name,
+				    attr);
+}
+
+static void iio_direct_attr_params(struct iio_attr_handle *attr,
+				   struct attr_fun_params *params,
+				   struct iio_ch_info *ch_info,
+				   char *buf, uint32_t len)
+{
+	params->ch_info = NULL;
+	if (attr->ch) {
+		ch_info->ch_out = attr->ch->ch_out;
+		ch_info->ch_num = attr->ch->channel;
+		ch_info->type = attr->ch->ch_type;
+		ch_info->differential = attr->ch->diferential;
+		ch_info->address = attr->ch->address;
+		params->ch_info = ch_info;
+	}
+	params->buf = buf;
+	params->len = len;
+	params->dev_instance = attr->dev->dev_instance;
+	params->dev = attr->dev;
+	params->ch = attr->ch;
+}
+
+/**
+ * @brief Read an attribute as a string. Cached values are used the same way
+ * as for iiod clients.
+ * @param attr - Attribute handle.
+ * @param buf - Value.
+ * @param len - Size of buf.
+ * @return Length of the value, negative error code otherwise.
+ */
+int iio_direct_attr_read(struct iio_attr_handle *attr, char *buf, uint32_t len)
+{
+	struct attr_fun_params params;
+	struct iio_ch_info ch_info;
+
+	if (!attr || !attr->attr || !buf)
+		return -EINVAL;
+
+	iio_direct_attr_params(attr, &params, &ch_info, buf, len);
+
+	return iio_attr_show(&params, attr->attr);
+}
+
+/**
+ * @brief Write an attribute as a string.
+ * @param attr - Attribute handle.
+ * @param buf - Null terminated value.
+ * @param len - Length of the value.
+ * @return Value returned by the store function, negative error code
+ * otherwise.
+ */
+int iio_direct_attr_write(struct iio_attr_handle *attr, char *buf,
+			  uint32_t len)
+{
+	struct attr_fun_params params;
+	struct iio_ch_info ch_info;
+
+	if (!attr || !attr->attr || !buf)
+		return -EINVAL;
 
-	return 0;
+	iio_direct_attr_params(attr, &params, &ch_info, buf, len);
+
+	return iio_attr_store(&params, attr->attr, buf, len);
 }
 
-static int iio_push_buffer(struct iiod_ctx *ctx, const char *device)
+/**
+ * @brief Read an attribute and parse its value.
+ * @param attr - Attribute handle.
+ * @param fmt - Format of the value.
+ * @param size - Number of entries in vals.
+ * @param vals - Parsed values, see iio_parse_values().
+ * @return Number of parsed values, negative error code otherwise.
+ */
+int iio_direct_attr_get(struct iio_attr_handle *attr, enum iio_val fmt,
+			int32_t size, int32_t *vals)
 {
-	return iio_call_submit(ctx, device, IIO_DIRECTION_OUTPUT);
+	char buf[IIO_DIRECT_ATTR_LEN];
+	int ret;
+
+	ret = iio_direct_attr_read(attr, buf, sizeof(buf));
+	if (ret < 0)
+		return ret;
+	if ((uint32_t)ret >= sizeof(buf))
+		return -ENOSPC;
+
+	return iio_parse_values(buf, fmt, size, vals);
 }
 
-static int iio_refill_buffer(struct iiod_ctx *ctx, const char *device)
+/**
+ * @brief Format values and write them to an attribute.
+ * @param attr - Attribute handle.
+ * @param fmt - Format of the value.
+ * @param size - Number of values.
+ * @param vals - Values.
+ * @return Value returned by the store function, negative error code
+ * otherwise.
+ */
+int iio_direct_attr_set(struct iio_attr_handle *attr, enum iio_val fmt,
+			int32_t size, int32_t *vals)
 {
-	return iio_call_submit(ctx, device, IIO_DIRECTION_INPUT);
+	char buf[IIO_DIRECT_ATTR_LEN];
+	int ret;
+
+	if (!vals)
+		return -EINVAL;
+
+	ret = iio_format_value(buf, sizeof(buf), fmt, size, vals);
+	if (ret <= 0)
+		return -EINVAL;
+	if ((uint32_t)ret >= sizeof(buf))
+		return -ENOSPC;
+
+	return iio_direct_attr_write(attr, buf, ret);
 }
 
 /**
- * @brief Read chunk of data from RAM to pbuf. Call
- * "iio_transfer_dev_to_mem()" first.
- * This function is probably called multiple times by libtinyiiod after a
- * "iio_transfer_dev_to_mem" call, since we can only read "bytes_count" bytes.
- * @param device - String containing device name.
- * @param pbuf - Buffer where value is stored.
- * @param offset - Offset to the remaining data after reading n chunks.
- * @param bytes_count - Number of bytes to read.
- * @return: Bytes_count or negative value in case of error.
+ * @brief Open the buffer of a device. Triggers and timestamps work the same
+ * as for an iiod client.
+ * @param desc - IIO descriptor.
+ * @param dev - Device handle.
+ * @param samples - Number of scans in the buffer.
+ * @param mask - Channels to be enabled, see iio_direct_get_channel().
+ * @param nb_words - Number of 32 bit words in mask.
+ * @param dir - IIO_DIRECTION_INPUT to capture, IIO_DIRECTION_OUTPUT to
+ *              generate samples.
+ * @param cyclic - Output the buffer repeatedly.
+ * @return 0 in case of success, negative error code otherwise.
  */
-static int iio_read_buffer(struct iiod_ctx *ctx, const char *device, char *buf,
-			   uint32_t bytes)
+int iio_direct_buffer_open(struct iio_desc *desc, int dev, uint32_t samples,
+			   const uint32_t *mask, uint32_t nb_words,
+			   enum iio_buffer_direction dir, bool cyclic)
 {
-	struct iio_dev_priv	*dev;
-	int32_t			ret;
-	uint32_t		size;
+	struct iio_dev_priv *ldev = iio_direct_dev(desc, dev);
+	int ret;
 
-	dev = get_iio_device(ctx->instance, device);
-	if (!dev || !dev->buffer.initalized)
+	if (!ldev || !mask || !nb_words)
 		return -EINVAL;
 
-	ret = no_os_cb_size(&dev->buffer.cb, &size);
-#ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
-#warning Buffer overrun error checking is disabled.
-	if (ret != -NO_OS_EOVERRUN)
-#endif
-		if (NO_OS_IS_ERR_VALUE(ret))
-			return ret;
+	ret = iio_dev_open(desc, ldev, samples, mask, nb_words, cyclic);
+	if (ret)
+		return ret;
 
-	bytes = no_os_min(size, bytes);
-	if (!bytes)
-		return -EAGAIN;
+	ldev->buffer.public.dir = dir;
 
+	return 0;
+}
 
-	ret = no_os_cb_read(&dev->buffer.cb, buf, bytes);
-#ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
-	if (ret != -NO_OS_EOVERRUN)
-#endif
-		if (NO_OS_IS_ERR_VALUE(ret))
-			return ret;
+/**
+ * @brief Close the buffer of a device, as CLOSE does.
+ * @param desc - IIO descriptor.
+ * @param dev - Device handle.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int iio_direct_buffer_close(struct iio_desc *desc, int dev)
+{
+	struct iio_dev_priv *ldev = iio_direct_dev(desc, dev);
 
-	return bytes;
+	if (!ldev)
+		return -EINVAL;
+
+	return iio_dev_close(desc, ldev);
 }
 
+/**
+ * @brief Get the buffer of a device, to get the scan layout.
+ * @param desc - IIO descriptor.
+ * @param dev - Device handle.
+ * @return Buffer of the device, NULL if the device has no buffer.
+ */
+struct iio_buffer *iio_direct_get_buffer(struct iio_desc *desc, int dev)
+{
+	struct iio_dev_priv *ldev = iio_direct_dev(desc, dev);
+
+	if (!ldev || !ldev->buffer.initalized)
+		return NULL;
+
+	return &ldev->buffer.public;
+}
 
 /**
- * @brief Write chunk of data into RAM.
- * This function is probably called multiple times by libtinyiiod before a
- * "iio_transfer_mem_to_dev" call, since we can only write "bytes_count" bytes
- * at a time.
- * @param device - String containing device name.
- * @param buf - Values to write.
- * @param offset - Offset in memory after the nth chunk of data.
- * @param bytes_count - Number of bytes to write.
- * @return Bytes_count or negative value in case of error.
+ * @brief Capture samples. Devices without a trigger are read now, the others
+ * fill the buffer each time their trigger fires.
+ * @param desc - IIO descriptor.
+ * @param dev - Device handle.
+ * @return Number of bytes ready to be read, negative error code otherwise.
  */
-static int iio_write_buffer(struct iiod_ctx *ctx, const char *device,
-			    const char *buf, uint32_t bytes)
+int iio_direct_buffer_refill(struct iio_desc *desc, int dev)
 {
-	struct iio_dev_priv	*dev;
-	int32_t			ret;
-	uint32_t		available;
-	uint32_t		size;
+	struct iio_dev_priv *ldev = iio_direct_dev(desc, dev);
+	uint32_t size;
+	int ret;
 
-	dev = get_iio_device(ctx->instance, device);
-	if (!dev || !dev->buffer.initalized)
+	if (!ldev)
 		return -EINVAL;
 
-	ret = no_os_cb_size(&dev->buffer.cb, &size);
+	ret = iio_dev_submit(ldev, IIO_DIRECTION_INPUT);
 	if (NO_OS_IS_ERR_VALUE(ret))
 		return ret;
 
-	available = dev->buffer.public.size - size;
-	bytes = no_os_min(available, bytes);
-	ret = no_os_cb_write(&dev->buffer.cb, buf, bytes);
+	ret = no_os_cb_size(&ldev->buffer.cb, &size);
 	if (NO_OS_IS_ERR_VALUE(ret))
 		return ret;
 
-	return bytes;
+	return size;
 }
 
-int iio_buffer_get_block(struct iio_buffer *buffer, void **addr)
+/**
+ * @brief Send the samples written in the buffer to the device.
+ * @param desc - IIO descriptor.
+ * @param dev - Device handle.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int iio_direct_buffer_push(struct iio_desc *desc, int dev)
 {
-	uint32_t size;
+	struct iio_dev_priv *ldev = iio_direct_dev(desc, dev);
+	int ret;
 
-	if (!buffer)
+	if (!ldev)
 		return -EINVAL;
 
-	if (buffer->dir == IIO_DIRECTION_INPUT)
-		return no_os_cb_prepare_async_write(buffer->buf, buffer->size, addr, &size);
+	ret = iio_dev_submit(ldev, IIO_DIRECTION_OUTPUT);
 
-	return no_os_cb_prepare_async_read(buffer->buf, buffer->size, addr, &size);
+	return NO_OS_IS_ERR_VALUE(ret) ? ret : 0;
 }
 
-int iio_buffer_block_done(struct iio_buffer *buffer)
+/**
+ * @brief Copy samples out of the buffer.
+ * @param desc - IIO descriptor.
+ * @param dev - Device handle.
+ * @param data - Destination.
+ * @param bytes - Maximum number of bytes to be read.
+ * @return Number of bytes read, -EAGAIN if the buffer is empty.
+ */
+int iio_direct_buffer_read(struct iio_desc *desc, int dev, void *data,
+			   uint32_t bytes)
 {
-	if (!buffer)
+	struct iio_dev_priv *ldev = iio_direct_dev(desc, dev);
+
+	if (!ldev || !data)
 		return -EINVAL;
 
-	if (buffer->dir == IIO_DIRECTION_INPUT)
-		return no_os_cb_end_async_write(buffer->buf);
+	return iio_dev_read_buffer(ldev, data, bytes);
+}
 
-	return no_os_cb_end_async_read(buffer->buf);
+/**
+ * @brief Copy samples into the buffer.
+ * @param desc - IIO descriptor.
+ * @param dev - Device handle.
+ * @param data - Source.
+ * @param bytes - Number of bytes to be written.
+ * @return Number of bytes written, limited by the free space of the buffer.
+ */
+int iio_direct_buffer_write(struct iio_desc *desc, int dev, const void *data,
+			    uint32_t bytes)
+{
+	struct iio_dev_priv *ldev = iio_direct_dev(desc, dev);
+
+	if (!ldev || !data)
+		return -EINVAL;
+
+	return iio_dev_write_buffer(ldev, data, bytes);
 }
 
-/* Write to buffer iio_buffer.bytes_per_scan bytes from data */
-int iio_buffer_push_scan(struct iio_buffer *buffer, void *data)
+/**
+ * @brief Get the next contiguous block of samples, without copying them.
+ * Must be followed by iio_direct_buffer_block_done(). Samples lost in an
+ * overrun are skipped.
+ * @param desc - IIO descriptor.
+ * @param dev - Device handle.
+ * @param addr - Start of the block.
+ * @param bytes - Size of the block.
+ * @return 0 in case of success, -EAGAIN if there is nothing to be read.
+ */
+int iio_direct_buffer_get_block(struct iio_desc *desc, int dev, void **addr,
+				uint32_t *bytes)
 {
-	if (!buffer)
+	struct iio_dev_priv *ldev = iio_direct_dev(desc, dev);
+	uint32_t size;
+	int ret;
+
+	if (!ldev || !ldev->buffer.initalized || !addr || !bytes)
 		return -EINVAL;
 
-	return no_os_cb_write(buffer->buf, data, buffer->bytes_per_scan);
+	*bytes = 0;
+	if (ldev->buffer.public.dir == IIO_DIRECTION_OUTPUT) {
+		ret = no_os_cb_size(&ldev->buffer.cb, &size);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+		if (size == ldev->buffer.cb.size)
+			return -EAGAIN;
+		return no_os_cb_prepare_async_write(&ldev->buffer.cb,
+						    ldev->buffer.cb.size - size,
+						    addr, bytes);
+	}
+
+	ret = no_os_cb_prepare_async_read(&ldev->buffer.cb,
+					  ldev->buffer.cb.size, addr, bytes);
+	if (ret == -NO_OS_EOVERRUN)
+		ret = 0;
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	return *bytes ? 0 : -EAGAIN;
 }
 
-/* Read from buffer iio_buffer.bytes_per_scan bytes into data */
-int iio_buffer_pop_scan(struct iio_buffer *buffer, void *data)
+/**
+ * @brief Release the block returned by iio_direct_buffer_get_block(). The
+ * whole block is consumed, or made available to the device for output
+ * buffers.
+ * @param desc - IIO descriptor.
+ * @param dev - Device handle.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int iio_direct_buffer_block_done(struct iio_desc *desc, int dev)
 {
-	if (!buffer)
+	struct iio_dev_priv *ldev = iio_direct_dev(desc, dev);
+
+	if (!ldev || !ldev->buffer.initalized)
 		return -EINVAL;
 
-	if(!buffer->cyclic_info.is_cyclic)
-		return no_os_cb_read(buffer->buf, data, buffer->bytes_per_scan);
+	if (ldev->buffer.public.dir == IIO_DIRECTION_OUTPUT)
+		return no_os_cb_end_async_write(&ldev->buffer.cb);
 
-	memcpy(data,
-	       &buffer->buf->buff[buffer->cyclic_info.buff_index],
-	       buffer->bytes_per_scan);
+	return no_os_cb_end_async_read(&ldev->buffer.cb);
+}
 
-	buffer->cyclic_info.buff_index += buffer->bytes_per_scan;
-	if (buffer->size == buffer->cyclic_info.buff_index)
-		buffer->cyclic_info.buff_index = 0;
+/**
+ * @brief Dump the statistics in a compact binary form, all fields little
+ * endian:
+ *  - header: u8 version (1), u8 number of commands, u8 number of connections,
+ *    u8 number of latency buckets, u32 number of devices
+ *  - for each command, in iiod_cmd_name() order: u32 count, u32 min_us,
+ *    u32 avg_us, u32 max_us
+ *  - for each open connection: u32 id, u32 commands, u64 bytes_in,
+ *    u64 bytes_out
+ *  - for each device: u32 overruns, u32 underruns, u32 for each latency bucket
+ * @param desc - IIO descriptor.
+ * @param buf  - Buffer for the dump, or NULL to get the needed size.
+ * @param len  - Size of buf.
+ * @return Size of the dump or negative value in case of error.
+ */
+int iio_stats_dump(struct iio_desc *desc, uint8_t *buf, uint32_t len)
+{
+	struct iiod_conn_stats conn;
+	struct iiod_cmd_stats cmd;
+	struct iio_dev_priv *dev;
+	uint32_t i, j, nb_conns, size;
+	uint8_t *p;
 
-	return 0;
+	if (!desc)
+		return -EINVAL;
+
+	nb_conns = 0;
+	for (i = 0; i < desc->max_conns; i++)
+		if (!iiod_conn_get_stats(desc->iiod, i, &conn))
+			nb_conns++;
+
+	size = 8 + IIOD_NB_CMDS * 16 + nb_conns * 24 +
+	       desc->nb_devs * (8 + IIO_STATS_LATENCY_BUCKETS * 4);
+	if (!buf)
+		return size;
+	if (len < size)
+		return -EINVAL;
+
+	buf[0] = 1;
+	buf[1] = IIOD_NB_CMDS;
+	buf[2] = nb_conns;
+	buf[3] = IIO_STATS_LATENCY_BUCKETS;
+	no_os_put_unaligned_le32(desc->nb_devs, buf + 4);
+	p = buf + 8;
+
+	for (i = 0; i < IIOD_NB_CMDS; i++, p += 16) {
+		iiod_get_cmd_stats(desc->iiod, i, &cmd);
+		no_os_put_unaligned_le32(cmd.count, p);
+		no_os_put_unaligned_le32(cmd.min_us, p + 4);
+		no_os_put_unaligned_le32(cmd.count ? cmd.total_us / cmd.count : 0,
+					 p + 8);
+		no_os_put_unaligned_le32(cmd.max_us, p + 12);
+	}
+
+	for (i = 0; i < desc->max_conns; i++) {
+		if (iiod_conn_get_stats(desc->iiod, i, &conn))
+			continue;
+		no_os_put_unaligned_le32(i, p);
+		no_os_put_unaligned_le32(conn.cmds, p + 4);
+		no_os_put_unaligned_le32(conn.bytes_in, p + 8);
+		no_os_put_unaligned_le32(conn.bytes_in >> 32, p + 12);
+		no_os_put_unaligned_le32(conn.bytes_out, p + 16);
+		no_os_put_unaligned_le32(conn.bytes_out >> 32, p + 20);
+		p += 24;
+	}
+
+	for (i = 0; i < desc->nb_devs; i++) {
+		dev = &desc->devs[i];
+		no_os_put_unaligned_le32(dev->overruns, p);
+		no_os_put_unaligned_le32(dev->underruns, p + 4);
+		p += 8;
+		for (j = 0; j < IIO_STATS_LATENCY_BUCKETS; j++, p += 4)
+			no_os_put_unaligned_le32(dev->trig_latency[j], p);
+	}
+
+	return size;
 }
 
 #if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
@@ -1443,12 +2651,15 @@ static int32_t accept_network_clients(struct iio_desc *desc)
 			return ret;
 
 		data.conn = sock;
-		data.buf = no_os_calloc(1, IIOD_CONN_BUFFER_SIZE);
-		data.len = IIOD_CONN_BUFFER_SIZE;
-
-		ret = iiod_conn_add(desc->iiod, &data, &id);
-		if (NO_OS_IS_ERR_VALUE(ret))
-			return ret;
+		data.buf = no_os_calloc(1, desc->conn_buf_size);
+		data.len = desc->conn_buf_size;
+		ret = data.buf ? iiod_conn_add(desc->iiod, &data, &id) : -ENOMEM;
+		if (NO_OS_IS_ERR_VALUE(ret)) {
+			/* Connection table full, refuse the client */
+			socket_remove(sock);
+			no_os_free(data.buf);
+			continue;
+		}
 
 		ret = _push_conn(desc, id);
 		if (NO_OS_IS_ERR_VALUE(ret))
@@ -1459,6 +2670,40 @@ static int32_t accept_network_clients(struct iio_desc *desc)
 }
 #endif
 
+/**
+ * @brief Serve a connection for one scheduling turn. A connection moving
+ * buffer data keeps the turn while it makes progress, until it transferred
+ * stream_quantum bytes. The others get a single step, so clients polling
+ * attributes take little from a streaming one.
+ * @param desc    - IIO descriptor.
+ * @param conn_id - Connection popped from the FIFO.
+ * @return Result of the last iiod_conn_step().
+ */
+static int32_t iio_serve_conn(struct iio_desc *desc, uint32_t conn_id)
+{
+	struct iiod_conn_stats stats;
+	uint64_t start, prev, cur;
+	int32_t ret;
+
+	iiod_conn_get_stats(desc->iiod, conn_id, &stats);
+	start = stats.bytes_in + stats.bytes_out;
+	prev = start;
+	do {
+		ret = iiod_conn_step(desc->iiod, conn_id);
+		if (ret != -EAGAIN || !iiod_conn_streaming(desc->iiod, conn_id))
+			return ret;
+
+		iiod_conn_get_stats(desc->iiod, conn_id, &stats);
+		cur = stats.bytes_in + stats.bytes_out;
+		/* Waiting for samples or for the link, let the others run */
+		if (cur == prev)
+			return ret;
+		prev = cur;
+	} while (cur - start < desc->stream_quantum);
+
+	return ret;
+}
+
 /**
  * @brief Execute an iio step
  * @param desc - IIo descriptor
@@ -1487,7 +2732,7 @@ int iio_step(struct iio_desc *desc)
 	if (NO_OS_IS_ERR_VALUE(ret))
 		return ret;
 
-	ret = iiod_conn_step(desc->iiod, conn_id);
+	ret = iio_serve_conn(desc, conn_id);
 	if (ret == -ENOTCONN) {
 #if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
 		iiod_conn_remove(desc->iiod, conn_id, &data);
@@ -1501,6 +2746,28 @@ int iio_step(struct iio_desc *desc)
 	return ret;
 }
 
+/**
+ * @brief Free the devices array and the scan masks of the devices.
+ * @param desc - IIO descriptor.
+ */
+static void iio_free_devs(struct iio_desc *desc)
+{
+	uint32_t i;
+
+	if (!desc->devs)
+		return;
+
+	for (i = 0; i < desc->nb_devs; i++) {
+		if (desc->devs[i].buffer.public.nb_mask_words > 1)
+			no_os_free(desc->devs[i].buffer.public.active_masks);
+		/* Copy made by iio_extend_descriptor() */
+		if (desc->devs[i].own_descriptor)
+			no_os_free(desc->devs[i].dev_descriptor);
+	}
+	no_os_free(desc->devs);
+	desc->devs = NULL;
+}
+
 /**
  * @brief Add context attributes into xml string buffer.
  * @param desc - IIo descriptor.
@@ -1542,6 +2809,11 @@ static uint32_t iio_add_ctx_attr_in_xml(struct iio_desc *desc, char *buff,
 				      attr[j].value);
 		}
 
+	if (desc->timestamp_clock_name)
+		i += snprintf(buff + i, no_os_max(n - i, 0),
+			      "<context-attribute name=\"timestamp_clock\" "
+			      "value=\"%s\" />", desc->timestamp_clock_name);
+
 	return i;
 }
 
@@ -1767,12 +3039,119 @@ static int32_t iio_init_xml(struct iio_desc *desc)
 	return 0;
 }
 
+/**
+ * @brief Count the entries of an attribute list.
+ * @param attrs - List ended by an entry without name, can be NULL.
+ * @return Number of attributes.
+ */
+static uint32_t iio_nb_attrs(const struct iio_attribute *attrs)
+{
+	uint32_t n = 0;
+
+	while (attrs && attrs[n].name)
+		n++;
+
+	return n;
+}
+
+/**
+ * @brief Replace the device descriptor with a copy extended with the elements
+ * provided by iio: the timestamp channel appended to the channels, the
+ * watermark buffer attribute and the statistics debug attributes.
+ * @param desc  - IIO descriptor.
+ * @param ldev  - Device having the timestamp flag, set_watermark or a buffer.
+ * @param stats - Append the device statistics debug attributes.
+ * @param ctx_stats - Also append the iiod statistics debug attributes.
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int iio_extend_descriptor(struct iio_desc *desc,
+				 struct iio_dev_priv *ldev, bool stats,
+				 bool ctx_stats)
+{
+	struct iio_device *src = ldev->dev_descriptor;
+	struct iio_device *dst;
+	struct iio_channel *ch;
+	struct iio_attribute *attr;
+	uint32_t nb_ch, nb_attrs, nb_dbg, nb_stats, i;
+	uint8_t *tail;
+
+	/* Channels are only copied when the timestamp is appended */
+	nb_ch = src->timestamp ? src->num_ch + 1 : 0;
+	nb_attrs = 0;
+	/* Existing ones, the new ones and the end of the array */
+	if (src->set_watermark)
+		nb_attrs = iio_nb_attrs(src->buffer_attributes) + 2;
+	nb_stats = ctx_stats ? NO_OS_ARRAY_SIZE(iio_stats_attrs) :
+		   IIO_STATS_DEV_ATTRS;
+	nb_dbg = 0;
+	if (stats)
+		nb_dbg = iio_nb_attrs(src->debug_attributes) + nb_stats + 1;
+
+	dst = no_os_calloc(1, sizeof(*dst) + nb_ch * sizeof(*dst->channels) +
+			   (nb_attrs + nb_dbg) * sizeof(struct iio_attribute));
+	if (!dst)
+		return -ENOMEM;
+
+	*dst = *src;
+	tail = (uint8_t *)(dst + 1);
+
+	if (src->timestamp) {
+		dst->channels = (struct iio_channel *)tail;
+		tail += nb_ch * sizeof(*dst->channels);
+		if (src->num_ch)
+			memcpy(dst->channels, src->channels,
+			       src->num_ch * sizeof(*dst->channels));
+		ch = &dst->channels[src->num_ch];
+		ch->ch_type = IIO_TIMESTAMP;
+		ch->channel = -1;
+		for (i = 0; i < src->num_ch; i++)
+			ch->scan_index = no_os_max(ch->scan_index,
+						   dst->channels[i].scan_index + 1);
+		ch->scan_type = &iio_timestamp_scan_type;
+		ch->attributes = iio_timestamp_attrs;
+		dst->num_ch++;
+	}
+
+	if (src->set_watermark) {
+		dst->buffer_attributes = (struct iio_attribute *)tail;
+		tail += nb_attrs * sizeof(*dst->buffer_attributes);
+		if (nb_attrs > 2)
+			memcpy(dst->buffer_attributes, src->buffer_attributes,
+			       (nb_attrs - 2) * sizeof(*dst->buffer_attributes));
+		attr = &dst->buffer_attributes[nb_attrs - 2];
+		attr->name = "watermark";
+		attr->priv = (intptr_t)ldev;
+		attr->show = iio_watermark_show;
+		attr->store = iio_watermark_store;
+	}
+
+	if (stats) {
+		dst->debug_attributes = (struct iio_attribute *)tail;
+		attr = dst->debug_attributes;
+		i = nb_dbg - nb_stats - 1;
+		if (i)
+			memcpy(attr, src->debug_attributes, i * sizeof(*attr));
+		attr += i;
+		memcpy(attr, iio_stats_attrs, nb_stats * sizeof(*attr));
+		for (i = 0; i < nb_stats; i++)
+			attr[i].priv = i < IIO_STATS_DEV_ATTRS ?
+				       (intptr_t)ldev : (intptr_t)desc;
+	}
+
+	ldev->dev_descriptor = dst;
+	ldev->own_descriptor = true;
+
+	return 0;
+}
+
 static int32_t iio_init_devs(struct iio_desc *desc,
 			     struct iio_device_init *devs, uint32_t n)
 {
 	uint32_t i;
 	struct iio_dev_priv *ldev;
 	struct iio_device_init *ndev;
+	bool ctx_stats = true;
+	bool buffered;
 
 	desc->nb_devs = n;
 	desc->devs = (struct iio_dev_priv *)no_os_calloc(desc->nb_devs,
@@ -1780,23 +3159,65 @@ static int32_t iio_init_devs(struct iio_desc *desc,
 	if (!desc->devs)
 		return -ENOMEM;
 
+	/* Each trigger can be used by all the devices */
+	if (desc->nb_trigs && n) {
+		desc->trig_subs = no_os_calloc(desc->nb_trigs * n,
+					       sizeof(*desc->trig_subs));
+		if (!desc->trig_subs) {
+			iio_free_devs(desc);
+			return -ENOMEM;
+		}
+		for (i = 0; i < desc->nb_trigs; i++)
+			desc->trigs[i].subs = desc->trig_subs + i * n;
+	}
+
 	for (i = 0; i < n; i++) {
 		ndev = devs + i;
 		ldev = desc->devs + i;
 		ldev->dev_descriptor = ndev->dev_descriptor;
+		buffered = ndev->dev_descriptor->read_dev ||
+			   ndev->dev_descriptor->write_dev ||
+			   ndev->dev_descriptor->submit ||
+			   ndev->dev_descriptor->trigger_handler;
+		if (ndev->dev_descriptor->timestamp ||
+		    ndev->dev_descriptor->set_watermark || buffered) {
+			if (iio_extend_descriptor(desc, ldev, buffered,
+						  buffered && ctx_stats)) {
+				iio_free_devs(desc);
+				return -ENOMEM;
+			}
+			ctx_stats &= !buffered;
+		}
+		if (ndev->dev_descriptor->timestamp &&
+		    !desc->timestamp_clock_name)
+			desc->timestamp_clock_name = "monotonic";
 		sprintf(ldev->dev_id, "iio:device%"PRIu32"", i);
-		ldev->trig_idx = iio_get_trig_idx_by_id(desc, ndev->trigger_id);
+		ldev->trig_idx = NO_TRIGGER;
+		iio_attach_trigger(desc, ldev,
+				   iio_get_trig_idx_by_id(desc, ndev->trigger_id));
 		ldev->dev_instance = ndev->dev;
 		ldev->dev_data.dev = ndev->dev;
 		ldev->dev_data.buffer = &ldev->buffer.public;
 		ldev->name = ndev->name;
-		if (ndev->dev_descriptor->read_dev ||
-		    ndev->dev_descriptor->write_dev ||
-		    ndev->dev_descriptor->submit ||
-		    ndev->dev_descriptor->trigger_handler) {
+		if (buffered) {
 			ldev->buffer.raw_buf = ndev->raw_buf;
 			ldev->buffer.raw_buf_len = ndev->raw_buf_len;
 			ldev->buffer.public.buf = &ldev->buffer.cb;
+			ldev->buffer.public.watermark = 1;
+			ldev->buffer.public.nb_mask_words =
+				IIO_MASK_WORDS(ldev->dev_descriptor->num_ch);
+			if (ldev->buffer.public.nb_mask_words > 1) {
+				ldev->buffer.public.active_masks = no_os_calloc(
+						ldev->buffer.public.nb_mask_words,
+						sizeof(uint32_t));
+				if (!ldev->buffer.public.active_masks) {
+					iio_free_devs(desc);
+					return -ENOMEM;
+				}
+			} else {
+				ldev->buffer.public.active_masks =
+					&ldev->buffer.public.active_mask;
+			}
 			ldev->buffer.initalized = 1;
 		} else {
 			ldev->buffer.initalized = 0;
@@ -1806,6 +3227,17 @@ static int32_t iio_init_devs(struct iio_desc *desc,
 	return 0;
 }
 
+/**
+ * @brief Free the triggers array and the per trigger bookkeeping.
+ * @param desc - IIO descriptor.
+ */
+static void iio_free_trigs(struct iio_desc *desc)
+{
+	no_os_free(desc->trig_subs);
+	no_os_free((void *)desc->trig_pending);
+	no_os_free(desc->trigs);
+}
+
 /**
  * @brief Initializes IIO triggers.
  * @param desc  - IIO descriptor.
@@ -1826,6 +3258,14 @@ static int32_t iio_init_trigs(struct iio_desc *desc,
 	if (!desc->trigs)
 		return -ENOMEM;
 
+	desc->trig_pending = no_os_calloc(IIO_MASK_WORDS(n),
+					  sizeof(*desc->trig_pending));
+	if (n && !desc->trig_pending) {
+		no_os_free(desc->trigs);
+		desc->trigs = NULL;
+		return -ENOMEM;
+	}
+
 	for (i = 0; i < n; i++) {
 		trig_init_iter = trigs + i;
 		trig_priv_iter = desc->trigs + i;
@@ -1862,6 +3302,13 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 
 	ldesc->ctx_attrs = init_param->ctx_attrs;
 	ldesc->nb_ctx_attr = init_param->nb_ctx_attr;
+	ldesc->max_conns = init_param->max_conns ? init_param->max_conns :
+			   IIOD_MAX_CONNECTIONS;
+	ldesc->conn_buf_size = init_param->conn_buf_size ?
+			       init_param->conn_buf_size : IIOD_CONN_BUFFER_SIZE;
+	ldesc->stream_quantum = init_param->stream_quantum ?
+				init_param->stream_quantum : IIO_STREAM_QUANTUM;
+	iio_timestamp_clock = init_param->timestamp_clock;
 
 	ret = iio_init_trigs(ldesc, init_param->trigs, init_param->nb_trigs);
 	if (NO_OS_IS_ERR_VALUE(ret))
@@ -1869,7 +3316,9 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 
 	ret = iio_init_devs(ldesc, init_param->devs, init_param->nb_devs);
 	if (NO_OS_IS_ERR_VALUE(ret))
-		goto free_desc;
+		goto free_trigs;
+	if (ldesc->timestamp_clock_name && init_param->timestamp_clock_name)
+		ldesc->timestamp_clock_name = init_param->timestamp_clock_name;
 
 	ret = iio_init_xml(ldesc);
 	if (NO_OS_IS_ERR_VALUE(ret))
@@ -1895,13 +3344,15 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 	iiod_param.ops = ops;
 	iiod_param.xml = ldesc->xml_desc;
 	iiod_param.xml_len = ldesc->xml_size;
+	iiod_param.get_time = iio_get_timestamp;
+	iiod_param.max_conns = ldesc->max_conns;
 
 	ret = iiod_init(&ldesc->iiod, &iiod_param);
 	if (NO_OS_IS_ERR_VALUE(ret))
 		goto free_xml;
 
 	ret = no_os_cb_init(&ldesc->conns,
-			    sizeof(uint32_t) * (IIOD_MAX_CONNECTIONS + 1));
+			    sizeof(uint32_t) * (ldesc->max_conns + 1));
 	if (NO_OS_IS_ERR_VALUE(ret))
 		goto free_iiod;
 
@@ -1915,6 +3366,15 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 			.buf = uart_buff,
 			.len = sizeof(uart_buff)
 		};
+		if (ldesc->conn_buf_size != sizeof(uart_buff)) {
+			ldesc->uart_buff = no_os_calloc(1, ldesc->conn_buf_size);
+			if (!ldesc->uart_buff) {
+				ret = -ENOMEM;
+				goto free_conns;
+			}
+			data.buf = ldesc->uart_buff;
+			data.len = ldesc->conn_buf_size;
+		}
 		ret = iiod_conn_add(ldesc->iiod, &data, &conn_id);
 		if (NO_OS_IS_ERR_VALUE(ret))
 			goto free_conns;
@@ -1963,16 +3423,16 @@ free_pylink:
 	socket_remove(ldesc->server);
 #endif
 free_conns:
+	no_os_free(ldesc->uart_buff);
 	no_os_cb_remove(ldesc->conns);
 free_iiod:
 	iiod_remove(ldesc->iiod);
 free_xml:
 	no_os_free(ldesc->xml_desc);
 free_trigs:
-	no_os_free(ldesc->trigs);
+	iio_free_trigs(ldesc);
 free_devs:
-	no_os_free(ldesc->devs);
-free_desc:
+	iio_free_devs(ldesc);
 	no_os_free(ldesc);
 
 	return ret;
@@ -1985,6 +3445,8 @@ free_desc:
  */
 int iio_remove(struct iio_desc *desc)
 {
+	uint32_t i, j;
+
 	if (!desc)
 		return -EINVAL;
 
@@ -1992,9 +3454,17 @@ int iio_remove(struct iio_desc *desc)
 	socket_remove(desc->server);
 #endif
 	no_os_cb_remove(desc->conns);
+	no_os_free(desc->uart_buff);
 	iiod_remove(desc->iiod);
-	no_os_free(desc->devs);
-	no_os_free(desc->trigs);
+	for (i = 0; i < desc->nb_devs; i++) {
+		if (!desc->devs[i].attr_cache)
+			continue;
+		for (j = 0; j < desc->devs[i].attr_cache_size; j++)
+			no_os_free(desc->devs[i].attr_cache[j].val);
+		no_os_free(desc->devs[i].attr_cache);
+	}
+	iio_free_devs(desc);
+	iio_free_trigs(desc);
 	no_os_free(desc->xml_desc);
 	no_os_free(desc);
 
@@ -46,11 +46,19 @@
 /******************************************************************************/
 
 #include "iio_types.h"
+#include "iio_val.h"
 #include "no_os_uart.h"
 #if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
 #include "tcp_socket.h"
 #endif
 
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Buckets of the trigger latency histogram: <10us, <100us ... >=100ms */
+#define IIO_STATS_LATENCY_BUCKETS	6
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -62,6 +70,21 @@ enum pysical_link_type {
 };
 
 struct iio_desc;
+struct iio_dev_priv;
+
+/**
+ * @struct iio_attr_handle
+ * @brief Attribute looked up with the direct client API. Valid as long as the
+ * iio_desc it was found in.
+ */
+struct iio_attr_handle {
+	/** Device owning the attribute */
+	struct iio_dev_priv *dev;
+	/** Channel owning the attribute, NULL for the other attributes */
+	struct iio_channel *ch;
+	/** The attribute */
+	struct iio_attribute *attr;
+};
 
 struct iio_device_init {
 	char *name;
@@ -122,6 +145,22 @@ struct iio_init_param {
 	uint32_t nb_devs;
 	struct iio_trigger_init *trigs;
 	uint32_t nb_trigs;
+	/** Clock used to timestamp scans, in ns. If NULL, no_os_get_time() is
+	 *  used. Can be backed by a no_os_timer or a RTC. */
+	int64_t (*timestamp_clock)(void);
+	/** Name of timestamp_clock, exported in the timestamp_clock context
+	 *  attribute. Defaults to "monotonic". */
+	const char *timestamp_clock_name;
+	/** Maximum number of simultaneous clients. 0 for 10. */
+	uint32_t max_conns;
+	/** Size of the payload buffer of each client, in bytes. It has to fit
+	 *  the largest attribute value. 0 for 4 KiB. Not used by the local
+	 *  backend, which provides its own buffer. */
+	uint32_t conn_buf_size;
+	/** Bytes a client moving buffer data may transfer in one iio_step()
+	 *  before the next client is served. Clients running other commands get
+	 *  a single step. 0 for 16 KiB. */
+	uint32_t stream_quantum;
 };
 
 /******************************************************************************/
@@ -141,11 +180,11 @@ int iio_step(struct iio_desc *desc);
    (is_synchronous = true) or will be called from iio_step if trigger is
    asynchronous (is_synchronous = false) */
 int iio_process_trigger_type(struct iio_desc *desc, char *trigger_name);
-
-int32_t iio_parse_value(char *buf, enum iio_val fmt,
-			int32_t *val, int32_t *val2);
-int iio_format_value(char *buf, uint32_t len, enum iio_val fmt,
-		     int32_t size, int32_t *vals);
+/* Get the numeric handle of a trigger, for iio_process_trigger() */
+int iio_get_trigger_handle(struct iio_desc *desc, const char *trigger_name);
+/* Same as iio_process_trigger_type() without the name lookup. The time taken
+ * does not depend on the number of devices or triggers in the context. */
+int iio_process_trigger(struct iio_desc *desc, uint32_t handle);
 
 /* DMA buffer functions. */
 /* Get buffer addr where to write iio_buffer.size bytes */
@@ -154,9 +193,68 @@ int iio_buffer_get_block(struct iio_buffer *buffer, void **addr);
 int iio_buffer_block_done(struct iio_buffer *buffer);
 
 /* Trigger buffer functions. */
+/* Read the clock used to timestamp scans, in ns */
+int64_t iio_get_timestamp(void);
+/* Check if channel ch is enabled in the current scan */
+bool iio_buffer_ch_active(struct iio_buffer *buffer, uint32_t ch);
 /* Write to buffer iio_buffer.bytes_per_scan bytes from data */
 int iio_buffer_push_scan(struct iio_buffer *buffer, void *data);
+/* Same as iio_buffer_push_scan, with the given time in the timestamp element */
+int iio_buffer_push_scan_ts(struct iio_buffer *buffer, void *data,
+			    int64_t timestamp);
+/* Write nb_scans scans of iio_buffer.data_bytes bytes each from data */
+int iio_buffer_push_scans(struct iio_buffer *buffer, void *data,
+			  uint32_t nb_scans);
 /* Read from buffer iio_buffer.bytes_per_scan bytes into data */
 int iio_buffer_pop_scan(struct iio_buffer *buffer, void *data);
 
+/* Direct client API. Lets the application use the devices of the context
+ * directly, the same way an iiod client does, without the text protocol. */
+/* Get the handle of a device by name or id (iio:deviceX) */
+int iio_direct_get_device(struct iio_desc *desc, const char *name);
+/* Get the index of a channel, which is also its bit in the buffer mask */
+int iio_direct_get_channel(struct iio_desc *desc, int dev, const char *channel,
+			   bool output);
+/* Find a device attribute, or a channel attribute if ch is not negative */
+int iio_direct_get_attr(struct iio_desc *desc, int dev, int ch,
+			const char *name, struct iio_attr_handle *attr);
+int iio_direct_get_buffer_attr(struct iio_desc *desc, int dev,
+			       const char *name, struct iio_attr_handle *attr);
+int iio_direct_get_debug_attr(struct iio_desc *desc, int dev,
+			      const char *name, struct iio_attr_handle *attr);
+/* Read or write the attribute as a string */
+int iio_direct_attr_read(struct iio_attr_handle *attr, char *buf, uint32_t len);
+int iio_direct_attr_write(struct iio_attr_handle *attr, char *buf,
+			  uint32_t len);
+/* Read or write the attribute as values of the given format */
+int iio_direct_attr_get(struct iio_attr_handle *attr, enum iio_val fmt,
+			int32_t size, int32_t *vals);
+int iio_direct_attr_set(struct iio_attr_handle *attr, enum iio_val fmt,
+			int32_t size, int32_t *vals);
+/* Open the buffer with the channels in mask, as OPEN does */
+int iio_direct_buffer_open(struct iio_desc *desc, int dev, uint32_t samples,
+			   const uint32_t *mask, uint32_t nb_words,
+			   enum iio_buffer_direction dir, bool cyclic);
+int iio_direct_buffer_close(struct iio_desc *desc, int dev);
+/* Buffer of an open device, to get the scan layout */
+struct iio_buffer *iio_direct_get_buffer(struct iio_desc *desc, int dev);
+/* Capture samples, returns the number of bytes ready to be read */
+int iio_direct_buffer_refill(struct iio_desc *desc, int dev);
+/* Send the samples written in the buffer to the device */
+int iio_direct_buffer_push(struct iio_desc *desc, int dev);
+/* Copy samples out of or into the buffer */
+int iio_direct_buffer_read(struct iio_desc *desc, int dev, void *data,
+			   uint32_t bytes);
+int iio_direct_buffer_write(struct iio_desc *desc, int dev, const void *data,
+			    uint32_t bytes);
+/* Access the samples in place. Get the next contiguous block to be read,
+ * or to be written for output buffers, and release it when done. */
+int iio_direct_buffer_get_block(struct iio_desc *desc, int dev, void **addr,
+				uint32_t *bytes);
+int iio_direct_buffer_block_done(struct iio_desc *desc, int dev);
+
+/* Dump the iiod and device statistics in the binary format documented in
+ * iio.c. Returns the size of the dump, or the needed size if buf is NULL. */
+int iio_stats_dump(struct iio_desc *desc, uint8_t *buf, uint32_t len);
+
 #endif /* IIO_H_ */
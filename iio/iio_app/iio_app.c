@@ -302,7 +302,7 @@ int iio_app_init(struct iio_app_desc **app,
 		 struct iio_app_init_param app_init_param)
 {
 	struct iio_device_init *iio_init_devs;
-	struct iio_init_param iio_init_param;
+	struct iio_init_param iio_init_param = { 0 };
 	struct no_os_uart_desc *uart_desc;
 	struct iio_app_desc *application;
 	struct iio_data_buffer *buff;
@@ -397,6 +397,8 @@ int iio_app_init(struct iio_app_desc **app,
 	iio_init_param.nb_trigs = app_init_param.nb_trigs;
 	iio_init_param.ctx_attrs = app_init_param.ctx_attrs;
 	iio_init_param.nb_ctx_attr = app_init_param.nb_ctx_attr;
+	iio_init_param.timestamp_clock = app_init_param.timestamp_clock;
+	iio_init_param.timestamp_clock_name = app_init_param.timestamp_clock_name;
 
 	status = iio_init(&application->iio_desc, &iio_init_param);
 	if(status < 0)
@@ -125,6 +125,10 @@ struct iio_app_init_param {
 	int (*post_step_callback)(void *arg);
 	/** Function parameteres */
 	void *arg;
+	/** Clock used to timestamp scans, in ns. NULL for no_os_get_time() */
+	int64_t (*timestamp_clock)(void);
+	/** Name of timestamp_clock, "monotonic" if NULL */
+	const char *timestamp_clock_name;
 
 #ifdef NO_OS_LWIP_NETWORKING
 	struct lwip_network_param lwip_param;
@@ -50,7 +50,28 @@
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
-#ifndef LINUX_PLATFORM
+/**
+ * @brief Process a trigger by its handle. The handle is looked up by name on
+ * the first call, since iio_desc is usually set after the trigger is created.
+ *
+ * @param iio_desc - IIO descriptor.
+ * @param name     - Trigger name.
+ * @param handle   - Cached trigger handle.
+ *
+ * @return ret     - Result of the processing procedure.
+ */
+static int iio_trig_process(struct iio_desc *iio_desc, const char *name,
+			    int32_t *handle)
+{
+	if (*handle < 0) {
+		*handle = iio_get_trigger_handle(iio_desc, name);
+		if (*handle < 0)
+			return *handle;
+	}
+
+	return iio_process_trigger(iio_desc, *handle);
+}
+
 /**
  * @brief Initialize hardware trigger.
  *
@@ -77,6 +98,7 @@ int iio_hw_trig_init(struct iio_hw_trig **iio_trig,
 	trig_desc->irq_ctrl = init_param->irq_ctrl;
 	trig_desc->irq_id = init_param->irq_id;
 	trig_desc->irq_trig_lvl = init_param->irq_trig_lvl;
+	trig_desc->handle = -ENOENT;
 
 	struct no_os_callback_desc irq_cb = {
 		.callback = iio_hw_trig_handler,
@@ -153,7 +175,7 @@ void iio_hw_trig_handler(void *trig)
 
 	struct iio_hw_trig *desc = trig;
 
-	iio_process_trigger_type(desc->iio_desc, desc->name);
+	iio_trig_process(desc->iio_desc, desc->name, &desc->handle);
 }
 
 /**
@@ -170,7 +192,6 @@ int iio_hw_trig_remove(struct iio_hw_trig *trig)
 
 	return 0;
 }
-#endif
 
 /**
  * @brief Initialize software trigger.
@@ -194,6 +215,7 @@ int iio_sw_trig_init(struct iio_sw_trig **iio_trig,
 
 	trig_desc->iio_desc = init_param->iio_desc;
 	strncpy(trig_desc->name, init_param->name, TRIG_MAX_NAME_SIZE);
+	trig_desc->handle = -ENOENT;
 
 	*iio_trig = trig_desc;
 
@@ -220,7 +242,7 @@ int iio_sw_trig_handler(void *trig, char *buf, uint32_t len,
 
 	struct iio_sw_trig *desc = trig;
 
-	return iio_process_trigger_type(desc->iio_desc, desc->name);
+	return iio_trig_process(desc->iio_desc, desc->name, &desc->handle);
 }
 
 /**
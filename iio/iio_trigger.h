@@ -70,6 +70,8 @@ struct iio_hw_trig {
 	enum no_os_irq_trig_level irq_trig_lvl;
 	/** Device trigger name */
 	char name[TRIG_MAX_NAME_SIZE + 1];
+	/** Trigger handle in iio_desc, negative until resolved */
+	int32_t handle;
 };
 
 /**
@@ -113,6 +115,8 @@ struct iio_sw_trig {
 	struct iio_desc *iio_desc;
 	/** Device trigger name */
 	char name[TRIG_MAX_NAME_SIZE + 1];
+	/** Trigger handle in iio_desc, negative until resolved */
+	int32_t handle;
 };
 
 /**
@@ -126,7 +130,6 @@ struct iio_sw_trig_init_param {
 	const char *name;
 };
 
-#ifndef LINUX_PLATFORM
 /** API to initialize a hardware trigger */
 int iio_hw_trig_init(struct iio_hw_trig **iio_trig,
 		     struct iio_hw_trig_init_param *init_param);
@@ -138,7 +141,6 @@ int iio_trig_disable(void *trig);
 void iio_hw_trig_handler(void *trig);
 /** API to remove a hardware trigger */
 int iio_hw_trig_remove(struct iio_hw_trig *trig);
-#endif
 
 /** API to initialize a software trigger */
 int iio_sw_trig_init(struct iio_sw_trig **iio_trig,
@@ -84,6 +84,7 @@ enum iio_chan_type {
 	IIO_COUNT,
 	IIO_DELTA_ANGL,
 	IIO_DELTA_VELOCITY,
+	IIO_TIMESTAMP,
 };
 
 /**
@@ -127,6 +128,11 @@ enum iio_attribute_shared {
 	IIO_SHARED_BY_ALL,
 };
 
+/** Attribute value is read from the device on every access (default) */
+#define IIO_ATTR_VOLATILE	0
+/** Attribute value only changes when an attribute of the device is stored */
+#define IIO_ATTR_CONST		UINT32_MAX
+
 /**
  * @struct iio_attribute
  * @brief Structure holding pointers to show and store functions.
@@ -147,6 +153,11 @@ struct iio_attribute {
 	/** Store function pointer */
 	int (*store)(void *device, char *buf, uint32_t len,
 		     const struct iio_ch_info *channel, intptr_t priv);
+	/** How long the value returned by show may be served from RAM, in
+	 * milliseconds, IIO_ATTR_CONST or IIO_ATTR_VOLATILE. Cached values of a
+	 * device are dropped whenever a store on that device succeeds.
+	 */
+	uint32_t cache_ms;
 };
 
 /**
@@ -211,9 +222,29 @@ struct iio_cyclic_buffer_info {
 	uint32_t buff_index;
 };
 
+/* Number of 32 bit words in the scan mask of a device with n channels */
+#define IIO_MASK_WORDS(n)	(((n) + 31) / 32)
+
 struct iio_buffer {
-	/* Mask with active channels */
+	/* Mask with active channels. Only channels 0 to 31 */
 	uint32_t active_mask;
+	/*
+	 * Mask with all active channels. Channel n is bit n % 32 of word n / 32.
+	 * Points to active_mask for devices with up to 32 channels.
+	 */
+	uint32_t *active_masks;
+	/* Number of words in active_masks */
+	uint32_t nb_mask_words;
+	/* Set when the timestamp scan element is enabled */
+	bool timestamp_en;
+	/* Time of the last trigger in ns, pushed with each scan */
+	int64_t timestamp;
+	/* Bytes of channel data in a scan, without the timestamp */
+	uint32_t data_bytes;
+	/* Number of scans the device FIFO holds when it fires the trigger */
+	uint32_t watermark;
+	/* Timestamp of the last pushed scan, used to spread a batch of scans */
+	int64_t last_timestamp;
 	/* Size in bytes */
 	uint32_t size;
 	/* Number of bytes per sample * number of active channels */
@@ -257,6 +288,9 @@ struct iio_device {
 	uint16_t num_ch;
 	/** List of channels */
 	struct iio_channel *channels;
+	/** If set, a 64 bit timestamp scan element is added after the last
+	 *  channel. It is filled with the time of the trigger. */
+	bool timestamp;
 	/** Array of attributes. Last one should have its name set to NULL */
 	struct iio_attribute *attributes;
 	/** Array of attributes. Last one should have its name set to NULL */
@@ -277,12 +311,20 @@ struct iio_device {
 	/* Bufer callbacks */
 	/** Called before enabling buffer */
 	int32_t (*pre_enable)(void *dev, uint32_t mask);
+	/** Called before enabling buffer instead of pre_enable, with the whole
+	 *  mask. Needed by devices with more than 32 channels */
+	int32_t (*pre_enable_wide)(void *dev, const uint32_t *mask,
+				   uint32_t nb_words);
 	/** Called after disabling buffer */
 	int32_t (*post_disable)(void *dev);
 	/** Called when buffer ready to transfer. Write/read to/from dev */
 	int32_t	(*submit)(struct iio_device_data *dev);
 	/** Called after a trigger signal has been received by iio */
 	int32_t (*trigger_handler)(struct iio_device_data *dev);
+	/** Called when the watermark buffer attribute is written. If set, the
+	 *  device fires its trigger once its FIFO holds watermark scans and the
+	 *  trigger handler drains them with iio_buffer_push_scans() */
+	int32_t (*set_watermark)(void *dev, uint32_t watermark);
 
 	/* Read device register */
 	int32_t (*debug_reg_read)(void *dev, uint32_t reg, uint32_t *readval);
@@ -0,0 +1,394 @@
+/***************************************************************************//**
+ *   @file   iio_val.c
+ *   @brief  Formatting and parsing of iio attribute values.
+ *   Integer only and allocation free, without printf or strtok, so the
+ *   functions can be used concurrently and from small targets.
+********************************************************************************
+ * Copyright 2023(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "iio_val.h"
+#include "no_os_error.h"
+#include "no_os_util.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Write v in decimal, zero padded to width digits.
+ * @param buf   - Output, without the null terminator.
+ * @param v     - Value.
+ * @param width - Minimum number of digits.
+ * @return Number of written characters.
+ */
+static uint32_t iio_val_put_u32(char *buf, uint32_t v, uint32_t width)
+{
+	char digits[10];
+	uint32_t n = 0;
+	uint32_t i = 0;
+
+	do {
+		digits[n++] = '0' + v % 10;
+		v /= 10;
+	} while (v);
+
+	while (i + n < width)
+		buf[i++] = '0';
+	while (n)
+		buf[i++] = digits[--n];
+
+	return i;
+}
+
+static uint32_t iio_val_put_s32(char *buf, int32_t v)
+{
+	if (v >= 0)
+		return iio_val_put_u32(buf, v, 0);
+
+	buf[0] = '-';
+
+	return 1 + iio_val_put_u32(buf + 1, -(uint32_t)v, 0);
+}
+
+/* Write "[-]integer.fractional" with width fractional digits */
+static uint32_t iio_val_put_fixpoint(char *buf, int32_t integer,
+				     uint32_t fractional, uint32_t width,
+				     bool neg)
+{
+	uint32_t n = 0;
+
+	if (neg && integer == 0)
+		buf[n++] = '-';
+	n += iio_val_put_s32(buf + n, integer);
+	buf[n++] = '.';
+
+	return n + iio_val_put_u32(buf + n, fractional, width);
+}
+
+/* Copy n characters to buf with snprintf semantics */
+static int iio_val_copy(char *buf, uint32_t len, const char *src, uint32_t n)
+{
+	uint32_t cnt;
+
+	if (len) {
+		cnt = no_os_min(n, len - 1);
+		memcpy(buf, src, cnt);
+		buf[cnt] = '\0';
+	}
+
+	return n;
+}
+
+/**
+ * @brief Format values the same way as Linux IIO does.
+ * @param buf  - Output buffer, always null terminated if len is not 0.
+ * @param len  - Size of buf.
+ * @param fmt  - Format of vals.
+ * @param size - Number of values, used by IIO_VAL_INT_MULTIPLE.
+ * @param vals - Values.
+ * @return Length of the formatted string. As for snprintf, it may be larger
+ * than len if the output was truncated.
+ */
+int iio_format_value(char *buf, uint32_t len, enum iio_val fmt,
+		     int32_t size, int32_t *vals)
+{
+	char tmp[IIO_VAL_MAX_LEN];
+	int64_t val;
+	int32_t integer, fractional;
+	uint32_t n, l = 0;
+	int32_t i;
+
+	switch (fmt) {
+	case IIO_VAL_INT:
+		n = iio_val_put_s32(tmp, vals[0]);
+		break;
+	case IIO_VAL_INT_PLUS_MICRO_DB:
+	case IIO_VAL_INT_PLUS_MICRO:
+		n = iio_val_put_s32(tmp, vals[0]);
+		tmp[n++] = '.';
+		n += iio_val_put_u32(tmp + n, vals[1], 6);
+		if (fmt == IIO_VAL_INT_PLUS_MICRO_DB) {
+			memcpy(tmp + n, " dB", 3);
+			n += 3;
+		}
+		break;
+	case IIO_VAL_INT_PLUS_NANO:
+		n = iio_val_put_s32(tmp, vals[0]);
+		tmp[n++] = '.';
+		n += iio_val_put_u32(tmp + n, vals[1], 9);
+		break;
+	case IIO_VAL_FRACTIONAL:
+		val = no_os_div_s64((int64_t)vals[0] * 1000000000LL, vals[1]);
+		integer = (int32_t)no_os_div_s64_rem(val, 1000000000, &fractional);
+		n = iio_val_put_fixpoint(tmp, integer, abs(fractional), 9,
+					 fractional < 0);
+		break;
+	case IIO_VAL_FRACTIONAL_LOG2:
+		val = no_os_shift_right((int64_t)vals[0] * 1000000000LL, vals[1]);
+		integer = (int32_t)no_os_div_s64_rem(val, 1000000000LL, &fractional);
+		n = iio_val_put_fixpoint(tmp, integer, abs(fractional), 9,
+					 fractional < 0);
+		break;
+	case IIO_VAL_INT_MULTIPLE:
+		for (i = 0; i < size; i++) {
+			n = iio_val_put_s32(tmp, vals[i]);
+			tmp[n++] = ' ';
+			l += iio_val_copy(buf + l, len - l, tmp, n);
+			if (l >= len)
+				break;
+		}
+		return l;
+	case IIO_VAL_CHAR:
+		tmp[0] = (char)vals[0];
+		n = 1;
+		break;
+	default:
+		return 0;
+	}
+
+	return iio_val_copy(buf, len, tmp, n);
+}
+
+/* Value of the digit c in base 16, 16 if c is not a digit */
+static uint32_t iio_val_digit(char c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	c |= 0x20;
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+
+	return 16;
+}
+
+static const char *iio_val_skip_space(const char *s)
+{
+	while (*s == ' ' || (*s >= '\t' && *s <= '\r'))
+		s++;
+
+	return s;
+}
+
+/**
+ * @brief Parse an integer the same way as strtol(s, end, base) with base 0 or
+ * 10. Values up to UINT32_MAX are accepted and wrap to their int32_t
+ * representation.
+ * @param s    - Input string.
+ * @param end  - Set to the first character after the number.
+ * @param base - 0 to detect it from the prefix or 10.
+ * @param val  - Parsed value.
+ * @return 0 in case of success, -EINVAL if no digit was found.
+ */
+static int iio_val_parse_int(const char *s, const char **end, uint32_t base,
+			     int32_t *val)
+{
+	const char *start;
+	uint32_t v = 0;
+	uint32_t d;
+	bool neg;
+
+	s = iio_val_skip_space(s);
+	neg = *s == '-';
+	if (*s == '-' || *s == '+')
+		s++;
+
+	if (!base) {
+		base = 10;
+		if (s[0] == '0') {
+			base = 8;
+			if ((s[1] | 0x20) == 'x' && iio_val_digit(s[2]) < 16) {
+				base = 16;
+				s += 2;
+			}
+		}
+	}
+
+	start = s;
+	while ((d = iio_val_digit(*s)) < base) {
+		v = v * base + d;
+		s++;
+	}
+	if (s == start)
+		return -EINVAL;
+
+	*val = neg ? -v : v;
+	*end = s;
+
+	return 0;
+}
+
+/**
+ * @brief Parse "[-]integer[.fractional]". Fractional digits beyond the
+ * precision of subunits are truncated. As in Linux IIO, the fractional part
+ * carries the sign of values between -1 and 0.
+ * @param s        - Input string.
+ * @param subunits - 1000000 or 1000000000. If 0, the fractional digits are
+ *                   returned as a plain integer.
+ * @param integer  - Integer part.
+ * @param fract    - Fractional part.
+ * @return 0 in case of success, -EINVAL if the integer part is missing.
+ */
+static int iio_val_parse_fixpoint(const char *s, uint32_t subunits,
+				  int32_t *integer, int32_t *fract)
+{
+	uint32_t f = 0;
+	int32_t raw;
+	bool neg;
+	int ret;
+
+	s = iio_val_skip_space(s);
+	neg = *s == '-';
+	ret = iio_val_parse_int(s, &s, 0, integer);
+	if (ret)
+		return ret;
+
+	*fract = 0;
+	if (*s != '.')
+		return 0;
+	s++;
+
+	if (!subunits) {
+		if (!iio_val_parse_int(s, &s, 10, &raw))
+			*fract = raw;
+		return 0;
+	}
+
+	while (*s >= '0' && *s <= '9') {
+		subunits /= 10;
+		f += (*s++ - '0') * subunits;
+	}
+	*fract = (neg && *integer == 0) ? -(int32_t)f : (int32_t)f;
+
+	return 0;
+}
+
+/**
+ * @brief Parse values formatted as by iio_format_value().
+ * @param buf  - Input string, not modified.
+ * @param fmt  - Format of the values.
+ * @param size - Number of entries in vals. For IIO_VAL_FRACTIONAL_LOG2,
+ *               vals[1] is the shift to be applied, the result is stored
+ *               in vals[0].
+ * @param vals - Parsed values.
+ * @return Number of parsed values, negative error code otherwise.
+ */
+int iio_parse_values(const char *buf, enum iio_val fmt,
+		     int32_t size, int32_t *vals)
+{
+	int32_t integer, fract;
+	int64_t val;
+	int32_t i;
+	int ret;
+
+	if (!buf || !vals || size < 1)
+		return -EINVAL;
+
+	switch (fmt) {
+	case IIO_VAL_INT:
+		ret = iio_val_parse_int(buf, &buf, 0, &vals[0]);
+		return ret ? ret : 1;
+	case IIO_VAL_INT_PLUS_MICRO_DB:
+	case IIO_VAL_INT_PLUS_MICRO:
+	case IIO_VAL_INT_PLUS_NANO:
+	case IIO_VAL_FRACTIONAL:
+		if (size < 2)
+			return -EINVAL;
+		ret = iio_val_parse_fixpoint(buf,
+					     fmt == IIO_VAL_INT_PLUS_NANO ? 1000000000 :
+					     fmt == IIO_VAL_FRACTIONAL ? 0 : 1000000,
+					     &vals[0], &vals[1]);
+		return ret ? ret : 2;
+	case IIO_VAL_FRACTIONAL_LOG2:
+		if (size < 2 || vals[1] < 0 || vals[1] > 31)
+			return -EINVAL;
+		ret = iio_val_parse_fixpoint(buf, 1000000000, &integer, &fract);
+		if (ret)
+			return ret;
+		if (integer < 0)
+			fract = -fract;
+		val = (int64_t)fract * (1LL << vals[1]);
+		vals[0] = integer * (1LL << vals[1]) +
+			  no_os_div_s64(val, 1000000000);
+		return 1;
+	case IIO_VAL_INT_MULTIPLE:
+		for (i = 0; i < size; i++)
+			if (iio_val_parse_int(buf, &buf, 0, &vals[i]))
+				break;
+		return i ? i : -EINVAL;
+	case IIO_VAL_CHAR:
+		if (!buf[0])
+			return -EINVAL;
+		vals[0] = buf[0];
+		return 1;
+	default:
+		return -EINVAL;
+	}
+}
+
+/**
+ * @brief Parse a single value.
+ * @param buf  - Input string.
+ * @param fmt  - Format of the value. IIO_VAL_INT_MULTIPLE and
+ *               IIO_VAL_FRACTIONAL_LOG2 need iio_parse_values().
+ * @param val  - Integer part, may be NULL.
+ * @param val2 - Fractional part, may be NULL.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t iio_parse_value(char *buf, enum iio_val fmt, int32_t *val,
+			int32_t *val2)
+{
+	int32_t vals[2] = {0};
+	int ret;
+
+	if (fmt == IIO_VAL_INT_MULTIPLE || fmt == IIO_VAL_FRACTIONAL_LOG2)
+		return -EINVAL;
+
+	ret = iio_parse_values(buf, fmt, 2, vals);
+
+	/* Callers commonly don't check the result, never leave them unset */
+	if (val)
+		*val = vals[0];
+	if (val2)
+		*val2 = vals[1];
+
+	return ret < 0 ? ret : 0;
+}
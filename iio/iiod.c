@@ -99,6 +99,8 @@ static const uint32_t priority_array[] = {
 
 static_assert(NO_OS_ARRAY_SIZE(cmds) == NO_OS_ARRAY_SIZE(priority_array),
 	      "Arrays must have the same size");
+static_assert(NO_OS_ARRAY_SIZE(cmds) == IIOD_NB_CMDS,
+	      "IIOD_NB_CMDS must match the number of commands");
 
 /* Set res->cmd to corresponding cmd and return the processed length of buf */
 static int32_t parse_cmd(const char *token, struct comand_desc *res)
@@ -132,6 +134,39 @@ static int32_t parse_num(const char *token, uint32_t *res, uint32_t base)
 	return 0;
 }
 
+/*
+ * Parse a channel mask of any width. The most significant word comes first,
+ * each word being 8 hex digits. A shorter first word is accepted.
+ */
+static int32_t iiod_parse_mask(const char *token, struct comand_desc *res)
+{
+	uint32_t len, i, word, shift;
+	char c;
+
+	len = strlen(token);
+	if (!len || len > IIOD_MAX_MASK_WORDS * 8)
+		return -EINVAL;
+
+	res->mask_words = (len + 7) / 8;
+	memset(res->mask, 0, sizeof(res->mask));
+	for (i = 0; i < len; i++) {
+		c = token[len - 1 - i];
+		if (c >= '0' && c <= '9')
+			word = c - '0';
+		else if (c >= 'a' && c <= 'f')
+			word = c - 'a' + 10;
+		else if (c >= 'A' && c <= 'F')
+			word = c - 'A' + 10;
+		else
+			return -EINVAL;
+
+		shift = (i % 8) * 4;
+		res->mask[i / 8] |= word << shift;
+	}
+
+	return 0;
+}
+
 static int32_t iiod_parse_open(const char *token, struct comand_desc *res,
 			       char **ctx)
 {
@@ -148,7 +183,7 @@ static int32_t iiod_parse_open(const char *token, struct comand_desc *res,
 	if (!token)
 		return -EINVAL;
 
-	ret = parse_num(token, &res->mask, 16);
+	ret = iiod_parse_mask(token, res);
 	if (NO_OS_IS_ERR_VALUE(ret))
 		return ret;
 
@@ -285,7 +320,8 @@ int32_t iiod_parse_line(char *buf, struct comand_desc *res, char **ctx)
 }
 
 static int dummy_open(struct iiod_ctx *ctx, const char *device,
-		      uint32_t samples, uint32_t mask, bool cyclic)
+		      uint32_t samples, const uint32_t *mask, uint32_t nb_words,
+		      bool cyclic)
 {
 	return -EINVAL;
 }
@@ -354,15 +390,21 @@ int32_t iiod_copy_ops(struct iiod_ops *ops, struct iiod_ops *new_ops)
 int32_t iiod_init(struct iiod_desc **desc, struct iiod_init_param *param)
 {
 	struct iiod_desc *ldesc;
+	uint32_t max_conns;
 	int32_t ret;
 
 	if (!desc || !param || !param->ops)
 		return -EINVAL;
 
-	ldesc = (struct iiod_desc *)calloc(1, sizeof(*ldesc));
+	max_conns = param->max_conns ? param->max_conns : IIOD_MAX_CONNECTIONS;
+	ldesc = (struct iiod_desc *)calloc(1, sizeof(*ldesc) +
+					   max_conns * sizeof(*ldesc->conns));
 	if (!ldesc)
 		return -ENOMEM;
 
+	ldesc->conns = (struct iiod_conn_priv *)(ldesc + 1);
+	ldesc->max_conns = max_conns;
+
 	ret = iiod_copy_ops(&ldesc->ops, param->ops);
 	if (NO_OS_IS_ERR_VALUE(ret)) {
 		free(ldesc);
@@ -373,6 +415,7 @@ int32_t iiod_init(struct iiod_desc **desc, struct iiod_init_param *param)
 	ldesc->xml = param->xml;
 	ldesc->xml_len = param->xml_len;
 	ldesc->app_instance = param->instance;
+	ldesc->get_time = param->get_time;
 
 	*desc = ldesc;
 
@@ -405,7 +448,7 @@ int32_t iiod_conn_add(struct iiod_desc *desc, struct iiod_conn_data *data,
 	if (!desc || !new_conn_id)
 		return -EINVAL;
 
-	for (i = 0; i < IIOD_MAX_CONNECTIONS; ++i)
+	for (i = 0; i < desc->max_conns; ++i)
 		if (!desc->conns[i].used) {
 			conn = &desc->conns[i];
 			memset(conn, 0, sizeof(*conn));
@@ -429,7 +472,7 @@ int32_t iiod_conn_add(struct iiod_desc *desc, struct iiod_conn_data *data,
 int32_t iiod_conn_remove(struct iiod_desc *desc, uint32_t conn_id,
 			 struct iiod_conn_data *data)
 {
-	if (!desc || conn_id > IIOD_MAX_CONNECTIONS ||
+	if (!desc || conn_id >= desc->max_conns ||
 	    !desc->conns[conn_id].used)
 		return -EINVAL;
 	struct iiod_conn_priv *conn;
@@ -452,7 +495,7 @@ static int32_t call_op(struct iiod_ops *ops, struct comand_desc *data,
 		return ops->set_timeout(ctx, data->timeout);
 	case IIOD_CMD_OPEN:
 		return ops->open(ctx, data->device, data->sample_count,
-				 data->mask, data->cyclic);
+				 data->mask, data->mask_words, data->cyclic);
 	case IIOD_CMD_CLOSE:
 		return ops->close(ctx, data->device);
 	case IIOD_CMD_SETTRIG:
@@ -490,6 +533,10 @@ static int32_t rw_iiod_buff(struct iiod_desc *desc, struct iiod_conn_priv *conn,
 		if (NO_OS_IS_ERR_VALUE(ret))
 			return ret;
 
+		if (flags & IIOD_WR)
+			conn->stats.bytes_out += ret;
+		else
+			conn->stats.bytes_in += ret;
 		buf->idx += ret;
 		if (ret < len)
 			return -EAGAIN;
@@ -500,6 +547,8 @@ static int32_t rw_iiod_buff(struct iiod_desc *desc, struct iiod_conn_priv *conn,
 		if (NO_OS_IS_ERR_VALUE(ret))
 			return ret;
 
+		conn->stats.bytes_out += ret;
+
 		if (ret != 1)
 			return -EAGAIN;
 	}
@@ -583,6 +632,7 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 		.name = data->attr,
 		.channel = data->channel
 	};
+	uint32_t i;
 	int32_t ret;
 
 	switch (data->cmd) {
@@ -593,7 +643,8 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 	case IIOD_CMD_SETTRIG:
 	case IIOD_CMD_SET:
 		if (data->cmd == IIOD_CMD_OPEN) {
-			conn->mask = data->mask;
+			memcpy(conn->mask, data->mask, sizeof(conn->mask));
+			conn->mask_words = data->mask_words;
 			if (data->cyclic)
 				conn->is_cyclic_buffer = true;
 		}
@@ -652,9 +703,12 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 			break;
 		}
 		conn->res.val = data->bytes_count;
-		ret = snprintf(conn->buf_mask, 10, "%08"PRIx32, conn->mask);
+		/* Same number of words as received in OPEN, MSW first */
+		for (i = 0; i < conn->mask_words; i++)
+			sprintf(conn->buf_mask + i * 8, "%08"PRIx32,
+				conn->mask[conn->mask_words - 1 - i]);
 		conn->res.buf.buf = conn->buf_mask;
-		conn->res.buf.len = ret;
+		conn->res.buf.len = conn->mask_words * 8;
 		break;
 	case IIOD_CMD_WRITEBUF:
 		conn->res.val = data->bytes_count;
@@ -686,6 +740,7 @@ static int32_t iiod_read_line(struct iiod_desc *desc,
 		if (NO_OS_IS_ERR_VALUE(ret))
 			goto end;
 
+		conn->stats.bytes_in++;
 		if (conn->parser_idx == 0 && (*ch == '\n' || *ch == '\r'))
 			continue ;
 
@@ -703,6 +758,42 @@ end:
 	return ret;
 }
 
+/* Start measuring the service time of the command just parsed */
+static void iiod_stats_start(struct iiod_desc *desc,
+			     struct iiod_conn_priv *conn)
+{
+	conn->stats_cmd = conn->cmd_data.cmd;
+	conn->stats_start = desc->get_time ? desc->get_time() : 0;
+	conn->stats_pending = true;
+}
+
+/* Account the command started by iiod_stats_start(), once */
+static void iiod_stats_done(struct iiod_desc *desc,
+			    struct iiod_conn_priv *conn)
+{
+	struct iiod_cmd_stats *stats;
+	int64_t elapsed;
+	uint32_t us;
+
+	if (!conn->stats_pending)
+		return;
+
+	conn->stats_pending = false;
+	elapsed = desc->get_time ? desc->get_time() - conn->stats_start : 0;
+	if (elapsed < 0)
+		elapsed = 0;
+	us = no_os_min(elapsed / 1000, (int64_t)UINT32_MAX);
+
+	stats = &desc->cmd_stats[conn->stats_cmd];
+	if (!stats->count || us < stats->min_us)
+		stats->min_us = us;
+	if (us > stats->max_us)
+		stats->max_us = us;
+	stats->total_us += us;
+	stats->count++;
+	conn->stats.cmds++;
+}
+
 /*
  * Function will return SUCCESS when a state was processed.
  * If a state is still in processing state, it will return -EAGAIN.
@@ -733,7 +824,11 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 			conn->res.write_val = 1;
 			conn->res.val = ret;
 			conn->state = IIOD_WRITING_CMD_RESULT;
-		} else if (conn->cmd_data.cmd == IIOD_CMD_WRITE) {
+			return 0;
+		}
+
+		iiod_stats_start(desc, conn);
+		if (conn->cmd_data.cmd == IIOD_CMD_WRITE) {
 			/* Special case. Attribute needs to be read */
 			conn->nb_buf.buf = conn->payload_buf;
 			conn->nb_buf.len = conn->cmd_data.bytes_count;
@@ -782,9 +877,11 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 
 		if (conn->cmd_data.cmd != IIOD_CMD_READBUF &&
 		    conn->cmd_data.cmd != IIOD_CMD_WRITEBUF) {
-			if (conn->is_cyclic_buffer && conn->cmd_data.cmd != IIOD_CMD_OPEN)
+			if (conn->is_cyclic_buffer && conn->cmd_data.cmd != IIOD_CMD_OPEN) {
+				/* Pushing lasts until CLOSE, not part of the cmd */
+				iiod_stats_done(desc, conn);
 				conn->state = IIOD_PUSH_CYCLIC_BUFFER;
-			else
+			} else
 				conn->state = IIOD_LINE_DONE;
 		} else {
 			/* Preapre for IIOD_RW_BUF state */
@@ -799,11 +896,17 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 		if (conn->cmd_data.cmd == IIOD_CMD_READBUF)
 			ret = do_read_buff(desc, conn);
 		else {
-			ret = do_write_buff(desc, conn);
+			/* Nothing left to receive if only the push is pending */
+			ret = 0;
+			if (conn->cmd_data.bytes_count)
+				ret = do_write_buff(desc, conn);
 			if (ret == 0) {
 				conn->res.write_val = 1;
 				ret = desc->ops.push_buffer(&ctx,
 							    conn->cmd_data.device);
+				/* Device queue full, push again on the next step */
+				if (ret == -EAGAIN)
+					return ret;
 				if (NO_OS_IS_ERR_VALUE(ret)) {
 					conn->res.val = ret;
 					conn->state = IIOD_LINE_DONE;
@@ -837,8 +940,11 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 		/* Push puffer to IIO application */
 		ret = desc->ops.push_buffer(&ctx,
 					    conn->cmd_data.device);
-		/* If an error was encountered, close connection */
-		if (NO_OS_IS_ERR_VALUE(ret)) {
+		/*
+		 * Device queue full, push again on the next step. Otherwise, if an
+		 * error was encountered, close connection
+		 */
+		if (NO_OS_IS_ERR_VALUE(ret) && ret != -EAGAIN) {
 			conn->res.val = ret;
 			desc->ops.close(&ctx, conn->cmd_data.device);
 			conn->state = IIOD_LINE_DONE;
@@ -861,6 +967,7 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 			conn->nb_buf.len = 0;
 			conn->state = IIOD_RUNNING_CMD;
 			conn->is_cyclic_buffer = false;
+			iiod_stats_start(desc, conn);
 		}
 		return 0;
 
@@ -875,7 +982,7 @@ int32_t iiod_conn_step(struct iiod_desc *desc, uint32_t conn_id)
 	struct iiod_conn_priv *conn;
 	int32_t ret;
 
-	if (!desc || conn_id > IIOD_MAX_CONNECTIONS ||
+	if (!desc || conn_id >= desc->max_conns ||
 	    !desc->conns[conn_id].used)
 		return -EINVAL;
 
@@ -889,7 +996,50 @@ int32_t iiod_conn_step(struct iiod_desc *desc, uint32_t conn_id)
 		//The loop will continue because the state was changed.
 	} while (true);
 
+	if (conn->state == IIOD_LINE_DONE)
+		iiod_stats_done(desc, conn);
+	else
+		conn->stats_pending = false;
 	conn_clean_state(conn);
 
 	return ret;
 }
+
+bool iiod_conn_streaming(struct iiod_desc *desc, uint32_t conn_id)
+{
+	if (!desc || conn_id >= desc->max_conns || !desc->conns[conn_id].used)
+		return false;
+
+	return desc->conns[conn_id].state == IIOD_RW_BUF;
+}
+
+const char *iiod_cmd_name(uint32_t cmd)
+{
+	if (cmd >= IIOD_NB_CMDS)
+		return NULL;
+
+	return cmds[cmd].str;
+}
+
+int32_t iiod_get_cmd_stats(struct iiod_desc *desc, uint32_t cmd,
+			   struct iiod_cmd_stats *stats)
+{
+	if (!desc || !stats || cmd >= IIOD_NB_CMDS)
+		return -EINVAL;
+
+	*stats = desc->cmd_stats[cmd];
+
+	return 0;
+}
+
+int32_t iiod_conn_get_stats(struct iiod_desc *desc, uint32_t conn_id,
+			    struct iiod_conn_stats *stats)
+{
+	if (!desc || !stats || conn_id >= desc->max_conns ||
+	    !desc->conns[conn_id].used)
+		return -EINVAL;
+
+	*stats = desc->conns[conn_id].stats;
+
+	return 0;
+}
@@ -43,7 +43,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-/* Maximum nomber of iiod connections to allocate simultaneously */
+/* Default maximum number of simultaneous iiod connections */
 #define IIOD_MAX_CONNECTIONS	10
 #define IIOD_VERSION		"1.1.0000000"
 #define IIOD_VERSION_LEN	(sizeof(IIOD_VERSION) - 1)
@@ -52,6 +52,8 @@
 #define MAX_TRIG_ID		64
 #define MAX_CHN_ID		64
 #define MAX_ATTR_NAME		256
+/* Number of commands of the protocol, see iiod_cmd_name() */
+#define IIOD_NB_CMDS		14
 
 enum iio_attr_type {
 	IIO_ATTR_TYPE_DEBUG,
@@ -109,9 +111,10 @@ struct iiod_ops {
 	 * (depending on the internal buffer).
 	 * All calls with the same ctx will refer to this buffer until close is
 	 * called.
+	 * mask holds nb_words words, word n for channels 32 * n to 32 * n + 31.
 	 */
 	int (*open)(struct iiod_ctx *ctx, const char *device, uint32_t samples,
-		    uint32_t mask, bool cyclic);
+		    const uint32_t *mask, uint32_t nb_words, bool cyclic);
 	/* Equivalent of iio_buffer_destroy */
 	int (*close)(struct iiod_ctx *ctx, const char *device);
 
@@ -154,6 +157,29 @@ struct iiod_ops {
 				 uint32_t buffers_count);
 };
 
+/* Statistics of a command, over all connections */
+struct iiod_cmd_stats {
+	/* Number of completed commands */
+	uint32_t count;
+	/*
+	 * Service time in us, from the parsed command line until the last
+	 * byte of the answer was sent. Zero without iiod_init_param.get_time
+	 */
+	uint32_t min_us;
+	uint32_t max_us;
+	uint64_t total_us;
+};
+
+/* Statistics of a connection */
+struct iiod_conn_stats {
+	/* Bytes received from the client */
+	uint64_t bytes_in;
+	/* Bytes sent to the client */
+	uint64_t bytes_out;
+	/* Number of completed commands */
+	uint32_t cmds;
+};
+
 /*
  * Internal structure.
  * It is created in iiod_init and must be passed to all fucntions
@@ -172,6 +198,13 @@ struct iiod_init_param {
 	char *xml;
 	/* Size of xml in bytes */
 	uint32_t xml_len;
+	/*
+	 * Monotonic clock in ns used to measure the service time of the
+	 * commands. Optional
+	 */
+	int64_t (*get_time)(void);
+	/* Size of the connection table. IIOD_MAX_CONNECTIONS if 0 */
+	uint32_t max_conns;
 };
 
 /* Initialize desc. */
@@ -190,5 +223,16 @@ int32_t iiod_conn_remove(struct iiod_desc *desc, uint32_t conn_id,
 			 struct iiod_conn_data *data);
 /* Advance in the state machine of a connection. Will not block */
 int32_t iiod_conn_step(struct iiod_desc *desc, uint32_t conn_id);
+/* True while conn_id transfers the data of a READBUF or WRITEBUF */
+bool iiod_conn_streaming(struct iiod_desc *desc, uint32_t conn_id);
+
+/* Name of a command of the protocol. NULL if cmd >= IIOD_NB_CMDS */
+const char *iiod_cmd_name(uint32_t cmd);
+/* Statistics of cmd since iiod_init */
+int32_t iiod_get_cmd_stats(struct iiod_desc *desc, uint32_t cmd,
+			   struct iiod_cmd_stats *stats);
+/* Statistics of conn_id since iiod_conn_add. -EINVAL if it is not used */
+int32_t iiod_conn_get_stats(struct iiod_desc *desc, uint32_t conn_id,
+			    struct iiod_conn_stats *stats);
 
 #endif //IIOD_H
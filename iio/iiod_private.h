@@ -44,6 +44,11 @@
 #define IIOD_ENDL			0x2
 #define IIOD_RD				0x4
 #define IIOD_PARSER_MAX_BUF_SIZE	128
+/*
+ * Maximum number of 32 bit words in a channel mask. Each word is sent as
+ * 8 hex digits and the whole OPEN command has to fit in the parser buffer.
+ */
+#define IIOD_MAX_MASK_WORDS	(IIOD_PARSER_MAX_BUF_SIZE / 8)
 
 #define IIOD_STR(cmd) {(cmd), sizeof(cmd) - 1}
 
@@ -84,7 +89,9 @@ enum iiod_cmd {
  */
 struct comand_desc {
 	enum iiod_cmd cmd;
-	uint32_t mask;
+	/* Channel mask, word n holds channels 32 * n to 32 * n + 31 */
+	uint32_t mask[IIOD_MAX_MASK_WORDS];
+	uint32_t mask_words;
 	uint32_t timeout;
 	uint32_t sample_count;
 	uint32_t bytes_count;
@@ -154,19 +161,32 @@ struct iiod_conn_priv {
 	struct iiod_buff nb_buf;
 
 	/* Mask of current opened buffer */
-	uint32_t mask;
+	uint32_t mask[IIOD_MAX_MASK_WORDS];
+	/* Number of words in mask */
+	uint32_t mask_words;
 	/* Buffer to store mask as a string */
-	char buf_mask[10];
+	char buf_mask[IIOD_MAX_MASK_WORDS * 8 + 1];
 	/* Context for strtok_r function */
 	char *strtok_ctx;
 	/* True if the device was open with cyclic buffer flag */
 	bool is_cyclic_buffer;
+
+	/* Traffic and number of commands of the connection */
+	struct iiod_conn_stats stats;
+	/* Command whose service time is being measured */
+	enum iiod_cmd stats_cmd;
+	/* Set while stats_cmd is being served */
+	bool stats_pending;
+	/* Time at which stats_cmd was parsed, in ns */
+	int64_t stats_start;
 };
 
 /* Private iiod information */
 struct iiod_desc {
-	/* Pool of iiod connections */
-	struct iiod_conn_priv conns[IIOD_MAX_CONNECTIONS];
+	/* Pool of iiod connections, allocated after this structure */
+	struct iiod_conn_priv *conns;
+	/* Number of entries in conns */
+	uint32_t max_conns;
 	/* Application operations */
 	struct iiod_ops ops;
 	/* Application instance */
@@ -175,6 +195,10 @@ struct iiod_desc {
 	char *xml;
 	/* XML length in bytes */
 	uint32_t xml_len;
+	/* Clock for the service time of the commands. Can be NULL */
+	int64_t (*get_time)(void);
+	/* Statistics of each command, indexed by enum iiod_cmd */
+	struct iiod_cmd_stats cmd_stats[IIOD_NB_CMDS];
 };
 
 #endif //IIOD_PRIVATE_H
@@ -180,7 +180,10 @@ enum jesd204_state_op_mode {
  * @struct jesd204_state_op
  * @brief JESD204 device per-state op
  * @param mode:		mode for this state op, depending on this per_device or per_link is called
- * @param per_device:		op called for each JESD204 **device** during a transition
+ * @param per_device:		op called for each JESD204 **device** during a transition;
+ *				for a non-top device it may return
+ *				JESD204_STATE_CHANGE_DEFER instead of blocking,
+ *				to be called again later (no-OS specific)
  * @param per_link		op called for each JESD204 **link** individually during a transition
  * // FIXME: maybe pass 'struct jesd204_sysref' for post_state_sysref, to make this configurable? we'll see later
  * // FIXME: for now, the device should also be a top-level device, in case of multi-chip setups
@@ -244,11 +247,37 @@ struct jesd204_topology_dev {
 	unsigned int		links_number;
 };
 
+/* no-OS specific */
+/**
+ * @struct jesd204_fsm_report
+ * @brief Timing of the last jesd204_fsm_start()/stop()/resume() call
+ * @param total_us:	duration of the whole transition
+ * @param state_us:	duration of each state
+ * @param dev_us:	time spent in the ops of each device, for each state;
+ *			indexed [dev * __JESD204_MAX_OPS + op], where dev is the
+ *			index in the topology devs array and the top device is
+ *			last (dev == devs_number)
+ * @param devs_number:	number of non-top devices
+ * @param error:	first error returned by a state op, 0 if none
+ * @param error_op:	state in which error was returned
+ * @param error_dev:	device that returned error
+ */
+struct jesd204_fsm_report {
+	uint32_t			total_us;
+	uint32_t			state_us[__JESD204_MAX_OPS];
+	uint32_t			*dev_us;
+	unsigned int			devs_number;
+	int				error;
+	enum jesd204_dev_op		error_op;
+	struct jesd204_dev		*error_dev;
+};
+
 /* no-OS specific */
 struct jesd204_topology {
 	struct jesd204_dev_top		*dev_top;
 	struct jesd204_topology_dev	*devs;
 	unsigned int			devs_number;
+	struct jesd204_fsm_report	report;
 };
 
 /* no-OS specific */
@@ -272,6 +301,23 @@ int jesd204_fsm_start(struct jesd204_topology *topology, unsigned int link_idx);
 /* no-OS specific */
 int jesd204_fsm_stop(struct jesd204_topology *topology, unsigned int link_idx);
 
+/* no-OS specific */
+int jesd204_fsm_resume(struct jesd204_topology *topology, unsigned int link_idx,
+		       enum jesd204_dev_op from);
+
+/* no-OS specific */
+int jesd204_fsm_retrain(struct jesd204_topology *topology,
+			unsigned int link_idx);
+
+/* no-OS specific */
+const struct jesd204_fsm_report *jesd204_fsm_get_report(
+	struct jesd204_topology *topology);
+
+/* no-OS specific */
+void jesd204_fsm_report_print(struct jesd204_topology *topology);
+
+const char *jesd204_state_op_str(enum jesd204_dev_op op);
+
 void *jesd204_dev_priv(struct jesd204_dev *jdev);
 
 int jesd204_link_get_lmfc_lemc_rate(struct jesd204_link *lnk,
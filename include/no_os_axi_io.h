@@ -56,4 +56,10 @@ int32_t no_os_axi_io_read(uint32_t base, uint32_t offset, uint32_t *data);
 /* AXI IO Write data */
 int32_t no_os_axi_io_write(uint32_t base, uint32_t offset, uint32_t data);
 
+/* AXI IO Map a memory range for direct (bulk) access */
+int32_t no_os_axi_io_map(uint32_t base, uint32_t size, void **addr);
+
+/* AXI IO Unmap a memory range, making written data visible to bus masters */
+int32_t no_os_axi_io_unmap(uint32_t base, void *addr, uint32_t size);
+
 #endif // _NO_OS_AXI_IO_H_
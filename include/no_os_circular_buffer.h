@@ -102,11 +102,13 @@ int32_t no_os_cb_prepare_async_write(struct no_os_circular_buffer *desc,
 				     void **write_buff,
 				     uint32_t *raw_size_avilable);
 int32_t no_os_cb_end_async_write(struct no_os_circular_buffer *desc);
+int32_t no_os_cb_abort_async_write(struct no_os_circular_buffer *desc);
 
 int32_t no_os_cb_prepare_async_read(struct no_os_circular_buffer *desc,
 				    uint32_t raw_size_to_read,
 				    void **read_buff,
 				    uint32_t *raw_size_avilable);
 int32_t no_os_cb_end_async_read(struct no_os_circular_buffer *desc);
+int32_t no_os_cb_abort_async_read(struct no_os_circular_buffer *desc);
 
 #endif //_NO_OS_CIRCULAR_BUFFER_H_
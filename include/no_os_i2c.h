@@ -52,6 +52,9 @@
 
 #define I2C_MAX_BUS_NUMBER 4
 
+/** Message flag: read from the slave, otherwise the message is a write */
+#define NO_OS_I2C_M_RD		0x0001
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -63,6 +66,21 @@
  */
 struct no_os_i2c_platform_ops ;
 
+/**
+ * @struct no_os_i2c_msg
+ * @brief One segment of a combined I2C transaction. Consecutive messages of a
+ * transfer are separated by a repeated start, a stop condition is generated
+ * only after the last message.
+ */
+struct no_os_i2c_msg {
+	/** Buffer with the data to send or where to store the received data */
+	uint8_t		*buf;
+	/** Number of bytes to transfer */
+	uint16_t	len;
+	/** Message flags (NO_OS_I2C_M_RD) */
+	uint16_t	flags;
+};
+
 /**
  * @struct no_os_i2c_init_param
  * @brief Structure holding the parameters for I2C initialization.
@@ -134,6 +152,9 @@ struct no_os_i2c_platform_ops {
 	int32_t (*i2c_ops_read)(struct no_os_i2c_desc *, uint8_t *, uint8_t, uint8_t);
 	/** i2c remove function pointer */
 	int32_t (*i2c_ops_remove)(struct no_os_i2c_desc *);
+	/** i2c combined transfer function pointer */
+	int32_t (*i2c_ops_transfer)(struct no_os_i2c_desc *, struct no_os_i2c_msg *,
+				    uint32_t);
 };
 
 /******************************************************************************/
@@ -159,6 +180,18 @@ int32_t no_os_i2c_read(struct no_os_i2c_desc *desc,
 		       uint8_t bytes_number,
 		       uint8_t stop_bit);
 
+/* Execute several messages as one combined (repeated start) transaction. */
+int32_t no_os_i2c_transfer(struct no_os_i2c_desc *desc,
+			   struct no_os_i2c_msg *msgs,
+			   uint32_t len);
+
+/* Write a register address and read back its value with a repeated start. */
+int32_t no_os_i2c_write_read(struct no_os_i2c_desc *desc,
+			     uint8_t *tx_data,
+			     uint16_t tx_len,
+			     uint8_t *rx_data,
+			     uint16_t rx_len);
+
 /* Initialize I2C bus descriptor*/
 int32_t no_os_i2cbus_init(const struct no_os_i2c_init_param *param);
 
@@ -0,0 +1,156 @@
+/***************************************************************************//**
+ *   @file   no_os_waveform.h
+ *   @brief  Fixed-point waveform synthesis for DAC buffers.
+********************************************************************************
+ * Copyright 2023(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_WAVEFORM_H_
+#define _NO_OS_WAVEFORM_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+#define NO_OS_WAVE_MAX_TONES	8
+/* Full scale amplitude (Q15) */
+#define NO_OS_WAVE_FULL_SCALE	32767
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+/**
+ * @enum no_os_wave_type
+ * @brief Waveform types.
+ */
+enum no_os_wave_type {
+	/** Sum of one or more tones */
+	NO_OS_WAVE_TONE,
+	/** Linear frequency sweep */
+	NO_OS_WAVE_CHIRP_LIN,
+	/** Exponential (logarithmic) frequency sweep */
+	NO_OS_WAVE_CHIRP_LOG,
+	/** Pseudo-random binary sequence */
+	NO_OS_WAVE_PRBS,
+};
+
+/**
+ * @struct no_os_wave_fmt
+ * @brief Sample format of the target channel, as described by its IIO
+ * scan_type.
+ */
+struct no_os_wave_fmt {
+	/** 's' or 'u' (offset binary) */
+	char sign;
+	/** Number of valid bits */
+	uint8_t realbits;
+	/** Storage size in bits: 8, 16 or 32 */
+	uint8_t storagebits;
+	/** Left shift of the valid bits within the storage */
+	uint8_t shift;
+	/** Big endian storage */
+	bool is_big_endian;
+};
+
+/**
+ * @struct no_os_wave_tone
+ * @brief Single tone.
+ */
+struct no_os_wave_tone {
+	/** Frequency tuning word: f / fs * 2^32, see no_os_wave_ftw() */
+	uint32_t ftw;
+	/** Start phase, 2^32 is a full turn */
+	uint32_t phase;
+	/** Amplitude, Q15 */
+	int16_t amplitude;
+};
+
+/**
+ * @struct no_os_wave
+ * @brief Waveform generator. Successive no_os_wave_fill() calls continue the
+ * waveform, so it can feed streaming buffers as well as cyclic ones.
+ */
+struct no_os_wave {
+	enum no_os_wave_type type;
+	/** Sample format, signed 16-bit if storagebits is 0 */
+	struct no_os_wave_fmt fmt;
+	/** Complex output: I = cos, Q = sin of the same phase */
+	bool iq;
+	/** Tones, for NO_OS_WAVE_TONE */
+	uint8_t nb_tones;
+	struct no_os_wave_tone tone[NO_OS_WAVE_MAX_TONES];
+	/** Chirp start and stop frequency tuning words */
+	uint32_t ftw_start;
+	uint32_t ftw_stop;
+	/** Chirp sweep length in samples */
+	uint32_t sweep_len;
+	/** PRBS order: 7, 15, 23 or 31 */
+	uint8_t prbs_order;
+	/** Chirp and PRBS amplitude, Q15 */
+	int16_t amplitude;
+	/* Generator state, set up by no_os_wave_init() */
+	uint32_t acc[NO_OS_WAVE_MAX_TONES];
+	int64_t ftw_q;
+	int64_t ftw_step;
+	uint32_t ftw_rate;
+	bool ftw_down;
+	uint32_t n;
+	uint32_t prbs;
+};
+
+/******************************************************************************/
+/************************ Variable Declarations *******************************/
+/******************************************************************************/
+/* One sine period, 16 bit offset binary (util/no_os_sin_lut.c) */
+extern const uint16_t no_os_sine_lut_16[512];
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+/* Frequency tuning word of a (possibly negative) frequency */
+uint32_t no_os_wave_ftw(int64_t freq_hz, uint64_t fs_hz);
+/* Validate the waveform parameters and reset the generator */
+int no_os_wave_init(struct no_os_wave *w);
+/* Set up a waveform from a text description */
+int no_os_wave_parse(struct no_os_wave *w, const char *spec, uint64_t fs_hz,
+		     uint32_t period);
+/* Generate samples */
+int no_os_wave_fill(struct no_os_wave *w, void *i_buf, void *q_buf,
+		    uint32_t nb_samples, uint32_t stride);
+
+#endif // _NO_OS_WAVEFORM_H_
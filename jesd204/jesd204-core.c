@@ -23,6 +23,15 @@ static int jesd204_dev_alloc_links(struct jesd204_dev_top *jdev_top)
 		return -ENOMEM;
 	jdev_top->active_links = links;
 
+	jdev_top->cached_links = (struct jesd204_link *)
+				 no_os_calloc(jdev_top->num_links,
+					      sizeof(*jdev_top->cached_links));
+	if (!jdev_top->cached_links) {
+		no_os_free(links);
+		jdev_top->active_links = NULL;
+		return -ENOMEM;
+	}
+
 	for (i = 0; i < jdev_top->num_links; i++) {
 		links[i].jdev_top = jdev_top;
 		links[i].link_idx = i;
@@ -97,6 +106,17 @@ int jesd204_topology_init(struct jesd204_topology **topology,
 	top->devs = (struct jesd204_topology_dev *)no_os_calloc(1,
 			top->devs_number * sizeof(*top->devs));
 
+	top->report.devs_number = top->devs_number;
+	top->report.dev_us = (uint32_t *)no_os_calloc(devs_number,
+			     __JESD204_MAX_OPS * sizeof(*top->report.dev_us));
+	if ((top->devs_number && !top->devs) || !top->report.dev_us) {
+		no_os_free(top->report.dev_us);
+		no_os_free(top->devs);
+		no_os_free(top->dev_top);
+		no_os_free(top);
+		return -ENOMEM;
+	}
+
 	for (i = 0; i < devs_number; i++) {
 		if (devs[i].is_top_device) {
 			top->dev_top->jdev = devs[i].jdev;
@@ -108,12 +128,17 @@ int jesd204_topology_init(struct jesd204_topology **topology,
 			jesd204_dev_alloc_links(top->dev_top);
 		} else {
 			top->devs[d] = devs[i];
+			top->devs[d].jdev->topology = top;
 			if (top->devs[d].is_sysref_provider)
 				top->dev_top->jdev_sysref = top->devs[d].jdev;
 			d++;
 		}
 	}
 
+#ifdef LINUX_PLATFORM
+	pthread_mutex_init(&top->dev_top->lock, NULL);
+#endif
+
 	*topology = top;
 
 	return 0;
@@ -125,6 +150,13 @@ int jesd204_topology_remove(struct jesd204_topology *topology)
 	if (!topology)
 		return -EINVAL;
 
+#ifdef LINUX_PLATFORM
+	pthread_mutex_destroy(&topology->dev_top->lock);
+#endif
+	no_os_free(topology->report.dev_us);
+	no_os_free(topology->devs);
+	no_os_free(topology->dev_top->active_links);
+	no_os_free(topology->dev_top->cached_links);
 	no_os_free(topology->dev_top);
 	no_os_free(topology);
 
@@ -135,6 +167,9 @@ int jesd204_topology_remove(struct jesd204_topology *topology)
 struct jesd204_dev_top *jesd204_dev_get_topology_top_dev(
 	struct jesd204_dev *jdev)
 {
+	if (!jdev->topology)
+		return NULL;
+
 	return jdev->topology->dev_top;
 }
 
@@ -343,10 +378,28 @@ int jesd204_link_get_lmfc_lemc_rate(struct jesd204_link *lnk,
 	return 0;
 }
 
+/* no-OS specific */
+/* The per-device ops of several devices may request a SYSREF at once */
+static int jesd204_sysref_call(struct jesd204_dev_top *jdev_top,
+			       struct jesd204_dev *jdev_sysref)
+{
+	int ret;
+
+#ifdef LINUX_PLATFORM
+	pthread_mutex_lock(&jdev_top->lock);
+#endif
+	/* By now, this should have been validated to have sysref_cb() */
+	ret = jdev_sysref->dev_data->sysref_cb(jdev_sysref);
+#ifdef LINUX_PLATFORM
+	pthread_mutex_unlock(&jdev_top->lock);
+#endif
+
+	return ret;
+}
+
 int jesd204_sysref_async(struct jesd204_dev *jdev)
 {
 	struct jesd204_dev_top *jdev_top = jesd204_dev_get_topology_top_dev(jdev);
-	const struct jesd204_dev_data *dev_data;
 
 	if (!jdev_top)
 		return -EFAULT;
@@ -358,16 +411,12 @@ int jesd204_sysref_async(struct jesd204_dev *jdev)
 	if (!jdev_top->jdev_sysref->dev_data)
 		return -EFAULT;
 
-	dev_data = jdev_top->jdev_sysref->dev_data;
-
-	/* By now, this should have been validated to have sysref_cb() */
-	return dev_data->sysref_cb(jdev_top->jdev_sysref);
+	return jesd204_sysref_call(jdev_top, jdev_top->jdev_sysref);
 }
 
 int jesd204_sysref_async_force(struct jesd204_dev *jdev)
 {
 	struct jesd204_dev_top *jdev_top = jesd204_dev_get_topology_top_dev(jdev);
-	const struct jesd204_dev_data *dev_data;
 
 	if (!jdev_top)
 		return -EFAULT;
@@ -383,10 +432,7 @@ int jesd204_sysref_async_force(struct jesd204_dev *jdev)
 	if (!jdev_top->jdev_sysref_sec->dev_data)
 		return -EFAULT;
 
-	dev_data = jdev_top->jdev_sysref_sec->dev_data;
-
-	/* By now, this should have been validated to have sysref_cb() */
-	return dev_data->sysref_cb(jdev_top->jdev_sysref_sec);
+	return jesd204_sysref_call(jdev_top, jdev_top->jdev_sysref_sec);
 }
 
 bool jesd204_dev_is_top(struct jesd204_dev *jdev)
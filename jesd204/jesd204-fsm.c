@@ -4,98 +4,554 @@
  * Copyright (c) 2022 Analog Devices Inc.
  */
 
+#include <string.h>
 #include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "no_os_delay.h"
+#include "no_os_print_log.h"
 #include "jesd204-priv.h"
 
+#ifdef LINUX_PLATFORM
+#include <pthread.h>
+#endif
+
 /* no-OS specific */
-int jesd204_fsm_start(struct jesd204_topology *topology, unsigned int link_idx)
+struct jesd204_fsm_job {
+	struct jesd204_dev		*jdev;
+	unsigned int			dev_idx;
+	enum jesd204_dev_op		op;
+	enum jesd204_state_op_reason	reason;
+	uint32_t			us;
+	int				ret;
+	bool				done;
+#ifdef LINUX_PLATFORM
+	pthread_t			thread;
+	bool				threaded;
+#endif
+};
+
+static const char *const jesd204_op_names[__JESD204_MAX_OPS] = {
+	[JESD204_OP_DEVICE_INIT] = "device_init",
+	[JESD204_OP_LINK_INIT] = "link_init",
+	[JESD204_OP_LINK_SUPPORTED] = "link_supported",
+	[JESD204_OP_LINK_PRE_SETUP] = "link_pre_setup",
+	[JESD204_OP_CLK_SYNC_STAGE1] = "clk_sync_stage1",
+	[JESD204_OP_CLK_SYNC_STAGE2] = "clk_sync_stage2",
+	[JESD204_OP_CLK_SYNC_STAGE3] = "clk_sync_stage3",
+	[JESD204_OP_LINK_SETUP] = "link_setup",
+	[JESD204_OP_OPT_SETUP_STAGE1] = "opt_setup_stage1",
+	[JESD204_OP_OPT_SETUP_STAGE2] = "opt_setup_stage2",
+	[JESD204_OP_OPT_SETUP_STAGE3] = "opt_setup_stage3",
+	[JESD204_OP_OPT_SETUP_STAGE4] = "opt_setup_stage4",
+	[JESD204_OP_OPT_SETUP_STAGE5] = "opt_setup_stage5",
+	[JESD204_OP_CLOCKS_ENABLE] = "clocks_enable",
+	[JESD204_OP_LINK_ENABLE] = "link_enable",
+	[JESD204_OP_LINK_RUNNING] = "link_running",
+	[JESD204_OP_OPT_POST_RUNNING_STAGE] = "opt_post_running_stage",
+};
+
+const char *jesd204_state_op_str(enum jesd204_dev_op op)
+{
+	if (op >= __JESD204_MAX_OPS)
+		return "unknown";
+
+	return jesd204_op_names[op];
+}
+
+/* no-OS specific */
+static uint64_t jesd204_fsm_time_us(void)
+{
+	struct no_os_time t = no_os_get_time();
+
+	return (uint64_t)t.s * 1000000 + t.us;
+}
+
+/* no-OS specific */
+static bool jesd204_dev_on_link(struct jesd204_topology_dev *tdev,
+				unsigned int link_id)
+{
+	unsigned int l;
+
+	for (l = 0; l < tdev->links_number; l++)
+		if (tdev->link_ids[l] == link_id)
+			return true;
+
+	return false;
+}
+
+/* no-OS specific */
+static bool jesd204_dev_on_top(struct jesd204_dev_top *jdev_top,
+			       struct jesd204_topology_dev *tdev)
+{
+	unsigned int lnk_id;
+
+	for (lnk_id = 0; lnk_id < jdev_top->num_links; lnk_id++)
+		if (jesd204_dev_on_link(tdev, jdev_top->link_ids[lnk_id]))
+			return true;
+
+	return false;
+}
+
+/* no-OS specific */
+/* Devices are walked in topology order on init and backwards on uninit */
+static struct jesd204_topology_dev *jesd204_fsm_dev(struct jesd204_topology
+		*topology, unsigned int i, enum jesd204_state_op_reason reason)
+{
+	if (reason == JESD204_STATE_OP_REASON_UNINIT)
+		return &topology->devs[topology->devs_number - 1 - i];
+
+	return &topology->devs[i];
+}
+
+/* no-OS specific */
+static void jesd204_fsm_account(struct jesd204_topology *topology,
+				struct jesd204_dev *jdev, unsigned int dev_idx,
+				enum jesd204_dev_op op, uint32_t us, int ret)
+{
+	struct jesd204_fsm_report *report = &topology->report;
+
+	report->dev_us[dev_idx * __JESD204_MAX_OPS + op] += us;
+
+	if (ret >= 0 || report->error)
+		return;
+
+	report->error = ret;
+	report->error_op = op;
+	report->error_dev = jdev;
+	pr_err("JESD204: %s failed with %d (%s)\n", jesd204_state_op_str(op),
+	       ret, dev_idx == topology->devs_number ? "top" : "device");
+}
+
+/* no-OS specific */
+static void jesd204_fsm_per_link(struct jesd204_topology *topology,
+				 struct jesd204_dev *jdev, unsigned int dev_idx,
+				 enum jesd204_dev_op op,
+				 enum jesd204_state_op_reason reason,
+				 struct jesd204_link *lnk)
+{
+	uint64_t start = jesd204_fsm_time_us();
+	int ret;
+
+	ret = jdev->dev_data->state_ops[op].per_link(jdev, reason, lnk);
+
+	jesd204_fsm_account(topology, jdev, dev_idx, op,
+			    jesd204_fsm_time_us() - start, ret);
+}
+
+/* no-OS specific */
+/*
+ * Call the per-device op of a job once. The job is done unless the op
+ * returned JESD204_STATE_CHANGE_DEFER, in which case it is called again.
+ */
+static void jesd204_fsm_job_step(struct jesd204_fsm_job *job)
+{
+	uint64_t start = jesd204_fsm_time_us();
+
+	job->ret = job->jdev->dev_data->state_ops[job->op].per_device(job->jdev,
+			job->reason);
+	job->us += jesd204_fsm_time_us() - start;
+	job->done = job->ret != JESD204_STATE_CHANGE_DEFER;
+}
+
+#ifdef LINUX_PLATFORM
+/* no-OS specific */
+static void *jesd204_fsm_job_thread(void *arg)
+{
+	struct jesd204_fsm_job *job = arg;
+
+	do {
+		jesd204_fsm_job_step(job);
+	} while (!job->done);
+
+	return NULL;
+}
+#endif
+
+/* no-OS specific */
+/*
+ * Run the per-device ops of the non-top devices of one state. They depend
+ * only on the previous state being completed, not on each other, so they
+ * are all issued at once and joined before the per-link ops of the state.
+ * On Linux each one gets its own thread. Elsewhere (and if a thread can't
+ * be created) they are polled in turn: an op that returns
+ * JESD204_STATE_CHANGE_DEFER instead of blocking is called again after the
+ * others got their turn, until it is done.
+ * The jobs only write their own entry; the report is updated after the
+ * join, and the framework calls an op makes into the shared topology are
+ * serialized by the topology lock.
+ */
+static void jesd204_fsm_devs_per_device(struct jesd204_topology *topology,
+					struct jesd204_fsm_job *jobs,
+					enum jesd204_dev_op op,
+					enum jesd204_state_op_reason reason)
 {
-	enum jesd204_state_op_reason reason = JESD204_STATE_OP_REASON_INIT;
 	struct jesd204_dev_top *jdev_top = topology->dev_top;
-	bool per_device_op_done[16];
-	enum jesd204_dev_op op;
-	int lnk_dev;
-	int lnk_id;
-	int dev;
+	struct jesd204_topology_dev *tdev;
+	unsigned int nb_jobs = 0;
+	unsigned int dev;
+	unsigned int i;
+	bool pending;
 
-	for (op = 0; op < __JESD204_MAX_OPS; op++) {
-		for (dev = 0; dev < topology->devs_number; dev++)
-			per_device_op_done[dev] = false;
-
-		for (lnk_id = 0; lnk_id < jdev_top->num_links; lnk_id++) {
-			for (dev = 0; dev < topology->devs_number; dev++) {
-				for (lnk_dev = 0; lnk_dev < topology->devs[dev].links_number; lnk_dev++) {
-					if (topology->devs[dev].link_ids[lnk_dev] == jdev_top->link_ids[lnk_id]) {
-						if (topology->devs[dev].jdev->dev_data->state_ops[op].per_device
-						    && !per_device_op_done[dev]) {
-							topology->devs[dev].jdev->dev_data->state_ops[op].per_device(
-								topology->devs[dev].jdev, reason);
-							per_device_op_done[dev] = true;
-						}
-						if (topology->devs[dev].jdev->dev_data->state_ops[op].per_link)
-							topology->devs[dev].jdev->dev_data->state_ops[op].per_link(
-								topology->devs[dev].jdev, reason,
-								&jdev_top->active_links[lnk_id].link);
-					}
-				}
-			}
-			if (jdev_top->jdev->dev_data->state_ops[op].per_link) {
-				jdev_top->jdev->dev_data->state_ops[op].per_link(jdev_top->jdev, reason,
-						&jdev_top->active_links[lnk_id].link);
-				if (jdev_top->jdev->dev_data->state_ops[op].post_state_sysref)
-					jesd204_sysref_async(jdev_top->jdev);
-			}
+	for (dev = 0; dev < topology->devs_number; dev++) {
+		tdev = jesd204_fsm_dev(topology, dev, reason);
+		if (!tdev->jdev->dev_data->state_ops[op].per_device ||
+		    !jesd204_dev_on_top(jdev_top, tdev))
+			continue;
+
+		memset(&jobs[nb_jobs], 0, sizeof(*jobs));
+		jobs[nb_jobs].jdev = tdev->jdev;
+		jobs[nb_jobs].dev_idx = tdev - topology->devs;
+		jobs[nb_jobs].op = op;
+		jobs[nb_jobs].reason = reason;
+		nb_jobs++;
+	}
+
+#ifdef LINUX_PLATFORM
+	for (i = 0; nb_jobs > 1 && i < nb_jobs; i++)
+		jobs[i].threaded = !pthread_create(&jobs[i].thread, NULL,
+						   jesd204_fsm_job_thread,
+						   &jobs[i]);
+#endif
+
+	do {
+		pending = false;
+		for (i = 0; i < nb_jobs; i++) {
+#ifdef LINUX_PLATFORM
+			if (jobs[i].threaded)
+				continue;
+#endif
+			if (jobs[i].done)
+				continue;
+
+			jesd204_fsm_job_step(&jobs[i]);
+			pending |= !jobs[i].done;
 		}
-		if (jdev_top->jdev->dev_data->state_ops[op].per_device) {
-			jdev_top->jdev->dev_data->state_ops[op].per_device(jdev_top->jdev, reason);
+	} while (pending);
+
+	for (i = 0; i < nb_jobs; i++) {
+#ifdef LINUX_PLATFORM
+		if (jobs[i].threaded)
+			pthread_join(jobs[i].thread, NULL);
+#endif
+		jesd204_fsm_account(topology, jobs[i].jdev, jobs[i].dev_idx,
+				    op, jobs[i].us, jobs[i].ret);
+	}
+}
+
+/* no-OS specific */
+static void jesd204_fsm_top_per_device(struct jesd204_topology *topology,
+				       enum jesd204_dev_op op,
+				       enum jesd204_state_op_reason reason)
+{
+	struct jesd204_dev *jdev = topology->dev_top->jdev;
+	uint64_t start;
+	int ret;
+
+	if (!jdev->dev_data->state_ops[op].per_device)
+		return;
+
+	start = jesd204_fsm_time_us();
+	ret = jdev->dev_data->state_ops[op].per_device(jdev, reason);
+	jesd204_fsm_account(topology, jdev, topology->devs_number, op,
+			    jesd204_fsm_time_us() - start, ret);
+}
+
+/* no-OS specific */
+static void jesd204_fsm_devs_per_link(struct jesd204_topology *topology,
+				      enum jesd204_dev_op op,
+				      enum jesd204_state_op_reason reason,
+				      unsigned int lnk_id)
+{
+	struct jesd204_dev_top *jdev_top = topology->dev_top;
+	struct jesd204_topology_dev *tdev;
+	unsigned int dev;
+
+	for (dev = 0; dev < topology->devs_number; dev++) {
+		tdev = jesd204_fsm_dev(topology, dev, reason);
+		if (!tdev->jdev->dev_data->state_ops[op].per_link ||
+		    !jesd204_dev_on_link(tdev, jdev_top->link_ids[lnk_id]))
+			continue;
+
+		jesd204_fsm_per_link(topology, tdev->jdev, tdev - topology->devs,
+				     op, reason, &jdev_top->active_links[lnk_id].link);
+	}
+}
+
+/* no-OS specific */
+static void jesd204_fsm_top_per_link(struct jesd204_topology *topology,
+				     enum jesd204_dev_op op,
+				     enum jesd204_state_op_reason reason,
+				     unsigned int lnk_id)
+{
+	struct jesd204_dev_top *jdev_top = topology->dev_top;
+
+	if (!jdev_top->jdev->dev_data->state_ops[op].per_link)
+		return;
+
+	jesd204_fsm_per_link(topology, jdev_top->jdev, topology->devs_number,
+			     op, reason, &jdev_top->active_links[lnk_id].link);
+}
+
+/* no-OS specific */
+static struct jesd204_fsm_job *jesd204_fsm_prepare(struct jesd204_topology
+		*topology)
+{
+	struct jesd204_fsm_report *report = &topology->report;
+
+	memset(report->dev_us, 0, (topology->devs_number + 1) *
+	       __JESD204_MAX_OPS * sizeof(*report->dev_us));
+	memset(report->state_us, 0, sizeof(report->state_us));
+	report->total_us = 0;
+	report->error = 0;
+	report->error_dev = NULL;
+
+	return no_os_calloc(topology->devs_number + 1, sizeof(struct jesd204_fsm_job));
+}
+
+/* no-OS specific */
+/*
+ * On init the devices go first: their per-device ops, then the per-link ops
+ * of each link, with the top device op of a link last. The top device
+ * per-device op closes the state.
+ */
+static void jesd204_fsm_init_op(struct jesd204_topology *topology,
+				struct jesd204_fsm_job *jobs,
+				enum jesd204_dev_op op)
+{
+	enum jesd204_state_op_reason reason = JESD204_STATE_OP_REASON_INIT;
+	struct jesd204_dev_top *jdev_top = topology->dev_top;
+	unsigned int lnk_id;
+
+	jesd204_fsm_devs_per_device(topology, jobs, op, reason);
+
+	for (lnk_id = 0; lnk_id < jdev_top->num_links; lnk_id++) {
+		jesd204_fsm_devs_per_link(topology, op, reason, lnk_id);
+		if (jdev_top->jdev->dev_data->state_ops[op].per_link) {
+			jesd204_fsm_top_per_link(topology, op, reason, lnk_id);
 			if (jdev_top->jdev->dev_data->state_ops[op].post_state_sysref)
 				jesd204_sysref_async(jdev_top->jdev);
 		}
 	}
-
-	return 0;
+	if (jdev_top->jdev->dev_data->state_ops[op].per_device) {
+		jesd204_fsm_top_per_device(topology, op, reason);
+		if (jdev_top->jdev->dev_data->state_ops[op].post_state_sysref)
+			jesd204_sysref_async(jdev_top->jdev);
+	}
 }
 
 /* no-OS specific */
-int jesd204_fsm_stop(struct jesd204_topology *topology, unsigned int link_idx)
+/*
+ * On uninit the top device goes first: its per-device op, then the
+ * per-device ops of the other devices, then the per-link ops of each link
+ * backwards, with the top device op of a link first.
+ */
+static void jesd204_fsm_uninit_op(struct jesd204_topology *topology,
+				  struct jesd204_fsm_job *jobs,
+				  enum jesd204_dev_op op)
 {
 	enum jesd204_state_op_reason reason = JESD204_STATE_OP_REASON_UNINIT;
 	struct jesd204_dev_top *jdev_top = topology->dev_top;
-	bool per_device_op_done[16];
-	int lnk_dev;
 	int lnk_id;
-	int dev;
+
+	jesd204_fsm_top_per_device(topology, op, reason);
+	jesd204_fsm_devs_per_device(topology, jobs, op, reason);
+
+	for (lnk_id = jdev_top->num_links - 1; lnk_id >= 0; lnk_id--) {
+		jesd204_fsm_top_per_link(topology, op, reason, lnk_id);
+		jesd204_fsm_devs_per_link(topology, op, reason, lnk_id);
+	}
+}
+
+/* no-OS specific */
+/*
+ * Uninitialize the states from the last one down to @first (if @uninit), then
+ * initialize them back from @first up to the last one (if @init).
+ */
+static int jesd204_fsm_run(struct jesd204_topology *topology, int first,
+			   bool uninit, bool init)
+{
+	struct jesd204_fsm_report *report = &topology->report;
+	struct jesd204_fsm_job *jobs;
+	uint64_t start, op_start;
 	int op;
 
-	for (op = __JESD204_MAX_OPS - 1; op >= 0; op--) {
-		for (dev = topology->devs_number - 1; dev >= 0 ; dev--)
-			per_device_op_done[dev] = false;
-
-		if (jdev_top->jdev->dev_data->state_ops[op].per_device)
-			jdev_top->jdev->dev_data->state_ops[op].per_device(jdev_top->jdev, reason);
-
-		for (lnk_id = jdev_top->num_links - 1; lnk_id >= 0; lnk_id--) {
-			if (jdev_top->jdev->dev_data->state_ops[op].per_link)
-				jdev_top->jdev->dev_data->state_ops[op].per_link(jdev_top->jdev, reason,
-						&jdev_top->active_links[lnk_id].link);
-			for (dev = topology->devs_number - 1; dev >= 0; dev--) {
-				for (lnk_dev = topology->devs[dev].links_number - 1; lnk_dev >= 0; lnk_dev--) {
-					if (topology->devs[dev].link_ids[lnk_dev] == jdev_top->link_ids[lnk_id]) {
-						if (topology->devs[dev].jdev->dev_data->state_ops[op].per_device
-						    && !per_device_op_done[dev]) {
-							topology->devs[dev].jdev->dev_data->state_ops[op].per_device(
-								topology->devs[dev].jdev, reason);
-							per_device_op_done[dev] = true;
-						}
-						if (topology->devs[dev].jdev->dev_data->state_ops[op].per_link)
-							topology->devs[dev].jdev->dev_data->state_ops[op].per_link(
-								topology->devs[dev].jdev, reason,
-								&jdev_top->active_links[lnk_id].link);
-					}
-				}
-			}
-		}
+	jobs = jesd204_fsm_prepare(topology);
+	if (!jobs)
+		return -ENOMEM;
+
+	start = jesd204_fsm_time_us();
+	for (op = __JESD204_MAX_OPS - 1; uninit && op >= first; op--) {
+		op_start = jesd204_fsm_time_us();
+		jesd204_fsm_uninit_op(topology, jobs, op);
+		report->state_us[op] += jesd204_fsm_time_us() - op_start;
+	}
+	for (op = first; init && op < __JESD204_MAX_OPS; op++) {
+		op_start = jesd204_fsm_time_us();
+		jesd204_fsm_init_op(topology, jobs, op);
+		report->state_us[op] += jesd204_fsm_time_us() - op_start;
+	}
+	report->total_us = jesd204_fsm_time_us() - start;
+
+	no_os_free(jobs);
+
+	return 0;
+}
+
+/* no-OS specific */
+/* Parameters that the lane rate and the device clocks are derived from */
+static bool jesd204_link_same_clocking(const struct jesd204_link *a,
+				       const struct jesd204_link *b)
+{
+	return a->sample_rate == b->sample_rate &&
+	       a->sample_rate_div == b->sample_rate_div &&
+	       a->num_lanes == b->num_lanes &&
+	       a->num_converters == b->num_converters &&
+	       a->octets_per_frame == b->octets_per_frame &&
+	       a->frames_per_multiframe == b->frames_per_multiframe &&
+	       a->num_of_multiblocks_in_emb == b->num_of_multiblocks_in_emb &&
+	       a->bits_per_sample == b->bits_per_sample &&
+	       a->jesd_version == b->jesd_version &&
+	       a->jesd_encoder == b->jesd_encoder &&
+	       a->subclass == b->subclass &&
+	       a->samples_per_conv_frame == b->samples_per_conv_frame &&
+	       a->sysref.mode == b->sysref.mode &&
+	       a->sysref.lmfc_offset == b->sysref.lmfc_offset;
+}
+
+/* no-OS specific */
+/*
+ * Re-derive the link parameters with the top device link_init op and compare
+ * them to the ones the links were brought up with.
+ */
+static bool jesd204_fsm_clocking_unchanged(struct jesd204_topology *topology)
+{
+	struct jesd204_dev_top *jdev_top = topology->dev_top;
+	struct jesd204_dev *jdev = jdev_top->jdev;
+	struct jesd204_link *lnk;
+	jesd204_link_cb link_init;
+	unsigned int i;
+
+	if (!jdev_top->links_cached)
+		return false;
+
+	link_init = jdev->dev_data->state_ops[JESD204_OP_LINK_INIT].per_link;
+	for (i = 0; i < jdev_top->num_links; i++) {
+		lnk = &jdev_top->active_links[i].link;
+		if (link_init && link_init(jdev, JESD204_STATE_OP_REASON_INIT, lnk) < 0)
+			return false;
+		if (!jesd204_link_same_clocking(lnk, &jdev_top->cached_links[i]))
+			return false;
 	}
 
+	return true;
+}
+
+/* no-OS specific */
+int jesd204_fsm_start(struct jesd204_topology *topology, unsigned int link_idx)
+{
+	struct jesd204_dev_top *jdev_top;
+	unsigned int i;
+	int ret;
+
+	if (!topology)
+		return -EINVAL;
+
+	ret = jesd204_fsm_run(topology, 0, false, true);
+	if (ret)
+		return ret;
+
+	jdev_top = topology->dev_top;
+	for (i = 0; i < jdev_top->num_links; i++)
+		jdev_top->cached_links[i] = jdev_top->active_links[i].link;
+	jdev_top->links_cached = !topology->report.error;
+
 	return 0;
 }
+
+/* no-OS specific */
+int jesd204_fsm_stop(struct jesd204_topology *topology, unsigned int link_idx)
+{
+	if (!topology)
+		return -EINVAL;
+
+	topology->dev_top->links_cached = false;
+
+	return jesd204_fsm_run(topology, 0, true, false);
+}
+
+/* no-OS specific */
+/*
+ * Bring the links down to the state before @from and back up again. If the
+ * link parameters changed since the last start (so the clocks would need to
+ * be reprogrammed), all states are replayed instead.
+ */
+int jesd204_fsm_resume(struct jesd204_topology *topology, unsigned int link_idx,
+		       enum jesd204_dev_op from)
+{
+	int ret;
+
+	if (!topology || from >= __JESD204_MAX_OPS)
+		return -EINVAL;
+
+	if (from <= JESD204_OP_LINK_INIT ||
+	    !jesd204_fsm_clocking_unchanged(topology)) {
+		ret = jesd204_fsm_stop(topology, link_idx);
+		if (ret)
+			return ret;
+
+		return jesd204_fsm_start(topology, link_idx);
+	}
+
+	return jesd204_fsm_run(topology, from, true, true);
+}
+
+/* no-OS specific */
+int jesd204_fsm_retrain(struct jesd204_topology *topology,
+			unsigned int link_idx)
+{
+	return jesd204_fsm_resume(topology, link_idx, JESD204_OP_LINK_SETUP);
+}
+
+/* no-OS specific */
+const struct jesd204_fsm_report *jesd204_fsm_get_report(
+	struct jesd204_topology *topology)
+{
+	if (!topology)
+		return NULL;
+
+	return &topology->report;
+}
+
+/* no-OS specific */
+void jesd204_fsm_report_print(struct jesd204_topology *topology)
+{
+	struct jesd204_fsm_report *report;
+	unsigned int dev;
+	uint32_t us;
+	int op;
+
+	if (!topology)
+		return;
+
+	report = &topology->report;
+	pr_info("JESD204: transition took %u us\n", (unsigned int)report->total_us);
+	for (op = 0; op < __JESD204_MAX_OPS; op++) {
+		if (!report->state_us[op])
+			continue;
+
+		pr_info("  %-24s %10u us\n", jesd204_state_op_str(op),
+			(unsigned int)report->state_us[op]);
+		for (dev = 0; dev <= report->devs_number; dev++) {
+			us = report->dev_us[dev * __JESD204_MAX_OPS + op];
+			if (!us)
+				continue;
+			if (dev == report->devs_number)
+				pr_info("    top       %10u us\n", (unsigned int)us);
+			else
+				pr_info("    device %-2u %10u us\n", dev, (unsigned int)us);
+		}
+	}
+	if (report->error)
+		pr_info("  first error %d in %s\n", report->error,
+			jesd204_state_op_str(report->error_op));
+}
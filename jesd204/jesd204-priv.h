@@ -9,6 +9,10 @@
 
 #include "jesd204.h"
 
+#ifdef LINUX_PLATFORM
+#include <pthread.h>
+#endif
+
 #define JESD204_MAX_LINKS	16
 
 /**
@@ -51,6 +55,12 @@ struct jesd204_link_opaque {
  *			(connections should match against this)
  * @num_links		number of links
  * @active_links	active JESD204 link settings
+ * @cached_links	link settings of the last successful start, used to
+ *			check if a link can be retrained without touching
+ *			the clocks
+ * @links_cached	true if cached_links is valid
+ * @lock		serializes the SYSREF requests of the devices, whose
+ *			per-device ops may run on concurrent threads
  */
 struct jesd204_dev_top {
 	/* no-OS specific */
@@ -63,6 +73,13 @@ struct jesd204_dev_top {
 	unsigned int			num_links;
 
 	struct jesd204_link_opaque	*active_links;
+
+	/* no-OS specific */
+	struct jesd204_link		*cached_links;
+	bool				links_cached;
+#ifdef LINUX_PLATFORM
+	pthread_mutex_t			lock;
+#endif
 };
 
 struct jesd204_dev_top *jesd204_dev_get_topology_top_dev(
@@ -58,6 +58,7 @@
 #include "lwip/inet.h"
 #include "lwip_socket.h"
 #include "no_os_delay.h"
+#include "no_os_util.h"
 #include "tcp_socket.h"
 
 #include "adin1110.h"
@@ -75,25 +76,46 @@ static uint8_t lwip_buff[ADIN1110_LWIP_BUFF_SIZE];
 static int adin1110_read_frames(struct adin1110_desc *desc, struct pbuf **p,
 				uint32_t *len)
 {
-	struct adin1110_eth_buff mac_buff = {0};
+	struct adin1110_frame_span spans[ADIN1110_SG_MAX_SPANS];
+	uint32_t nb_spans = 0;
+	struct pbuf *q;
 	int ret;
 
-	mac_buff.payload = &lwip_buff[ADIN1110_ETH_HDR_LEN];
-
-	ret = adin1110_read_fifo(desc, 0, &mac_buff);
-	if (ret)
+	/* Only take a pbuf from the pool when a frame is waiting */
+	ret = adin1110_rx_frame_len(desc, 0, len);
+	if (ret || !*len)
 		return ret;
 
-	*len = mac_buff.len;
-	if (!mac_buff.len)
-		return 0;
-
-	memcpy(lwip_buff, mac_buff.mac_dest, ADIN1110_ETH_HDR_LEN);
-	*p = pbuf_alloc(PBUF_RAW, mac_buff.len, PBUF_POOL);
-	if (!*p)
+	/* Oversized frames are dropped by adin1110_read_fifo_sg() */
+	*p = pbuf_alloc(PBUF_RAW, no_os_min(*len, ADIN1110_BUFF_LEN), PBUF_POOL);
+	if (!*p) {
+		*len = 0;
 		return -ENOMEM;
+	}
+
+	/* Receive straight into the pbuf chain if it's short enough */
+	for (q = *p; q && nb_spans < ADIN1110_SG_MAX_SPANS; q = q->next) {
+		spans[nb_spans].buff = q->payload;
+		spans[nb_spans].len = q->len;
+		nb_spans++;
+	}
+
+	if (q) {
+		spans[0].buff = lwip_buff;
+		spans[0].len = ADIN1110_LWIP_BUFF_SIZE;
+		nb_spans = 1;
+	}
+
+	ret = adin1110_read_fifo_sg(desc, 0, spans, nb_spans, len);
+	if (ret || !*len) {
+		pbuf_free(*p);
+		return ret;
+	}
+
+	if (q)
+		pbuf_take(*p, lwip_buff, *len);
 
-	pbuf_take(*p, lwip_buff, mac_buff.len);
+	pbuf_realloc(*p, *len);
 
 	return 0;
 }
@@ -141,23 +163,31 @@ static int32_t adin1110_step(struct lwip_network_desc *desc, void *data)
  */
 static int32_t adin1110_netif_output(struct netif *net, struct pbuf *p)
 {
+	struct adin1110_frame_span spans[ADIN1110_SG_MAX_SPANS];
 	struct lwip_network_desc *lwip_desc;
 	struct adin1110_desc *mac_desc;
-	struct adin1110_eth_buff buff;
-	uint32_t frame_len;
+	uint32_t nb_spans = 0;
+	struct pbuf *q;
 
 	lwip_desc = net->state;
 	mac_desc = lwip_desc->mac_desc;
 
 	LINK_STATS_INC(link.xmit);
-	frame_len = pbuf_copy_partial(p, lwip_buff, p->tot_len, 0);
 
-	memcpy(&buff.mac_dest, lwip_buff, ADIN1110_ETH_HDR_LEN);
+	/* Send the pbuf chain segments as they are, unless there are too many */
+	for (q = p; q && nb_spans < ADIN1110_SG_MAX_SPANS; q = q->next) {
+		spans[nb_spans].buff = q->payload;
+		spans[nb_spans].len = q->len;
+		nb_spans++;
+	}
 
-	buff.len = frame_len;
-	buff.payload = &lwip_buff[ADIN1110_ETH_HDR_LEN];
+	if (q) {
+		spans[0].buff = lwip_buff;
+		spans[0].len = pbuf_copy_partial(p, lwip_buff, p->tot_len, 0);
+		nb_spans = 1;
+	}
 
-	return adin1110_write_fifo(mac_desc, 0, &buff);
+	return adin1110_write_fifo_sg(mac_desc, 0, spans, nb_spans);
 }
 
 /**
@@ -53,6 +53,8 @@ SRCS += $(NO-OS)/iio/iio_app/iio_app.c \
 	$(NO-OS)/util/no_os_fifo.c \
 	$(DRIVERS)/axi_core/iio_axi_adc/iio_axi_adc.c \
 	$(DRIVERS)/axi_core/iio_axi_dac/iio_axi_dac.c \
+	$(NO-OS)/util/no_os_sin_lut.c \
+	$(NO-OS)/util/no_os_waveform.c \
 	$(DRIVERS)/api/no_os_irq.c
 endif
 INCS +=	$(PROJECT)/src/app_clock.h \
@@ -116,5 +118,6 @@ INCS += $(NO-OS)/iio/iio_app/iio_app.h \
 	$(INCLUDE)/no_os_fifo.h \
 	$(INCLUDE)/no_os_list.h \
 	$(DRIVERS)/axi_core/iio_axi_adc/iio_axi_adc.h \
-	$(DRIVERS)/axi_core/iio_axi_dac/iio_axi_dac.h
+	$(DRIVERS)/axi_core/iio_axi_dac/iio_axi_dac.h \
+	$(INCLUDE)/no_os_waveform.h
 endif
@@ -44,6 +44,8 @@ ifeq (y,$(strip $(TINYIIOD)))
 SRCS += $(NO-OS)/util/no_os_fifo.c \
 	$(NO-OS)/util/no_os_list.c \
 	$(DRIVERS)/axi_core/iio_axi_dac/iio_axi_dac.c \
+	$(NO-OS)/util/no_os_sin_lut.c \
+	$(NO-OS)/util/no_os_waveform.c \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_uart.c \
 	$(NO-OS)/util/no_os_lf256fifo.c \
 	$(PLATFORM_DRIVERS)/xilinx_irq.c \
@@ -88,5 +90,6 @@ INCS += $(INCLUDE)/no_os_fifo.h \
 	$(INCLUDE)/no_os_list.h \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_irq.h \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_uart.h \
-	$(DRIVERS)/axi_core/iio_axi_dac/iio_axi_dac.h
+	$(DRIVERS)/axi_core/iio_axi_dac/iio_axi_dac.h \
+	$(INCLUDE)/no_os_waveform.h
 endif
@@ -50,6 +50,8 @@ SRCS += $(NO-OS)/util/no_os_fifo.c \
 	$(DRIVERS)/rf-transceiver/ad9361/iio_ad9361.c \
 	$(DRIVERS)/axi_core/iio_axi_adc/iio_axi_adc.c \
 	$(DRIVERS)/axi_core/iio_axi_dac/iio_axi_dac.c \
+	$(NO-OS)/util/no_os_sin_lut.c \
+	$(NO-OS)/util/no_os_waveform.c \
 	$(NO-OS)/iio/iio_app/iio_app.c \
 	$(NO-OS)/util/no_os_circular_buffer.c
 endif
@@ -94,6 +96,7 @@ INCS += $(INCLUDE)/no_os_fifo.h \
 	$(DRIVERS)/rf-transceiver/ad9361/iio_ad9361.h \
 	$(DRIVERS)/axi_core/iio_axi_adc/iio_axi_adc.h \
 	$(DRIVERS)/axi_core/iio_axi_dac/iio_axi_dac.h \
+	$(INCLUDE)/no_os_waveform.h \
 	$(NO-OS)/iio/iio_app/iio_app.h \
 	$(INCLUDE)/no_os_circular_buffer.h
 
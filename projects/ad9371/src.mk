@@ -65,6 +65,8 @@ SRCS += $(PLATFORM_DRIVERS)/$(PLATFORM)_uart.c \
 	$(NO-OS)/util/no_os_list.c \
 	$(DRIVERS)/axi_core/iio_axi_adc/iio_axi_adc.c \
 	$(DRIVERS)/axi_core/iio_axi_dac/iio_axi_dac.c \
+	$(NO-OS)/util/no_os_sin_lut.c \
+	$(NO-OS)/util/no_os_waveform.c \
 	$(NO-OS)/iio/iio_app/iio_app.c \
 	$(DRIVERS)/api/no_os_uart.c \
 	$(DRIVERS)/api/no_os_irq.c
@@ -125,5 +127,6 @@ INCS += $(INCLUDE)/no_os_fifo.h \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_uart.h \
 	$(DRIVERS)/axi_core/iio_axi_adc/iio_axi_adc.h \
 	$(NO-OS)/iio/iio_app/iio_app.h \
-	$(DRIVERS)/axi_core/iio_axi_dac/iio_axi_dac.h
+	$(DRIVERS)/axi_core/iio_axi_dac/iio_axi_dac.h \
+	$(INCLUDE)/no_os_waveform.h
 endif
@@ -25,6 +25,8 @@ SRCS += $(DRIVERS)/dac/ad9739a/ad9739a.c \
 ifeq (y,$(strip $(TINYIIOD)))
 SRCS += $(NO-OS)/util/no_os_fifo.c \
 	$(DRIVERS)/axi_core/iio_axi_dac/iio_axi_dac.c \
+	$(NO-OS)/util/no_os_sin_lut.c \
+	$(NO-OS)/util/no_os_waveform.c \
 	$(DRIVERS)/api/no_os_irq.c \
 	$(NO-OS)/util/no_os_list.c \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_uart.c \
@@ -58,5 +60,6 @@ INCS +=	$(INCLUDE)/no_os_fifo.h \
 	$(INCLUDE)/no_os_list.h \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_irq.h \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_uart.h \
-	$(DRIVERS)/axi_core/iio_axi_dac/iio_axi_dac.h
+	$(DRIVERS)/axi_core/iio_axi_dac/iio_axi_dac.h \
+	$(INCLUDE)/no_os_waveform.h
 endif
@@ -0,0 +1,194 @@
+/*
+ * profile2bin - compile an ADRV9002 JSON profile (as exported by TES) into
+ * the binary profile format loaded by adrv9002_profile_bin_load().
+ *
+ * Usage:
+ *     profile2bin [-c] profile output
+ *
+ *     profile is either the JSON file or a C header holding it as a string
+ *     literal, like the src/app/Navassa_*_profile.h files.
+ *     -c  write a C header holding a "const uint8_t profile_bin[]" array
+ *         instead of the raw binary.
+ *
+ * The binary holds the adi_adrv9001_Init_t image of the build environment, so
+ * the tool must be built for the same ABI as the target (see the Makefile).
+ * Mismatches are detected by the loader through the layout signature.
+ */
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "adi_adrv9001_profileutil.h"
+#include "adrv9002_profile.h"
+#include "adi_common_hal.h"
+
+/* No platform HAL on the host: parser errors go to stderr. */
+static int32_t host_log_write(void *devHalCfg, uint32_t logLevel,
+			      const char *formatStr, va_list argp)
+{
+	vfprintf(stderr, formatStr, argp);
+	fputc('\n', stderr);
+
+	return 0;
+}
+
+int32_t (*adi_common_hal_LogWrite)(void *devHalCfg, uint32_t logLevel,
+				   const char *formatStr, va_list argp) = host_log_write;
+
+static char *read_file(const char *path, long *len)
+{
+	FILE *f = fopen(path, "rb");
+	char *buf;
+
+	if (!f)
+		return NULL;
+
+	fseek(f, 0, SEEK_END);
+	*len = ftell(f);
+	fseek(f, 0, SEEK_SET);
+
+	buf = malloc(*len + 1);
+	if (buf && fread(buf, 1, *len, f) != (size_t)*len) {
+		free(buf);
+		buf = NULL;
+	}
+	fclose(f);
+
+	return buf;
+}
+
+/*
+ * Replace the content of a C header with the JSON held by its first string
+ * literal: escapes and line continuations are resolved and adjacent literals
+ * are concatenated. Plain JSON is left as is.
+ */
+static int extract_c_string(char *buf, long *len)
+{
+	char *src = buf, *end = buf + *len, *dst = buf;
+
+	while (src < end && *src && strchr(" \t\r\n", *src))
+		src++;
+	if (src < end && *src == '{')
+		return 0;
+
+	src = memchr(buf, '"', *len);
+	if (!src)
+		return -1;
+
+	for (src++; src < end; src++) {
+		if (*src == '"') {
+			/* Concatenate with the next literal, if any */
+			for (src++; src < end && *src && strchr(" \t\r\n", *src); src++)
+				;
+			if (src == end || *src != '"')
+				break;
+			continue;
+		}
+		if (*src != '\\') {
+			*dst++ = *src;
+			continue;
+		}
+		if (++src == end)
+			return -1;
+		switch (*src) {
+		case '\r':
+			if (src + 1 < end && src[1] == '\n')
+				src++;
+		/* fallthrough */
+		case '\n':
+			break;
+		case 'n':
+			*dst++ = '\n';
+			break;
+		case 't':
+			*dst++ = '\t';
+			break;
+		default:
+			*dst++ = *src;
+			break;
+		}
+	}
+
+	*len = dst - buf;
+
+	return 0;
+}
+
+static int write_header(FILE *f, const uint8_t *blob, int len, const char *src)
+{
+	int i;
+
+	fprintf(f, "/* Generated by profile2bin from %s, do not edit. */\n", src);
+	fprintf(f, "#include <stdint.h>\n\n");
+	fprintf(f, "const uint8_t profile_bin[%d] __attribute__((aligned(4))) = {", len);
+	for (i = 0; i < len; i++)
+		fprintf(f, "%s0x%02x,", i % 12 ? " " : "\n\t", blob[i]);
+	fprintf(f, "\n};\n");
+
+	return ferror(f) ? -1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+	adi_adrv9001_Device_t dev = { 0 };
+	adi_adrv9001_Init_t *init;
+	int c_header = 0;
+	uint8_t *blob;
+	char *json;
+	long len;
+	FILE *f;
+	int ret;
+
+	if (argc > 1 && !strcmp(argv[1], "-c")) {
+		c_header = 1;
+		argc--;
+		argv++;
+	}
+	if (argc != 3) {
+		fprintf(stderr, "usage: profile2bin [-c] profile.json|profile.h output\n");
+		return 1;
+	}
+
+	json = read_file(argv[1], &len);
+	if (!json || extract_c_string(json, &len)) {
+		fprintf(stderr, "cannot read %s\n", argv[1]);
+		return 1;
+	}
+
+	init = calloc(1, sizeof(*init));
+	blob = malloc(sizeof(struct adrv9002_profile_bin_hdr) + sizeof(*init));
+	if (!init || !blob)
+		return 1;
+
+	if (adi_adrv9001_profileutil_Parse(&dev, init, json, len)) {
+		fprintf(stderr, "cannot parse %s\n", argv[1]);
+		return 1;
+	}
+
+	ret = adrv9002_profile_bin_build(init, blob,
+					 sizeof(struct adrv9002_profile_bin_hdr) + sizeof(*init));
+	if (ret < 0)
+		return 1;
+
+	f = fopen(argv[2], c_header ? "w" : "wb");
+	if (!f) {
+		fprintf(stderr, "cannot open %s\n", argv[2]);
+		return 1;
+	}
+	if (c_header) {
+		if (write_header(f, blob, ret, argv[1]))
+			return 1;
+	} else if (fwrite(blob, 1, ret, f) != (size_t)ret) {
+		return 1;
+	}
+	fclose(f);
+
+	printf("%s: %d bytes, layout 0x%08x\n", argv[2], ret,
+	       adrv9002_profile_bin_layout());
+
+	free(blob);
+	free(init);
+	free(json);
+
+	return 0;
+}
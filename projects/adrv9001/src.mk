@@ -60,6 +60,13 @@ INCS +=	$(INCLUDE)/no_os_spi.h \
 # Navassa API sources
 SRC_DIRS += $(DRIVERS)/rf-transceiver/navassa
 
+# Compiled profile instead of JSON parsing. Generate src/app/profile_bin.h
+# first with: make -C scripts/profile2bin header
+ifeq (y,$(strip $(PROFILE_BIN)))
+CFLAGS += -DADRV9002_PROFILE_BIN
+INCS += $(PROJECT)/src/app/profile_bin.h
+endif
+
 # IIO
 ifeq (y,$(strip $(TINYIIOD)))
 LIBRARIES += iio
@@ -71,6 +78,8 @@ SRCS += $(PLATFORM_DRIVERS)/$(PLATFORM)_uart.c \
 	$(NO-OS)/util/no_os_fifo.c \
 	$(DRIVERS)/axi_core/iio_axi_adc/iio_axi_adc.c \
 	$(DRIVERS)/axi_core/iio_axi_dac/iio_axi_dac.c \
+	$(NO-OS)/util/no_os_sin_lut.c \
+	$(NO-OS)/util/no_os_waveform.c \
 	$(DRIVERS)/api/no_os_uart.c \
 	$(DRIVERS)/api/no_os_irq.c
 INCS += $(INCLUDE)/no_os_uart.h \
@@ -81,7 +90,8 @@ INCS += $(INCLUDE)/no_os_uart.h \
 	$(INCLUDE)/no_os_fifo.h \
 	$(INCLUDE)/no_os_list.h \
 	$(DRIVERS)/axi_core/iio_axi_adc/iio_axi_adc.h \
-	$(DRIVERS)/axi_core/iio_axi_dac/iio_axi_dac.h
+	$(DRIVERS)/axi_core/iio_axi_dac/iio_axi_dac.h \
+	$(INCLUDE)/no_os_waveform.h
 endif
 
 CFLAGS = -DADI_DYNAMIC_PROFILE_LOAD \
@@ -66,7 +66,12 @@
 #include "adi_adrv9001_arm.h"
 #include "adi_adrv9001_radio.h"
 #include "adi_adrv9001_profileutil.h"
+#ifdef ADRV9002_PROFILE_BIN
+#include "adrv9002_profile.h"
+#include "profile_bin.h"
+#else
 #include "Navassa_CMOS_profile.h"
+#endif
 
 /* ADC/DAC Buffers */
 #if defined(DMA_EXAMPLE) || defined(IIO_SUPPORT)
@@ -351,10 +356,20 @@ int main(void)
 
 	phy.chip = &chip;
 
+#ifdef ADRV9002_PROFILE_BIN
+	ret = adrv9002_profile_bin_load(&phy.profile, profile_bin,
+					sizeof(profile_bin));
+	if (ret) {
+		printf("Invalid binary profile (%d), regenerate it with profile2bin\n",
+		       ret);
+		goto error;
+	}
+#else
 	ret = adi_adrv9001_profileutil_Parse(phy.adrv9001, &phy.profile,
 					     (char *)json_profile, strlen(json_profile));
 	if (ret)
 		goto error;
+#endif
 
 	phy.curr_profile = &phy.profile;
 
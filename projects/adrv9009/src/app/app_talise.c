@@ -46,6 +46,7 @@
 #include "no_os_error.h"
 #include "no_os_delay.h"
 #include "no_os_util.h"
+#include "no_os_print_log.h"
 
 // talise
 #include "talise.h"
@@ -94,6 +95,7 @@ adiHalErr_t talise_setup(taliseDevice_t * const pd, taliseInit_t * const pi)
 	uint8_t framerStatus = 0;
 	uint32_t count = sizeof(armBinary);
 	taliseArmVersionInfo_t talArmVersionInfo;
+	struct adi_hal_spi_stats spiStats;
 #if defined(ADRV9008_1)
 	uint32_t initCalMask = TAL_ADC_TUNER | TAL_TIA_3DB_CORNER | TAL_DC_OFFSET |
 			       TAL_RX_GAIN_DELAY | TAL_FLASH_CAL | TAL_RX_QEC_INIT;
@@ -206,6 +208,8 @@ adiHalErr_t talise_setup(taliseDevice_t * const pd, taliseInit_t * const pi)
 		/*< user code- load Talise stream binary into streamBinary[4096] >*/
 		/*< user code- load ARM binary byte array into armBinary[114688] >*/
 
+		ADIHAL_resetSpiStats(pd->devHalInfo);
+
 		talAction = TALISE_loadStreamFromBinary(pd, &streamBinary[0]);
 		if (talAction != TALACT_NO_ACTION) {
 			/*** < User: decide what to do based on Talise recovery action returned > ***/
@@ -220,6 +224,15 @@ adiHalErr_t talise_setup(taliseDevice_t * const pd, taliseInit_t * const pi)
 			goto error_11;
 		}
 
+		ADIHAL_getSpiStats(pd->devHalInfo, &spiStats);
+		pr_info("ARM/stream load: %lu bytes, %lu SPI frames in %lu us (%lu kB/s)\n",
+			(unsigned long)spiStats.bytes,
+			(unsigned long)spiStats.transactions,
+			(unsigned long)spiStats.time_us,
+			spiStats.time_us ? (unsigned long)no_os_div_u64(
+				(uint64_t)spiStats.bytes * 1000,
+				(uint32_t)spiStats.time_us) : 0UL);
+
 		/* TALISE_verifyArmChecksum() will timeout after 200ms
 		 * if ARM checksum is not computed
 		 */
@@ -24,6 +24,15 @@
  * Enums and structures
  *=======================================*/
 
+/**
+ * \brief SPI traffic counters, updated by the multi-byte accessors
+ */
+struct adi_hal_spi_stats {
+	uint32_t		transactions;	/* chip select frames */
+	uint32_t		bytes;		/* register bytes transferred */
+	uint64_t		time_us;	/* time spent in the transfers */
+};
+
 struct adi_hal {
 	struct no_os_gpio_desc	*gpio_adrv_resetb;
 	struct no_os_gpio_desc	*gpio_adrv_sysref_req;
@@ -33,6 +42,16 @@ struct adi_hal {
 	uint8_t			spi_adrv_csn;
 	void 			*extra_gpio;
 	uint8_t			gpio_adrv_resetb_num;
+	/* Pack multi-byte accesses in one no_os_spi_transfer() (default on) */
+	bool			spi_burst;
+	/* Device is set for ascending address streaming (tracked by the HAL) */
+	bool			spi_stream;
+	/* Device is forced to single instruction mode (tracked by the HAL) */
+	bool			spi_single_instr;
+	struct adi_hal_spi_stats	spi_stats;
+	/* Burst mode storage, allocated by ADIHAL_openHw() */
+	struct no_os_spi_msg	*spi_msgs;
+	uint8_t			*spi_buf;
 };
 
 /**
@@ -621,6 +640,37 @@ adiHalErr_t ADIHAL_setLogLevel(void *devHalInfo, uint16_t halLogLevel);
 adiHalErr_t ADIHAL_writeToLog(void *devHalInfo, adiLogLevel_t logLevel,
 			      uint32_t errorCode, const char *comment);
 
+/**
+ * \brief Get the SPI traffic counters of the multi-byte accessors
+ *
+ * ADIHAL_spiWriteBytes() and ADIHAL_spiReadBytes() account the number of
+ * chip select frames, the number of register bytes and the time spent in
+ * the transfers. Together they give the load time and throughput of the ARM
+ * and stream processor images.
+ *
+ * \param devHalInfo Pointer to Platform HAL defined structure containing
+ *                   hardware settings describing the device of interest.
+ *
+ * \param stats Counters accumulated since ADIHAL_openHw() or the last
+ *              ADIHAL_resetSpiStats() call.
+ *
+ * \retval ADIHAL_OK if function completed successfully.
+ * \retval ADIHAL_GEN_SW if device references is unknown.
+ */
+adiHalErr_t ADIHAL_getSpiStats(void *devHalInfo,
+			       struct adi_hal_spi_stats *stats);
+
+/**
+ * \brief Clear the SPI traffic counters
+ *
+ * \param devHalInfo Pointer to Platform HAL defined structure containing
+ *                   hardware settings describing the device of interest.
+ *
+ * \retval ADIHAL_OK if function completed successfully.
+ * \retval ADIHAL_GEN_SW if device references is unknown.
+ */
+adiHalErr_t ADIHAL_resetSpiStats(void *devHalInfo);
+
 
 #ifdef __cplusplus
 }
@@ -47,6 +47,7 @@
 #include "no_os_gpio.h"
 #include "no_os_error.h"
 #include "no_os_delay.h"
+#include "no_os_alloc.h"
 #ifndef ALTERA_PLATFORM
 #include "xilinx_spi.h"
 #include "xilinx_gpio.h"
@@ -55,10 +56,155 @@
 #include "altera_gpio.h"
 #endif
 
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+#define ADIHAL_SPI_CONFIG_A		0x000
+#define ADIHAL_SPI_CONFIG_B		0x001
+#define ADIHAL_SPI_SINGLE_INSTR		0x80
+#define ADIHAL_SPI_SOFT_RESET		0x81
+#define ADIHAL_SPI_LSB_FIRST		0x42
+#define ADIHAL_SPI_ADDR_ASCENSION	0x24
+#define ADIHAL_SPI_READ			0x80
+#define ADIHAL_SPI_HDR_LEN		2
+/* Limits of one no_os_spi_transfer() call in burst mode */
+#define ADIHAL_SPI_BURST_MSGS		64
+#define ADIHAL_SPI_BURST_BYTES		(HAL_SPIWRITEARRAY_BUFFERSIZE * 3)
+
 /******************************************************************************/
 /************************** Functions Implementation **************************/
 /******************************************************************************/
 
+/* Time base for the SPI statistics */
+static uint64_t adi_hal_time_us(void)
+{
+	struct no_os_time t = no_os_get_time();
+
+	return (uint64_t)t.s * 1000000 + t.us;
+}
+
+/*
+ * Follow the address ascension (CONFIG_A) and single instruction (CONFIG_B)
+ * settings so that writes are only streamed when the device accepts it
+ */
+static void adi_hal_spi_track_config(struct adi_hal *devHalData,
+				     uint16_t addr, uint8_t data)
+{
+	if (addr == ADIHAL_SPI_CONFIG_A)
+		devHalData->spi_stream = !(data & (ADIHAL_SPI_SOFT_RESET |
+						   ADIHAL_SPI_LSB_FIRST)) &&
+					 (data & ADIHAL_SPI_ADDR_ASCENSION) ==
+					 ADIHAL_SPI_ADDR_ASCENSION;
+	else if (addr == ADIHAL_SPI_CONFIG_B)
+		devHalData->spi_single_instr = data & ADIHAL_SPI_SINGLE_INSTR;
+}
+
+/* True if several registers can be accessed in one chip select frame */
+static bool adi_hal_spi_can_stream(struct adi_hal *devHalData)
+{
+	return devHalData->spi_stream && !devHalData->spi_single_instr;
+}
+
+/*
+ * Issue the queued messages as one chained transfer and, for reads, copy the
+ * received bytes back in the order of the address array.
+ */
+static adiHalErr_t adi_hal_spi_flush(struct adi_hal *devHalData,
+				     uint32_t nb_msgs, uint8_t *readdata)
+{
+	uint32_t i, j, n;
+	int32_t status;
+
+	if (!nb_msgs)
+		return ADIHAL_OK;
+
+	status = no_os_spi_transfer(devHalData->spi_adrv_desc, devHalData->spi_msgs,
+				    nb_msgs);
+	if (status != 0)
+		return ADIHAL_SPI_FAIL;
+
+	devHalData->spi_stats.transactions += nb_msgs;
+	for (i = 0, n = 0; i < nb_msgs; i++) {
+		for (j = ADIHAL_SPI_HDR_LEN;
+		     j < devHalData->spi_msgs[i].bytes_number; j++, n++)
+			if (readdata)
+				readdata[n] = devHalData->spi_msgs[i].rx_buff[j];
+	}
+	devHalData->spi_stats.bytes += n;
+
+	return ADIHAL_OK;
+}
+
+/*
+ * Pack consecutive accesses into SPI messages: one message per register, or
+ * one per run of ascending addresses when the device streams and is not in
+ * single instruction mode. The messages
+ * are sent in chunks, each with a single no_os_spi_transfer() call.
+ */
+static adiHalErr_t adi_hal_spi_burst(struct adi_hal *devHalData,
+				     uint16_t *addr, uint8_t *data,
+				     uint32_t count, bool read)
+{
+	struct no_os_spi_msg *msg = NULL;
+	uint8_t *buf = devHalData->spi_buf;
+	uint32_t nb_msgs = 0;
+	uint32_t first = 0;
+	uint32_t len = 0;
+	adiHalErr_t errVal;
+	uint32_t i;
+
+	for (i = 0; i < count; i++) {
+		if (msg && adi_hal_spi_can_stream(devHalData) &&
+		    addr[i] == addr[i - 1] + 1 &&
+		    len < ADIHAL_SPI_BURST_BYTES) {
+			msg->bytes_number++;
+		} else {
+			if (nb_msgs == ADIHAL_SPI_BURST_MSGS ||
+			    len + ADIHAL_SPI_HDR_LEN + 1 > ADIHAL_SPI_BURST_BYTES) {
+				errVal = adi_hal_spi_flush(devHalData, nb_msgs,
+							   read ? &data[first] : NULL);
+				if (errVal)
+					return errVal;
+
+				first = i;
+				nb_msgs = 0;
+				len = 0;
+			}
+
+			msg = &devHalData->spi_msgs[nb_msgs++];
+			msg->tx_buff = &buf[len];
+			msg->rx_buff = &buf[len];
+			msg->bytes_number = ADIHAL_SPI_HDR_LEN + 1;
+			msg->cs_change = 1;
+			msg->cs_change_delay = 0;
+			msg->cs_delay_first = 0;
+			msg->cs_delay_last = 0;
+
+			buf[len++] = (read ? ADIHAL_SPI_READ : 0) |
+				     ((addr[i] >> 8) & 0x7F);
+			buf[len++] = addr[i] & 0xFF;
+		}
+
+		buf[len++] = read ? 0x00 : data[i];
+
+		/* The streaming settings apply from the next frame on */
+		if (!read && (addr[i] == ADIHAL_SPI_CONFIG_A ||
+			      addr[i] == ADIHAL_SPI_CONFIG_B)) {
+			errVal = adi_hal_spi_flush(devHalData, nb_msgs, NULL);
+			if (errVal)
+				return errVal;
+
+			adi_hal_spi_track_config(devHalData, addr[i], data[i]);
+			first = i + 1;
+			nb_msgs = 0;
+			len = 0;
+			msg = NULL;
+		}
+	}
+
+	return adi_hal_spi_flush(devHalData, nb_msgs, read ? &data[first] : NULL);
+}
+
 adiHalErr_t ADIHAL_setTimeout(void *devHalInfo, uint32_t halTimeout_ms)
 {
 	return ADIHAL_OK;
@@ -107,6 +253,18 @@ adiHalErr_t ADIHAL_openHw(void *devHalInfo, uint32_t halTimeout_ms)
 
 	status |= no_os_spi_init(&dev_hal_data->spi_adrv_desc, &spi_param);
 
+	dev_hal_data->spi_msgs = no_os_calloc(ADIHAL_SPI_BURST_MSGS,
+					      sizeof(*dev_hal_data->spi_msgs));
+	dev_hal_data->spi_buf = no_os_calloc(ADIHAL_SPI_BURST_BYTES,
+					     sizeof(*dev_hal_data->spi_buf));
+	/* Without the burst storage, fall back to one access per frame */
+	dev_hal_data->spi_burst = dev_hal_data->spi_msgs && dev_hal_data->spi_buf;
+	dev_hal_data->spi_stream = false;
+	dev_hal_data->spi_single_instr = false;
+	dev_hal_data->spi_stats = (struct adi_hal_spi_stats) {
+		0
+	};
+
 	status |= no_os_gpio_get(&dev_hal_data->gpio_adrv_sysref_req,
 				 &gpio_adrv_sysref_req_param);
 
@@ -127,6 +285,12 @@ adiHalErr_t ADIHAL_closeHw(void *devHalInfo)
 
 	status |= no_os_spi_remove(dev_hal_data->spi_adrv_desc);
 
+	no_os_free(dev_hal_data->spi_msgs);
+	no_os_free(dev_hal_data->spi_buf);
+	dev_hal_data->spi_msgs = NULL;
+	dev_hal_data->spi_buf = NULL;
+	dev_hal_data->spi_burst = false;
+
 	if (status != 0)
 		return ADIHAL_ERR;
 	else
@@ -144,6 +308,10 @@ adiHalErr_t ADIHAL_resetHw(void *devHalInfo)
 	no_os_gpio_direction_output(devHalData->gpio_adrv_resetb, 1);
 	no_os_mdelay(10);
 
+	/* Back to the power-on SPI configuration */
+	devHalData->spi_stream = false;
+	devHalData->spi_single_instr = false;
+
 	return ADIHAL_OK;
 }
 
@@ -180,23 +348,37 @@ adiHalErr_t ADIHAL_spiWriteByte(void *devHalInfo,
 
 	if (status != 0)
 		return ADIHAL_SPI_FAIL;
-	else
-		return ADIHAL_OK;
+
+	adi_hal_spi_track_config(devHalData, addr, data);
+
+	return ADIHAL_OK;
 }
 
 adiHalErr_t ADIHAL_spiWriteBytes(void *devHalInfo,
 				 uint16_t *addr, uint8_t *data, uint32_t count)
 {
-	adiHalErr_t errVal;
+	struct adi_hal *devHalData = (struct adi_hal *)devHalInfo;
+	adiHalErr_t errVal = ADIHAL_OK;
+	uint64_t start;
 	uint32_t i;
 
-	for (i = 0; i < count; i++) {
-		errVal = ADIHAL_spiWriteByte(devHalInfo, addr[i], data[i]);
-		if (errVal)
-			return errVal;
+	start = adi_hal_time_us();
+
+	if (devHalData->spi_burst) {
+		errVal = adi_hal_spi_burst(devHalData, addr, data, count, false);
+	} else {
+		for (i = 0; i < count; i++) {
+			errVal = ADIHAL_spiWriteByte(devHalInfo, addr[i], data[i]);
+			if (errVal)
+				break;
+		}
+		devHalData->spi_stats.transactions += i;
+		devHalData->spi_stats.bytes += i;
 	}
 
-	return ADIHAL_OK;
+	devHalData->spi_stats.time_us += adi_hal_time_us() - start;
+
+	return errVal;
 }
 
 adiHalErr_t ADIHAL_spiReadByte(void *devHalInfo,
@@ -223,16 +405,28 @@ adiHalErr_t ADIHAL_spiReadByte(void *devHalInfo,
 adiHalErr_t ADIHAL_spiReadBytes(void *devHalInfo,
 				uint16_t *addr, uint8_t *readdata, uint32_t count)
 {
-	adiHalErr_t errVal;
+	struct adi_hal *devHalData = (struct adi_hal *)devHalInfo;
+	adiHalErr_t errVal = ADIHAL_OK;
+	uint64_t start;
 	uint32_t i;
 
-	for (i = 0; i < count; i++) {
-		errVal = ADIHAL_spiReadByte(devHalInfo, addr[i], &readdata[i]);
-		if (errVal)
-			return errVal;
+	start = adi_hal_time_us();
+
+	if (devHalData->spi_burst) {
+		errVal = adi_hal_spi_burst(devHalData, addr, readdata, count, true);
+	} else {
+		for (i = 0; i < count; i++) {
+			errVal = ADIHAL_spiReadByte(devHalInfo, addr[i], &readdata[i]);
+			if (errVal)
+				break;
+		}
+		devHalData->spi_stats.transactions += i;
+		devHalData->spi_stats.bytes += i;
 	}
 
-	return ADIHAL_OK;
+	devHalData->spi_stats.time_us += adi_hal_time_us() - start;
+
+	return errVal;
 }
 
 adiHalErr_t ADIHAL_spiWriteField(void *devHalInfo,
@@ -301,3 +495,30 @@ adiHalErr_t ADIHAL_setLogLevel(void *devHalInfo, uint16_t logLevel)
 
 	return ADIHAL_OK;
 }
+
+adiHalErr_t ADIHAL_getSpiStats(void *devHalInfo,
+			       struct adi_hal_spi_stats *stats)
+{
+	struct adi_hal *dev_hal_data = (struct adi_hal *)devHalInfo;
+
+	if (devHalInfo == NULL || stats == NULL)
+		return (ADIHAL_GEN_SW);
+
+	*stats = dev_hal_data->spi_stats;
+
+	return ADIHAL_OK;
+}
+
+adiHalErr_t ADIHAL_resetSpiStats(void *devHalInfo)
+{
+	struct adi_hal *dev_hal_data = (struct adi_hal *)devHalInfo;
+
+	if (devHalInfo == NULL)
+		return (ADIHAL_GEN_SW);
+
+	dev_hal_data->spi_stats = (struct adi_hal_spi_stats) {
+		0
+	};
+
+	return ADIHAL_OK;
+}
@@ -17,7 +17,9 @@ SRCS += $(DRIVERS)/api/no_os_uart.c     \
         $(NO-OS)/util/no_os_list.c      \
         $(NO-OS)/util/no_os_util.c      \
         $(NO-OS)/util/no_os_alloc.c     \
-        $(NO-OS)/util/no_os_mutex.c
+        $(NO-OS)/util/no_os_mutex.c     \
+        $(NO-OS)/util/no_os_sin_lut.c   \
+        $(NO-OS)/util/no_os_waveform.c
 
 INCS += $(INCLUDE)/no_os_delay.h     \
         $(INCLUDE)/no_os_error.h     \
@@ -29,7 +31,8 @@ INCS += $(INCLUDE)/no_os_delay.h     \
         $(INCLUDE)/no_os_uart.h      \
         $(INCLUDE)/no_os_util.h      \
         $(INCLUDE)/no_os_alloc.h     \
-        $(INCLUDE)/no_os_mutex.h
+        $(INCLUDE)/no_os_mutex.h     \
+        $(INCLUDE)/no_os_waveform.h
 
 INCS += $(DRIVERS)/adc/adc_demo/adc_demo.h \
         $(DRIVERS)/dac/dac_demo/dac_demo.h
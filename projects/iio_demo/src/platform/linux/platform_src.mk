@@ -16,8 +16,14 @@ SRCS += $(NO-OS)/util/no_os_circular_buffer.c
 INCS += $(INCLUDE)/no_os_circular_buffer.h
 
 SRCS += $(DRIVERS)/platform/linux/linux_uart.c \
+	$(DRIVERS)/api/no_os_irq.c \
+	$(DRIVERS)/platform/linux/linux_gpio_cdev.c \
+	$(DRIVERS)/platform/linux/linux_gpio_irq.c \
 	$(DRIVERS)/platform/linux/linux_delay.c
 
+INCS += $(DRIVERS)/platform/linux/linux_gpio.h \
+	$(DRIVERS)/platform/linux/linux_gpio_irq.h
+
 
 INCS += $(INCLUDE)/no_os_gpio.h \
 	$(INCLUDE)/no_os_trng.h		
@@ -0,0 +1,51 @@
+SRCS += $(PROJECT)/src/platform/$(PLATFORM)/main.c
+
+INCS += $(PROJECT)/src/common/common_data.h
+SRCS += $(PROJECT)/src/common/common_data.c
+
+INCS += $(INCLUDE)/no_os_delay.h		\
+		$(INCLUDE)/no_os_error.h	\
+		$(INCLUDE)/no_os_gpio.h		\
+		$(INCLUDE)/no_os_i2c.h		\
+		$(INCLUDE)/no_os_alloc.h	\
+		$(INCLUDE)/no_os_print_log.h	\
+		$(INCLUDE)/no_os_spi.h		\
+		$(INCLUDE)/no_os_crc8.h		\
+		$(INCLUDE)/no_os_util.h		\
+		$(INCLUDE)/no_os_units.h	\
+		$(INCLUDE)/no_os_mutex.h
+
+SRCS += $(DRIVERS)/api/no_os_gpio.c		\
+		$(DRIVERS)/api/no_os_i2c.c	\
+		$(DRIVERS)/api/no_os_spi.c	\
+		$(NO-OS)/util/no_os_alloc.c	\
+		$(NO-OS)/util/no_os_crc8.c	\
+		$(NO-OS)/util/no_os_util.c	\
+		$(NO-OS)/util/no_os_mutex.c
+
+SRCS += $(DRIVERS)/platform/linux/linux_delay.c
+
+INCS += $(DRIVERS)/platform/sim/sim_device.h	\
+		$(DRIVERS)/platform/sim/sim_gpio.h	\
+		$(DRIVERS)/platform/sim/sim_i2c.h	\
+		$(DRIVERS)/platform/sim/sim_models.h	\
+		$(DRIVERS)/platform/sim/sim_spi.h
+SRCS += $(DRIVERS)/platform/sim/sim_device.c	\
+		$(DRIVERS)/platform/sim/sim_gpio.c	\
+		$(DRIVERS)/platform/sim/sim_i2c.c	\
+		$(DRIVERS)/platform/sim/sim_spi.c	\
+		$(DRIVERS)/platform/sim/sim_ad7124.c	\
+		$(DRIVERS)/platform/sim/sim_ad74413r.c	\
+		$(DRIVERS)/platform/sim/sim_adin1110.c	\
+		$(DRIVERS)/platform/sim/sim_adxl367.c
+
+INCS += $(DRIVERS)/adc/ad7124/ad7124.h		\
+		$(DRIVERS)/adc/ad7124/ad7124_regs.h	\
+		$(DRIVERS)/accel/adxl367/adxl367.h	\
+		$(DRIVERS)/adc-dac/ad74413r/ad74413r.h	\
+		$(DRIVERS)/net/adin1110/adin1110.h
+SRCS += $(DRIVERS)/adc/ad7124/ad7124.c		\
+		$(DRIVERS)/adc/ad7124/ad7124_regs.c	\
+		$(DRIVERS)/accel/adxl367/adxl367.c	\
+		$(DRIVERS)/adc-dac/ad74413r/ad74413r.c	\
+		$(DRIVERS)/net/adin1110/adin1110.c
@@ -0,0 +1,123 @@
+/***************************************************************************//**
+ *   @file   common_data.c
+ *   @brief  Defines common data to be used by the simulation benchmarks.
+********************************************************************************
+ * Copyright 2023(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include "common_data.h"
+#include "ad7124_regs.h"
+
+struct sim_spi_init_param sim_ad7124_spi_extra = {
+	.cs_setup_ns = SIM_SPI_CS_SETUP_NS,
+	.cs_hold_ns = SIM_SPI_CS_HOLD_NS,
+};
+
+struct sim_spi_init_param sim_adxl367_spi_extra = {
+	.cs_setup_ns = SIM_SPI_CS_SETUP_NS,
+	.cs_hold_ns = SIM_SPI_CS_HOLD_NS,
+};
+
+struct sim_spi_init_param sim_ad74413r_spi_extra = {
+	.cs_setup_ns = SIM_SPI_CS_SETUP_NS,
+	.cs_hold_ns = SIM_SPI_CS_HOLD_NS,
+};
+
+struct sim_spi_init_param sim_adin1110_spi_extra = {
+	.cs_setup_ns = SIM_SPI_CS_SETUP_NS,
+	.cs_hold_ns = SIM_SPI_CS_HOLD_NS,
+};
+
+struct no_os_spi_init_param sim_ad7124_spi_ip = {
+	.device_id = 0,
+	.max_speed_hz = SIM_SPI_BAUDRATE,
+	.chip_select = 0,
+	.mode = NO_OS_SPI_MODE_3,
+	.bit_order = NO_OS_SPI_BIT_ORDER_MSB_FIRST,
+	.platform_ops = &sim_spi_ops,
+	.extra = &sim_ad7124_spi_extra,
+};
+
+struct ad7124_init_param sim_ad7124_ip = {
+	.spi_init = &sim_ad7124_spi_ip,
+	.regs = ad7124_regs,
+	.check_ready = 1,
+	.spi_rdy_poll_cnt = 25000,
+	.active_device = ID_AD7124_4,
+};
+
+struct adxl367_init_param sim_adxl367_ip = {
+	.comm_type = ADXL367_SPI_COMM,
+	.spi_init = {
+		.device_id = 0,
+		.max_speed_hz = SIM_SPI_BAUDRATE,
+		.chip_select = 1,
+		.mode = NO_OS_SPI_MODE_0,
+		.bit_order = NO_OS_SPI_BIT_ORDER_MSB_FIRST,
+		.platform_ops = &sim_spi_ops,
+		.extra = &sim_adxl367_spi_extra,
+	},
+};
+
+struct ad74413r_init_param sim_ad74413r_ip = {
+	.chip_id = AD74413R,
+	.comm_param = {
+		.device_id = 0,
+		.max_speed_hz = SIM_SPI_BAUDRATE,
+		.chip_select = 2,
+		.mode = NO_OS_SPI_MODE_1,
+		.bit_order = NO_OS_SPI_BIT_ORDER_MSB_FIRST,
+		.platform_ops = &sim_spi_ops,
+		.extra = &sim_ad74413r_spi_extra,
+	},
+};
+
+struct adin1110_init_param sim_adin1110_ip = {
+	.chip_type = ADIN1110,
+	.comm_param = {
+		.device_id = 0,
+		.max_speed_hz = SIM_SPI_BAUDRATE,
+		.chip_select = 3,
+		.mode = NO_OS_SPI_MODE_0,
+		.bit_order = NO_OS_SPI_BIT_ORDER_MSB_FIRST,
+		.platform_ops = &sim_spi_ops,
+		.extra = &sim_adin1110_spi_extra,
+	},
+	.reset_param = {
+		.number = -1,
+		.platform_ops = &sim_gpio_ops,
+	},
+	.mac_address = { 0x00, 0x18, 0x80, 0x03, 0x25, 0x60 },
+	.append_crc = true,
+};
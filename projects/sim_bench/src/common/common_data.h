@@ -0,0 +1,66 @@
+/***************************************************************************//**
+ *   @file   common_data.h
+ *   @brief  Defines common data to be used by the simulation benchmarks.
+********************************************************************************
+ * Copyright 2023(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef __COMMON_DATA_H__
+#define __COMMON_DATA_H__
+
+#include "no_os_spi.h"
+#include "no_os_gpio.h"
+#include "sim_spi.h"
+#include "sim_gpio.h"
+#include "ad7124.h"
+#include "adxl367.h"
+#include "ad74413r.h"
+#include "adin1110.h"
+
+/* SCLK rate and CS delays the benchmarks are modelled with */
+#define SIM_SPI_BAUDRATE	10000000
+#define SIM_SPI_CS_SETUP_NS	100
+#define SIM_SPI_CS_HOLD_NS	100
+
+extern struct sim_spi_init_param sim_ad7124_spi_extra;
+extern struct sim_spi_init_param sim_adxl367_spi_extra;
+extern struct sim_spi_init_param sim_ad74413r_spi_extra;
+extern struct sim_spi_init_param sim_adin1110_spi_extra;
+
+extern struct no_os_spi_init_param sim_ad7124_spi_ip;
+extern struct ad7124_init_param sim_ad7124_ip;
+extern struct adxl367_init_param sim_adxl367_ip;
+extern struct ad74413r_init_param sim_ad74413r_ip;
+extern struct adin1110_init_param sim_adin1110_ip;
+
+#endif /* __COMMON_DATA_H__ */
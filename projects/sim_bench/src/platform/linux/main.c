@@ -0,0 +1,337 @@
+/***************************************************************************//**
+ *   @file   main.c
+ *   @brief  Hardware-free driver benchmarks on the simulated SPI bus.
+********************************************************************************
+ * Copyright 2023(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "common_data.h"
+#include "sim_device.h"
+#include "sim_models.h"
+#include "sim_spi.h"
+#include "no_os_error.h"
+
+#define SIM_BENCH_ITERATIONS	1000
+#define SIM_BENCH_FIFO_SETS	128
+#define SIM_BENCH_PAYLOAD_LEN	256
+#define SIM_BENCH_FRAME_BURST	4
+
+/***************************************************************************//**
+ * @brief Monotonic host time.
+ *
+ * @return Time in nanoseconds.
+*******************************************************************************/
+static uint64_t sim_bench_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/***************************************************************************//**
+ * @brief Print the bus and host cost of one benchmark.
+ *
+ * @param part    - Part name.
+ * @param op      - Benchmarked operation.
+ * @param nb_ops  - Number of operations executed.
+ * @param host_ns - Host time spent.
+ * @param spi     - SPI descriptor the operations went through.
+*******************************************************************************/
+static void sim_bench_report(const char *part, const char *op, uint32_t nb_ops,
+			     uint64_t host_ns, struct no_os_spi_desc *spi)
+{
+	struct sim_bus_stats stats;
+
+	sim_spi_get_stats(spi, &stats);
+
+	printf("%-9s %-16s %5u ops: %7llu frames %9llu bytes, "
+	       "bus %9.2f us/op, host %7.2f us/op\n",
+	       part, op, nb_ops, (unsigned long long)stats.frames,
+	       (unsigned long long)stats.bytes,
+	       stats.bus_time_ns / 1000.0 / nb_ops, host_ns / 1000.0 / nb_ops);
+}
+
+/***************************************************************************//**
+ * @brief AD7124: conversion polling and data register reads.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+static int sim_bench_ad7124(void)
+{
+	struct sim_ad7124_param param = {
+		.id = AD7124_4_ID,
+	};
+	struct sim_device *sdev;
+	struct ad7124_dev *dev;
+	uint64_t start;
+	int32_t sample;
+	uint32_t i;
+	int ret;
+
+	ret = sim_device_init(&sdev, &sim_ad7124_model, &param);
+	if (ret)
+		return ret;
+
+	sim_ad7124_spi_extra.device = sdev;
+	ret = ad7124_setup(&dev, &sim_ad7124_ip);
+	if (ret)
+		goto free_sdev;
+
+	sim_spi_reset_stats(dev->spi_desc);
+	start = sim_bench_time_ns();
+	for (i = 0; i < SIM_BENCH_ITERATIONS; i++) {
+		ret = ad7124_wait_for_conv_ready(dev, dev->spi_rdy_poll_cnt);
+		if (ret)
+			goto free_dev;
+
+		ret = ad7124_read_data(dev, &sample);
+		if (ret)
+			goto free_dev;
+	}
+	sim_bench_report("ad7124", "read_data", SIM_BENCH_ITERATIONS,
+			 sim_bench_time_ns() - start, dev->spi_desc);
+
+free_dev:
+	ad7124_remove(dev);
+free_sdev:
+	sim_device_remove(sdev);
+
+	return ret;
+}
+
+/***************************************************************************//**
+ * @brief ADXL367: FIFO watermark reads.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+static int sim_bench_adxl367(void)
+{
+	int16_t x[SIM_BENCH_FIFO_SETS], y[SIM_BENCH_FIFO_SETS],
+		z[SIM_BENCH_FIFO_SETS];
+	struct sim_device *sdev;
+	struct adxl367_dev *dev;
+	uint16_t entries;
+	uint64_t start;
+	uint32_t i;
+	int ret;
+
+	ret = sim_device_init(&sdev, &sim_adxl367_model, NULL);
+	if (ret)
+		return ret;
+
+	sim_adxl367_spi_extra.device = sdev;
+	ret = adxl367_init(&dev, sim_adxl367_ip);
+	if (ret)
+		goto free_sdev;
+
+	ret = adxl367_fifo_setup(dev, ADXL367_STREAM_MODE,
+				 ADXL367_FIFO_FORMAT_XYZ, SIM_BENCH_FIFO_SETS);
+	if (ret)
+		goto free_dev;
+
+	ret = adxl367_set_power_mode(dev, ADXL367_OP_MEASURE);
+	if (ret)
+		goto free_dev;
+
+	sim_spi_reset_stats(dev->spi_desc);
+	start = sim_bench_time_ns();
+	for (i = 0; i < SIM_BENCH_ITERATIONS; i++) {
+		ret = adxl367_read_raw_fifo(dev, x, y, z, NULL, &entries);
+		if (ret)
+			goto free_dev;
+	}
+	sim_bench_report("adxl367", "read_raw_fifo", SIM_BENCH_ITERATIONS,
+			 sim_bench_time_ns() - start, dev->spi_desc);
+
+free_dev:
+	adxl367_remove(dev);
+free_sdev:
+	sim_device_remove(sdev);
+
+	return ret;
+}
+
+/***************************************************************************//**
+ * @brief AD74413R: ADC result register reads.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+static int sim_bench_ad74413r(void)
+{
+	struct sim_device *sdev;
+	struct ad74413r_desc *desc;
+	uint64_t start;
+	uint16_t val;
+	uint32_t i;
+	int ret;
+
+	ret = sim_device_init(&sdev, &sim_ad74413r_model, NULL);
+	if (ret)
+		return ret;
+
+	sim_ad74413r_spi_extra.device = sdev;
+	ret = ad74413r_init(&desc, &sim_ad74413r_ip);
+	if (ret)
+		goto free_sdev;
+
+	sim_spi_reset_stats(desc->comm_desc);
+	start = sim_bench_time_ns();
+	for (i = 0; i < SIM_BENCH_ITERATIONS; i++) {
+		ret = ad74413r_get_raw_adc_result(desc, i % AD74413R_N_CHANNELS,
+						  &val);
+		if (ret)
+			goto free_desc;
+	}
+	sim_bench_report("ad74413r", "get_raw_adc", SIM_BENCH_ITERATIONS,
+			 sim_bench_time_ns() - start, desc->comm_desc);
+
+free_desc:
+	ad74413r_remove(desc);
+free_sdev:
+	sim_device_remove(sdev);
+
+	return ret;
+}
+
+/***************************************************************************//**
+ * @brief ADIN1110: frame write and read back through the model loopback.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+static int sim_bench_adin1110(void)
+{
+	struct sim_adin1110_param param = {
+		.phy_id = ADIN1110_PHY_ID,
+		.crc = true,
+		.loopback = true,
+	};
+	uint8_t tx_payload[SIM_BENCH_PAYLOAD_LEN];
+	uint8_t rx_payload[ADIN1110_BUFF_LEN];
+	struct adin1110_eth_buff tx_buff = {
+		.len = SIM_BENCH_PAYLOAD_LEN + ADIN1110_ETH_HDR_LEN,
+		.mac_dest = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF },
+		.ethertype = { 0x88, 0xB5 },
+		.payload = tx_payload,
+	};
+	struct adin1110_eth_buff rx_buff = {
+		.payload = rx_payload,
+	};
+	struct adin1110_desc *desc;
+	struct sim_device *sdev;
+	uint64_t start;
+	uint32_t i, j;
+	int ret;
+
+	memset(tx_payload, 0xA5, sizeof(tx_payload));
+	memcpy(tx_buff.mac_source, sim_adin1110_ip.mac_address,
+	       ADIN1110_ETH_ALEN);
+
+	ret = sim_device_init(&sdev, &sim_adin1110_model, &param);
+	if (ret)
+		return ret;
+
+	sim_adin1110_spi_extra.device = sdev;
+	ret = adin1110_init(&desc, &sim_adin1110_ip);
+	if (ret)
+		goto free_sdev;
+
+	sim_spi_reset_stats(desc->comm_desc);
+	start = sim_bench_time_ns();
+	for (i = 0; i < SIM_BENCH_ITERATIONS; i += SIM_BENCH_FRAME_BURST) {
+		for (j = 0; j < SIM_BENCH_FRAME_BURST; j++) {
+			ret = adin1110_write_fifo(desc, 0, &tx_buff);
+			if (ret)
+				goto free_desc;
+		}
+
+		for (j = 0; j < SIM_BENCH_FRAME_BURST; j++) {
+			ret = adin1110_read_fifo(desc, 0, &rx_buff);
+			if (ret)
+				goto free_desc;
+
+			if (rx_buff.len != tx_buff.len ||
+			    memcmp(rx_payload, tx_payload, SIM_BENCH_PAYLOAD_LEN)) {
+				ret = -EIO;
+				goto free_desc;
+			}
+		}
+	}
+	sim_bench_report("adin1110", "frame_loopback", SIM_BENCH_ITERATIONS,
+			 sim_bench_time_ns() - start, desc->comm_desc);
+
+free_desc:
+	adin1110_remove(desc);
+free_sdev:
+	sim_device_remove(sdev);
+
+	return ret;
+}
+
+/***************************************************************************//**
+ * @brief Main function execution for the Linux platform.
+ *
+ * @return ret - Result of the benchmarks execution.
+*******************************************************************************/
+int main()
+{
+	int ret;
+
+	ret = sim_bench_ad7124();
+	if (ret)
+		goto error;
+
+	ret = sim_bench_adxl367();
+	if (ret)
+		goto error;
+
+	ret = sim_bench_ad74413r();
+	if (ret)
+		goto error;
+
+	ret = sim_bench_adin1110();
+	if (ret)
+		goto error;
+
+	return 0;
+
+error:
+	printf("Benchmark failed: %d\n", ret);
+
+	return ret;
+}
@@ -0,0 +1,435 @@
+/***************************************************************************//**
+ *   @file   test_iio_direct.c
+ *   @brief  Unit tests of the iio direct client API.
+********************************************************************************
+ * Copyright 2023(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "iio.h"
+#include "iiod.h"
+#include "iio_val.h"
+#include "no_os_alloc.h"
+#include "no_os_circular_buffer.h"
+#include "no_os_list.h"
+#include "no_os_util.h"
+#include "mock_no_os_delay.h"
+#include "mock_no_os_uart.h"
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define TEST_SAMPLES		4
+/* Circular buffer of several times the size of the opened buffer */
+#define TEST_RAW_BUF_LEN	(TEST_SAMPLES * sizeof(uint16_t) * 4)
+
+struct test_dev {
+	int32_t gain;
+	int32_t offset[2];
+	uint16_t next;
+	uint32_t mask;
+};
+
+static struct test_dev test_dev;
+static struct iio_desc *desc;
+static int8_t raw_buf[TEST_RAW_BUF_LEN];
+static char backend_buf[64];
+
+/*******************************************************************************
+ *    TEST DEVICE
+ ******************************************************************************/
+
+static int test_local_read(void *conn, uint8_t *buf, uint32_t len)
+{
+	return -EAGAIN;
+}
+
+static int test_local_write(void *conn, uint8_t *buf, uint32_t len)
+{
+	return len;
+}
+
+static int test_gain_show(void *device, char *buf, uint32_t len,
+			  const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct test_dev *dev = device;
+
+	return iio_format_value(buf, len, IIO_VAL_INT, 1, &dev->gain);
+}
+
+static int test_gain_store(void *device, char *buf, uint32_t len,
+			   const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct test_dev *dev = device;
+
+	return iio_parse_value(buf, IIO_VAL_INT, &dev->gain, NULL);
+}
+
+static int test_offset_show(void *device, char *buf, uint32_t len,
+			    const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct test_dev *dev = device;
+
+	return iio_format_value(buf, len, IIO_VAL_INT, 1,
+				&dev->offset[channel->ch_num]);
+}
+
+static int test_offset_store(void *device, char *buf, uint32_t len,
+			     const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct test_dev *dev = device;
+
+	return iio_parse_value(buf, IIO_VAL_INT, &dev->offset[channel->ch_num],
+			       NULL);
+}
+
+static int32_t test_pre_enable(void *device, uint32_t mask)
+{
+	struct test_dev *dev = device;
+
+	dev->mask = mask;
+
+	return 0;
+}
+
+static int32_t test_read_dev(void *device, void *buff, uint32_t nb_samples)
+{
+	struct test_dev *dev = device;
+	uint16_t *data = buff;
+	uint32_t i;
+
+	for (i = 0; i < nb_samples; i++)
+		data[i] = dev->next++;
+
+	return nb_samples;
+}
+
+static int32_t test_write_dev(void *device, void *buff, uint32_t nb_samples)
+{
+	return nb_samples;
+}
+
+static struct scan_type test_scan_type = {
+	.sign = 'u',
+	.realbits = 16,
+	.storagebits = 16,
+};
+
+static struct iio_attribute test_ch_attrs[] = {
+	{
+		.name = "offset",
+		.show = test_offset_show,
+		.store = test_offset_store,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+static struct iio_attribute test_dev_attrs[] = {
+	{
+		.name = "gain",
+		.show = test_gain_show,
+		.store = test_gain_store,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+static struct iio_attribute test_debug_attrs[] = {
+	{
+		.name = "debug_gain",
+		.show = test_gain_show,
+		.store = test_gain_store,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+static struct iio_channel test_channels[] = {
+	{
+		.name = "voltage0",
+		.ch_type = IIO_VOLTAGE,
+		.channel = 0,
+		.scan_index = 0,
+		.scan_type = &test_scan_type,
+		.attributes = test_ch_attrs,
+		.indexed = true,
+	},
+	{
+		.name = "voltage1",
+		.ch_type = IIO_VOLTAGE,
+		.channel = 1,
+		.scan_index = 1,
+		.scan_type = &test_scan_type,
+		.attributes = test_ch_attrs,
+		.indexed = true,
+	},
+	{
+		.name = "voltage0",
+		.ch_type = IIO_VOLTAGE,
+		.channel = 0,
+		.scan_index = 0,
+		.scan_type = &test_scan_type,
+		.indexed = true,
+		.ch_out = true,
+	},
+};
+
+static struct iio_device test_descriptor = {
+	.num_ch = NO_OS_ARRAY_SIZE(test_channels),
+	.channels = test_channels,
+	.attributes = test_dev_attrs,
+	.debug_attributes = test_debug_attrs,
+	.pre_enable = test_pre_enable,
+	.read_dev = test_read_dev,
+	.write_dev = test_write_dev,
+};
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	struct iio_local_backend backend = {
+		.local_backend_event_read = test_local_read,
+		.local_backend_event_write = test_local_write,
+		.local_backend_buff = backend_buf,
+		.local_backend_buff_len = sizeof(backend_buf),
+	};
+	struct iio_device_init devs[] = {
+		{
+			.name = "test_dev",
+			.dev = &test_dev,
+			.dev_descriptor = &test_descriptor,
+			.raw_buf = raw_buf,
+			.raw_buf_len = sizeof(raw_buf),
+		},
+	};
+	struct iio_init_param init_param = {
+		.phy_type = USE_LOCAL_BACKEND,
+		.local_backend = &backend,
+		.devs = devs,
+		.nb_devs = NO_OS_ARRAY_SIZE(devs),
+	};
+
+	memset(&test_dev, 0, sizeof(test_dev));
+	TEST_ASSERT_EQUAL_INT(0, iio_init(&desc, &init_param));
+}
+
+void tearDown(void)
+{
+	iio_remove(desc);
+	desc = NULL;
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_iio_direct_get_device(void)
+{
+	TEST_ASSERT_EQUAL_INT(0, iio_direct_get_device(desc, "test_dev"));
+	TEST_ASSERT_EQUAL_INT(0, iio_direct_get_device(desc, "iio:device0"));
+	TEST_ASSERT_EQUAL_INT(-ENODEV, iio_direct_get_device(desc, "missing"));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, iio_direct_get_device(desc, NULL));
+}
+
+void test_iio_direct_get_channel(void)
+{
+	TEST_ASSERT_EQUAL_INT(0, iio_direct_get_channel(desc, 0, "voltage0",
+			      false));
+	TEST_ASSERT_EQUAL_INT(1, iio_direct_get_channel(desc, 0, "voltage1",
+			      false));
+	TEST_ASSERT_EQUAL_INT(2, iio_direct_get_channel(desc, 0, "voltage0",
+			      true));
+	TEST_ASSERT_EQUAL_INT(-ENOENT, iio_direct_get_channel(desc, 0,
+			      "voltage1", true));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, iio_direct_get_channel(desc, 1,
+			      "voltage0", false));
+}
+
+void test_iio_direct_attr(void)
+{
+	struct iio_attr_handle attr;
+	char buf[16];
+	int32_t val;
+
+	TEST_ASSERT_EQUAL_INT(0, iio_direct_get_attr(desc, 0, -1, "gain",
+			      &attr));
+	val = 42;
+	TEST_ASSERT_EQUAL_INT(0, iio_direct_attr_set(&attr, IIO_VAL_INT, 1,
+			      &val));
+	TEST_ASSERT_EQUAL_INT32(42, test_dev.gain);
+	TEST_ASSERT_EQUAL_INT(2, iio_direct_attr_read(&attr, buf, sizeof(buf)));
+	TEST_ASSERT_EQUAL_STRING("42", buf);
+
+	strcpy(buf, "-7");
+	TEST_ASSERT_EQUAL_INT(0, iio_direct_attr_write(&attr, buf,
+			      strlen(buf)));
+	val = 0;
+	TEST_ASSERT_EQUAL_INT(1, iio_direct_attr_get(&attr, IIO_VAL_INT, 1,
+			      &val));
+	TEST_ASSERT_EQUAL_INT32(-7, val);
+
+	TEST_ASSERT_EQUAL_INT(0, iio_direct_get_debug_attr(desc, 0,
+			      "debug_gain", &attr));
+	TEST_ASSERT_EQUAL_INT(1, iio_direct_attr_get(&attr, IIO_VAL_INT, 1,
+			      &val));
+	TEST_ASSERT_EQUAL_INT32(-7, val);
+
+	TEST_ASSERT_EQUAL_INT(-ENOENT, iio_direct_get_attr(desc, 0, -1,
+			      "missing", &attr));
+	TEST_ASSERT_EQUAL_INT(-ENOENT, iio_direct_get_buffer_attr(desc, 0,
+			      "gain", &attr));
+}
+
+void test_iio_direct_channel_attr(void)
+{
+	struct iio_attr_handle attr;
+	int32_t val = 5;
+
+	TEST_ASSERT_EQUAL_INT(0, iio_direct_get_attr(desc, 0, 1, "offset",
+			      &attr));
+	TEST_ASSERT_EQUAL_INT(0, iio_direct_attr_set(&attr, IIO_VAL_INT, 1,
+			      &val));
+	TEST_ASSERT_EQUAL_INT32(0, test_dev.offset[0]);
+	TEST_ASSERT_EQUAL_INT32(5, test_dev.offset[1]);
+
+	TEST_ASSERT_EQUAL_INT(-ENOENT, iio_direct_get_attr(desc, 0, 2, "offset",
+			      &attr));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, iio_direct_get_attr(desc, 0, 3, "offset",
+			      &attr));
+}
+
+void test_iio_direct_buffer_read(void)
+{
+	uint32_t mask = NO_OS_BIT(0);
+	uint16_t data[TEST_SAMPLES];
+	uint32_t i;
+
+	TEST_ASSERT_EQUAL_INT(0, iio_direct_buffer_open(desc, 0, TEST_SAMPLES,
+			      &mask, 1, IIO_DIRECTION_INPUT, false));
+	TEST_ASSERT_EQUAL_UINT32(mask, test_dev.mask);
+	TEST_ASSERT_EQUAL_UINT32(sizeof(uint16_t),
+				 iio_direct_get_buffer(desc, 0)->bytes_per_scan);
+
+	TEST_ASSERT_EQUAL_INT(sizeof(data), iio_direct_buffer_refill(desc, 0));
+	TEST_ASSERT_EQUAL_INT(sizeof(data), iio_direct_buffer_read(desc, 0, data,
+			      sizeof(data)));
+	for (i = 0; i < TEST_SAMPLES; i++)
+		TEST_ASSERT_EQUAL_UINT16(i, data[i]);
+	TEST_ASSERT_EQUAL_INT(-EAGAIN, iio_direct_buffer_read(desc, 0, data,
+			      sizeof(data)));
+
+	TEST_ASSERT_EQUAL_INT(0, iio_direct_buffer_close(desc, 0));
+}
+
+void test_iio_direct_buffer_get_block(void)
+{
+	uint32_t mask = NO_OS_BIT(0);
+	uint16_t *block;
+	uint32_t bytes;
+	uint32_t i;
+
+	TEST_ASSERT_EQUAL_INT(0, iio_direct_buffer_open(desc, 0, TEST_SAMPLES,
+			      &mask, 1, IIO_DIRECTION_INPUT, false));
+	TEST_ASSERT_EQUAL_INT(-EAGAIN, iio_direct_buffer_get_block(desc, 0,
+			      (void **)&block, &bytes));
+
+	/* Blocks span all the captures held by the circular buffer */
+	for (i = 0; i < 3; i++)
+		TEST_ASSERT_GREATER_THAN(0, iio_direct_buffer_refill(desc, 0));
+	TEST_ASSERT_EQUAL_INT(0, iio_direct_buffer_get_block(desc, 0,
+			      (void **)&block, &bytes));
+	TEST_ASSERT_EQUAL_UINT32(3 * TEST_SAMPLES * sizeof(uint16_t), bytes);
+	for (i = 0; i < 3 * TEST_SAMPLES; i++)
+		TEST_ASSERT_EQUAL_UINT16(i, block[i]);
+	TEST_ASSERT_EQUAL_INT(0, iio_direct_buffer_block_done(desc, 0));
+	TEST_ASSERT_EQUAL_INT(-EAGAIN, iio_direct_buffer_get_block(desc, 0,
+			      (void **)&block, &bytes));
+
+	TEST_ASSERT_EQUAL_INT(0, iio_direct_buffer_close(desc, 0));
+}
+
+void test_iio_direct_buffer_write(void)
+{
+	uint32_t mask = NO_OS_BIT(2);
+	uint16_t data[TEST_SAMPLES] = {1, 2, 3, 4};
+	uint16_t *block;
+	uint32_t bytes;
+
+	TEST_ASSERT_EQUAL_INT(0, iio_direct_buffer_open(desc, 0, TEST_SAMPLES,
+			      &mask, 1, IIO_DIRECTION_OUTPUT, false));
+
+	/* The whole circular buffer is free */
+	TEST_ASSERT_EQUAL_INT(0, iio_direct_buffer_get_block(desc, 0,
+			      (void **)&block, &bytes));
+	TEST_ASSERT_EQUAL_UINT32(TEST_RAW_BUF_LEN, bytes);
+	memset(block, 0, bytes);
+	TEST_ASSERT_EQUAL_INT(0, iio_direct_buffer_block_done(desc, 0));
+	TEST_ASSERT_EQUAL_INT(-EAGAIN, iio_direct_buffer_get_block(desc, 0,
+			      (void **)&block, &bytes));
+
+	TEST_ASSERT_EQUAL_INT(0, iio_direct_buffer_push(desc, 0));
+	TEST_ASSERT_EQUAL_INT(sizeof(data), iio_direct_buffer_write(desc, 0,
+			      data, sizeof(data)));
+
+	TEST_ASSERT_EQUAL_INT(0, iio_direct_buffer_close(desc, 0));
+}
+
+void test_iio_direct_invalid(void)
+{
+	uint32_t mask = NO_OS_BIT(0);
+	void *block;
+	uint32_t bytes;
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, iio_direct_buffer_open(desc, 1,
+			      TEST_SAMPLES, &mask, 1, IIO_DIRECTION_INPUT,
+			      false));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, iio_direct_buffer_open(desc, 0,
+			      TEST_SAMPLES, NULL, 1, IIO_DIRECTION_INPUT,
+			      false));
+	TEST_ASSERT_NULL(iio_direct_get_buffer(desc, 1));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, iio_direct_buffer_get_block(desc, 1,
+			      &block, &bytes));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, iio_direct_buffer_block_done(desc, 1));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, iio_direct_buffer_refill(desc, 1));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, iio_direct_buffer_close(desc, -1));
+}
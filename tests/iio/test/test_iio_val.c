@@ -0,0 +1,513 @@
+/***************************************************************************//**
+ *   @file   test_iio_val.c
+ *   @brief  Conformance and speed tests of the iio value formatter and parser.
+********************************************************************************
+ * Copyright 2023(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "iio_val.h"
+#include "no_os_util.h"
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define TEST_ITERATIONS		20000
+#define SPEED_ITERATIONS	200000
+
+static uint32_t seed;
+
+/*******************************************************************************
+ *    REFERENCE IMPLEMENTATION
+ ******************************************************************************/
+
+/*
+ * snprintf/strtok based implementation iio_val.c replaced, kept as reference
+ * for the output format.
+ */
+static int ref_format_value(char *buf, uint32_t len, enum iio_val fmt,
+			    int32_t size, int32_t *vals)
+{
+	int64_t tmp;
+	int32_t integer, fractional;
+	bool dB = false;
+	int32_t i = 0;
+	uint32_t l = 0;
+
+	switch (fmt) {
+	case IIO_VAL_INT:
+		return snprintf(buf, len, "%"PRIi32"", vals[0]);
+	case IIO_VAL_INT_PLUS_MICRO_DB:
+		dB = true;
+	/* intentional fall through */
+	case IIO_VAL_INT_PLUS_MICRO:
+		return snprintf(buf, len, "%"PRIi32".%06"PRIu32"%s", vals[0],
+				(uint32_t)vals[1], dB ? " dB" : "");
+	case IIO_VAL_INT_PLUS_NANO:
+		return snprintf(buf, len, "%"PRIi32".%09"PRIu32"", vals[0],
+				(uint32_t)vals[1]);
+	case IIO_VAL_FRACTIONAL:
+		tmp = no_os_div_s64((int64_t)vals[0] * 1000000000LL, vals[1]);
+		fractional = vals[1];
+		integer = (int32_t)no_os_div_s64_rem(tmp, 1000000000, &fractional);
+
+		if (integer == 0 && fractional < 0)
+			return snprintf(buf, len, "-0.%09u", abs(fractional));
+
+		return snprintf(buf, len, "%"PRIi32".%09u", integer,
+				abs(fractional));
+	case IIO_VAL_FRACTIONAL_LOG2:
+		tmp = no_os_shift_right((int64_t)vals[0] * 1000000000LL, vals[1]);
+		integer = (int32_t)no_os_div_s64_rem(tmp, 1000000000LL, &fractional);
+
+		if (integer == 0 && fractional < 0)
+			return snprintf(buf, len, "-0.%09u", abs(fractional));
+
+		return snprintf(buf, len, "%"PRIi32".%09u", integer,
+				abs(fractional));
+	case IIO_VAL_INT_MULTIPLE:
+		while (i < size) {
+			l += snprintf(&buf[l], len - l, "%"PRIi32" ", vals[i]);
+			if (l >= len)
+				break;
+			i++;
+		}
+		return l;
+	case IIO_VAL_CHAR:
+		return snprintf(buf, len, "%c", (char)vals[0]);
+	default:
+		return 0;
+	}
+}
+
+static int32_t ref_str_parse(char *buf, int32_t *integer, int32_t *_fract)
+{
+	char *p;
+
+	p = strtok(buf, ".");
+	if (p == NULL)
+		return -EINVAL;
+
+	*integer = strtol(p, NULL, 0);
+
+	p = strtok(NULL, "\n");
+	if (p == NULL)
+		return -EINVAL;
+
+	*_fract = strtol(p, NULL, 10);
+
+	return 0;
+}
+
+static int32_t ref_fract_interpret(int32_t fract, int32_t subunits)
+{
+	int32_t temp = fract;
+
+	while ((subunits != 0) || (temp != 0)) {
+		temp /= 10;
+		subunits /= 10;
+		if (!temp)
+			break;
+		if (subunits <= 1)
+			fract /= 10;
+	}
+
+	return fract * subunits;
+}
+
+/*******************************************************************************
+ *    HELPERS
+ ******************************************************************************/
+
+static uint32_t test_rand(void)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+
+	return seed;
+}
+
+/* Random value, biased towards the small ones and the limits */
+static int32_t test_rand_s32(void)
+{
+	static const int32_t limits[] = {0, 1, -1, INT32_MAX, INT32_MIN};
+	uint32_t r = test_rand();
+
+	switch (r % 4) {
+	case 0:
+		return limits[test_rand() % NO_OS_ARRAY_SIZE(limits)];
+	case 1:
+		return (int32_t)(test_rand() % 2000) - 1000;
+	default:
+		return (int32_t)test_rand();
+	}
+}
+
+static void test_check_format(enum iio_val fmt, int32_t size, int32_t *vals,
+			      uint32_t len)
+{
+	char exp[128];
+	char act[128];
+	int exp_ret, act_ret;
+
+	memset(exp, 0x55, sizeof(exp));
+	memset(act, 0x55, sizeof(act));
+	exp_ret = ref_format_value(exp, len, fmt, size, vals);
+	act_ret = iio_format_value(act, len, fmt, size, vals);
+
+	TEST_ASSERT_EQUAL_INT(exp_ret, act_ret);
+	TEST_ASSERT_EQUAL_MEMORY(exp, act, sizeof(exp));
+}
+
+static uint64_t test_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	seed = 0x12345678;
+}
+
+void tearDown(void)
+{
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_iio_format_value_int(void)
+{
+	int32_t val;
+	int i;
+
+	for (i = 0; i < TEST_ITERATIONS; i++) {
+		val = test_rand_s32();
+		test_check_format(IIO_VAL_INT, 1, &val, 64);
+	}
+}
+
+void test_iio_format_value_fixpoint(void)
+{
+	static const enum iio_val fmts[] = {
+		IIO_VAL_INT_PLUS_MICRO,
+		IIO_VAL_INT_PLUS_MICRO_DB,
+		IIO_VAL_INT_PLUS_NANO
+	};
+	int32_t vals[2];
+	uint32_t f;
+	int i;
+
+	for (f = 0; f < NO_OS_ARRAY_SIZE(fmts); f++) {
+		for (i = 0; i < TEST_ITERATIONS; i++) {
+			vals[0] = test_rand_s32();
+			/* Out of range fractional parts are printed as unsigned */
+			if (i % 8)
+				vals[1] = test_rand() % (fmts[f] == IIO_VAL_INT_PLUS_NANO ?
+							 1000000000 : 1000000);
+			else
+				vals[1] = test_rand_s32();
+			test_check_format(fmts[f], 2, vals, 64);
+		}
+	}
+}
+
+void test_iio_format_value_fractional(void)
+{
+	int32_t vals[2];
+	int i;
+
+	for (i = 0; i < TEST_ITERATIONS; i++) {
+		vals[0] = test_rand_s32();
+		do {
+			vals[1] = test_rand_s32();
+		} while (!vals[1]);
+		test_check_format(IIO_VAL_FRACTIONAL, 2, vals, 64);
+
+		vals[1] = test_rand() % 32;
+		test_check_format(IIO_VAL_FRACTIONAL_LOG2, 2, vals, 64);
+	}
+}
+
+void test_iio_format_value_multiple_and_char(void)
+{
+	int32_t vals[8];
+	int32_t size;
+	int i, j;
+
+	for (i = 0; i < TEST_ITERATIONS; i++) {
+		size = test_rand() % NO_OS_ARRAY_SIZE(vals) + 1;
+		for (j = 0; j < size; j++)
+			vals[j] = test_rand_s32();
+		test_check_format(IIO_VAL_INT_MULTIPLE, size, vals, 128);
+
+		vals[0] = test_rand() % 256;
+		test_check_format(IIO_VAL_CHAR, 1, vals, 64);
+	}
+}
+
+void test_iio_format_value_truncated(void)
+{
+	int32_t vals[4] = {-123456, 789, 2147483647, -5};
+	uint32_t len;
+
+	for (len = 0; len < 40; len++) {
+		test_check_format(IIO_VAL_INT, 1, vals, len);
+		test_check_format(IIO_VAL_INT_PLUS_MICRO_DB, 2, vals, len);
+		test_check_format(IIO_VAL_FRACTIONAL, 2, vals, len);
+		test_check_format(IIO_VAL_INT_MULTIPLE, 4, vals, len);
+	}
+}
+
+void test_iio_parse_value_int(void)
+{
+	static const char * const bases[] = {"%"PRIi32, "0x%"PRIx32, "0%"PRIo32};
+	char buf[64];
+	int32_t exp, val;
+	int i;
+
+	for (i = 0; i < TEST_ITERATIONS; i++) {
+		exp = test_rand_s32();
+		/* strtol clamps, only compare where it doesn't */
+		if (i % 3) {
+			snprintf(buf, sizeof(buf), bases[i % 3],
+				 (uint32_t)exp & 0x7fffffff);
+			exp = strtol(buf, NULL, 0);
+		} else {
+			snprintf(buf, sizeof(buf), "%"PRIi32, exp);
+		}
+		TEST_ASSERT_EQUAL_INT(0, iio_parse_value(buf, IIO_VAL_INT, &val,
+				      NULL));
+		TEST_ASSERT_EQUAL_INT(exp, val);
+	}
+
+	TEST_ASSERT_EQUAL_INT(0, iio_parse_value(" \t+42\n", IIO_VAL_INT, &val,
+			      NULL));
+	TEST_ASSERT_EQUAL_INT(42, val);
+	TEST_ASSERT_EQUAL_INT(0, iio_parse_value("4294967295", IIO_VAL_INT, &val,
+			      NULL));
+	TEST_ASSERT_EQUAL_INT(-1, val);
+	TEST_ASSERT_EQUAL_INT(0, iio_parse_value("0x", IIO_VAL_INT, &val, NULL));
+	TEST_ASSERT_EQUAL_INT(0, val);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, iio_parse_value("abc", IIO_VAL_INT, &val,
+			      NULL));
+	TEST_ASSERT_EQUAL_INT(0, val);
+}
+
+void test_iio_parse_value_fixpoint(void)
+{
+	char buf[64];
+	char ref_buf[64];
+	int32_t vals[2];
+	int32_t val, val2, ref_val, ref_val2;
+	int i;
+
+	/* Formatter output parses back to the same values */
+	for (i = 0; i < TEST_ITERATIONS; i++) {
+		vals[0] = test_rand_s32();
+		vals[1] = test_rand() % 1000000;
+		iio_format_value(buf, sizeof(buf), IIO_VAL_INT_PLUS_MICRO, 2, vals);
+		TEST_ASSERT_EQUAL_INT(0, iio_parse_value(buf, IIO_VAL_INT_PLUS_MICRO,
+				      &val, &val2));
+		TEST_ASSERT_EQUAL_INT(vals[0], val);
+		TEST_ASSERT_EQUAL_INT(vals[1], val2);
+
+		/* Same as the reference when it doesn't drop leading zeros */
+		if (vals[1] >= 100000 && vals[0] != 0) {
+			strcpy(ref_buf, buf);
+			TEST_ASSERT_EQUAL_INT(0, ref_str_parse(ref_buf, &ref_val,
+							       &ref_val2));
+			ref_val2 = ref_fract_interpret(ref_val2, 1000000);
+			TEST_ASSERT_EQUAL_INT(ref_val, val);
+			TEST_ASSERT_EQUAL_INT(ref_val2, val2);
+		}
+
+		vals[1] = test_rand() % 1000000000;
+		iio_format_value(buf, sizeof(buf), IIO_VAL_INT_PLUS_NANO, 2, vals);
+		TEST_ASSERT_EQUAL_INT(0, iio_parse_value(buf, IIO_VAL_INT_PLUS_NANO,
+				      &val, &val2));
+		TEST_ASSERT_EQUAL_INT(vals[0], val);
+		TEST_ASSERT_EQUAL_INT(vals[1], val2);
+
+		vals[1] = test_rand() % 1000000;
+		iio_format_value(buf, sizeof(buf), IIO_VAL_INT_PLUS_MICRO_DB, 2,
+				 vals);
+		TEST_ASSERT_EQUAL_INT(0, iio_parse_value(buf,
+				      IIO_VAL_INT_PLUS_MICRO_DB, &val, &val2));
+		TEST_ASSERT_EQUAL_INT(vals[0], val);
+		TEST_ASSERT_EQUAL_INT(vals[1], val2);
+	}
+
+	/* Short, long and missing fractional parts */
+	TEST_ASSERT_EQUAL_INT(0, iio_parse_value("1.5", IIO_VAL_INT_PLUS_MICRO,
+			      &val, &val2));
+	TEST_ASSERT_EQUAL_INT(1, val);
+	TEST_ASSERT_EQUAL_INT(500000, val2);
+	TEST_ASSERT_EQUAL_INT(0, iio_parse_value("1.05\n", IIO_VAL_INT_PLUS_MICRO,
+			      &val, &val2));
+	TEST_ASSERT_EQUAL_INT(50000, val2);
+	TEST_ASSERT_EQUAL_INT(0, iio_parse_value("2.1234567", IIO_VAL_INT_PLUS_MICRO,
+			      &val, &val2));
+	TEST_ASSERT_EQUAL_INT(123456, val2);
+	TEST_ASSERT_EQUAL_INT(0, iio_parse_value("7", IIO_VAL_INT_PLUS_NANO,
+			      &val, &val2));
+	TEST_ASSERT_EQUAL_INT(7, val);
+	TEST_ASSERT_EQUAL_INT(0, val2);
+
+	/* The sign of values between -1 and 0 is in the fractional part */
+	TEST_ASSERT_EQUAL_INT(0, iio_parse_value("-0.25", IIO_VAL_INT_PLUS_MICRO,
+			      &val, &val2));
+	TEST_ASSERT_EQUAL_INT(0, val);
+	TEST_ASSERT_EQUAL_INT(-250000, val2);
+	TEST_ASSERT_EQUAL_INT(0, iio_parse_value("-1.25", IIO_VAL_INT_PLUS_MICRO,
+			      &val, &val2));
+	TEST_ASSERT_EQUAL_INT(-1, val);
+	TEST_ASSERT_EQUAL_INT(250000, val2);
+
+	/* IIO_VAL_FRACTIONAL returns the fractional digits as they are */
+	TEST_ASSERT_EQUAL_INT(0, iio_parse_value("12.500", IIO_VAL_FRACTIONAL,
+			      &val, &val2));
+	TEST_ASSERT_EQUAL_INT(12, val);
+	TEST_ASSERT_EQUAL_INT(500, val2);
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, iio_parse_value(".5",
+			      IIO_VAL_INT_PLUS_MICRO, &val, &val2));
+}
+
+void test_iio_parse_values(void)
+{
+	const char buf[] = "1 -2 0x10 \n";
+	int32_t vals[4] = {0};
+
+	TEST_ASSERT_EQUAL_INT(3, iio_parse_values(buf, IIO_VAL_INT_MULTIPLE, 4,
+			      vals));
+	TEST_ASSERT_EQUAL_INT(1, vals[0]);
+	TEST_ASSERT_EQUAL_INT(-2, vals[1]);
+	TEST_ASSERT_EQUAL_INT(16, vals[2]);
+	TEST_ASSERT_EQUAL_INT(2, iio_parse_values(buf, IIO_VAL_INT_MULTIPLE, 2,
+			      vals));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, iio_parse_values("", IIO_VAL_INT_MULTIPLE,
+			      4, vals));
+
+	/* 0.75 * 2^4 */
+	vals[1] = 4;
+	TEST_ASSERT_EQUAL_INT(1, iio_parse_values("0.750000000",
+			      IIO_VAL_FRACTIONAL_LOG2, 2, vals));
+	TEST_ASSERT_EQUAL_INT(12, vals[0]);
+	vals[1] = 3;
+	TEST_ASSERT_EQUAL_INT(1, iio_parse_values("-2.5", IIO_VAL_FRACTIONAL_LOG2,
+			      2, vals));
+	TEST_ASSERT_EQUAL_INT(-20, vals[0]);
+
+	TEST_ASSERT_EQUAL_INT(1, iio_parse_values("y", IIO_VAL_CHAR, 1, vals));
+	TEST_ASSERT_EQUAL_INT('y', vals[0]);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, iio_parse_values("1.5",
+			      IIO_VAL_INT_PLUS_MICRO, 1, vals));
+
+	/* The input is not modified, unlike with strtok */
+	TEST_ASSERT_EQUAL_STRING("1 -2 0x10 \n", buf);
+}
+
+void test_iio_val_speed(void)
+{
+	char buf[64];
+	char ref_buf[64];
+	int32_t vals[2] = {-12, 345678};
+	int32_t val, val2;
+	uint64_t start, ref_ns, ns;
+	volatile uint32_t sink = 0;
+	int i;
+
+	start = test_time_ns();
+	for (i = 0; i < SPEED_ITERATIONS; i++) {
+		vals[1] = i % 1000000;
+		sink += ref_format_value(buf, sizeof(buf), IIO_VAL_INT_PLUS_MICRO,
+					 2, vals);
+	}
+	ref_ns = test_time_ns() - start;
+
+	start = test_time_ns();
+	for (i = 0; i < SPEED_ITERATIONS; i++) {
+		vals[1] = i % 1000000;
+		sink += iio_format_value(buf, sizeof(buf), IIO_VAL_INT_PLUS_MICRO,
+					 2, vals);
+	}
+	ns = test_time_ns() - start;
+
+	printf("iio_format_value: %"PRIu64" ns/op, snprintf: %"PRIu64" ns/op\n",
+	       ns / SPEED_ITERATIONS, ref_ns / SPEED_ITERATIONS);
+
+	start = test_time_ns();
+	for (i = 0; i < SPEED_ITERATIONS; i++) {
+		strcpy(ref_buf, "-12.345678");
+		ref_str_parse(ref_buf, &val, &val2);
+		sink += ref_fract_interpret(val2, 1000000);
+	}
+	ref_ns = test_time_ns() - start;
+
+	start = test_time_ns();
+	for (i = 0; i < SPEED_ITERATIONS; i++) {
+		strcpy(ref_buf, "-12.345678");
+		iio_parse_value(ref_buf, IIO_VAL_INT_PLUS_MICRO, &val, &val2);
+		sink += val2;
+	}
+	ns = test_time_ns() - start;
+
+	printf("iio_parse_value: %"PRIu64" ns/op, strtok: %"PRIu64" ns/op\n",
+	       ns / SPEED_ITERATIONS, ref_ns / SPEED_ITERATIONS);
+
+	TEST_ASSERT_NOT_EQUAL(0, sink);
+}
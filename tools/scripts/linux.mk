@@ -8,6 +8,8 @@ PROJECT_BUILD = $(BUILD_DIR)/app
 CFLAGS +=  -g3 \
 		-DLINUX_PLATFORM \
 
+LIB_FLAGS += -lpthread
+
 $(PROJECT_TARGET):
 	$(call mk_dir, $(BUILD_DIR)) $(HIDE)
 	$(call set_one_time_rule,$@)
@@ -372,6 +372,51 @@ int32_t no_os_cb_end_async_read(struct no_os_circular_buffer *desc)
 }
 /** @} */
 
+/*
+ * Functionality described at no_os_cb_abort_async_write/read having the
+ * is_read parameter to specifiy if it is a read or write operation.
+ */
+static int32_t no_os_cb_abort_async_operation(struct no_os_circular_buffer
+		*desc, bool is_read)
+{
+	struct no_os_cb_ptr	*ptr;
+
+	if (!desc)
+		return -EINVAL;
+
+	ptr = is_read ? &desc->read : &desc->write;
+	if (!ptr->async_started)
+		return -1;
+
+	/* Leave the index in place, the same block is handed out again */
+	ptr->async_size = 0;
+	ptr->async_started = false;
+
+	return 0;
+}
+
+/**
+ * \defgroup abort_async_group Abort Ashyncronous functions
+ * @brief Abort asynchronous transaction, without consuming the buffer.
+ *
+ * @param desc - Circular buffer reference
+ * @return
+ *  - 0   - No errors
+ *  - -1   - Asynchronous transaction not started
+ *  - -EINVAL        - Wrong parameters used
+ * @{
+ */
+int32_t no_os_cb_abort_async_write(struct no_os_circular_buffer *desc)
+{
+	return no_os_cb_abort_async_operation(desc, 0);
+}
+
+int32_t no_os_cb_abort_async_read(struct no_os_circular_buffer *desc)
+{
+	return no_os_cb_abort_async_operation(desc, 1);
+}
+/** @} */
+
 /**
  * @brief Write data to the buffer (Blocking).
  * @param desc - Circular buffer reference
@@ -1,4 +1,5 @@
 #include <stdint.h>
+#include "no_os_waveform.h"
 
 const uint16_t no_os_sine_lut_16[512] = {
 	0x8000, 0x8192, 0x8324, 0x84b6, 0x8647, 0x87d9, 0x896a, 0x8afb,
@@ -0,0 +1,744 @@
+/***************************************************************************//**
+ *   @file   no_os_waveform.c
+ *   @brief  Fixed-point waveform synthesis for DAC buffers.
+********************************************************************************
+ * Copyright 2023(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include "no_os_waveform.h"
+#include "no_os_util.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+/* Samples generated per pass, kept on the stack */
+#define WAVE_CHUNK		64
+/* Fractional bits of the chirp instantaneous tuning word */
+#define WAVE_FTW_FRAC		24
+/* Phase offset of cos() relative to sin() */
+#define WAVE_QUARTER_TURN	0x40000000u
+/* ln(2), Q64, upper and lower words */
+#define WAVE_LN2_HI		0xb17217f7u
+#define WAVE_LN2_LO		0xd1cf79abu
+/* Extra fractional bits kept while computing the log chirp rate */
+#define WAVE_GUARD_BITS		8
+/* Significant digits kept when parsing a number (fits 64 bits once scaled) */
+#define WAVE_PARSE_MANT_MAX	100000000000ull
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+/**
+ * @brief Linearly interpolated sine.
+ * @param phase - Phase, 2^32 is a full turn.
+ * @return sin(phase), Q15.
+ */
+static inline int32_t wave_sin(uint32_t phase)
+{
+	uint32_t idx = phase >> 23;
+	int32_t frac = (phase >> 7) & 0xFFFF;
+	int32_t s0 = (int32_t)no_os_sine_lut_16[idx] - 0x8000;
+	int32_t s1 = (int32_t)no_os_sine_lut_16[(idx + 1) & 511] - 0x8000;
+
+	return s0 + (((s1 - s0) * frac) >> 16);
+}
+
+/**
+ * @brief Square of a number in [1, 2), Q62.
+ * @param m - Argument, Q62.
+ * @return m * m, Q62, below 4.
+ */
+static uint64_t wave_sqr_q62(uint64_t m)
+{
+	uint32_t mh = m >> 32;
+	uint32_t ml = m;
+
+	return (no_os_mul_u32_u32(mh, mh) << 2) +
+	       (no_os_mul_u32_u32(mh, ml) >> 29) +
+	       (no_os_mul_u32_u32(ml, ml) >> 62);
+}
+
+/**
+ * @brief Base 2 logarithm, bit by bit from the squared mantissa.
+ * @param v - Argument, > 0.
+ * @return log2(v), Q(32 + WAVE_GUARD_BITS).
+ */
+static uint64_t wave_log2(uint32_t v)
+{
+	uint32_t msb = no_os_find_last_set_bit(v);
+	uint64_t res = (uint64_t)msb << (32 + WAVE_GUARD_BITS);
+	uint64_t m;
+	int i;
+
+	/* Mantissa in [1, 2), Q62 */
+	m = (uint64_t)v << (62 - msb);
+	for (i = 31 + WAVE_GUARD_BITS; i >= 0; i--) {
+		m = wave_sqr_q62(m);
+		if (m >> 63) {
+			res |= 1ull << i;
+			m >>= 1;
+		}
+	}
+
+	return res;
+}
+
+/**
+ * @brief exp(x) - 1, or 1 - exp(-x), from the Taylor series. The terms are
+ * summed with WAVE_GUARD_BITS extra bits, so that their truncation doesn't
+ * add up.
+ * @param x - Argument, Q(32 + WAVE_GUARD_BITS), below 1.
+ * @param neg - Compute 1 - exp(-x).
+ * @return The result, Q32, rounded.
+ */
+static uint64_t wave_expm1(uint64_t x, bool neg)
+{
+	uint64_t term = x, sum = 0;
+	uint32_t mul;
+	uint32_t k;
+
+	/* x rounded to Q32, for the following terms */
+	mul = no_os_min_t(uint64_t, (x + (1u << (WAVE_GUARD_BITS - 1))) >>
+			  WAVE_GUARD_BITS, UINT32_MAX);
+
+	/* term = x^(k - 1) / (k - 1)! */
+	for (k = 2; term; k++) {
+		if (neg && (k & 1))
+			sum -= term;
+		else
+			sum += term;
+		term = no_os_mul_u64_u32_shr(term, mul, 32) / k;
+	}
+
+	return (sum + (1u << (WAVE_GUARD_BITS - 1))) >> WAVE_GUARD_BITS;
+}
+
+/**
+ * @brief Frequency tuning word of a frequency: f / fs * 2^32. Negative
+ * frequencies (complex signals) wrap to the upper half of the range.
+ * @param freq_hz - Frequency.
+ * @param fs_hz - Sample rate, below 2^48 Hz.
+ * @return The tuning word.
+ */
+uint32_t no_os_wave_ftw(int64_t freq_hz, uint64_t fs_hz)
+{
+	uint64_t f, hi, rem;
+	uint32_t ftw;
+
+	if (!fs_hz)
+		return 0;
+
+	f = (freq_hz < 0 ? -(uint64_t)freq_hz : (uint64_t)freq_hz) % fs_hz;
+	/* (f << 32) / fs in two steps, f << 32 overflows for fs above 4 GHz */
+	hi = (f << 16) / fs_hz;
+	rem = (f << 16) % fs_hz;
+	ftw = (hi << 16) + ((rem << 16) / fs_hz);
+
+	return freq_hz < 0 ? -ftw : ftw;
+}
+
+/**
+ * @brief Validate the waveform parameters and reset the generator.
+ * @param w - Waveform.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_wave_init(struct no_os_wave *w)
+{
+	struct no_os_wave_fmt *fmt;
+	int32_t start, stop;
+	uint64_t x, rate;
+	uint8_t i;
+
+	if (!w)
+		return -EINVAL;
+
+	fmt = &w->fmt;
+	if (!fmt->storagebits) {
+		fmt->sign = 's';
+		fmt->realbits = 16;
+		fmt->storagebits = 16;
+		fmt->shift = 0;
+		fmt->is_big_endian = false;
+	}
+	if ((fmt->storagebits != 8 && fmt->storagebits != 16 &&
+	     fmt->storagebits != 32) || !fmt->realbits ||
+	    fmt->realbits + fmt->shift > fmt->storagebits ||
+	    (fmt->sign != 's' && fmt->sign != 'u'))
+		return -EINVAL;
+
+	start = (int32_t)w->ftw_start;
+	stop = (int32_t)w->ftw_stop;
+	w->ftw_q = (int64_t)start * (1 << WAVE_FTW_FRAC);
+	w->n = 0;
+
+	switch (w->type) {
+	case NO_OS_WAVE_TONE:
+		if (!w->nb_tones || w->nb_tones > NO_OS_WAVE_MAX_TONES)
+			return -EINVAL;
+		for (i = 0; i < w->nb_tones; i++)
+			w->acc[i] = w->tone[i].phase;
+		break;
+	case NO_OS_WAVE_CHIRP_LIN:
+		if (!w->sweep_len)
+			return -EINVAL;
+		w->acc[0] = 0;
+		w->ftw_step = ((int64_t)stop - start) * (1 << WAVE_FTW_FRAC) /
+			      (int64_t)w->sweep_len;
+		break;
+	case NO_OS_WAVE_CHIRP_LOG:
+		if (!w->sweep_len || start <= 0 || stop <= 0)
+			return -EINVAL;
+		/*
+		 * ftw(n + 1) = ftw(n) * (1 +- rate), reaching ftw_stop after
+		 * sweep_len: rate = |exp(+-x) - 1|, x = |ln(stop / start)| / sweep_len
+		 */
+		w->ftw_down = stop < start;
+		if (w->ftw_down)
+			x = wave_log2(start) - wave_log2(stop);
+		else
+			x = wave_log2(stop) - wave_log2(start);
+		x = no_os_mul_u64_u32_shr(x, WAVE_LN2_HI, 32) +
+		    (no_os_mul_u64_u32_shr(x, WAVE_LN2_LO, 32) >> 32);
+		x = (x + w->sweep_len / 2) / w->sweep_len;
+		if (x >> (32 + WAVE_GUARD_BITS))
+			return -EINVAL;
+		rate = wave_expm1(x, w->ftw_down);
+		if (rate >> 32)
+			return -EINVAL;
+		w->acc[0] = 0;
+		w->ftw_rate = rate;
+		break;
+	case NO_OS_WAVE_PRBS:
+		if (w->prbs_order != 7 && w->prbs_order != 15 &&
+		    w->prbs_order != 23 && w->prbs_order != 31)
+			return -EINVAL;
+		w->prbs = NO_OS_GENMASK(w->prbs_order - 1, 0);
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Generate tones: each tone is computed over the whole chunk at once,
+ * phases depend on the sample index only.
+ * @param w - Waveform.
+ * @param si - I output, Q15 (may exceed the range when tones add up).
+ * @param sq - Q output.
+ * @param n - Number of samples.
+ */
+static void wave_gen_tone(struct no_os_wave *w, int32_t *si, int32_t *sq,
+			  uint32_t n)
+{
+	uint32_t j, ph0, ftw;
+	int32_t amp;
+	uint8_t k;
+
+	memset(si, 0, n * sizeof(*si));
+	memset(sq, 0, n * sizeof(*sq));
+
+	for (k = 0; k < w->nb_tones; k++) {
+		ph0 = w->acc[k];
+		ftw = w->tone[k].ftw;
+		amp = w->tone[k].amplitude;
+
+		for (j = 0; j < n; j++)
+			si[j] += (wave_sin(ph0 + j * ftw + WAVE_QUARTER_TURN) * amp) >> 15;
+		if (w->iq)
+			for (j = 0; j < n; j++)
+				sq[j] += (wave_sin(ph0 + j * ftw) * amp) >> 15;
+
+		w->acc[k] = ph0 + n * ftw;
+	}
+}
+
+/**
+ * @brief Generate a chirp. The instantaneous tuning word restarts from
+ * ftw_start every sweep_len samples, the phase is continuous.
+ * @param w - Waveform.
+ * @param si - I output, Q15.
+ * @param sq - Q output.
+ * @param n - Number of samples.
+ */
+static void wave_gen_chirp(struct no_os_wave *w, int32_t *si, int32_t *sq,
+			   uint32_t n)
+{
+	uint32_t phase[WAVE_CHUNK];
+	uint64_t hi, lo, d;
+	int32_t amp = w->amplitude;
+	uint32_t j;
+
+	for (j = 0; j < n; j++) {
+		phase[j] = w->acc[0];
+		w->acc[0] += (uint32_t)(w->ftw_q >> WAVE_FTW_FRAC);
+
+		if (w->type == NO_OS_WAVE_CHIRP_LIN) {
+			w->ftw_q += w->ftw_step;
+		} else {
+			/* ftw_q * rate >> 32, without a 64x32 bit product */
+			hi = (uint64_t)w->ftw_q >> 32;
+			lo = (uint32_t)w->ftw_q;
+			d = hi * w->ftw_rate + ((lo * w->ftw_rate) >> 32);
+			w->ftw_q += w->ftw_down ? -(int64_t)d : (int64_t)d;
+		}
+
+		if (++w->n == w->sweep_len) {
+			w->n = 0;
+			w->ftw_q = (int64_t)(int32_t)w->ftw_start * (1 << WAVE_FTW_FRAC);
+		}
+	}
+
+	for (j = 0; j < n; j++)
+		si[j] = (wave_sin(phase[j] + WAVE_QUARTER_TURN) * amp) >> 15;
+	if (w->iq)
+		for (j = 0; j < n; j++)
+			sq[j] = (wave_sin(phase[j]) * amp) >> 15;
+}
+
+/**
+ * @brief Next PRBS bit (Fibonacci LFSR, ITU-T O.150 polynomials).
+ * @param w - Waveform.
+ * @return The bit.
+ */
+static inline uint32_t wave_prbs_bit(struct no_os_wave *w)
+{
+	uint8_t tap;
+	uint32_t bit;
+
+	switch (w->prbs_order) {
+	case 7:
+		tap = 6;
+		break;
+	case 15:
+		tap = 14;
+		break;
+	case 23:
+		tap = 18;
+		break;
+	default:
+		tap = 28;
+		break;
+	}
+
+	bit = ((w->prbs >> (w->prbs_order - 1)) ^ (w->prbs >> (tap - 1))) & 1;
+	w->prbs = ((w->prbs << 1) | bit) &
+		  NO_OS_GENMASK(w->prbs_order - 1, 0);
+
+	return bit;
+}
+
+/**
+ * @brief Generate a PRBS, one bit per sample (and per I/Q component).
+ * @param w - Waveform.
+ * @param si - I output, Q15.
+ * @param sq - Q output.
+ * @param n - Number of samples.
+ */
+static void wave_gen_prbs(struct no_os_wave *w, int32_t *si, int32_t *sq,
+			  uint32_t n)
+{
+	uint32_t j;
+
+	for (j = 0; j < n; j++) {
+		si[j] = wave_prbs_bit(w) ? w->amplitude : -w->amplitude;
+		if (w->iq)
+			sq[j] = wave_prbs_bit(w) ? w->amplitude : -w->amplitude;
+	}
+}
+
+/**
+ * @brief Saturate and convert Q15 samples to the channel format.
+ * @param fmt - Sample format.
+ * @param s - Samples.
+ * @param buf - Address of the first output sample.
+ * @param n - Number of samples.
+ * @param stride - Distance between output samples, in samples.
+ */
+static void wave_pack(const struct no_os_wave_fmt *fmt, int32_t *s,
+		      uint8_t *buf, uint32_t n, uint32_t stride)
+{
+	uint32_t mask = NO_OS_GENMASK(fmt->realbits - 1, 0);
+	uint32_t bytes = fmt->storagebits / 8;
+	uint32_t j, raw;
+	int16_t *p16;
+	int32_t v;
+	uint8_t b;
+
+	for (j = 0; j < n; j++)
+		s[j] = no_os_clamp(s[j], -32768, 32767);
+
+	/* Native format of the AXI DAC and most demo channels */
+	if (fmt->storagebits == 16 && fmt->realbits == 16 && !fmt->shift &&
+	    fmt->sign == 's' && !fmt->is_big_endian) {
+		p16 = (int16_t *)buf;
+		for (j = 0; j < n; j++)
+			p16[j * stride] = s[j];
+		return;
+	}
+
+	for (j = 0; j < n; j++, buf += stride * bytes) {
+		v = s[j];
+		if (fmt->realbits <= 16)
+			v >>= 16 - fmt->realbits;
+		else
+			v *= 1 << (fmt->realbits - 16);
+		raw = (uint32_t)v;
+		if (fmt->sign == 'u')
+			raw += NO_OS_BIT(fmt->realbits - 1);
+		raw = (raw & mask) << fmt->shift;
+
+		for (b = 0; b < bytes; b++) {
+			if (fmt->is_big_endian)
+				buf[bytes - 1 - b] = raw >> (8 * b);
+			else
+				buf[b] = raw >> (8 * b);
+		}
+	}
+}
+
+/**
+ * @brief Generate samples, continuing the waveform from the previous call.
+ * Works for interleaved (DMA scan) buffers as well as per-channel ones.
+ * @param w - Waveform, set up with no_os_wave_init().
+ * @param i_buf - Address of the first I (or real) sample.
+ * @param q_buf - Address of the first Q sample, unused if w->iq is false.
+ * @param nb_samples - Number of samples per component.
+ * @param stride - Distance between consecutive samples of a component, in
+ *		   samples: the number of channels of an interleaved buffer, 1 for
+ *		   a per-channel buffer.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_wave_fill(struct no_os_wave *w, void *i_buf, void *q_buf,
+		    uint32_t nb_samples, uint32_t stride)
+{
+	int32_t si[WAVE_CHUNK], sq[WAVE_CHUNK];
+	uint8_t *pi = i_buf, *pq = q_buf;
+	uint32_t n, step;
+
+	if (!w || !w->fmt.storagebits || !i_buf || (w->iq && !q_buf) || !stride)
+		return -EINVAL;
+
+	step = WAVE_CHUNK * stride * (w->fmt.storagebits / 8);
+	while (nb_samples) {
+		n = no_os_min(nb_samples, (uint32_t)WAVE_CHUNK);
+
+		switch (w->type) {
+		case NO_OS_WAVE_TONE:
+			wave_gen_tone(w, si, sq, n);
+			break;
+		case NO_OS_WAVE_CHIRP_LIN:
+		case NO_OS_WAVE_CHIRP_LOG:
+			wave_gen_chirp(w, si, sq, n);
+			break;
+		case NO_OS_WAVE_PRBS:
+			wave_gen_prbs(w, si, sq, n);
+			break;
+		default:
+			return -EINVAL;
+		}
+
+		wave_pack(&w->fmt, si, pi, n, stride);
+		if (w->iq)
+			wave_pack(&w->fmt, sq, pq, n, stride);
+
+		pi += step;
+		pq += step;
+		nb_samples -= n;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Tuning word of a parsed frequency. With a period, the frequency is
+ * rounded to a multiple of fs / period, so that period samples hold a whole
+ * number of cycles and cyclic replay has no discontinuity.
+ * @param freq_hz - Frequency.
+ * @param fs_hz - Sample rate.
+ * @param period - Buffer length in samples, 0 for no rounding.
+ * @return The tuning word.
+ */
+static uint32_t wave_parse_ftw(int64_t freq_hz, uint64_t fs_hz,
+			       uint32_t period)
+{
+	int64_t k;
+
+	if (!period)
+		return no_os_wave_ftw(freq_hz, fs_hz);
+
+	k = (freq_hz * 2 * (int64_t)period + (freq_hz < 0 ? -1 : 1) *
+	     (int64_t)fs_hz) / (2 * (int64_t)fs_hz);
+	k %= (int64_t)period;
+	if (k < 0)
+		k += period;
+
+	return ((uint64_t)k << 32) / period;
+}
+
+/**
+ * @brief Check that only white space is left.
+ * @param p - Text.
+ * @return true if p is blank.
+ */
+static bool wave_parse_end(const char *p)
+{
+	while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')
+		p++;
+
+	return !*p;
+}
+
+/**
+ * @brief Check for a decimal digit.
+ * @param c - Character.
+ * @return true if c is a digit.
+ */
+static inline bool wave_is_digit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+/**
+ * @brief Parse a decimal number with optional fraction and exponent, e.g.
+ * "-3e6", "2.5e6" or "0.7", scaled and rounded to an integer.
+ * @param p - Text, leading blanks are skipped.
+ * @param end - Set past the number.
+ * @param mul - Scale applied before rounding, below 2^16.
+ * @param val - Result.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int wave_parse_dec(const char *p, const char **end, uint32_t mul,
+			  int64_t *val)
+{
+	bool neg = false, eneg = false, digits = false;
+	int32_t exp10 = 0, e = 0;
+	uint64_t mant = 0;
+	const char *q;
+
+	while (*p == ' ' || *p == '\t')
+		p++;
+	if (*p == '-' || *p == '+')
+		neg = *p++ == '-';
+
+	for (; wave_is_digit(*p); p++) {
+		digits = true;
+		if (mant < WAVE_PARSE_MANT_MAX)
+			mant = mant * 10 + (*p - '0');
+		else
+			exp10++;
+	}
+	if (*p == '.') {
+		for (p++; wave_is_digit(*p); p++) {
+			digits = true;
+			if (mant < WAVE_PARSE_MANT_MAX) {
+				mant = mant * 10 + (*p - '0');
+				exp10--;
+			}
+		}
+	}
+	if (!digits)
+		return -EINVAL;
+
+	if (*p == 'e' || *p == 'E') {
+		q = p + 1;
+		if (*q == '-' || *q == '+')
+			eneg = *q++ == '-';
+		if (wave_is_digit(*q)) {
+			for (; wave_is_digit(*q); q++)
+				if (e < 100)
+					e = e * 10 + (*q - '0');
+			exp10 += eneg ? -e : e;
+			p = q;
+		}
+	}
+
+	mant *= mul;
+	for (; exp10 > 0 && mant; exp10--) {
+		if (mant > INT64_MAX / 10)
+			return -ERANGE;
+		mant *= 10;
+	}
+	for (; exp10 < -1 && mant; exp10++)
+		mant /= 10;
+	if (exp10 == -1)
+		mant = (mant + 5) / 10;
+	if (mant > INT64_MAX)
+		return -ERANGE;
+
+	*val = neg ? -(int64_t)mant : (int64_t)mant;
+	*end = p;
+
+	return 0;
+}
+
+/**
+ * @brief Parse an optional amplitude (fraction of full scale), ending the
+ * description.
+ * @param p - Text.
+ * @param amplitude - Amplitude, Q15. Left unchanged if p holds none.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int wave_parse_scale(const char *p, int16_t *amplitude)
+{
+	const char *end;
+	int64_t scale;
+	int ret;
+
+	if (wave_parse_end(p))
+		return 0;
+
+	ret = wave_parse_dec(p, &end, NO_OS_WAVE_FULL_SCALE, &scale);
+	if (ret)
+		return ret;
+
+	if (!wave_parse_end(end) || scale <= 0 || scale > NO_OS_WAVE_FULL_SCALE)
+		return -EINVAL;
+
+	*amplitude = scale;
+
+	return 0;
+}
+
+/**
+ * @brief Set up a waveform from a text description, e.g. received through an
+ * IIO attribute. The sample format and the iq flag are kept. Frequencies are
+ * in Hz and numbers may have a fraction and an exponent ("2.5e6"), the
+ * optional scale is a fraction of full scale (default 0.5):
+ *	"tone <f>[,<f>...] [<scale>]"		sum of up to NO_OS_WAVE_MAX_TONES
+ *	"chirp <f0> <f1> <samples> [lin|log] [<scale>]"
+ *	"prbs <7|15|23|31> [<scale>]"
+ * @param w - Waveform.
+ * @param spec - Description.
+ * @param fs_hz - Sample rate.
+ * @param period - Buffer length for cyclic replay: tones are rounded to a
+ *		   whole number of cycles, a chirp with 0 samples sweeps over
+ *		   the buffer. 0 if not replayed.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_wave_parse(struct no_os_wave *w, const char *spec, uint64_t fs_hz,
+		     uint32_t period)
+{
+	int64_t f[NO_OS_WAVE_MAX_TONES], len;
+	int16_t amplitude = NO_OS_WAVE_FULL_SCALE / 2;
+	const char *p, *end;
+	char *num_end;
+	uint8_t n = 0, k;
+	int ret;
+
+	if (!w || !spec || !fs_hz)
+		return -EINVAL;
+
+	if (!strncmp(spec, "tone", 4)) {
+		p = spec + 4;
+		do {
+			ret = wave_parse_dec(p, &end, 1, &f[n]);
+			if (ret)
+				return ret;
+			n++;
+			p = end;
+		} while (*p == ',' && p++ && n < NO_OS_WAVE_MAX_TONES);
+
+		ret = wave_parse_scale(p, &amplitude);
+		if (ret)
+			return ret;
+
+		w->type = NO_OS_WAVE_TONE;
+		w->nb_tones = n;
+		for (k = 0; k < n; k++) {
+			w->tone[k].ftw = wave_parse_ftw(f[k], fs_hz, period);
+			/* Newman phases keep the crest factor of the sum low */
+			w->tone[k].phase = ((uint64_t)k * k << 31) / n;
+			w->tone[k].amplitude = amplitude / n;
+		}
+	} else if (!strncmp(spec, "chirp", 5)) {
+		p = spec + 5;
+		ret = wave_parse_dec(p, &end, 1, &f[0]);
+		if (ret)
+			return ret;
+		ret = wave_parse_dec(end, &p, 1, &f[1]);
+		if (ret)
+			return ret;
+		ret = wave_parse_dec(p, &end, 1, &len);
+		if (ret)
+			return ret;
+		if (len < 0 || len > UINT32_MAX)
+			return -EINVAL;
+		p = end;
+		w->sweep_len = len;
+		if (!w->sweep_len)
+			w->sweep_len = period;
+
+		while (*p == ' ')
+			p++;
+		w->type = NO_OS_WAVE_CHIRP_LIN;
+		if (!strncmp(p, "log", 3)) {
+			w->type = NO_OS_WAVE_CHIRP_LOG;
+			p += 3;
+		} else if (!strncmp(p, "lin", 3)) {
+			p += 3;
+		}
+
+		ret = wave_parse_scale(p, &amplitude);
+		if (ret)
+			return ret;
+
+		w->ftw_start = no_os_wave_ftw(f[0], fs_hz);
+		w->ftw_stop = no_os_wave_ftw(f[1], fs_hz);
+		w->amplitude = amplitude;
+	} else if (!strncmp(spec, "prbs", 4)) {
+		p = spec + 4;
+		w->prbs_order = strtoul(p, &num_end, 0);
+		if (num_end == p)
+			return -EINVAL;
+
+		ret = wave_parse_scale(num_end, &amplitude);
+		if (ret)
+			return ret;
+
+		w->type = NO_OS_WAVE_PRBS;
+		w->amplitude = amplitude;
+	} else {
+		return -EINVAL;
+	}
+
+	return no_os_wave_init(w);
+}